@@ -825,7 +825,7 @@ int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
 }
 #endif // FORKFD_NO_FORKFD
 
-#if _POSIX_SPAWN > 0 && !defined(FORKFD_NO_SPAWNFD)
+#if defined(FORKFD_HAVE_POSIX_SPAWN) && !defined(FORKFD_NO_SPAWNFD)
 int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_actions_t *file_actions,
             posix_spawnattr_t *attrp, char *const argv[], char *const envp[])
 {
@@ -834,6 +834,7 @@ int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_act
     struct pipe_payload payload;
     pid_t pid;
     int death_pipe[2];
+    int spawn_error;
     int ret = -1;
     /* we can only do work if we have a way to start the child in stopped mode;
      * otherwise, we have a major race condition. */
@@ -855,12 +856,12 @@ int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_act
     /* start the process */
     if (flags & FFD_SPAWN_SEARCH_PATH) {
         /* use posix_spawnp */
-        if (posix_spawnp(&pid, path, file_actions, attrp, argv, envp) != 0)
-            goto err_close;
+        spawn_error = posix_spawnp(&pid, path, file_actions, attrp, argv, envp);
     } else {
-        if (posix_spawn(&pid, path, file_actions, attrp, argv, envp) != 0)
-            goto err_close;
+        spawn_error = posix_spawn(&pid, path, file_actions, attrp, argv, envp);
     }
+    if (spawn_error != 0)
+        goto err_close;
 
     if (ppid)
         *ppid = pid;
@@ -880,6 +881,7 @@ int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_act
 err_close:
     EINTR_LOOP(ret, close(death_pipe[0]));
     EINTR_LOOP(ret, close(death_pipe[1]));
+    errno = spawn_error; /* posix_spawn returns the error instead of setting errno */
 
 err_free:
     /* free the info pointer */
@@ -888,7 +890,7 @@ err_free:
 out:
     return -1;
 }
-#endif // _POSIX_SPAWN && !FORKFD_NO_SPAWNFD
+#endif // FORKFD_HAVE_POSIX_SPAWN && !FORKFD_NO_SPAWNFD
 
 int forkfd_wait4(int ffd, struct forkfd_info *info, int options, struct rusage *rusage)
 {
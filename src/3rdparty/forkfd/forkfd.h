@@ -31,6 +31,15 @@
 #include <unistd.h> // to get the POSIX flags
 
 #if _POSIX_SPAWN > 0
+#  define FORKFD_HAVE_POSIX_SPAWN 1
+#elif defined(__has_include)
+/* Darwin provides posix_spawn() but defines _POSIX_SPAWN as -1 */
+#  if __has_include(<spawn.h>)
+#    define FORKFD_HAVE_POSIX_SPAWN 1
+#  endif
+#endif
+
+#ifdef FORKFD_HAVE_POSIX_SPAWN
 #  include <spawn.h>
 #endif
 
@@ -61,7 +70,7 @@ static inline int forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *
 }
 int forkfd_close(int ffd);
 
-#if _POSIX_SPAWN > 0
+#ifdef FORKFD_HAVE_POSIX_SPAWN
 /* only for spawnfd: */
 #  define FFD_SPAWN_SEARCH_PATH   O_RDWR
 
@@ -0,0 +1,484 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+    \page qtconcurrentalgorithms.html
+    \title Concurrent Sort, Scan and Partition
+    \brief Sorting, scanning and partitioning a sequence in parallel.
+    \ingroup thread
+    \since 6.9
+
+    The QtConcurrent::sort(), QtConcurrent::stableSort(),
+    QtConcurrent::inclusiveScan() and QtConcurrent::partition() functions
+    are parallel versions of the standard algorithms with the same names.
+    They work in-place on a sequence such as a QList, or on a range given
+    by a pair of random-access iterators.
+
+    These functions are part of the \l {Qt Concurrent} framework.
+
+    Each of the above functions has a blocking variant that returns once the
+    algorithm is done, instead of a QFuture:
+
+    \code
+    QList<int> values = ...;
+    QtConcurrent::blockingSort(values);
+    QtConcurrent::blockingInclusiveScan(values);
+
+    auto odd = QtConcurrent::blockingPartition(values, [](int value) { return value % 2; });
+    \endcode
+
+    The range is split into chunks that are processed by the threads of a
+    QThreadPool, the global one unless another pool is given. Sequences that
+    are too small to be worth splitting are processed by a single thread.
+
+    Like for the other functions in QtConcurrent, the functions passed to
+    these algorithms are called from several threads at the same time, and
+    must therefore be thread-safe.
+
+    \section1 Concurrent Sort
+
+    QtConcurrent::sort() sorts the items of a sequence in ascending order, by
+    default using \c{operator<()}. A comparison function of the form
+
+    \code
+    bool function(const T &left, const T &right);
+    \endcode
+
+    can be passed to establish a different order. QtConcurrent::stableSort()
+    additionally preserves the order of equivalent items.
+
+    Both functions sort chunks of the sequence in parallel and then merge the
+    sorted chunks. If the items are default-constructible, the merges go
+    through a temporary buffer of the size of the sequence, which lets all
+    threads take part in every merge. Otherwise the chunks are merged in
+    place.
+
+    \section1 Concurrent Inclusive Scan
+
+    QtConcurrent::inclusiveScan() computes the running totals of a sequence,
+    replacing each item with the combination of it and all items before it,
+    by default using \c{operator+()}. The function combining two items must be
+    associative, since the order in which items are combined differs from a
+    sequential scan.
+
+    \section1 Concurrent Partition
+
+    QtConcurrent::partition() reorders a sequence so that all items for which
+    a predicate returns \c true come before the items for which it returns
+    \c false, and reports an iterator to the first item of the second group.
+    The relative order of the items is not preserved.
+
+    \sa {Concurrent Map and Map-Reduce}, {Concurrent Filter and Filter-Reduce}
+*/
+
+/*!
+  \class QtConcurrent::StagedKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::SortKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::InclusiveScanKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PartitionKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmskernel-1] ThreadEngineStarter<void> QtConcurrent::startSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmskernel-2] ThreadEngineStarter<void> QtConcurrent::startInclusiveScan(QThreadPool *pool, InputIterator begin, InputIterator end, OutputIterator output, BinaryOp &&binaryOp)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmskernel-3] ThreadEngineStarter<Iterator> QtConcurrent::startPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+  \internal
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare, with threads taken from
+    \a pool. The order of equivalent items is not preserved.
+
+    \sa stableSort(), blockingSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> QFuture<void> QtConcurrent::sort(Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare. The order of equivalent
+    items is not preserved.
+
+    \sa stableSort(), blockingSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare, with threads
+    taken from \a pool. The order of equivalent items is not preserved.
+
+    \sa stableSort(), blockingSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> QFuture<void> QtConcurrent::sort(Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare. The order of
+    equivalent items is not preserved.
+
+    \sa stableSort(), blockingSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare, with threads taken from
+    \a pool. The order of equivalent items is preserved.
+
+    \sa sort(), blockingStableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> QFuture<void> QtConcurrent::stableSort(Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare. The order of equivalent
+    items is preserved.
+
+    \sa sort(), blockingStableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare, with threads
+    taken from \a pool. The order of equivalent items is preserved.
+
+    \sa sort(), blockingStableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> QFuture<void> QtConcurrent::stableSort(Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare. The order of
+    equivalent items is preserved.
+
+    \sa sort(), blockingStableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOp> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it using \a binaryOp, with threads taken from \a pool.
+    \a binaryOp must be associative.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOp> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it using \a binaryOp. \a binaryOp must be associative.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename InputIterator, typename OutputIterator, typename BinaryOp> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, InputIterator begin, InputIterator end, OutputIterator output, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Writes the result of combining each item from \a begin to \a end with
+    all items before it using \a binaryOp to the range starting at
+    \a output, with threads taken from \a pool. \a binaryOp must be
+    associative. \a output must be a random-access iterator, and may be
+    equal to \a begin.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename InputIterator, typename OutputIterator, typename BinaryOp> QFuture<void> QtConcurrent::inclusiveScan(InputIterator begin, InputIterator end, OutputIterator output, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Writes the result of combining each item from \a begin to \a end with
+    all items before it using \a binaryOp to the range starting at
+    \a output. \a binaryOp must be associative. \a output must be a
+    random-access iterator, and may be equal to \a begin.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<typename Sequence::iterator> QtConcurrent::partition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items of \a sequence for which \a predicate returns \c true in
+    front of the other ones, with threads taken from \a pool. The result of
+    the returned future is an iterator to the first item for which
+    \a predicate returns \c false.
+
+    \sa blockingPartition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<typename Sequence::iterator> QtConcurrent::partition(Sequence &sequence, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items of \a sequence for which \a predicate returns \c true in
+    front of the other ones. The result of the returned future is an
+    iterator to the first item for which \a predicate returns \c false.
+
+    \sa blockingPartition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<Iterator> QtConcurrent::partition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items from \a begin to \a end for which \a predicate returns
+    \c true in front of the other ones, with threads taken from \a pool. The
+    result of the returned future is an iterator to the first item for
+    which \a predicate returns \c false.
+
+    \sa blockingPartition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<Iterator> QtConcurrent::partition(Iterator begin, Iterator end, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items from \a begin to \a end for which \a predicate returns
+    \c true in front of the other ones. The result of the returned future is
+    an iterator to the first item for which \a predicate returns \c false.
+
+    \sa blockingPartition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> void QtConcurrent::blockingSort(QThreadPool *pool, Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare, with threads taken from
+    \a pool. The order of equivalent items is not preserved.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> void QtConcurrent::blockingSort(Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare. The order of equivalent
+    items is not preserved.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> void QtConcurrent::blockingSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare, with threads
+    taken from \a pool. The order of equivalent items is not preserved.
+
+    \note This function will block until the range is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> void QtConcurrent::blockingSort(Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare. The order of
+    equivalent items is not preserved.
+
+    \note This function will block until the range is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> void QtConcurrent::blockingStableSort(QThreadPool *pool, Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare, with threads taken from
+    \a pool. The order of equivalent items is preserved.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Compare> void QtConcurrent::blockingStableSort(Sequence &sequence, Compare &&compare)
+    \since 6.9
+
+    Sorts the items of \a sequence using \a compare. The order of equivalent
+    items is preserved.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> void QtConcurrent::blockingStableSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare, with threads
+    taken from \a pool. The order of equivalent items is preserved.
+
+    \note This function will block until the range is sorted.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Compare> void QtConcurrent::blockingStableSort(Iterator begin, Iterator end, Compare &&compare)
+    \since 6.9
+
+    Sorts the items from \a begin to \a end using \a compare. The order of
+    equivalent items is preserved.
+
+    \note This function will block until the range is sorted.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOp> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it using \a binaryOp, with threads taken from \a pool.
+    \a binaryOp must be associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOp> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it using \a binaryOp. \a binaryOp must be associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename InputIterator, typename OutputIterator, typename BinaryOp> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, InputIterator begin, InputIterator end, OutputIterator output, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Writes the result of combining each item from \a begin to \a end with
+    all items before it using \a binaryOp to the range starting at
+    \a output, with threads taken from \a pool. \a binaryOp must be
+    associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename InputIterator, typename OutputIterator, typename BinaryOp> void QtConcurrent::blockingInclusiveScan(InputIterator begin, InputIterator end, OutputIterator output, BinaryOp &&binaryOp)
+    \since 6.9
+
+    Writes the result of combining each item from \a begin to \a end with
+    all items before it using \a binaryOp to the range starting at
+    \a output. \a binaryOp must be associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> typename Sequence::iterator QtConcurrent::blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items of \a sequence for which \a predicate returns \c true in
+    front of the other ones, with threads taken from \a pool, and returns an
+    iterator to the first item for which \a predicate returns \c false.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> typename Sequence::iterator QtConcurrent::blockingPartition(Sequence &sequence, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items of \a sequence for which \a predicate returns \c true in
+    front of the other ones, and returns an iterator to the first item for
+    which \a predicate returns \c false.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> Iterator QtConcurrent::blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items from \a begin to \a end for which \a predicate returns
+    \c true in front of the other ones, with threads taken from \a pool, and
+    returns an iterator to the first item for which \a predicate returns
+    \c false.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> Iterator QtConcurrent::blockingPartition(Iterator begin, Iterator end, Predicate &&predicate)
+    \since 6.9
+
+    Moves the items from \a begin to \a end for which \a predicate returns
+    \c true in front of the other ones, and returns an iterator to the first
+    item for which \a predicate returns \c false.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
@@ -0,0 +1,328 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#if 0
+#pragma qt_class(QtConcurrentAlgorithms)
+#endif
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmskernel.h>
+#include <QtConcurrent/qtconcurrentcompilertest.h>
+#include <QtConcurrent/qtconcurrentfunctionwrappers.h>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, Compare &&compare = Compare())
+{
+    return startSort<false>(pool, sequence.begin(), sequence.end(),
+                            std::forward<Compare>(compare));
+}
+
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> sort(Sequence &sequence, Compare &&compare = Compare())
+{
+    return startSort<false>(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                            std::forward<Compare>(compare));
+}
+
+// sort() on iterators
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<void> sort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    return startSort<false>(pool, begin, end, std::forward<Compare>(compare));
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<void> sort(Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    return startSort<false>(QThreadPool::globalInstance(), begin, end,
+                            std::forward<Compare>(compare));
+}
+
+// stableSort() on sequences
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> stableSort(QThreadPool *pool, Sequence &sequence, Compare &&compare = Compare())
+{
+    return startSort<true>(pool, sequence.begin(), sequence.end(),
+                           std::forward<Compare>(compare));
+}
+
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> stableSort(Sequence &sequence, Compare &&compare = Compare())
+{
+    return startSort<true>(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                           std::forward<Compare>(compare));
+}
+
+// stableSort() on iterators
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<void> stableSort(QThreadPool *pool, Iterator begin, Iterator end,
+                         Compare &&compare = Compare())
+{
+    return startSort<true>(pool, begin, end, std::forward<Compare>(compare));
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<void> stableSort(Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    return startSort<true>(QThreadPool::globalInstance(), begin, end,
+                           std::forward<Compare>(compare));
+}
+
+// inclusiveScan() on sequences, in place
+template <typename Sequence, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOp &&binaryOp = BinaryOp())
+{
+    return startInclusiveScan(pool, sequence.begin(), sequence.end(), sequence.begin(),
+                              std::forward<BinaryOp>(binaryOp));
+}
+
+template <typename Sequence, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOp &&binaryOp = BinaryOp())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                              sequence.begin(), std::forward<BinaryOp>(binaryOp));
+}
+
+// inclusiveScan() on iterators
+template <typename InputIterator, typename OutputIterator, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::isIterator_v<InputIterator>, int> = 0>
+QFuture<void> inclusiveScan(QThreadPool *pool, InputIterator begin, InputIterator end,
+                            OutputIterator output, BinaryOp &&binaryOp = BinaryOp())
+{
+    return startInclusiveScan(pool, begin, end, output, std::forward<BinaryOp>(binaryOp));
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::isIterator_v<InputIterator>, int> = 0>
+QFuture<void> inclusiveScan(InputIterator begin, InputIterator end, OutputIterator output,
+                            BinaryOp &&binaryOp = BinaryOp())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), begin, end, output,
+                              std::forward<BinaryOp>(binaryOp));
+}
+
+// partition() on sequences
+template <typename Sequence, typename Predicate,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<typename Sequence::iterator> partition(QThreadPool *pool, Sequence &sequence,
+                                               Predicate &&predicate)
+{
+    return startPartition(pool, sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+template <typename Sequence, typename Predicate,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<typename Sequence::iterator> partition(Sequence &sequence, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+// partition() on iterators
+template <typename Iterator, typename Predicate,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<Iterator> partition(QThreadPool *pool, Iterator begin, Iterator end,
+                            Predicate &&predicate)
+{
+    return startPartition(pool, begin, end, std::forward<Predicate>(predicate));
+}
+
+template <typename Iterator, typename Predicate,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+QFuture<Iterator> partition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), begin, end,
+                          std::forward<Predicate>(predicate));
+}
+
+// blockingSort() on sequences
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingSort(QThreadPool *pool, Sequence &sequence, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<false>(pool, sequence.begin(), sequence.end(),
+                                            std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingSort(Sequence &sequence, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<false>(QThreadPool::globalInstance(), sequence.begin(),
+                                            sequence.end(), std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+// blockingSort() on iterators
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+void blockingSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<false>(pool, begin, end, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+void blockingSort(Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<false>(QThreadPool::globalInstance(), begin, end,
+                                            std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+// blockingStableSort() on sequences
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingStableSort(QThreadPool *pool, Sequence &sequence, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<true>(pool, sequence.begin(), sequence.end(),
+                                           std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingStableSort(Sequence &sequence, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<true>(QThreadPool::globalInstance(), sequence.begin(),
+                                           sequence.end(), std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+// blockingStableSort() on iterators
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+void blockingStableSort(QThreadPool *pool, Iterator begin, Iterator end,
+                        Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<true>(pool, begin, end, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+void blockingStableSort(Iterator begin, Iterator end, Compare &&compare = Compare())
+{
+    QFuture<void> future = startSort<true>(QThreadPool::globalInstance(), begin, end,
+                                           std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() on sequences, in place
+template <typename Sequence, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOp &&binaryOp = BinaryOp())
+{
+    QFuture<void> future = startInclusiveScan(pool, sequence.begin(), sequence.end(),
+                                              sequence.begin(), std::forward<BinaryOp>(binaryOp));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingInclusiveScan(Sequence &sequence, BinaryOp &&binaryOp = BinaryOp())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(),
+                                              sequence.end(), sequence.begin(),
+                                              std::forward<BinaryOp>(binaryOp));
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() on iterators
+template <typename InputIterator, typename OutputIterator, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::isIterator_v<InputIterator>, int> = 0>
+void blockingInclusiveScan(QThreadPool *pool, InputIterator begin, InputIterator end,
+                           OutputIterator output, BinaryOp &&binaryOp = BinaryOp())
+{
+    QFuture<void> future = startInclusiveScan(pool, begin, end, output,
+                                              std::forward<BinaryOp>(binaryOp));
+    future.waitForFinished();
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOp = std::plus<>,
+          std::enable_if_t<QtPrivate::isIterator_v<InputIterator>, int> = 0>
+void blockingInclusiveScan(InputIterator begin, InputIterator end, OutputIterator output,
+                           BinaryOp &&binaryOp = BinaryOp())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), begin, end, output,
+                                              std::forward<BinaryOp>(binaryOp));
+    future.waitForFinished();
+}
+
+// blockingPartition() on sequences
+template <typename Sequence, typename Predicate,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+typename Sequence::iterator blockingPartition(QThreadPool *pool, Sequence &sequence,
+                                              Predicate &&predicate)
+{
+    QFuture<typename Sequence::iterator> future =
+            startPartition(pool, sequence.begin(), sequence.end(),
+                           std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Sequence, typename Predicate,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+typename Sequence::iterator blockingPartition(Sequence &sequence, Predicate &&predicate)
+{
+    QFuture<typename Sequence::iterator> future =
+            startPartition(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                           std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+// blockingPartition() on iterators
+template <typename Iterator, typename Predicate,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+Iterator blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+{
+    QFuture<Iterator> future = startPartition(pool, begin, end,
+                                              std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Iterator, typename Predicate,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0>
+Iterator blockingPartition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    QFuture<Iterator> future = startPartition(QThreadPool::globalInstance(), begin, end,
+                                              std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
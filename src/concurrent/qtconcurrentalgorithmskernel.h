@@ -0,0 +1,525 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHMSKERNEL_H
+#define QTCONCURRENT_ALGORITHMSKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtConcurrent/qtconcurrentthreadengine.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+/*
+    The StagedKernel class runs a computation made of consecutive stages,
+    each consisting of a number of independent tasks. Worker threads claim
+    tasks in order from a shared counter, like the for-iteration of
+    IterateKernel does with its iterations, but a task only starts once all
+    tasks of the previous stages are done. Since tasks are claimed in order,
+    every task a thread waits for is already being run by another thread.
+*/
+template <typename T>
+class StagedKernel : public ThreadEngine<T>
+{
+public:
+    typedef T ResultType;
+
+    explicit StagedKernel(QThreadPool *pool) : ThreadEngine<T>(pool) { }
+
+protected:
+    // Called from the constructor of the subclass.
+    void addStage(int taskCount)
+    {
+        totalTaskCount += taskCount;
+        stageEnds.append(totalTaskCount);
+    }
+
+    virtual void runTask(int stage, int task) = 0;
+
+    // Splits a range of size elements into chunks of at least minimumChunkSize
+    // elements, using a few chunks per thread to even out the load.
+    int chunkCount(qsizetype size, qsizetype minimumChunkSize) const
+    {
+        const qsizetype maximumChunks = qMax(qsizetype(1), size / minimumChunkSize);
+        const qsizetype threadCount = qMax(1, ThreadEngineBase::threadPool->maxThreadCount());
+        return int(qMin(threadCount * 4, maximumChunks));
+    }
+
+    void start() override
+    {
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        if (progressReportingEnabled && totalTaskCount > 0)
+            this->setProgressRange(0, totalTaskCount);
+    }
+
+    bool shouldStartThread() override
+    {
+        return nextTask.loadRelaxed() < totalTaskCount && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            const int task = nextTask.fetchAndAddRelaxed(1);
+            if (task >= totalTaskCount)
+                break;
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            const int stage = stageOf(task);
+            const int stageBegin = stage > 0 ? stageEnds.at(stage - 1) : 0;
+            waitForTasks(stageBegin);
+
+            {
+                // other threads may wait for this task, even if it throws
+                TaskFinisher finisher{ this };
+                if (!this->isCanceled())
+                    runTask(stage, task - stageBegin);
+            }
+
+            if (progressReportingEnabled)
+                this->setProgressValue(finishedTasks.loadRelaxed());
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+private:
+    struct TaskFinisher
+    {
+        StagedKernel *kernel;
+        ~TaskFinisher() { kernel->finishTask(); }
+    };
+
+    int stageOf(int task) const
+    {
+        return int(std::upper_bound(stageEnds.cbegin(), stageEnds.cend(), task)
+                   - stageEnds.cbegin());
+    }
+
+    void waitForTasks(int count)
+    {
+        if (finishedTasks.loadAcquire() >= count)
+            return;
+        QMutexLocker locker(&stageMutex);
+        while (finishedTasks.loadAcquire() < count)
+            stageFinished.wait(&stageMutex);
+    }
+
+    void finishTask()
+    {
+        const int finished = finishedTasks.fetchAndAddOrdered(1) + 1;
+        if (std::binary_search(stageEnds.cbegin(), stageEnds.cend(), finished)) {
+            QMutexLocker locker(&stageMutex);
+            stageFinished.wakeAll();
+        }
+    }
+
+    QVarLengthArray<int, 16> stageEnds;
+    int totalTaskCount = 0;
+    QAtomicInt nextTask;
+    QAtomicInt finishedTasks;
+    QMutex stageMutex;
+    QWaitCondition stageFinished;
+    bool progressReportingEnabled = true;
+};
+
+/*
+    Sorts each chunk, then merges pairs of sorted runs until one run is left.
+    When the elements are default-constructible every merge goes through a
+    buffer and is split into as many tasks as there are chunks, so that all
+    threads take part in the last merges too. Otherwise the runs are merged
+    in place, one task per merge.
+*/
+template <typename Iterator, typename Compare, bool Stable>
+class SortKernel : public StagedKernel<void>
+{
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+    static constexpr bool UseBuffer = std::is_default_constructible_v<ValueType>;
+    static constexpr qsizetype MinimumChunkSize = 4096;
+
+public:
+    template <typename C = Compare>
+    SortKernel(QThreadPool *pool, Iterator _begin, Iterator _end, C &&_compare)
+        : StagedKernel<void>(pool),
+          begin(_begin),
+          size(std::distance(_begin, _end)),
+          compare(std::forward<C>(_compare))
+    {
+        // merging pairs of runs needs a power of two
+        const quint32 count = quint32(chunkCount(size, MinimumChunkSize));
+        rounds = 31 - qCountLeadingZeroBits(count);
+        chunks = 1 << rounds;
+
+        addStage(chunks);
+        for (int round = 0; round < rounds; ++round)
+            addStage(UseBuffer ? chunks : chunks >> (round + 1));
+        if (UseBuffer && rounds % 2)
+            addStage(chunks);
+    }
+
+    void start() override
+    {
+        if constexpr (UseBuffer) {
+            if (rounds > 0)
+                buffer.reset(new ValueType[size]);
+        }
+        StagedKernel<void>::start();
+    }
+
+    void finish() override
+    {
+        buffer.reset();
+    }
+
+    void runTask(int stage, int task) override
+    {
+        if (stage == 0) {
+            const Iterator first = begin + boundary(task);
+            const Iterator last = begin + boundary(task + 1);
+            if constexpr (Stable)
+                std::stable_sort(first, last, std::ref(compare));
+            else
+                std::sort(first, last, std::ref(compare));
+        } else if (stage <= rounds) {
+            const int round = stage - 1;
+            if constexpr (UseBuffer) {
+                if (round % 2 == 0)
+                    mergePart(begin, buffer.get(), round, task);
+                else
+                    mergePart(buffer.get(), begin, round, task);
+            } else {
+                const int first = task << (round + 1);
+                const int middle = first + (1 << round);
+                const int last = first + (2 << round);
+                std::inplace_merge(begin + boundary(first), begin + boundary(middle),
+                                   begin + boundary(last), std::ref(compare));
+            }
+        } else {
+            // an odd number of merge rounds left the result in the buffer
+            std::move(buffer.get() + boundary(task), buffer.get() + boundary(task + 1),
+                      begin + boundary(task));
+        }
+    }
+
+private:
+    qsizetype boundary(int chunk) const
+    {
+        return size * chunk / chunks;
+    }
+
+    // Writes the part of the merge of two runs that belongs to task.
+    template <typename Source, typename Destination>
+    void mergePart(Source source, Destination destination, int round, int task)
+    {
+        const int parts = 2 << round;
+        const int part = task % parts;
+        const int first = task - part;
+        const qsizetype low = boundary(first);
+        const qsizetype middle = boundary(first + parts / 2);
+        const qsizetype high = boundary(first + parts);
+
+        const qsizetype from = (high - low) * part / parts;
+        const qsizetype to = (high - low) * (part + 1) / parts;
+        const Source left = source + low;
+        const Source right = source + middle;
+        const qsizetype leftFrom = splitPoint(left, middle - low, right, high - middle, from);
+        const qsizetype leftTo = splitPoint(left, middle - low, right, high - middle, to);
+
+        std::merge(std::make_move_iterator(left + leftFrom),
+                   std::make_move_iterator(left + leftTo),
+                   std::make_move_iterator(right + (from - leftFrom)),
+                   std::make_move_iterator(right + (to - leftTo)),
+                   destination + low + from, std::ref(compare));
+    }
+
+    // Returns how many of the first count merged elements come from left,
+    // consistent with the stable order std::merge produces.
+    template <typename Source>
+    qsizetype splitPoint(Source left, qsizetype leftSize, Source right, qsizetype rightSize,
+                         qsizetype count)
+    {
+        qsizetype low = qMax(qsizetype(0), count - rightSize);
+        qsizetype high = qMin(count, leftSize);
+        while (low < high) {
+            const qsizetype i = low + (high - low) / 2;
+            if (std::invoke(compare, right[count - i - 1], left[i]))
+                high = i;
+            else
+                low = i + 1;
+        }
+        return low;
+    }
+
+    const Iterator begin;
+    const qsizetype size;
+    Compare compare;
+    int rounds;
+    int chunks;
+    std::unique_ptr<ValueType[]> buffer;
+};
+
+/*
+    Scans each chunk, then scans the chunk totals, then adds the total of
+    the preceding chunks to every element of each chunk but the first.
+    This requires binaryOp to be associative.
+*/
+template <typename InputIterator, typename OutputIterator, typename BinaryOp>
+class InclusiveScanKernel : public StagedKernel<void>
+{
+    using ValueType = typename std::iterator_traits<InputIterator>::value_type;
+    static constexpr qsizetype MinimumChunkSize = 4096;
+
+public:
+    template <typename Op = BinaryOp>
+    InclusiveScanKernel(QThreadPool *pool, InputIterator _begin, InputIterator _end,
+                        OutputIterator _output, Op &&_binaryOp)
+        : StagedKernel<void>(pool),
+          begin(_begin),
+          output(_output),
+          size(std::distance(_begin, _end)),
+          binaryOp(std::forward<Op>(_binaryOp))
+    {
+        chunks = chunkCount(size, MinimumChunkSize);
+        totals.resize(chunks);
+
+        addStage(chunks);
+        addStage(chunks > 1 ? 1 : 0);
+        addStage(chunks - 1);
+    }
+
+    void runTask(int stage, int task) override
+    {
+        if (stage == 0) {
+            const InputIterator first = begin + boundary(task);
+            const InputIterator last = begin + boundary(task + 1);
+            if (first == last)
+                return;
+            const OutputIterator end = std::inclusive_scan(first, last, output + boundary(task),
+                                                           std::ref(binaryOp));
+            totals[task] = *(end - 1);
+        } else if (stage == 1) {
+            for (int i = 1; i < chunks; ++i)
+                totals[i] = std::invoke(binaryOp, *totals[i - 1], *totals[i]);
+        } else {
+            const int chunk = task + 1;
+            const ValueType &carry = *totals[chunk - 1];
+            const OutputIterator last = output + boundary(chunk + 1);
+            for (OutputIterator it = output + boundary(chunk); it != last; ++it)
+                *it = std::invoke(binaryOp, carry, *it);
+        }
+    }
+
+private:
+    qsizetype boundary(int chunk) const
+    {
+        return size * chunk / chunks;
+    }
+
+    const InputIterator begin;
+    const OutputIterator output;
+    const qsizetype size;
+    BinaryOp binaryOp;
+    int chunks;
+    std::vector<std::optional<ValueType>> totals;
+};
+
+/*
+    Partitions each chunk in place, then computes where the matching
+    elements end up in total, then swaps the non-matching elements that are
+    in front of that point with the matching ones that are behind it.
+*/
+template <typename Iterator, typename Predicate>
+class PartitionKernel : public StagedKernel<Iterator>
+{
+    static constexpr qsizetype MinimumChunkSize = 4096;
+
+    // A run of misplaced elements, with the number of misplaced elements
+    // in the runs before it.
+    struct Run
+    {
+        qsizetype position;
+        qsizetype offset;
+    };
+    using Runs = std::vector<Run>;
+
+public:
+    template <typename P = Predicate>
+    PartitionKernel(QThreadPool *pool, Iterator _begin, Iterator _end, P &&_predicate)
+        : StagedKernel<Iterator>(pool),
+          begin(_begin),
+          size(std::distance(_begin, _end)),
+          predicate(std::forward<P>(_predicate)),
+          partitionPoint(_begin)
+    {
+        chunks = this->chunkCount(size, MinimumChunkSize);
+        matchCounts.resize(chunks);
+
+        this->addStage(chunks);
+        this->addStage(1);
+        this->addStage(chunks > 1 ? chunks : 0);
+    }
+
+    Iterator *result() override { return &partitionPoint; }
+
+    void runTask(int stage, int task) override
+    {
+        if (stage == 0) {
+            const Iterator first = begin + boundary(task);
+            const Iterator last = begin + boundary(task + 1);
+            matchCounts[task] = std::partition(first, last, std::ref(predicate)) - first;
+        } else if (stage == 1) {
+            findMisplacedRuns();
+        } else {
+            const qsizetype misplaced = misplacedFalse.back().offset;
+            swapMisplaced(misplaced * task / chunks, misplaced * (task + 1) / chunks);
+        }
+    }
+
+private:
+    qsizetype boundary(int chunk) const
+    {
+        return size * chunk / chunks;
+    }
+
+    void findMisplacedRuns()
+    {
+        const qsizetype matches = std::accumulate(matchCounts.cbegin(), matchCounts.cend(),
+                                                  qsizetype(0));
+        partitionPoint = begin + matches;
+        if (chunks == 1)
+            return;
+
+        // the last run is a sentinel holding the total
+        const auto addRun = [](Runs &runs, qsizetype from, qsizetype to) {
+            if (from >= to)
+                return;
+            const qsizetype offset = runs.back().offset;
+            runs.back().position = from;
+            runs.push_back(Run{ 0, offset + to - from });
+        };
+        misplacedFalse.push_back(Run{ 0, 0 });
+        misplacedTrue.push_back(Run{ 0, 0 });
+        for (int i = 0; i < chunks; ++i) {
+            const qsizetype chunkBegin = boundary(i);
+            const qsizetype chunkMiddle = chunkBegin + matchCounts[i];
+            const qsizetype chunkEnd = boundary(i + 1);
+            addRun(misplacedTrue, qMax(chunkBegin, matches), chunkMiddle);
+            addRun(misplacedFalse, chunkMiddle, qMin(chunkEnd, matches));
+        }
+        Q_ASSERT(misplacedTrue.back().offset == misplacedFalse.back().offset);
+    }
+
+    static typename Runs::const_iterator runAt(const Runs &runs, qsizetype offset)
+    {
+        return std::upper_bound(runs.cbegin(), runs.cend() - 1, offset,
+                                [](qsizetype offset, const Run &run) {
+                                    return offset < run.offset;
+                                }) - 1;
+    }
+
+    void swapMisplaced(qsizetype from, qsizetype to)
+    {
+        if (from >= to)
+            return;
+        auto falseRun = runAt(misplacedFalse, from);
+        auto trueRun = runAt(misplacedTrue, from);
+        for (qsizetype i = from; i < to;) {
+            const qsizetype count = qMin(to, qMin((falseRun + 1)->offset, (trueRun + 1)->offset))
+                                    - i;
+            std::swap_ranges(begin + falseRun->position + (i - falseRun->offset),
+                             begin + falseRun->position + (i - falseRun->offset) + count,
+                             begin + trueRun->position + (i - trueRun->offset));
+            i += count;
+            if (i == (falseRun + 1)->offset)
+                ++falseRun;
+            if (i == (trueRun + 1)->offset)
+                ++trueRun;
+        }
+    }
+
+    const Iterator begin;
+    const qsizetype size;
+    Predicate predicate;
+    Iterator partitionPoint;
+    int chunks;
+    std::vector<qsizetype> matchCounts;
+    Runs misplacedFalse;
+    Runs misplacedTrue;
+};
+
+template <typename Iterator>
+inline constexpr bool isRandomAccessIterator_v = std::is_base_of_v<
+        std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>;
+
+//! [qtconcurrentalgorithmskernel-1]
+template <bool Stable, typename Iterator, typename Compare>
+inline ThreadEngineStarter<void> startSort(QThreadPool *pool, Iterator begin, Iterator end,
+                                           Compare &&compare)
+{
+    static_assert(isRandomAccessIterator_v<Iterator>,
+                  "QtConcurrent sorting requires random-access iterators");
+    return startThreadEngine(new SortKernel<Iterator, std::decay_t<Compare>, Stable>(
+            pool, begin, end, std::forward<Compare>(compare)));
+}
+
+//! [qtconcurrentalgorithmskernel-2]
+template <typename InputIterator, typename OutputIterator, typename BinaryOp>
+inline ThreadEngineStarter<void> startInclusiveScan(QThreadPool *pool, InputIterator begin,
+                                                    InputIterator end, OutputIterator output,
+                                                    BinaryOp &&binaryOp)
+{
+    static_assert(isRandomAccessIterator_v<InputIterator>
+                          && isRandomAccessIterator_v<OutputIterator>,
+                  "QtConcurrent::inclusiveScan requires random-access iterators");
+    return startThreadEngine(
+            new InclusiveScanKernel<InputIterator, OutputIterator, std::decay_t<BinaryOp>>(
+                    pool, begin, end, output, std::forward<BinaryOp>(binaryOp)));
+}
+
+//! [qtconcurrentalgorithmskernel-3]
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<Iterator> startPartition(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, Predicate &&predicate)
+{
+    static_assert(isRandomAccessIterator_v<Iterator>,
+                  "QtConcurrent::partition requires random-access iterators");
+    return startThreadEngine(new PartitionKernel<Iterator, std::decay_t<Predicate>>(
+            pool, begin, end, std::forward<Predicate>(predicate)));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
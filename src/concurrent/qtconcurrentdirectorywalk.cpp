@@ -0,0 +1,449 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtconcurrentdirectorywalk.h"
+
+#include <QtCore/qexception.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <QtCore/private/qduplicatetracker_p.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+    \page qtconcurrentdirectorywalk.html
+    \title Concurrent Directory Walk
+    \brief Listing a directory tree with several threads.
+    \ingroup thread
+    \since 6.9
+
+    QtConcurrent::walkDirectory() lists the entries of a directory, and with
+    QDirListing::IteratorFlag::Recursive those of all its subdirectories, like
+    QDirListing does. Instead of walking the tree depth-first on a single
+    thread, every subdirectory that is found is handed to a new task in a
+    QThreadPool, the global one unless another pool is given. This keeps
+    several directory reads in flight, which pays off on storage that serves
+    requests in parallel, such as NVMe drives and network file systems.
+
+    These functions are part of the \l {Qt Concurrent} framework.
+
+    The flags and name filters have the same meaning as for QDirListing.
+    Symbolic link loops are detected across all threads when
+    QDirListing::IteratorFlag::FollowDirSymlinks is set.
+
+    \section1 Receiving File Paths
+
+    The overloads that don't take a function report the file path of each
+    entry as a result of the returned QFuture, which can be consumed while the
+    walk is still in progress, for instance with QFutureWatcher or by
+    iterating over the future:
+
+    \code
+    QFuture<QString> paths = QtConcurrent::walkDirectory(root);
+    for (const QString &path : paths)
+        index(path);
+    \endcode
+
+    By default, the entries are reported in no particular order: each
+    directory's entries are reported together, as soon as that directory has
+    been read. With QtConcurrent::DirectoryWalkOrder::DepthFirst, the order is
+    deterministic: each entry is followed by the entries of the directory it
+    names, if any. Results are then held back until all entries that come
+    before them are known.
+
+    \section1 Calling a Function for Each Entry
+
+    The overloads that take a function call it for each entry with a
+    QDirListing::DirEntry, from the thread that read the entry's directory.
+    The function is called from several threads at the same time and must
+    therefore be thread-safe. The DirEntry is only valid during the call.
+
+    \code
+    QAtomicInteger<qint64> totalSize;
+    QtConcurrent::blockingWalkDirectory(root, QDirListing::IteratorFlag::Recursive
+                                                  | QDirListing::IteratorFlag::FilesOnly,
+                                        [&](const QDirListing::DirEntry &entry) {
+        totalSize += entry.size();
+    });
+    \endcode
+
+    An exception thrown by the function is reported by the returned QFuture,
+    and stops the walk.
+
+    \section1 Canceling
+
+    Canceling the returned QFuture stops the walk: directories that haven't
+    been read yet are skipped, and the ones being read are abandoned after
+    the current entry.
+
+    \sa {Concurrent Map and Map-Reduce}, QDirListing
+*/
+
+/*!
+    \enum QtConcurrent::DirectoryWalkOrder
+    \since 6.9
+
+    This enum describes the order in which QtConcurrent::walkDirectory()
+    reports file paths.
+
+    \value Unordered
+        The entries of each directory are reported as soon as the directory
+        has been read, in the order in which the file system lists them.
+        Directories are read in no particular order.
+    \value DepthFirst
+        Each entry is reported before the entries of the directory it names,
+        and after the entries of all directories named by the entries before
+        it. Subdirectories that are walked but not reported themselves,
+        because of the flags or name filters, come after the other entries of
+        their parent directory. This is the order of a recursive QDirListing,
+        as long as no directory is filtered out.
+
+    \sa {Concurrent Directory Walk}
+*/
+
+/*!
+    \fn QFuture<QString> QtConcurrent::walkDirectory(QThreadPool *pool, const QString &path, QDirListing::IteratorFlags flags, QtConcurrent::DirectoryWalkOrder order)
+    \since 6.9
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    \a pool, and reports the file path of each entry in the given \a order.
+
+    \sa {Concurrent Directory Walk}
+*/
+
+/*!
+    \fn QFuture<QString> QtConcurrent::walkDirectory(QThreadPool *pool, const QString &path, const QStringList &nameFilters, QDirListing::IteratorFlags flags, QtConcurrent::DirectoryWalkOrder order)
+    \since 6.9
+    \overload
+
+    Only entries whose names match one of \a nameFilters are reported;
+    subdirectories are walked regardless.
+*/
+
+/*!
+    \fn QFuture<QString> QtConcurrent::walkDirectory(const QString &path, QDirListing::IteratorFlags flags, QtConcurrent::DirectoryWalkOrder order)
+    \since 6.9
+    \overload
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    the global QThreadPool, and reports the file path of each entry in the
+    given \a order.
+*/
+
+/*!
+    \fn QFuture<QString> QtConcurrent::walkDirectory(const QString &path, const QStringList &nameFilters, QDirListing::IteratorFlags flags, QtConcurrent::DirectoryWalkOrder order)
+    \since 6.9
+    \overload
+
+    Only entries whose names match one of \a nameFilters are reported;
+    subdirectories are walked regardless.
+*/
+
+/*!
+    \fn template <typename Function> QFuture<void> QtConcurrent::walkDirectory(QThreadPool *pool, const QString &path, QDirListing::IteratorFlags flags, Function &&function)
+    \since 6.9
+    \overload
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    \a pool, and calls \a function for each entry. \a function must be callable
+    with a \c{const QDirListing::DirEntry &}.
+
+    \sa blockingWalkDirectory(), {Concurrent Directory Walk}
+*/
+
+/*!
+    \fn template <typename Function> QFuture<void> QtConcurrent::walkDirectory(const QString &path, QDirListing::IteratorFlags flags, Function &&function)
+    \since 6.9
+    \overload
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    the global QThreadPool, and calls \a function for each entry.
+*/
+
+/*!
+    \fn template <typename Function> void QtConcurrent::blockingWalkDirectory(QThreadPool *pool, const QString &path, QDirListing::IteratorFlags flags, Function &&function)
+    \since 6.9
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    \a pool, and calls \a function for each entry. Returns once the whole tree
+    has been walked.
+
+    \sa walkDirectory(), {Concurrent Directory Walk}
+*/
+
+/*!
+    \fn template <typename Function> void QtConcurrent::blockingWalkDirectory(const QString &path, QDirListing::IteratorFlags flags, Function &&function)
+    \since 6.9
+    \overload
+
+    Lists the directory \a path according to \a flags, with threads taken from
+    the global QThreadPool, and calls \a function for each entry. Returns once
+    the whole tree has been walked.
+*/
+
+namespace QtConcurrent {
+
+namespace {
+
+using F = QDirListing::IteratorFlag;
+
+// DepthFirst keeps the tree of directories that have been found, so that
+// results can be released in order as soon as everything before them is known.
+struct DirectoryNode;
+struct DirectoryItem
+{
+    QString filePath; // null for directories that are walked but not reported
+    std::unique_ptr<DirectoryNode> child;
+};
+struct DirectoryNode
+{
+    std::vector<DirectoryItem> items;
+    bool done = false;
+};
+
+class DirectoryWalk : public std::enable_shared_from_this<DirectoryWalk>
+{
+public:
+    DirectoryWalk(QThreadPool *pool, const QStringList &nameFilters,
+                  QDirListing::IteratorFlags flags, DirectoryWalkOrder order,
+                  DirectoryWalkFunction function)
+        : pool(pool), nameFilters(nameFilters), flags(flags), order(order),
+          function(std::move(function))
+    {}
+
+    QFuture<QString> start(const QString &path);
+
+private:
+    std::unique_ptr<DirectoryNode> schedule(const QString &path);
+    bool enter(const QString &canonicalPath);
+    bool shouldRecurse(const QDirListing::DirEntry &entry) const;
+    bool needsSeparateRecursionPass() const;
+    void walk(const QString &path, DirectoryNode *node);
+    void readDirectory(const QString &path, QList<QString> &results,
+                       std::vector<DirectoryItem> &items);
+    void flushInOrder();
+
+    QFutureInterface<QString> futureInterface;
+    QThreadPool *pool;
+    const QStringList nameFilters;
+    const QDirListing::IteratorFlags flags;
+    const DirectoryWalkOrder order;
+    const DirectoryWalkFunction function;
+    QAtomicInt pending; // directories scheduled but not read yet
+
+    QMutex mutex;
+    QDuplicateTracker<QString> visitedLinks;
+    std::unique_ptr<DirectoryNode> root;
+    std::vector<std::pair<DirectoryNode *, size_t>> cursor;
+};
+
+QFuture<QString> DirectoryWalk::start(const QString &path)
+{
+    QFuture<QString> future = futureInterface.future();
+    futureInterface.reportStarted();
+    if (!pool) {
+        futureInterface.reportCanceled();
+        futureInterface.reportFinished();
+        return future;
+    }
+
+    if (flags.testAnyFlags(F::FollowDirSymlinks))
+        (void)enter(QFileInfo(path).canonicalFilePath());
+    // the root directory must not be flushed before the cursor points to it
+    QMutexLocker locker(&mutex);
+    root = schedule(path);
+    if (root)
+        cursor.emplace_back(root.get(), 0);
+    return future;
+}
+
+std::unique_ptr<DirectoryNode> DirectoryWalk::schedule(const QString &path)
+{
+    std::unique_ptr<DirectoryNode> node;
+    if (order == DirectoryWalkOrder::DepthFirst)
+        node = std::make_unique<DirectoryNode>();
+    pending.ref();
+    pool->start([self = shared_from_this(), path, node = node.get()] {
+        self->walk(path, node);
+    });
+    return node;
+}
+
+// Stops symlink loops; returns false if the directory has been walked already
+bool DirectoryWalk::enter(const QString &canonicalPath)
+{
+    QMutexLocker locker(&mutex);
+    return !visitedLinks.hasSeen(canonicalPath);
+}
+
+// Must match QDirListingPrivate::checkAndPushDirectory()
+bool DirectoryWalk::shouldRecurse(const QDirListing::DirEntry &entry) const
+{
+    if (!flags.testAnyFlags(F::FollowDirSymlinks) && entry.isSymLink())
+        return false;
+    const QString fileName = entry.fileName();
+    if (fileName == "."_L1 || fileName == ".."_L1)
+        return false;
+    if (!flags.testAnyFlags(F::IncludeHidden) && entry.isHidden())
+        return false;
+    return entry.isDir();
+}
+
+// Whether the filters can hide subdirectories that must be walked anyway, in
+// which case they are looked for in a second, unfiltered listing.
+bool DirectoryWalk::needsSeparateRecursionPass() const
+{
+    if (!nameFilters.isEmpty() || flags.testAnyFlags(F::ExcludeDirs))
+        return true;
+    // symbolic links to directories are filtered out by FilesOnly and DirsOnly
+    return flags.testAnyFlags(F::FollowDirSymlinks)
+            && flags.testAnyFlags(F::ExcludeFiles | F::ExcludeSpecial);
+}
+
+void DirectoryWalk::readDirectory(const QString &path, QList<QString> &results,
+                                  std::vector<DirectoryItem> &items)
+{
+    const bool recursive = flags.testAnyFlags(F::Recursive);
+    const bool separatePass = recursive && needsSeparateRecursionPass();
+    const bool inOrder = order == DirectoryWalkOrder::DepthFirst;
+
+    const auto recurseInto = [&](const QDirListing::DirEntry &entry) {
+        if (flags.testAnyFlags(F::FollowDirSymlinks) && !enter(entry.canonicalFilePath()))
+            return std::unique_ptr<DirectoryNode>();
+        return schedule(entry.filePath());
+    };
+
+    const QDirListing::IteratorFlags listingFlags =
+            flags & ~QDirListing::IteratorFlags(F::Recursive | F::FollowDirSymlinks);
+    // file name -> index in items, to attach directories found by the second pass
+    QHash<QString, size_t> reported;
+    for (const auto &entry : QDirListing(path, nameFilters, listingFlags)) {
+        if (futureInterface.isCanceled())
+            return;
+        if (function)
+            function(entry);
+        else if (inOrder)
+            items.push_back({ entry.filePath(), nullptr });
+        else
+            results.append(entry.filePath());
+
+        if (!recursive)
+            continue;
+        if (separatePass) {
+            if (inOrder && entry.isDir())
+                reported.insert(entry.fileName(), items.size() - 1);
+        } else if (shouldRecurse(entry)) {
+            auto child = recurseInto(entry);
+            if (inOrder)
+                items.back().child = std::move(child);
+        }
+    }
+
+    if (!separatePass)
+        return;
+
+    const QDirListing::IteratorFlags dirFlags = flags & F::IncludeHidden;
+    for (const auto &entry : QDirListing(path, dirFlags)) {
+        if (futureInterface.isCanceled())
+            return;
+        if (!shouldRecurse(entry))
+            continue;
+        auto child = recurseInto(entry);
+        if (!inOrder || !child)
+            continue;
+        if (auto it = reported.constFind(entry.fileName()); it != reported.cend())
+            items[*it].child = std::move(child);
+        else
+            items.push_back({ QString(), std::move(child) });
+    }
+}
+
+void DirectoryWalk::walk(const QString &path, DirectoryNode *node)
+{
+    QList<QString> results;
+    std::vector<DirectoryItem> items;
+    if (!futureInterface.isCanceled()) {
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            readDirectory(path, results, items);
+#ifndef QT_NO_EXCEPTIONS
+        } catch (QException &e) {
+            futureInterface.reportException(e);
+        } catch (...) {
+            futureInterface.reportException(QUnhandledException(std::current_exception()));
+        }
+#endif
+    }
+
+    if (node) {
+        QMutexLocker locker(&mutex);
+        node->items = std::move(items);
+        node->done = true;
+        flushInOrder();
+    } else if (!results.isEmpty()) {
+        futureInterface.reportAndMoveResults(std::move(results));
+    }
+
+    if (!pending.deref())
+        futureInterface.reportFinished();
+}
+
+// Reports the file paths whose predecessors are all known. Called with the mutex held.
+void DirectoryWalk::flushInOrder()
+{
+    QList<QString> ready;
+    while (!cursor.empty()) {
+        auto &[node, next] = cursor.back();
+        if (!node->done)
+            break;
+        if (next == node->items.size()) {
+            cursor.pop_back();
+            // the parent owns the node, release it together with its items
+            if (!cursor.empty()) {
+                auto &[parent, parentNext] = cursor.back();
+                parent->items[parentNext - 1].child.reset();
+            }
+            continue;
+        }
+        DirectoryItem &item = node->items[next++];
+        if (!item.filePath.isNull())
+            ready.append(std::move(item.filePath));
+        if (item.child)
+            cursor.emplace_back(item.child.get(), 0);
+    }
+    if (!ready.isEmpty())
+        futureInterface.reportAndMoveResults(std::move(ready));
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Starts walking \a path with threads from \a pool. If \a function is set it
+    is called for each entry, otherwise the file paths are reported in the
+    given \a order.
+*/
+QFuture<QString> startDirectoryWalk(QThreadPool *pool, const QString &path,
+                                    const QStringList &nameFilters,
+                                    QDirListing::IteratorFlags flags, DirectoryWalkOrder order,
+                                    DirectoryWalkFunction function)
+{
+    if (function)
+        order = DirectoryWalkOrder::Unordered;
+    auto walk = std::make_shared<DirectoryWalk>(pool, nameFilters, flags, order,
+                                                std::move(function));
+    return walk->start(path);
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_DIRECTORYWALK_H
+#define QTCONCURRENT_DIRECTORYWALK_H
+
+#if 0
+#pragma qt_class(QtConcurrentDirectoryWalk)
+#endif
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtCore/qdirlisting.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthreadpool.h>
+
+#include <functional>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+enum class DirectoryWalkOrder {
+    Unordered,
+    DepthFirst,
+};
+
+#ifndef Q_QDOC
+
+using DirectoryWalkFunction = std::function<void(const QDirListing::DirEntry &)>;
+
+Q_CONCURRENT_EXPORT
+QFuture<QString> startDirectoryWalk(QThreadPool *pool, const QString &path,
+                                    const QStringList &nameFilters,
+                                    QDirListing::IteratorFlags flags, DirectoryWalkOrder order,
+                                    DirectoryWalkFunction function);
+
+template <typename Function>
+using if_directory_walk_function =
+        std::enable_if_t<std::is_invocable_v<Function, const QDirListing::DirEntry &>, bool>;
+
+#endif // Q_QDOC
+
+// walkDirectory() reporting file paths
+inline QFuture<QString> walkDirectory(QThreadPool *pool, const QString &path,
+                                      QDirListing::IteratorFlags flags
+                                              = QDirListing::IteratorFlag::Recursive,
+                                      DirectoryWalkOrder order = DirectoryWalkOrder::Unordered)
+{
+    return startDirectoryWalk(pool, path, {}, flags, order, {});
+}
+
+inline QFuture<QString> walkDirectory(QThreadPool *pool, const QString &path,
+                                      const QStringList &nameFilters,
+                                      QDirListing::IteratorFlags flags
+                                              = QDirListing::IteratorFlag::Recursive,
+                                      DirectoryWalkOrder order = DirectoryWalkOrder::Unordered)
+{
+    return startDirectoryWalk(pool, path, nameFilters, flags, order, {});
+}
+
+inline QFuture<QString> walkDirectory(const QString &path,
+                                      QDirListing::IteratorFlags flags
+                                              = QDirListing::IteratorFlag::Recursive,
+                                      DirectoryWalkOrder order = DirectoryWalkOrder::Unordered)
+{
+    return startDirectoryWalk(QThreadPool::globalInstance(), path, {}, flags, order, {});
+}
+
+inline QFuture<QString> walkDirectory(const QString &path, const QStringList &nameFilters,
+                                      QDirListing::IteratorFlags flags
+                                              = QDirListing::IteratorFlag::Recursive,
+                                      DirectoryWalkOrder order = DirectoryWalkOrder::Unordered)
+{
+    return startDirectoryWalk(QThreadPool::globalInstance(), path, nameFilters, flags, order,
+                              {});
+}
+
+// walkDirectory() calling a function for each entry
+template <typename Function, if_directory_walk_function<Function> = true>
+QFuture<void> walkDirectory(QThreadPool *pool, const QString &path,
+                            QDirListing::IteratorFlags flags, Function &&function)
+{
+    return QFuture<void>(startDirectoryWalk(pool, path, {}, flags,
+                                            DirectoryWalkOrder::Unordered,
+                                            std::forward<Function>(function)));
+}
+
+template <typename Function, if_directory_walk_function<Function> = true>
+QFuture<void> walkDirectory(const QString &path, QDirListing::IteratorFlags flags,
+                            Function &&function)
+{
+    return QFuture<void>(startDirectoryWalk(QThreadPool::globalInstance(), path, {}, flags,
+                                            DirectoryWalkOrder::Unordered,
+                                            std::forward<Function>(function)));
+}
+
+template <typename Function, if_directory_walk_function<Function> = true>
+void blockingWalkDirectory(QThreadPool *pool, const QString &path,
+                           QDirListing::IteratorFlags flags, Function &&function)
+{
+    QFuture<void> future = walkDirectory(pool, path, flags, std::forward<Function>(function));
+    future.waitForFinished();
+}
+
+template <typename Function, if_directory_walk_function<Function> = true>
+void blockingWalkDirectory(const QString &path, QDirListing::IteratorFlags flags,
+                           Function &&function)
+{
+    QFuture<void> future = walkDirectory(path, flags, std::forward<Function>(function));
+    future.waitForFinished();
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif // QTCONCURRENT_DIRECTORYWALK_H
@@ -728,3 +728,18 @@
   \fn [QtConcurrent-7] ThreadEngineStarter<ResultType> QtConcurrent::startFilteredReduced(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&mapFunctor, ReduceFunctor &&reduceFunctor, ResultType &&initialValue, ReduceOptions options)
   \internal
 */
+
+/*!
+    \fn template <typename... Args> QFuture<void> QtConcurrent::filter(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... Args> auto QtConcurrent::filtered(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... ResultType, typename... Args> auto QtConcurrent::filteredReduced(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... Args> void QtConcurrent::blockingFilter(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... OutputSequence, typename... Args> auto QtConcurrent::blockingFiltered(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... ResultType, typename... Args> auto QtConcurrent::blockingFilteredReduced(QtConcurrent::SplittingMode mode, Args &&...args)
+    \since 6.9
+
+    Calls the overload taking \a args, distributing the items among the
+    threads as specified by \a mode.
+
+    \sa {Items with Irregular Processing Costs}
+*/
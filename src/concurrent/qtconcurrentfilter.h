@@ -710,6 +710,49 @@ OutputSequence blockingFiltered(Iterator begin, Iterator end, KeepFunctor &&keep
                                                    QtPrivate::PushBackWrapper(), OrderedReduce);
 }
 
+// overloads that select the splitting mode for one call
+template <typename... Args>
+QFuture<void> filter(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return filter(std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+auto filtered(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return filtered(std::forward<Args>(args)...);
+}
+
+template <typename... ResultType, typename... Args>
+auto filteredReduced(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return filteredReduced<ResultType...>(std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+void blockingFilter(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingFilter(std::forward<Args>(args)...);
+}
+
+template <typename... OutputSequence, typename... Args>
+auto blockingFiltered(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingFiltered<OutputSequence...>(std::forward<Args>(args)...);
+}
+
+template <typename... ResultType, typename... Args>
+auto blockingFilteredReduced(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingFilteredReduced<ResultType...>(std::forward<Args>(args)...);
+}
+
 } // namespace QtConcurrent
 
 QT_END_NAMESPACE
@@ -6,6 +6,8 @@
 #include <qdeadlinetimer.h>
 #include "private/qfunctions_p.h"
 
+#include <utility>
+
 
 #if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
 
@@ -15,6 +17,12 @@ enum {
     TargetRatio = 100
 };
 
+// In lazy splitting mode, blocks aim to take between these many nanoseconds.
+enum : qint64 {
+    MinimumBlockTime = 20 * 1000,
+    MaximumBlockTime = 200 * 1000
+};
+
 static qint64 getticks()
 {
     return QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
@@ -27,6 +35,20 @@ static double elapsed(qint64 after, qint64 before)
 
 namespace QtConcurrent {
 
+Q_CONSTINIT static thread_local SplittingMode nextSplittingMode = SplittingMode::Blocks;
+
+void setNextSplittingMode(SplittingMode mode)
+{
+    nextSplittingMode = mode;
+}
+
+// Consumed by the kernel, so that the calls it makes to user code don't
+// pass the mode on to nested map or filter calls.
+SplittingMode takeNextSplittingMode()
+{
+    return std::exchange(nextSplittingMode, SplittingMode::Blocks);
+}
+
 /*!
   \class QtConcurrent::Median
   \inmodule QtConcurrent
@@ -39,6 +61,18 @@ namespace QtConcurrent {
   \internal
  */
 
+/*!
+  \class QtConcurrent::SplittingBlockSizeManager
+  \inmodule QtConcurrent
+  \internal
+ */
+
+/*!
+  \class QtConcurrent::RangeSplitter
+  \inmodule QtConcurrent
+  \internal
+ */
+
 /*!
   \class QtConcurrent::ResultReporter
   \inmodule QtConcurrent
@@ -115,6 +149,142 @@ int BlockSizeManager::blockSize()
     return m_blockSize;
 }
 
+SplittingBlockSizeManager::SplittingBlockSizeManager(QThreadPool *pool, int iterationCount)
+    : maxBlockSize(qMax(iterationCount / (std::max(pool->maxThreadCount(), 1) * 2), 1)),
+      beforeUser(0),
+      m_blockSize(1)
+{ }
+
+void SplittingBlockSizeManager::timeBeforeUser()
+{
+    beforeUser = getticks();
+}
+
+void SplittingBlockSizeManager::timeAfterUser()
+{
+    const qint64 userPartElapsed = getticks() - beforeUser;
+    if (userPartElapsed < MinimumBlockTime)
+        m_blockSize = qMin(m_blockSize * 2, maxBlockSize);
+    else if (userPartElapsed > MaximumBlockTime)
+        m_blockSize = qMax(m_blockSize / 2, 1);
+}
+
+// A range is stored as its begin in the lower and its end in the upper half
+// of a 64-bit integer, so that it can be updated atomically. Ranges only ever
+// shrink or get split, so a compare-and-swap cannot succeed on a stale value.
+struct RangeSplitter::Slot
+{
+    alignas(64) QAtomicInteger<quint64> range; // one cache line per slot
+    QAtomicInt owned;
+};
+
+static constexpr quint64 packRange(int begin, int end)
+{
+    return quint64(quint32(begin)) | (quint64(quint32(end)) << 32);
+}
+
+static constexpr int rangeBegin(quint64 range)
+{
+    return int(quint32(range));
+}
+
+static constexpr int rangeEnd(quint64 range)
+{
+    return int(quint32(range >> 32));
+}
+
+RangeSplitter::RangeSplitter(int threadCount, int iterationCount)
+    : ranges(new Slot[std::max(threadCount, 1)]),
+      slotCount(std::max(threadCount, 1))
+{
+    // the first thread starts with everything, the others steal from it
+    ranges[0].range.storeRelaxed(packRange(0, iterationCount));
+}
+
+RangeSplitter::~RangeSplitter() = default;
+
+// Returns a slot for the calling thread, or -1 if there are more threads
+// than slots.
+int RangeSplitter::acquireSlot()
+{
+    for (int i = 0; i < slotCount; ++i) {
+        if (ranges[i].owned.testAndSetAcquire(0, 1))
+            return i;
+    }
+    return -1;
+}
+
+void RangeSplitter::releaseSlot(int slot)
+{
+    ranges[slot].owned.storeRelease(0);
+}
+
+// Takes up to blockSize iterations from the range in slot, stealing a new
+// range if it is empty. Returns false if there are no iterations left.
+bool RangeSplitter::takeBlock(int slot, int blockSize, int *beginIndex, int *endIndex)
+{
+    Slot &own = ranges[slot];
+    for (;;) {
+        const quint64 range = own.range.loadAcquire();
+        const int begin = rangeBegin(range);
+        const int end = rangeEnd(range);
+        if (begin == end) {
+            if (!steal(slot))
+                return false;
+            continue;
+        }
+
+        const int blockEnd = begin + qMin(blockSize, end - begin);
+        if (own.range.testAndSetOrdered(range, packRange(blockEnd, end))) {
+            *beginIndex = begin;
+            *endIndex = blockEnd;
+            return true;
+        }
+    }
+}
+
+bool RangeSplitter::steal(int slot)
+{
+    for (;;) {
+        int victim = -1;
+        quint64 victimRange = 0;
+        int largest = 0;
+        for (int i = 0; i < slotCount; ++i) {
+            if (i == slot)
+                continue;
+            const quint64 range = ranges[i].range.loadAcquire();
+            const int size = rangeEnd(range) - rangeBegin(range);
+            if (size > largest) {
+                victim = i;
+                victimRange = range;
+                largest = size;
+            }
+        }
+        if (victim < 0)
+            return false;
+
+        // take the back half, which rounds up so that a last iteration
+        // left behind by an exited thread is taken as well
+        const int begin = rangeBegin(victimRange);
+        const int end = rangeEnd(victimRange);
+        const int middle = begin + (end - begin) / 2;
+        if (ranges[victim].range.testAndSetOrdered(victimRange, packRange(begin, middle))) {
+            ranges[slot].range.storeRelease(packRange(middle, end));
+            return true;
+        }
+    }
+}
+
+bool RangeSplitter::hasIterations() const
+{
+    for (int i = 0; i < slotCount; ++i) {
+        const quint64 range = ranges[i].range.loadRelaxed();
+        if (rangeBegin(range) != rangeEnd(range))
+            return true;
+    }
+    return false;
+}
+
 } // namespace QtConcurrent
 
 QT_END_NAMESPACE
@@ -13,6 +13,8 @@
 #include <QtConcurrent/qtconcurrentthreadengine.h>
 
 #include <iterator>
+#include <memory>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -20,6 +22,26 @@ QT_BEGIN_NAMESPACE
 
 namespace QtConcurrent {
 
+enum class SplittingMode {
+    Blocks,
+    Lazy
+};
+
+// Hands the splitting mode requested for one call of a map or filter
+// function to the kernel that the call creates.
+Q_CONCURRENT_EXPORT void setNextSplittingMode(SplittingMode mode);
+Q_CONCURRENT_EXPORT SplittingMode takeNextSplittingMode();
+
+class SplittingModeScope
+{
+public:
+    explicit SplittingModeScope(SplittingMode mode) { setNextSplittingMode(mode); }
+    ~SplittingModeScope() { setNextSplittingMode(SplittingMode::Blocks); }
+
+private:
+    Q_DISABLE_COPY_MOVE(SplittingModeScope)
+};
+
 /*
     The BlockSizeManager class manages how many iterations a thread should
     reserve and process at a time. This is done by measuring the time spent
@@ -53,6 +75,59 @@ private:
     Q_DISABLE_COPY(BlockSizeManager)
 };
 
+/*
+    The SplittingBlockSizeManager class is the counterpart of BlockSizeManager
+    for the lazy splitting mode. It aims for blocks that take a fixed amount of
+    time, so it also shrinks the block size again when the iterations become
+    more expensive, so that a thread never commits to a long run of them.
+*/
+class Q_CONCURRENT_EXPORT SplittingBlockSizeManager
+{
+public:
+    explicit SplittingBlockSizeManager(QThreadPool *pool, int iterationCount);
+
+    void timeBeforeUser();
+    void timeAfterUser();
+    int blockSize() const { return m_blockSize; }
+
+private:
+    const int maxBlockSize;
+    qint64 beforeUser;
+    int m_blockSize;
+
+    Q_DISABLE_COPY(SplittingBlockSizeManager)
+};
+
+/*
+    The RangeSplitter class distributes the iterations of a for-iteration
+    in lazy splitting mode. Each thread owns a slot holding a range of
+    iterations and takes blocks from the front of it. A thread whose range
+    is empty steals the back half of the largest range left, so ranges are
+    only split when a thread would otherwise be idle, and the iterations a
+    busy thread has not started yet remain available to the others.
+*/
+class Q_CONCURRENT_EXPORT RangeSplitter
+{
+public:
+    RangeSplitter(int threadCount, int iterationCount);
+    ~RangeSplitter();
+
+    int acquireSlot();
+    void releaseSlot(int slot);
+    bool takeBlock(int slot, int blockSize, int *beginIndex, int *endIndex);
+    bool hasIterations() const;
+
+private:
+    struct Slot;
+
+    bool steal(int slot);
+
+    std::unique_ptr<Slot[]> ranges;
+    const int slotCount;
+
+    Q_DISABLE_COPY(RangeSplitter)
+};
+
 template <typename T>
 class ResultReporter
 {
@@ -158,6 +233,7 @@ public:
           current(_begin),
           iterationCount(selectIteration(IteratorCategory()) ? static_cast<int>(std::distance(_begin, _end)) : 0),
           forIteration(selectIteration(IteratorCategory())),
+          lazySplitting(takeNextSplittingMode() == SplittingMode::Lazy && forIteration),
           progressReportingEnabled(true)
     {
     }
@@ -170,6 +246,7 @@ public:
           current(_begin),
           iterationCount(selectIteration(IteratorCategory()) ? static_cast<int>(std::distance(_begin, _end)) : 0),
           forIteration(selectIteration(IteratorCategory())),
+          lazySplitting(takeNextSplittingMode() == SplittingMode::Lazy && forIteration),
           progressReportingEnabled(true),
           defaultValue(U())
     {
@@ -183,6 +260,7 @@ public:
           current(_begin),
           iterationCount(selectIteration(IteratorCategory()) ? static_cast<int>(std::distance(_begin, _end)) : 0),
           forIteration(selectIteration(IteratorCategory())),
+          lazySplitting(takeNextSplittingMode() == SplittingMode::Lazy && forIteration),
           progressReportingEnabled(true),
           defaultValue(std::forward<U>(_defaultValue))
     {
@@ -190,6 +268,12 @@ public:
 
     virtual ~IterateKernel() { }
 
+    // only random-access sequences can be split lazily
+    void setSplittingMode(SplittingMode mode)
+    {
+        lazySplitting = mode == SplittingMode::Lazy && forIteration;
+    }
+
     virtual bool runIteration(Iterator, int , T *) { return false; }
     virtual bool runIterations(Iterator, int, int, T *) { return false; }
 
@@ -198,11 +282,15 @@ public:
         progressReportingEnabled = this->isProgressReportingEnabled();
         if (progressReportingEnabled && iterationCount > 0)
             this->setProgressRange(0, iterationCount);
+        if (lazySplitting)
+            rangeSplitter.emplace(ThreadEngineBase::threadPool->maxThreadCount(), iterationCount);
     }
 
     bool shouldStartThread() override
     {
-        if (forIteration)
+        if (lazySplitting)
+            return rangeSplitter->hasIterations() && !this->shouldThrottleThread();
+        else if (forIteration)
             return (currentIndex.loadRelaxed() < iterationCount) && !this->shouldThrottleThread();
         else // whileIteration
             return (iteratorThreads.loadRelaxed() == 0);
@@ -210,7 +298,9 @@ public:
 
     ThreadFunctionResult threadFunction() override
     {
-        if (forIteration)
+        if (lazySplitting)
+            return this->splittingThreadFunction();
+        else if (forIteration)
             return this->forThreadFunction();
         else // whileIteration
             return this->whileThreadFunction();
@@ -267,6 +357,59 @@ public:
         return ThreadFinished;
     }
 
+    // Used instead of forThreadFunction() when the thread pool does work
+    // stealing: the iterations are split lazily between the threads, see
+    // RangeSplitter.
+    ThreadFunctionResult splittingThreadFunction()
+    {
+        const int slot = rangeSplitter->acquireSlot();
+        if (slot < 0)
+            return ThreadFinished;
+
+        SplittingBlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, iterationCount);
+        ResultReporter<T> resultReporter = createResultsReporter();
+        ThreadFunctionResult result = ThreadFinished;
+
+        for(;;) {
+            if (this->isCanceled())
+                break;
+
+            int beginIndex;
+            int endIndex;
+            if (!rangeSplitter->takeBlock(slot, blockSizeManager.blockSize(), &beginIndex, &endIndex))
+                break;
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            const int finalBlockSize = endIndex - beginIndex;
+            resultReporter.reserveSpace(finalBlockSize);
+
+            blockSizeManager.timeBeforeUser();
+            const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
+            blockSizeManager.timeAfterUser();
+
+            if (resultsAvailable)
+                resultReporter.reportResults(beginIndex);
+
+            if (progressReportingEnabled) {
+                completed.fetchAndAddAcquire(finalBlockSize);
+                this->setProgressValue(this->completed.loadRelaxed());
+            }
+
+            if (this->shouldThrottleThread()) {
+                result = ThrottleThread;
+                break;
+            }
+        }
+
+        // the iterations left in the slot are stolen by the other threads
+        rangeSplitter->releaseSlot(slot);
+        return result;
+    }
+
     ThreadFunctionResult whileThreadFunction()
     {
         if (iteratorThreads.testAndSetAcquire(0, 1) == false)
@@ -321,8 +464,10 @@ public:
     QAtomicInt completed;
     const int iterationCount;
     const bool forIteration;
+    bool lazySplitting;
     bool progressReportingEnabled;
     DefaultValueContainer<ResultType> defaultValue;
+    std::optional<RangeSplitter> rangeSplitter;
 };
 
 } // namespace QtConcurrent
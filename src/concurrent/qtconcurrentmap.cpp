@@ -105,6 +105,26 @@
     might be supported in a future version of Qt Concurrent.)
 */
 
+/*!
+    \enum class QtConcurrent::SplittingMode
+    \since 6.9
+
+    This enum specifies how the map and filter functions distribute the items
+    of a sequence among the threads.
+
+    \value Blocks The threads take blocks of consecutive items from a shared
+    position in the sequence. The size of the blocks grows as long as
+    processing an item takes little time compared to managing the blocks.
+    This is the default.
+    \value Lazy Each thread works through its own range of items in short
+    blocks, and an idle thread takes over the back half of the largest range
+    left. This balances the load better when the cost of processing items
+    varies a lot. Only applies to random-access sequences; others are
+    processed as with \c Blocks.
+
+    \sa {Items with Irregular Processing Costs}
+*/
+
 /*!
     \page qtconcurrentmap.html
     \title Concurrent Map and Map-Reduce
@@ -217,6 +237,27 @@
     Note that the result types above are not QFuture objects, but real result
     types (in this case, QList<QImage> and QImage).
 
+    \section2 Items with Irregular Processing Costs
+
+    By default, the threads take blocks of consecutive items from a shared
+    position in the sequence, and the size of the blocks grows as long as the
+    time spent per item is short compared to the time spent managing them.
+    When a few items take much longer to process than the others, a thread
+    can end up holding a large block of them while the other threads are
+    idle.
+
+    For such workloads, pass QtConcurrent::SplittingMode::Lazy as the first
+    argument. The items of random-access sequences are then split lazily:
+    each thread works through its own range of items in blocks that are kept
+    short, and an idle thread takes over the back half of the largest range
+    left. The mode only applies to that call, and is accepted by all the map
+    and filter functions, including their blocking variants.
+
+    \code
+    QFuture<Result> results = QtConcurrent::mapped(QtConcurrent::SplittingMode::Lazy,
+                                                   inputs, solve);
+    \endcode
+
     \section2 Using Member Functions
 
     QtConcurrent::map(), QtConcurrent::mapped(), and
@@ -744,3 +785,18 @@
 
   \sa blockingMappedReduced(), {Concurrent Map and Map-Reduce}
 */
+
+/*!
+    \fn template <typename... Args> QFuture<void> QtConcurrent::map(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... Args> auto QtConcurrent::mapped(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... ResultType, typename... Args> auto QtConcurrent::mappedReduced(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... Args> void QtConcurrent::blockingMap(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... OutputSequence, typename... Args> auto QtConcurrent::blockingMapped(QtConcurrent::SplittingMode mode, Args &&...args)
+    \fn template <typename... ResultType, typename... Args> auto QtConcurrent::blockingMappedReduced(QtConcurrent::SplittingMode mode, Args &&...args)
+    \since 6.9
+
+    Calls the overload taking \a args, distributing the items among the
+    threads as specified by \a mode.
+
+    \sa {Items with Irregular Processing Costs}
+*/
@@ -813,6 +813,49 @@ auto blockingMapped(Iterator begin, Iterator end, MapFunctor &&map)
                                                  QtPrivate::PushBackWrapper(), OrderedReduce);
 }
 
+// overloads that select the splitting mode for one call
+template <typename... Args>
+QFuture<void> map(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return map(std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+auto mapped(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return mapped(std::forward<Args>(args)...);
+}
+
+template <typename... ResultType, typename... Args>
+auto mappedReduced(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return mappedReduced<ResultType...>(std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+void blockingMap(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingMap(std::forward<Args>(args)...);
+}
+
+template <typename... OutputSequence, typename... Args>
+auto blockingMapped(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingMapped<OutputSequence...>(std::forward<Args>(args)...);
+}
+
+template <typename... ResultType, typename... Args>
+auto blockingMappedReduced(SplittingMode mode, Args &&...args)
+{
+    SplittingModeScope scope(mode);
+    return blockingMappedReduced<ResultType...>(std::forward<Args>(args)...);
+}
+
 } // namespace QtConcurrent
 
 
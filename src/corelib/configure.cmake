@@ -244,6 +244,28 @@ inotify_rm_watch(0, 1);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+syscall(__NR_io_uring_setup, 8, &params);
+syscall(__NR_io_uring_enter, 0, 1, 0, IORING_ENTER_GETEVENTS, 0, 0);
+syscall(__NR_io_uring_register, 0, IORING_REGISTER_EVENTFD, 0, 1);
+int opcodes[] = { IORING_OP_READV, IORING_OP_WRITEV };
+(void)opcodes;
+    /* END TEST: */
+    return 0;
+}
+")
+
 qt_config_compile_test(sysv_shm
     LABEL "System V/XSI shared memory"
     CODE
@@ -561,6 +583,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND TEST_io_uring
+)
 qt_feature("ipc_posix"
     LABEL "Defaulting legacy IPC to POSIX"
     CONDITION TEST_posix_shm AND TEST_posix_sem AND (
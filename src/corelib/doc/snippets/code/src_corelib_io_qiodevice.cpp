@@ -60,3 +60,15 @@ bool isExeFile(QFile *file)
     return file->peek(2) == "MZ";
 }
 //! [5]
+
+
+//! [6]
+void Client::onReadyRead()
+{
+    for (QByteArrayView chunk = socket->peekChunk(); !chunk.isEmpty();
+         chunk = socket->peekChunk()) {
+        parser.feed(chunk);
+        socket->skip(chunk.size());
+    }
+}
+//! [6]
@@ -6,7 +6,10 @@
 #endif
 #include <QtCore/qglobal.h>
 
-#define FORKFD_NO_SPAWNFD
+#ifndef Q_OS_DARWIN
+// only QProcess on Darwin uses spawnfd()
+#  define FORKFD_NO_SPAWNFD
+#endif
 #if defined(QT_NO_DEBUG) && !defined(NDEBUG)
 #  define NDEBUG
 #endif
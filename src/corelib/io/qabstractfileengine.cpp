@@ -1075,6 +1075,31 @@ qint64 QAbstractFileEngine::write(const char *data, qint64 len)
     return -1;
 }
 
+/*!
+    \since 6.9
+
+    Writes the blocks of \a data to the file, in order. Returns the number
+    of characters written on success; otherwise returns -1.
+
+    The default implementation calls write() for each block, until one is
+    not written completely.
+*/
+qint64 QAbstractFileEngine::writeGathered(QSpan<const QByteArrayView> data)
+{
+    qint64 writtenSoFar = 0;
+    for (QByteArrayView block : data) {
+        if (block.isEmpty())
+            continue;
+        const qint64 written = write(block.data(), block.size());
+        if (written <= 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < block.size())
+            break;
+    }
+    return writtenSoFar;
+}
+
 /*!
     This function reads one line, terminated by a '\\n' character, from the
     file info \a data. At most \a maxlen characters will be read. The
@@ -138,6 +138,7 @@ public:
     virtual qint64 read(char *data, qint64 maxlen);
     virtual qint64 readLine(char *data, qint64 maxlen);
     virtual qint64 write(const char *data, qint64 len);
+    virtual qint64 writeGathered(QSpan<const QByteArrayView> data);
 
     QFile::FileError error() const;
     QString errorString() const;
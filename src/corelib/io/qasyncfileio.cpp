@@ -0,0 +1,249 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qthreadpool.h>
+
+#if QT_CONFIG(io_uring)
+#  include "qasyncfileio_uring_p.h"
+#endif
+
+#ifdef Q_OS_WIN
+#  include <qt_windows.h>
+#  include <io.h>
+#else
+#  include "qplatformdefs.h"
+#  include <QtCore/private/qcore_unix_p.h>
+#  include <limits.h>
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    \internal
+    \class QAsyncFileIO
+
+    Performs positional reads and writes on files without blocking the calling
+    thread, reporting the results through QFuture. The operations are
+    independent of the file position and of the buffers of the QFileDevice
+    that provided the handle.
+
+    The default instance uses io_uring where the kernel provides it, and a
+    thread pool running blocking I/O otherwise.
+*/
+
+QExplicitlySharedDataPointer<QAsyncFileHandle>
+QAsyncFileHandle::create(int fd, QIODeviceBase::OpenMode mode)
+{
+    if (fd == -1)
+        return {};
+#ifdef Q_OS_WIN
+    const HANDLE handle = HANDLE(_get_osfhandle(fd));
+    if (handle == INVALID_HANDLE_VALUE)
+        return {};
+    // Positional I/O on a synchronous handle moves its file pointer, which
+    // QFSFileEngine relies on, so operate on a new file object instead.
+    DWORD access = 0;
+    if (mode & QIODeviceBase::ReadOnly)
+        access |= GENERIC_READ;
+    if (mode & QIODeviceBase::WriteOnly)
+        access |= GENERIC_WRITE;
+    const HANDLE reopened =
+            ReOpenFile(handle, access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0);
+    if (reopened == INVALID_HANDLE_VALUE)
+        return {};
+    return QExplicitlySharedDataPointer<QAsyncFileHandle>(new QAsyncFileHandle(reopened));
+#else
+    Q_UNUSED(mode);
+    const int duplicate = qt_safe_dup(fd);
+    if (duplicate == -1)
+        return {};
+    return QExplicitlySharedDataPointer<QAsyncFileHandle>(new QAsyncFileHandle(duplicate));
+#endif
+}
+
+QAsyncFileHandle::~QAsyncFileHandle()
+{
+#ifdef Q_OS_WIN
+    CloseHandle(nativeHandle);
+#else
+    qt_safe_close(nativeHandle);
+#endif
+}
+
+// Returns the size of a regular file, or -1 if the size isn't known.
+qint64 QAsyncFileHandle::size() const
+{
+#ifdef Q_OS_WIN
+    LARGE_INTEGER size;
+    if (GetFileType(nativeHandle) != FILE_TYPE_DISK || !GetFileSizeEx(nativeHandle, &size))
+        return -1;
+    return size.QuadPart;
+#else
+    QT_STATBUF st;
+    if (QT_FSTAT(nativeHandle, &st) != 0 || !S_ISREG(st.st_mode))
+        return -1;
+    return st.st_size;
+#endif
+}
+
+QAsyncFileIO::~QAsyncFileIO() = default;
+
+namespace {
+
+// Blocking positional I/O. Both functions loop until everything was
+// transferred, the end of the file was reached or an error occurred, and
+// return the number of bytes transferred, or -1 if an error occurred before
+// anything could be transferred.
+qint64 readAt(QAsyncFileHandle::NativeHandle handle, qint64 offset, char *data, qint64 maxSize)
+{
+    qint64 done = 0;
+    while (done < maxSize) {
+#ifdef Q_OS_WIN
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = DWORD(offset + done);
+        overlapped.OffsetHigh = DWORD((offset + done) >> 32);
+        const DWORD blockSize = DWORD(qMin<qint64>(maxSize - done, 1 << 30));
+        DWORD bytesRead = 0;
+        if (!ReadFile(handle, data + done, blockSize, &bytesRead, &overlapped)) {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+                break;
+            return done ? done : -1;
+        }
+        const qint64 result = bytesRead;
+#else
+        const size_t blockSize = size_t(qMin<qint64>(maxSize - done, SSIZE_MAX));
+        qint64 result;
+        QT_EINTR_LOOP(result, ::pread(handle, data + done, blockSize, QT_OFF_T(offset + done)));
+        if (result < 0)
+            return done ? done : -1;
+#endif
+        if (result == 0)
+            break;
+        done += result;
+    }
+    return done;
+}
+
+qint64 writeAt(QAsyncFileHandle::NativeHandle handle, qint64 offset, const char *data,
+               qint64 size)
+{
+    qint64 done = 0;
+    while (done < size) {
+#ifdef Q_OS_WIN
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = DWORD(offset + done);
+        overlapped.OffsetHigh = DWORD((offset + done) >> 32);
+        const DWORD blockSize = DWORD(qMin<qint64>(size - done, 1 << 30));
+        DWORD bytesWritten = 0;
+        if (!WriteFile(handle, data + done, blockSize, &bytesWritten, &overlapped))
+            return done ? done : -1;
+        const qint64 result = bytesWritten;
+#else
+        const size_t blockSize = size_t(qMin<qint64>(size - done, SSIZE_MAX));
+        qint64 result;
+        QT_EINTR_LOOP(result, ::pwrite(handle, data + done, blockSize, QT_OFF_T(offset + done)));
+        if (result < 0)
+            return done ? done : -1;
+#endif
+        if (result == 0)
+            break;
+        done += result;
+    }
+    return done;
+}
+
+class QThreadPoolFileIO final : public QAsyncFileIO
+{
+public:
+    QThreadPoolFileIO() { pool.setObjectName(QStringLiteral("Qt file I/O")); }
+    ~QThreadPoolFileIO() override { pool.waitForDone(); }
+
+    Backend backend() const override { return Backend::ThreadPool; }
+
+    QFuture<QByteArray> read(const HandlePointer &file, qint64 offset, qint64 maxSize) override
+    {
+        QFutureInterface<QByteArray> promise;
+        promise.reportStarted();
+        QFuture<QByteArray> future = promise.future();
+        pool.start([promise, file, offset, maxSize]() mutable {
+            QByteArray data;
+            if (!promise.isCanceled()) {
+                data.resize(maxSize);
+                const qint64 bytesRead = readAt(file->handle(), offset, data.data(), maxSize);
+                data.truncate(qMax(bytesRead, 0));
+            }
+            promise.reportAndMoveResult(std::move(data));
+            promise.reportFinished();
+        });
+        return future;
+    }
+
+    QFuture<qint64> write(const HandlePointer &file, qint64 offset,
+                          const QByteArray &data) override
+    {
+        QFutureInterface<qint64> promise;
+        promise.reportStarted();
+        QFuture<qint64> future = promise.future();
+        pool.start([promise, file, offset, data]() mutable {
+            qint64 bytesWritten = -1;
+            if (!promise.isCanceled())
+                bytesWritten = writeAt(file->handle(), offset, data.constData(), data.size());
+            promise.reportResult(bytesWritten);
+            promise.reportFinished();
+        });
+        return future;
+    }
+
+private:
+    // Not the global instance: blocking file I/O must not starve the tasks
+    // that applications run there.
+    QThreadPool pool;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QThreadPoolFileIO, threadPoolFileIO)
+#if QT_CONFIG(io_uring)
+Q_GLOBAL_STATIC(std::unique_ptr<QIoUringFileIO>, ioUringFileIO, QIoUringFileIO::create())
+#endif
+
+/*
+    \internal
+
+    Returns the instance to use for asynchronous file I/O.
+*/
+QAsyncFileIO *QAsyncFileIO::instance()
+{
+#if QT_CONFIG(io_uring)
+    if (QAsyncFileIO *io = instance(Backend::IoUring))
+        return io;
+#endif
+    return instance(Backend::ThreadPool);
+}
+
+/*
+    \internal
+
+    Returns the instance implementing asynchronous file I/O with \a backend,
+    or \nullptr if the backend isn't available.
+*/
+QAsyncFileIO *QAsyncFileIO::instance(Backend backend)
+{
+    switch (backend) {
+    case Backend::ThreadPool:
+        return threadPoolFileIO();
+    case Backend::IoUring:
+#if QT_CONFIG(io_uring)
+        if (auto io = ioUringFileIO())
+            return io->get();
+#endif
+        break;
+    }
+    return nullptr;
+}
+
+QT_END_NAMESPACE
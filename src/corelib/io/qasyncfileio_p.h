@@ -0,0 +1,83 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QASYNCFILEIO_P_H
+#define QASYNCFILEIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qiodevicebase.h>
+#include <QtCore/qshareddata.h>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+class QAsyncFileHandle : public QSharedData
+{
+public:
+#ifdef Q_OS_WIN
+    using NativeHandle = Qt::HANDLE;
+#else
+    using NativeHandle = int;
+#endif
+
+    // duplicates the handle, so that the file stays open as long as
+    // operations are pending, and without sharing the file position
+    static QExplicitlySharedDataPointer<QAsyncFileHandle> create(int fd,
+                                                                 QIODeviceBase::OpenMode mode);
+    ~QAsyncFileHandle();
+
+    NativeHandle handle() const { return nativeHandle; }
+    qint64 size() const;
+
+private:
+    explicit QAsyncFileHandle(NativeHandle handle) : nativeHandle(handle) {}
+    Q_DISABLE_COPY_MOVE(QAsyncFileHandle)
+
+    NativeHandle nativeHandle;
+};
+
+class Q_AUTOTEST_EXPORT QAsyncFileIO
+{
+public:
+    using HandlePointer = QExplicitlySharedDataPointer<QAsyncFileHandle>;
+
+    enum class Backend {
+        ThreadPool,
+        IoUring,
+    };
+
+    static QAsyncFileIO *instance();
+    static QAsyncFileIO *instance(Backend backend);
+
+    virtual ~QAsyncFileIO();
+
+    virtual Backend backend() const = 0;
+    virtual QFuture<QByteArray> read(const HandlePointer &file, qint64 offset,
+                                     qint64 maxSize) = 0;
+    virtual QFuture<qint64> write(const HandlePointer &file, qint64 offset,
+                                  const QByteArray &data) = 0;
+
+protected:
+    QAsyncFileIO() = default;
+
+private:
+    Q_DISABLE_COPY_MOVE(QAsyncFileIO)
+};
+
+QT_END_NAMESPACE
+
+#endif // QASYNCFILEIO_P_H
@@ -0,0 +1,423 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qasyncfileio_uring_p.h"
+
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qcore_unix_p.h>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The rings are shared with the kernel: we produce submissions by writing
+    entries and advancing the tail of the submission queue, and consume
+    completions by advancing the head of the completion queue. The raw system
+    calls are used, so that there is no dependency on liburing.
+*/
+
+namespace {
+
+int io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned count)
+{
+    return int(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+unsigned loadAcquire(const unsigned *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+void storeRelease(unsigned *p, unsigned value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T *ringPointer(void *ring, quint32 offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+// Number of entries of the submission queue, which also bounds the number of
+// operations in flight, so that neither of the queues can overflow.
+constexpr unsigned RingEntries = 128;
+
+} // unnamed namespace
+
+struct QIoUringFileIO::Operation
+{
+    virtual ~Operation() = default;
+    virtual void finish() = 0;
+    // Performs the remainder with the blocking backend, then finishes and
+    // deletes the operation.
+    virtual void failOver(QAsyncFileIO *io) = 0;
+
+    QAsyncFileIO::HandlePointer file;
+    qint64 offset = 0;
+    char *data = nullptr;
+    qint64 size = 0;
+    qint64 done = 0;
+    iovec iov = {};
+    bool failed = false;
+    bool isWrite = false;
+};
+
+struct QIoUringFileIO::ReadOperation : Operation
+{
+    void finish() override
+    {
+        buffer.truncate(failed && !done ? 0 : done);
+        promise.reportAndMoveResult(std::move(buffer));
+        promise.reportFinished();
+    }
+
+    void failOver(QAsyncFileIO *io) override
+    {
+        io->read(file, offset + done, size - done).then([this](const QByteArray &data) {
+            buffer.truncate(done);
+            buffer += data;
+            done = buffer.size();
+            finish();
+            delete this;
+        });
+    }
+
+    QFutureInterface<QByteArray> promise;
+    QByteArray buffer;
+};
+
+struct QIoUringFileIO::WriteOperation : Operation
+{
+    void finish() override
+    {
+        promise.reportResult(failed && !done ? -1 : done);
+        promise.reportFinished();
+    }
+
+    void failOver(QAsyncFileIO *io) override
+    {
+        io->write(file, offset + done, buffer.sliced(done)).then([this](qint64 written) {
+            if (written < 0)
+                failed = true;
+            else
+                done += written;
+            finish();
+            delete this;
+        });
+    }
+
+    QFutureInterface<qint64> promise;
+    QByteArray buffer;
+};
+
+std::unique_ptr<QIoUringFileIO> QIoUringFileIO::create()
+{
+    std::unique_ptr<QIoUringFileIO> io(new QIoUringFileIO);
+    if (!io->setup())
+        return nullptr;
+    io->start();
+    return io;
+}
+
+bool QIoUringFileIO::setup()
+{
+    io_uring_params params = {};
+    ringFd = io_uring_setup(RingEntries, &params);
+    if (ringFd < 0)
+        return false;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        return false;
+    }
+    if (singleMap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            return false;
+        }
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *entries = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           ringFd, IORING_OFF_SQES);
+    if (entries == MAP_FAILED)
+        return false;
+    sqes = static_cast<io_uring_sqe *>(entries);
+
+    sqHead = ringPointer<unsigned>(sqRing, params.sq_off.head);
+    sqTail = ringPointer<unsigned>(sqRing, params.sq_off.tail);
+    sqArray = ringPointer<unsigned>(sqRing, params.sq_off.array);
+    sqMask = *ringPointer<unsigned>(sqRing, params.sq_off.ring_mask);
+    cqHead = ringPointer<unsigned>(cqRing, params.cq_off.head);
+    cqTail = ringPointer<unsigned>(cqRing, params.cq_off.tail);
+    cqes = ringPointer<io_uring_cqe>(cqRing, params.cq_off.cqes);
+    cqMask = *ringPointer<unsigned>(cqRing, params.cq_off.ring_mask);
+    maxInFlight = qMin(params.sq_entries, params.cq_entries);
+
+    eventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0)
+        return false;
+    return io_uring_register(ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) == 0;
+}
+
+void QIoUringFileIO::start()
+{
+    // The notifier is deleted by the thread once its event loop has exited.
+    auto notifier = new QSocketNotifier(eventFd, QSocketNotifier::Read);
+    QObject::connect(notifier, &QSocketNotifier::activated, notifier,
+                     [this] { processCompletions(); });
+    QObject::connect(&thread, &QThread::finished, notifier, &QObject::deleteLater);
+    notifier->moveToThread(&thread);
+    thread.setObjectName(QStringLiteral("Qt file I/O"));
+    thread.start();
+}
+
+QIoUringFileIO::~QIoUringFileIO()
+{
+    if (thread.isRunning()) {
+        thread.quit();
+        thread.wait();
+    }
+
+    if (sqes) {
+        // The kernel may still write into the buffers of the operations in
+        // flight, so wait for them before tearing the ring down.
+        std::deque<Operation *> canceled;
+        {
+            QMutexLocker locker(&mutex);
+            shuttingDown = true;
+            canceled.swap(backlog);
+        }
+        for (Operation *operation : canceled) {
+            operation->failed = true;
+            operation->finish();
+            delete operation;
+        }
+        while (inFlight) {
+            int result;
+            QT_EINTR_LOOP(result, io_uring_enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS));
+            if (result < 0)
+                break;
+            processCompletions();
+        }
+        ::munmap(sqes, sqesSize);
+    }
+    if (cqRing && cqRing != sqRing)
+        ::munmap(cqRing, cqRingSize);
+    if (sqRing)
+        ::munmap(sqRing, sqRingSize);
+    if (eventFd >= 0)
+        qt_safe_close(eventFd);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+QFuture<QByteArray> QIoUringFileIO::read(const HandlePointer &file, qint64 offset,
+                                         qint64 maxSize)
+{
+    auto operation = new ReadOperation;
+    operation->promise.reportStarted();
+    QFuture<QByteArray> future = operation->promise.future();
+    operation->buffer.resize(maxSize);
+    operation->file = file;
+    operation->offset = offset;
+    operation->data = operation->buffer.data();
+    operation->size = maxSize;
+    enqueue(operation);
+    return future;
+}
+
+QFuture<qint64> QIoUringFileIO::write(const HandlePointer &file, qint64 offset,
+                                      const QByteArray &data)
+{
+    auto operation = new WriteOperation;
+    operation->promise.reportStarted();
+    QFuture<qint64> future = operation->promise.future();
+    operation->buffer = data;
+    operation->file = file;
+    operation->offset = offset;
+    // the kernel only reads from it
+    operation->data = const_cast<char *>(operation->buffer.constData());
+    operation->size = data.size();
+    operation->isWrite = true;
+    enqueue(operation);
+    return future;
+}
+
+void QIoUringFileIO::enqueue(Operation *operation)
+{
+    if (operation->size == 0) {
+        operation->finish();
+        delete operation;
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+    if (inFlight == maxInFlight) {
+        backlog.push_back(operation);
+        return;
+    }
+    ++inFlight;
+    prepare(operation);
+    const OperationList withdrawn = submitPending();
+    locker.unlock();
+    failOver(withdrawn);
+}
+
+// Queues a submission for the part of the operation that wasn't done yet.
+// Must be called with the mutex locked.
+void QIoUringFileIO::prepare(Operation *operation)
+{
+    const unsigned tail = *sqTail;
+    const unsigned index = tail & sqMask;
+    io_uring_sqe *sqe = sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+
+    operation->iov.iov_base = operation->data + operation->done;
+    operation->iov.iov_len = size_t(operation->size - operation->done);
+    sqe->opcode = operation->isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = operation->file->handle();
+    sqe->off = quint64(operation->offset + operation->done);
+    sqe->addr = quintptr(&operation->iov);
+    sqe->len = 1;
+    sqe->user_data = quintptr(operation);
+
+    sqArray[index] = index;
+    storeRelease(sqTail, tail + 1);
+}
+
+// Submits all queued entries. If the kernel doesn't take them (EAGAIN,
+// EBUSY) while it has none of our operations left, no completion would
+// trigger another attempt, so the queued entries and the backlog are
+// withdrawn and returned, to be passed to failOver() once the mutex is
+// unlocked.
+// Must be called with the mutex locked.
+QIoUringFileIO::OperationList QIoUringFileIO::submitPending()
+{
+    OperationList withdrawn;
+    for (;;) {
+        const unsigned head = loadAcquire(sqHead);
+        const unsigned tail = *sqTail;
+        const unsigned pending = tail - head;
+        if (!pending)
+            break;
+        const int result = io_uring_enter(ringFd, pending, 0, 0);
+        if (result > 0 || (result < 0 && errno == EINTR))
+            continue;
+        // the next completion retries the submission
+        if (inFlight > pending)
+            break;
+
+        // Without SQPOLL, the kernel only consumes entries in io_uring_enter(),
+        // so they can be taken back.
+        for (unsigned i = head; i != tail; ++i) {
+            const io_uring_sqe &sqe = sqes[sqArray[i & sqMask]];
+            withdrawn.append(reinterpret_cast<Operation *>(quintptr(sqe.user_data)));
+        }
+        storeRelease(sqTail, head);
+        inFlight -= pending;
+        for (Operation *operation : backlog)
+            withdrawn.append(operation);
+        backlog.clear();
+        break;
+    }
+    return withdrawn;
+}
+
+void QIoUringFileIO::failOver(const OperationList &operations)
+{
+    QAsyncFileIO *io = instance(Backend::ThreadPool);
+    for (Operation *operation : operations) {
+        if (io) {
+            operation->failOver(io);
+        } else {
+            operation->failed = true;
+            operation->finish();
+            delete operation;
+        }
+    }
+}
+
+// Accounts for the result of a completion. Returns true if the operation is
+// finished, false if the remainder needs to be submitted again.
+bool QIoUringFileIO::complete(Operation *operation, int result)
+{
+    if (result == -EINTR || result == -EAGAIN)
+        return shuttingDown;
+    if (result < 0) {
+        operation->failed = true;
+        return true;
+    }
+    operation->done += result;
+    // short transfers only happen at the end of the file or for huge
+    // operations that the kernel splits up
+    return result == 0 || operation->done == operation->size || shuttingDown;
+}
+
+void QIoUringFileIO::processCompletions()
+{
+    quint64 counter;
+    qt_safe_read(eventFd, &counter, sizeof(counter));
+
+    QVarLengthArray<Operation *, 32> finished;
+    OperationList withdrawn;
+    {
+        QMutexLocker locker(&mutex);
+        unsigned head = *cqHead;
+        const unsigned tail = loadAcquire(cqTail);
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            auto operation = reinterpret_cast<Operation *>(quintptr(cqe.user_data));
+            if (complete(operation, cqe.res)) {
+                finished.append(operation);
+                --inFlight;
+            } else {
+                prepare(operation);
+            }
+        }
+        storeRelease(cqHead, head);
+
+        while (!backlog.empty() && inFlight < maxInFlight) {
+            ++inFlight;
+            prepare(backlog.front());
+            backlog.pop_front();
+        }
+        withdrawn = submitPending();
+    }
+    failOver(withdrawn);
+
+    for (Operation *operation : std::as_const(finished)) {
+        operation->finish();
+        delete operation;
+    }
+}
+
+QT_END_NAMESPACE
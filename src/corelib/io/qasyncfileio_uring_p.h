@@ -0,0 +1,93 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QASYNCFILEIO_URING_P_H
+#define QASYNCFILEIO_URING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qasyncfileio_p.h"
+
+QT_REQUIRE_CONFIG(io_uring);
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <deque>
+#include <memory>
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+QT_BEGIN_NAMESPACE
+
+class QIoUringFileIO final : public QAsyncFileIO
+{
+public:
+    // returns nullptr if the kernel doesn't provide io_uring or forbids its use
+    static std::unique_ptr<QIoUringFileIO> create();
+    ~QIoUringFileIO() override;
+
+    Backend backend() const override { return Backend::IoUring; }
+    QFuture<QByteArray> read(const HandlePointer &file, qint64 offset, qint64 maxSize) override;
+    QFuture<qint64> write(const HandlePointer &file, qint64 offset,
+                          const QByteArray &data) override;
+
+private:
+    struct Operation;
+    struct ReadOperation;
+    struct WriteOperation;
+    using OperationList = QVarLengthArray<Operation *, 4>;
+
+    QIoUringFileIO() = default;
+    bool setup();
+    void start();
+
+    void enqueue(Operation *operation);
+    void prepare(Operation *operation);
+    OperationList submitPending();
+    void failOver(const OperationList &operations);
+    void processCompletions();
+    bool complete(Operation *operation, int result);
+
+    QMutex mutex;
+    std::deque<Operation *> backlog;
+    unsigned inFlight = 0;
+    unsigned maxInFlight = 0;
+    bool shuttingDown = false;
+
+    int ringFd = -1;
+    int eventFd = -1;
+    void *sqRing = nullptr;
+    void *cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+
+    // completions are reaped by a socket notifier on the eventfd of the ring,
+    // in the event loop of this thread
+    QThread thread;
+};
+
+QT_END_NAMESPACE
+
+#endif // QASYNCFILEIO_URING_P_H
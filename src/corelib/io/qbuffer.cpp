@@ -22,6 +22,7 @@ public:
 
     qint64 peek(char *data, qint64 maxSize) override;
     QByteArray peek(qint64 maxSize) override;
+    QByteArrayView peekChunk() override;
 
 #ifndef QT_NO_QOBJECT
     // private slots
@@ -59,6 +60,12 @@ QByteArray QBufferPrivate::peek(qint64 maxSize)
     return QByteArray(buf->constData() + pos, readBytes);
 }
 
+QByteArrayView QBufferPrivate::peekChunk()
+{
+    // the whole remaining byte array is one contiguous block
+    return QByteArrayView(*buf).sliced(qMin(pos, qint64(buf->size())));
+}
+
 /*!
     \class QBuffer
     \inmodule QtCore
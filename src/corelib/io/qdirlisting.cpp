@@ -113,6 +113,15 @@
         When combined with Recursive, symbolic links to directories will be
         iterated too. Symbolic link loops (e.g., link => . or link => ..) are
         automatically detected and ignored.
+
+    \value [since 6.9] PrefetchMetaData
+        Fetch the metadata (size, times, permissions and owner) of each
+        entry while the directory is being read, instead of on first use.
+        Use this when most entries' metadata is going to be queried anyway.
+        Symbolic links are not followed; the metadata of their targets is
+        still fetched on demand. This flag currently only has an effect on
+        Linux, where the entries are looked up relative to the open
+        directory.
 */
 
 #include "qdirlisting.h"
@@ -6,6 +6,10 @@
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
 
+#if QT_CONFIG(future)
+#  include <QtCore/qfuture.h>
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -338,6 +342,11 @@ void QFileDevice::close()
     // reset cached size
     d->cachedSize = 0;
 
+#if QT_CONFIG(future)
+    // pending asynchronous operations keep their own reference
+    d->asyncFileHandle.reset();
+#endif
+
     // keep earlier error from flush
     if (d->fileEngine->close() && flushed)
         unsetError();
@@ -574,6 +583,37 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \internal
+*/
+qint64 QFileDevicePrivate::writeGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QFileDevice);
+    const bool buffered = !(openMode & QIODevice::Unbuffered);
+
+    qint64 len = 0;
+    for (QByteArrayView block : data)
+        len += block.size();
+
+    // Small blocks are collected in the write buffer by writeData().
+    if (buffered && len <= writeBufferChunkSize)
+        return QIODevicePrivate::writeGathered(data);
+
+    q->unsetError();
+    lastWasWrite = true;
+    if (buffered && !writeBuffer.isEmpty() && !q->flush())
+        return -1;
+
+    const qint64 ret = fileEngine->writeGathered(data);
+    if (ret < 0) {
+        QFileDevice::FileError err = fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::WriteError;
+        setError(err, fileEngine->errorString());
+    }
+    return ret;
+}
+
 /*!
     Returns the file error status.
 
@@ -808,6 +848,123 @@ bool QFileDevice::setFileTime(const QDateTime &newDate, QFileDevice::FileTime fi
     return true;
 }
 
+#if QT_CONFIG(future)
+QAsyncFileIO::HandlePointer QFileDevicePrivate::asyncHandle(const char *function,
+                                                            QIODevice::OpenModeFlag access)
+{
+    Q_Q(QFileDevice);
+    if (!q->isOpen()) {
+        qWarning("QFileDevice::%s: IODevice is not open", function);
+        return {};
+    }
+    if (!(openMode & access)) {
+        qWarning("QFileDevice::%s: %s device", function,
+                 access == QIODevice::ReadOnly ? "WriteOnly" : "ReadOnly");
+        return {};
+    }
+    if (q->isSequential()) {
+        qWarning("QFileDevice::%s: Sequential device", function);
+        return {};
+    }
+    if (!asyncFileHandle) {
+        asyncFileHandle = QAsyncFileHandle::create(fileEngine->handle(), openMode);
+        if (!asyncFileHandle)
+            qWarning("QFileDevice::%s: No native file handle available", function);
+    }
+    // the operations go to the file directly
+    ensureFlushed();
+    return asyncFileHandle;
+}
+
+/*!
+    \since 6.9
+
+    Reads at most \a maxSize bytes from the file, starting at \a offset,
+    without blocking the calling thread. Returns a future that provides the
+    data once it has been read. The data is shorter than \a maxSize if the
+    end of the file was reached.
+
+    The read happens independently of pos() and of the buffers of this
+    device, and any number of reads and writes can be pending at the same
+    time. Data written with write() is flushed to the file before the read
+    is started. If an error occurs, the future provides an empty array.
+
+    The file can be closed while the read is pending; the operation keeps a
+    duplicate of the native file handle.
+
+    On Linux, the read is performed with io_uring if the kernel supports it.
+    Otherwise, it is performed by a pool of threads dedicated to file I/O. In
+    both cases, the future finishes in one of those internal threads, so use
+    QFuture::then() with a context object to continue in the thread of the
+    caller.
+
+    \note The file must be open for reading, and must not be sequential.
+
+    \note Include <QFuture> to use the returned future.
+
+    \sa writeAsync(), QFuture::then()
+*/
+QFuture<QByteArray> QFileDevice::readAsync(qint64 offset, qint64 maxSize)
+{
+    Q_D(QFileDevice);
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFileDevice::readAsync: Called with offset < 0 or maxSize < 0");
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    const QAsyncFileIO::HandlePointer file = d->asyncHandle("readAsync", ReadOnly);
+    QAsyncFileIO *io = QAsyncFileIO::instance();
+    if (!file || !io)
+        return QtFuture::makeReadyValueFuture(QByteArray());
+
+    // Don't allocate more than the file can provide. Files without a known
+    // size, or reporting 0 as some special files do, are read up to maxSize.
+    const qint64 fileSize = file->size();
+    if (fileSize > 0)
+        maxSize = qMin(maxSize, qMax(fileSize - offset, 0));
+    maxSize = qMin<qint64>(maxSize, QByteArray::max_size());
+    if (maxSize == 0)
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    return io->read(file, offset, maxSize);
+}
+
+/*!
+    \since 6.9
+
+    Writes \a data to the file at \a offset, without blocking the calling
+    thread. Returns a future that provides the number of bytes written once
+    the write has finished, or -1 if an error occurred.
+
+    The write happens independently of pos() and of the buffers of this
+    device. Data written with write() is flushed to the file before the
+    write is started, but data that this device buffered for reading before
+    the asynchronous write finished is not updated. Writes that are pending
+    at the same time may complete in any order.
+
+    \note The file must be open for writing, and must not be sequential. If
+    the file was opened with QIODevice::Append, some platforms write the data
+    at the end of the file regardless of \a offset.
+
+    \note Include <QFuture> to use the returned future.
+
+    \sa readAsync()
+*/
+QFuture<qint64> QFileDevice::writeAsync(qint64 offset, const QByteArray &data)
+{
+    Q_D(QFileDevice);
+    if (offset < 0) {
+        qWarning("QFileDevice::writeAsync: Called with offset < 0");
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+    const QAsyncFileIO::HandlePointer file = d->asyncHandle("writeAsync", WriteOnly);
+    QAsyncFileIO *io = QAsyncFileIO::instance();
+    if (!file || !io)
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    if (data.isEmpty())
+        return QtFuture::makeReadyValueFuture(qint64(0));
+    return io->write(file, offset, data);
+}
+#endif // QT_CONFIG(future)
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
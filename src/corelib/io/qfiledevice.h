@@ -11,6 +11,9 @@ QT_BEGIN_NAMESPACE
 
 class QDateTime;
 class QFileDevicePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 #if !defined(QT_USE_NODISCARD_FILE_OPEN) && !defined(QT_NO_USE_NODISCARD_FILE_OPEN)
 #  if QT_VERSION < QT_VERSION_CHECK(6, 10, 0)
@@ -110,6 +113,11 @@ public:
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
 protected:
     QFileDevice();
 #ifdef QT_NO_QOBJECT
@@ -18,6 +18,10 @@
 #include "private/qiodevice_p.h"
 #include "qfiledevice.h"
 
+#if QT_CONFIG(future)
+#  include "private/qasyncfileio_p.h"
+#endif
+
 #include <memory>
 #if defined(Q_OS_UNIX)
 #  include <sys/types.h> // for mode_t
@@ -50,13 +54,21 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    qint64 writeGathered(QSpan<const QByteArrayView> data) override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
     void setError(QFileDevice::FileError err, int errNum);
 
+#if QT_CONFIG(future)
+    QAsyncFileIO::HandlePointer asyncHandle(const char *function, QIODevice::OpenModeFlag access);
+#endif
+
     mutable std::unique_ptr<QAbstractFileEngine> fileEngine;
     mutable qint64 cachedSize;
+#if QT_CONFIG(future)
+    QAsyncFileIO::HandlePointer asyncFileHandle;
+#endif
 
     QFileDevice::FileHandleFlags handleFlags;
     QFileDevice::FileError error;
@@ -294,6 +294,11 @@ static int qt_fstatx(int fd, struct statx *statxBuffer)
     return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
 }
 
+static int qt_lstatxat(int dirfd, const char *name, struct statx *statxBuffer)
+{
+    return qt_real_statx(dirfd, name, AT_SYMLINK_NOFOLLOW, statxBuffer);
+}
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
 {
     // Permissions
@@ -355,6 +360,9 @@ static int qt_lstatx(const char *, struct statx *)
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_lstatxat(int, const char *, struct statx *)
+{ return -ENOSYS; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -577,6 +585,38 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 #endif
 }
 
+/*!
+    \internal
+
+    Fills \a data with the lstat(2) information of \a name, relative to the
+    directory \a dirfd, as QDirListing's PrefetchMetaData does while the
+    directory is being read. Resolving the name relative to the open directory
+    is cheaper than a lookup of the full path. For a symbolic link, only the
+    LinkType becomes known, and the target is stat()'ed later on demand.
+
+    Returns \c false, leaving \a data unchanged, if statx(2) is unavailable or
+    fails.
+*/
+bool QFileSystemEngine::fillMetaData(int dirfd, const char *name, QFileSystemMetaData &data)
+{
+    struct statx statxBuffer;
+    if (qt_lstatxat(dirfd, name, &statxBuffer) != 0)
+        return false;
+
+    data.knownFlagsMask |= QFileSystemMetaData::LinkType;
+    if (S_ISLNK(statxBuffer.stx_mode)) {
+        data.entryFlags |= QFileSystemMetaData::LinkType;
+        return true;
+    }
+
+    data.entryFlags &= ~(QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType);
+    data.fillFromStatxBuf(statxBuffer);
+    data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::ExistsAttribute;
+    data.entryFlags |= QFileSystemMetaData::ExistsAttribute;
+    return true;
+}
+
 //static
 QFileSystemEntry QFileSystemEngine::getLinkTarget(const QFileSystemEntry &link, QFileSystemMetaData &data)
 {
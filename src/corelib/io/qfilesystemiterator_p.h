@@ -29,6 +29,11 @@
 #include <private/qstringconverter_p.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+// read the entries with getdents64(2) instead of readdir()
+#  define QT_FILESYSTEMITERATOR_GETDENTS64
+#endif
+
 #include <memory>
 
 QT_BEGIN_NAMESPACE
@@ -54,6 +59,16 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(QT_FILESYSTEMITERATOR_GETDENTS64)
+    bool fillBuffer();
+
+    int dirFd = -1;
+    std::unique_ptr<char[]> buffer;
+    qsizetype bufferPos = 0;
+    qsizetype bufferEnd = 0;
+    bool prefetchMetaData = false;
+    int lastError = 0;
+    QStringDecoder toUtf16;
 #else
     struct DirStreamCloser {
         void operator()(QT_DIR *dir) { if (dir) QT_CLOSEDIR(dir); }
@@ -8,6 +8,15 @@
 
 #include <qvarlengtharray.h>
 
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+#include <private/qcore_unix_p.h>
+#include <private/qfilesystemengine_p.h>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <stddef.h>
+#endif
+
 #include <memory>
 
 #include <stdlib.h>
@@ -15,6 +24,69 @@
 
 QT_BEGIN_NAMESPACE
 
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+// The kernel's struct linux_dirent64, which is what glibc, bionic and musl
+// hand out as struct dirent64 from readdir64() too.
+using LinuxDirent64 = QT_DIRENT;
+static_assert(sizeof(LinuxDirent64::d_ino) == 8 && sizeof(LinuxDirent64::d_off) == 8);
+static_assert(offsetof(LinuxDirent64, d_reclen) == 16);
+static_assert(offsetof(LinuxDirent64, d_type) == 18);
+static_assert(offsetof(LinuxDirent64, d_name) == 19);
+
+// readdir() reads 32k at a time; ask for more so that big directories take
+// fewer system calls. The buffer is only allocated once there is an entry to read.
+static constexpr qsizetype GetdentsBufferSize = 128 * 1024;
+
+/*
+    Native filesystem iterator, which reads the entries of the directory
+    represented by \a entry in large batches with getdents64(2).
+*/
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry)
+    : dirPath(entry.filePath()),
+      toUtf16(QStringDecoder::Utf8)
+{
+    dirFd = qt_safe_open(entry.nativeFilePath().constData(), O_RDONLY | O_DIRECTORY);
+    if (dirFd == -1) {
+        lastError = errno;
+    } else {
+        if (!dirPath.endsWith(u'/'))
+            dirPath.append(u'/');
+    }
+}
+
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry,
+                                         QDirListing::IteratorFlags flags)
+    : QFileSystemIterator(entry)
+{
+    prefetchMetaData = flags.testAnyFlags(QDirListing::IteratorFlag::PrefetchMetaData);
+}
+
+QFileSystemIterator::~QFileSystemIterator()
+{
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+}
+
+bool QFileSystemIterator::fillBuffer()
+{
+    if (!buffer)
+        buffer.reset(new char[GetdentsBufferSize]);
+
+    qsizetype n;
+    QT_EINTR_LOOP(n, ::syscall(SYS_getdents64, dirFd, buffer.get(), GetdentsBufferSize));
+    if (n <= 0) {
+        // 0 is the end of the directory
+        lastError = n == 0 ? 0 : errno;
+        qt_safe_close(dirFd);
+        dirFd = -1;
+        buffer.reset();
+        return false;
+    }
+    bufferPos = 0;
+    bufferEnd = n;
+    return true;
+}
+#else
 /*
     Native filesystem iterator, which uses ::opendir()/readdir()/dirent from the system
     libraries to iterate over the directory represented by \a entry.
@@ -36,13 +108,14 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDirList
     : QFileSystemIterator(entry)
 {}
 
+QFileSystemIterator::~QFileSystemIterator() = default;
+#endif
+
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters)
     : QFileSystemIterator(entry)
 {
 }
 
-QFileSystemIterator::~QFileSystemIterator() = default;
-
 bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
 {
     auto asFileEntry = [this](QStringView name) {
@@ -53,6 +126,32 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
 #endif
         return QFileSystemEntry(dirPath + name, QFileSystemEntry::FromInternalPath());
     };
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+    while (dirFd != -1) {
+        if (bufferPos >= bufferEnd && !fillBuffer())
+            return false;
+
+        const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer.get() + bufferPos);
+        bufferPos += entry->d_reclen;
+
+        QByteArrayView name(entry->d_name, strlen(entry->d_name));
+        // name.size() is sufficient here, see QUtf8::convertToUnicode() for details
+        QVarLengthArray<char16_t> nameBuffer(name.size());
+        auto *end = toUtf16.appendToBuffer(nameBuffer.data(), name);
+        nameBuffer.resize(end - nameBuffer.constData());
+        if (toUtf16.hasError()) {
+            lastError = EILSEQ; // Invalid or incomplete multibyte or wide character
+            continue;
+        }
+
+        fileEntry = asFileEntry(nameBuffer);
+        metaData.fillFromDirEnt(*entry);
+        if (prefetchMetaData)
+            QFileSystemEngine::fillMetaData(dirFd, entry->d_name, metaData);
+        return true;
+    }
+    return false;
+#else
     if (!dir)
         return false;
 
@@ -90,6 +189,7 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
 
     lastError = errno;
     return false;
+#endif
 }
 
 QT_END_NAMESPACE
@@ -733,6 +733,22 @@ qint64 QFSFileEngine::write(const char *data, qint64 len)
     return d->nativeWrite(data, len);
 }
 
+/*!
+    \reimp
+*/
+qint64 QFSFileEngine::writeGathered(QSpan<const QByteArrayView> data)
+{
+    Q_D(QFSFileEngine);
+    d->metaData.clearFlags(QFileSystemMetaData::Times);
+
+    if (d->lastIOCommand != QFSFileEnginePrivate::IOWriteCommand) {
+        flush();
+        d->lastIOCommand = QFSFileEnginePrivate::IOWriteCommand;
+    }
+
+    return d->nativeWriteGathered(data);
+}
+
 /*!
     \internal
 */
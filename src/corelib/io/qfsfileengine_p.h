@@ -95,6 +95,7 @@ public:
     qint64 read(char *data, qint64 maxlen) override;
     qint64 readLine(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeGathered(QSpan<const QByteArrayView> data) override;
     bool cloneTo(QAbstractFileEngine *target) override;
 
     virtual bool isUnnamedFile() const
@@ -156,6 +157,7 @@ public:
     qint64 readLineFdFh(char *data, qint64 maxlen);
     qint64 nativeWrite(const char *data, qint64 len);
     qint64 writeFdFh(const char *data, qint64 len);
+    qint64 nativeWriteGathered(QSpan<const QByteArrayView> data);
     int nativeHandle() const;
     bool nativeIsSequential() const;
 #ifndef Q_OS_WIN
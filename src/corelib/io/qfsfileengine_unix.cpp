@@ -18,6 +18,7 @@
 #include "qvarlengtharray.h"
 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
@@ -246,6 +247,63 @@ qint64 QFSFileEnginePrivate::nativeWrite(const char *data, qint64 len)
     return writeFdFh(data, len);
 }
 
+/*!
+    \internal
+*/
+qint64 QFSFileEnginePrivate::nativeWriteGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QFSFileEngine);
+
+    // Buffered stdlib mode has no gathering write
+    if (fh || fd == -1)
+        return q->QAbstractFileEngine::writeGathered(data);
+
+#ifdef IOV_MAX
+    constexpr qsizetype MaxBlocks = IOV_MAX;
+#else
+    constexpr qsizetype MaxBlocks = _XOPEN_IOV_MAX;
+#endif
+
+    QVarLengthArray<iovec, 16> blocks;
+    for (QByteArrayView block : data) {
+        if (!block.isEmpty())
+            blocks.append({ const_cast<char *>(block.data()), size_t(block.size()) });
+    }
+
+    qint64 writtenBytes = 0;
+    iovec *next = blocks.data();
+    qsizetype remaining = blocks.size();
+    while (remaining) {
+        ssize_t result;
+        QT_EINTR_LOOP(result, ::writev(fd, next, int(qMin(remaining, MaxBlocks))));
+        if (result <= 0)
+            break;
+        writtenBytes += result;
+
+        // skip what was written, and continue in the middle of a block
+        while (remaining && size_t(result) >= next->iov_len) {
+            result -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining) {
+            next->iov_base = static_cast<char *>(next->iov_base) + result;
+            next->iov_len -= result;
+        }
+    }
+
+    if (!blocks.isEmpty() && writtenBytes == 0) {
+        writtenBytes = -1;
+        q->setError(errno == ENOSPC ? QFile::ResourceError : QFile::WriteError,
+                    QSystemError::stdString(errno));
+    } else {
+        // reset the cached size, if any
+        metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
+    }
+
+    return writtenBytes;
+}
+
 /*!
     \internal
 */
@@ -321,6 +321,17 @@ qint64 QFSFileEnginePrivate::nativeReadLine(char *data, qint64 maxlen)
     return q->QAbstractFileEngine::readLine(data, maxlen);
 }
 
+/*
+    \internal
+*/
+qint64 QFSFileEnginePrivate::nativeWriteGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QFSFileEngine);
+
+    // WriteFileGather() is restricted to page-aligned, unbuffered I/O
+    return q->QAbstractFileEngine::writeGathered(data);
+}
+
 /*
     \internal
 */
@@ -1222,6 +1222,11 @@ QByteArray QIODevice::read(qint64 maxSize)
     for reading, or that an error occurred. This function also has no
     way of indicating that more data may have been available and
     couldn't be read.
+
+    On sequential devices, the first block of buffered data is handed over
+    without being copied.
+
+    \sa peekChunk()
 */
 QByteArray QIODevice::readAll()
 {
@@ -1236,23 +1241,40 @@ QByteArray QIODevice::readAll()
 
     qint64 readBytes = (d->isSequential() ? Q_INT64_C(0) : size());
     if (readBytes == 0) {
-        // Size is unknown, read incrementally.
+        // Size is unknown, read incrementally. Take over the first buffered
+        // chunk instead of copying it.
+        bool readMore = true;
+        if (d->isSequential() && !d->transactionStarted && (d->openMode & Text) == 0) {
+            result = d->readChunk();
+            readBytes = result.size();
+            if (readBytes != 0 && d->buffer.isEmpty() && result.capacity() > readBytes) {
+                // Fill its spare room from the device, so that it is only
+                // reallocated if there is more data than that.
+                const qint64 spare = result.capacity() - readBytes;
+                result.resize(result.capacity());
+                const qint64 readResult = readData(result.data() + readBytes, spare);
+                if (readResult > 0)
+                    readBytes += readResult;
+                readMore = (readResult == spare);
+            }
+        }
+
         qint64 readChunkSize = qMax(qint64(d->buffer.chunkSize()),
                                     d->isSequential() ? (d->buffer.size() - d->transactionPos)
                                                       : d->buffer.size());
-        qint64 readResult;
-        do {
+        while (readMore) {
             if (readBytes + readChunkSize >= QByteArray::max_size()) {
                 // If resize would fail, don't read more, return what we have.
                 break;
             }
             result.resize(readBytes + readChunkSize);
-            readResult = d->read(result.data() + readBytes, readChunkSize);
+            const qint64 readResult = d->read(result.data() + readBytes, readChunkSize);
             if (readResult > 0 || readBytes == 0) {
                 readBytes += readResult;
                 readChunkSize = d->buffer.chunkSize();
             }
-        } while (readResult > 0);
+            readMore = (readResult > 0);
+        }
     } else {
         // Read it all in one go.
         readBytes -= d->pos;
@@ -1768,6 +1790,86 @@ void QIODevicePrivate::write(const char *data, qint64 size)
     }
 }
 
+/*!
+    \since 6.9
+    \overload
+
+    Writes the blocks of \a data to the device, in order, as if they had
+    been concatenated and written with a single call. Returns the number of
+    bytes that were actually written, or -1 if an error occurred before
+    anything was written.
+
+    This allows protocols to send a header and a payload that live in
+    different buffers without copying them together first. Devices that
+    support it, such as QAbstractSocket and QFile, hand all blocks to the
+    operating system at once (using \c writev() or \c sendmsg() on Unix);
+    other devices receive them through consecutive calls to writeData().
+    On a connected QUdpSocket, the blocks form a single datagram.
+
+    \sa write(), writeData()
+*/
+qint64 QIODevice::write(QSpan<const QByteArrayView> data)
+{
+    Q_D(QIODevice);
+    CHECK_WRITABLE(write, qint64(-1));
+
+#ifdef Q_OS_WIN
+    if (d->openMode & Text) {
+        // Line endings are expanded by write()
+        qint64 writtenSoFar = 0;
+        for (QByteArrayView block : data) {
+            if (block.isEmpty())
+                continue;
+            const qint64 ret = write(block.data(), block.size());
+            if (ret <= 0)
+                return writtenSoFar ? writtenSoFar : ret;
+            writtenSoFar += ret;
+            if (ret < block.size())
+                break;
+        }
+        return writtenSoFar;
+    }
+#endif
+
+    const bool sequential = d->isSequential();
+    // Make sure the device is positioned correctly.
+    if (d->pos != d->devicePos && !sequential && !seek(d->pos))
+        return qint64(-1);
+
+    const qint64 written = d->writeGathered(data);
+    if (!sequential && written > 0) {
+        d->pos += written;
+        d->devicePos += written;
+        d->buffer.skip(written);
+    }
+    return written;
+}
+
+/*!
+    \internal
+
+    Writes the blocks of \a data by calling writeData() for each of them,
+    until one is not written completely. Reimplemented by devices that can
+    hand all blocks to the system at once.
+*/
+qint64 QIODevicePrivate::writeGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QIODevice);
+
+    qint64 writtenSoFar = 0;
+    for (QByteArrayView block : data) {
+        if (block.isEmpty())
+            continue;
+        const qint64 written = q->writeData(block.data(), block.size());
+        if (written <= 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < block.size())
+            break;
+    }
+    return writtenSoFar;
+}
+
 /*!
     Puts the character \a c back into the device, and decrements the
     current position unless the position is 0. This function is
@@ -1845,6 +1947,45 @@ QByteArray QIODevicePrivate::peek(qint64 maxSize)
     return result;
 }
 
+/*!
+    \internal
+
+    Returns a view of the next contiguous block of buffered data, filling
+    the read buffer of a buffered device from readData() if it is empty.
+*/
+QByteArrayView QIODevicePrivate::peekChunk()
+{
+    Q_Q(QIODevice);
+
+    const bool sequential = isSequential();
+    if (isBufferEmpty() && readBufferChunkSize != 0 && (openMode & QIODevice::Unbuffered) == 0
+        && (sequential || pos == devicePos || q->seek(pos))) {
+        const qint64 bytesToBuffer = buffer.chunkSize();
+        const qint64 readFromDevice = q->readData(buffer.reserve(bytesToBuffer), bytesToBuffer);
+        buffer.chop(bytesToBuffer - qMax(Q_INT64_C(0), readFromDevice));
+        if (readFromDevice > 0 && !sequential)
+            devicePos += readFromDevice;
+    }
+
+    qint64 length = 0;
+    const char *data = buffer.readPointerAtPosition(
+            (sequential && transactionStarted) ? transactionPos : Q_INT64_C(0), length);
+    return QByteArrayView(data, length);
+}
+
+/*!
+    \internal
+
+    Takes the first chunk out of the read buffer of a sequential device
+    without copying it. Called by QIODevice::readAll() outside of
+    transactions and text mode only.
+*/
+QByteArray QIODevicePrivate::readChunk()
+{
+    Q_ASSERT(isSequential() && !transactionStarted);
+    return buffer.read();
+}
+
 /*! \fn bool QIODevice::getChar(char *c)
 
     Reads one character from the device and stores it in \a c. If \a c
@@ -1915,6 +2056,44 @@ QByteArray QIODevice::peek(qint64 maxSize)
     return d->peek(maxSize);
 }
 
+/*!
+    \since 6.9
+
+    Returns a view of the next contiguous block of data that is available
+    for reading, without copying it and without side effects. If the read
+    buffer of the device is empty, it is first refilled with a single call
+    to readData(), unless the device was opened in \l Unbuffered mode.
+
+    The view usually covers less than bytesAvailable(): the data of a
+    buffered device is kept in several chunks, and only the first of them
+    is returned. Call skip() to consume the data, after which peekChunk()
+    returns the next block. An empty view means that no data is currently
+    available, that the device is in \l Text mode, or that an error
+    occurred.
+
+    The view points into the internal buffer of the device and is only valid
+    until the next call to a non-const function of the device, or until
+    control returns to the event loop.
+
+    The following example consumes everything a socket has received,
+    without copying it into a QByteArray first:
+
+    \snippet code/src_corelib_io_qiodevice.cpp 6
+
+    \sa peek(), skip(), readAll()
+*/
+QByteArrayView QIODevice::peekChunk()
+{
+    Q_D(QIODevice);
+
+    CHECK_READABLE(peekChunk, QByteArrayView());
+
+    if (d->openMode & QIODevice::Text)
+        return QByteArrayView();
+
+    return d->peekChunk();
+}
+
 /*!
     \since 5.10
 
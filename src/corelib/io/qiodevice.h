@@ -12,6 +12,7 @@
 #include <QtCore/qobjectdefs.h>
 #include <QtCore/qscopedpointer.h>
 #endif
+#include <QtCore/qspan.h>
 #include <QtCore/qstring.h>
 
 #ifdef open
@@ -88,9 +89,11 @@ public:
     qint64 write(const char *data, qint64 len);
     qint64 write(const char *data);
     qint64 write(const QByteArray &data);
+    qint64 write(QSpan<const QByteArrayView> data);
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
+    QByteArrayView peekChunk();
     qint64 skip(qint64 maxSize);
 
     virtual bool waitForReadyRead(int msecs);
@@ -66,6 +66,7 @@ public:
         inline qint64 nextDataBlockSize() const { return (m_buf ? m_buf->nextDataBlockSize() : Q_INT64_C(0)); }
         inline const char *readPointer() const { return (m_buf ? m_buf->readPointer() : nullptr); }
         inline const char *readPointerAtPosition(qint64 pos, qint64 &length) const { Q_ASSERT(m_buf); return m_buf->readPointerAtPosition(pos, length); }
+        inline qsizetype dataBlocks(QSpan<QByteArrayView> blocks) const { return (m_buf ? m_buf->dataBlocks(blocks) : 0); }
         inline void free(qint64 bytes) { Q_ASSERT(m_buf); m_buf->free(bytes); }
         inline char *reserve(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserve(bytes); }
         inline char *reserveFront(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserveFront(bytes); }
@@ -148,8 +149,11 @@ public:
     qint64 readLine(char *data, qint64 maxSize);
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
+    virtual QByteArrayView peekChunk();
+    virtual QByteArray readChunk();
     qint64 skipByReading(qint64 maxSize);
     void write(const char *data, qint64 size);
+    virtual qint64 writeGathered(QSpan<const QByteArrayView> data);
 
     inline bool isWriteChunkCached(const char *data, qint64 size) const
     {
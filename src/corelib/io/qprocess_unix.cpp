@@ -52,6 +52,14 @@
 #include <forkfd.h>
 #endif
 
+// posix_spawn() is a system call on Darwin and it reports the failure to
+// execute the program, while the alternative there is a full fork()
+#if QT_CONFIG(process) && defined(Q_OS_DARWIN) && defined(FORKFD_HAVE_POSIX_SPAWN)
+#  define QPROCESS_USE_SPAWNFD
+#  include <crt_externs.h>
+#  include <spawn.h>
+#endif
+
 #ifndef O_PATH
 #  define O_PATH        0
 #endif
@@ -322,6 +330,16 @@ struct QChildProcess
 
     int startChild(pid_t *pid)
     {
+#ifdef QPROCESS_USE_SPAWNFD
+        // The child process modifier and the parameters need to run code in
+        // the child. If spawning fails, we retry with forkfd, which reports
+        // the reason through the childStartedPipe like it always did.
+        if (!d->unixExtras) {
+            int ffd = spawnChild(pid);
+            if (ffd != -1)
+                return ffd;
+        }
+#endif
         int ffdflags = FFD_CLOEXEC | (isUsingVfork ? 0 : FFD_USE_FORK);
         return ::vforkfd(ffdflags, pid, &QChildProcess::startProcess, this);
     }
@@ -333,6 +351,9 @@ private:
         static_cast<QChildProcess *>(self)->startProcess();
         Q_UNREACHABLE_RETURN(-1);
     }
+#ifdef QPROCESS_USE_SPAWNFD
+    int spawnChild(pid_t *pid) const noexcept;
+#endif
 
 #if defined(PTHREAD_CANCEL_DISABLE)
     int oldstate;
@@ -944,6 +965,62 @@ void QChildProcess::startProcess() const noexcept
     failChildProcess(d, "execve", errno);
 }
 
+#ifdef QPROCESS_USE_SPAWNFD
+// Does the same as startProcess() without forking: the successful execution
+// closes the childStartedPipe the same way, as it is close-on-exec.
+int QChildProcess::spawnChild(pid_t *pid) const noexcept
+{
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    if (posix_spawn_file_actions_init(&actions) != 0)
+        return -1;
+    if (posix_spawnattr_init(&attr) != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        return -1;
+    }
+
+    // same as commitChannels()
+    bool ok = true;
+    auto dup2 = [&](int fd, int target) {
+        ok = ok && posix_spawn_file_actions_adddup2(&actions, fd, target) == 0;
+    };
+    if (d->stdinChannel.pipe[0] != INVALID_Q_PIPE)
+        dup2(d->stdinChannel.pipe[0], STDIN_FILENO);
+    if (d->stdoutChannel.pipe[1] != INVALID_Q_PIPE)
+        dup2(d->stdoutChannel.pipe[1], STDOUT_FILENO);
+    if (d->stderrChannel.pipe[1] != INVALID_Q_PIPE)
+        dup2(d->stderrChannel.pipe[1], STDERR_FILENO);
+    else if (d->processChannelMode == QProcess::MergedChannels)
+        dup2(STDOUT_FILENO, STDERR_FILENO);
+
+    if (workingDirectory >= 0)
+        ok = ok && posix_spawn_file_actions_addfchdir_np(&actions, workingDirectory) == 0;
+
+    // reset the signal that we ignored
+    sigset_t sigdefault;
+    sigemptyset(&sigdefault);
+    sigaddset(&sigdefault, SIGPIPE);
+    ok = ok && posix_spawnattr_setsigdefault(&attr, &sigdefault) == 0;
+    short flags = POSIX_SPAWN_SETSIGDEF;
+    if (isUsingVfork) {
+        // restore the signal mask from the parent
+        ok = ok && posix_spawnattr_setsigmask(&attr, &oldsigset) == 0;
+        flags |= POSIX_SPAWN_SETSIGMASK;
+    }
+    ok = ok && posix_spawnattr_setflags(&attr, flags) == 0;
+
+    int ffd = -1;
+    if (ok) {
+        char **env = envp.pointers ? envp : *_NSGetEnviron();
+        ffd = ::spawnfd(FFD_CLOEXEC, pid, argv[0], &actions, &attr, argv, env);
+    }
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return ffd;
+}
+#endif // QPROCESS_USE_SPAWNFD
+
 bool QProcessPrivate::processStarted(QString *errorMessage)
 {
     Q_Q(QProcess);
@@ -5,6 +5,7 @@
 #include "qresource.h"
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
+#include "qresourceformat_p.h"
 #include "qset.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
@@ -15,6 +16,7 @@
 #include "qbytearray.h"
 #include "qstringlist.h"
 #include "qendian.h"
+#include "qthread.h"
 #include <qshareddata.h>
 #include <qplatformdefs.h>
 #include <qendian.h>
@@ -48,6 +50,10 @@
 #  include <qt_windows.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 //#define DEBUG_RESOURCE_MATCH
 
 QT_BEGIN_NAMESPACE
@@ -118,17 +124,30 @@ public:
 
 private:
     const uchar *tree, *names, *payloads;
+    const uchar *pathIndex = nullptr;
+    const uchar *dictionary = nullptr;
+#if QT_CONFIG(zstd)
+    mutable std::atomic<ZSTD_DDict *> zstdDDict = nullptr;
+#endif
     int version;
     inline int findOffset(int node) const { return node * (14 + (version >= 0x02 ? 8 : 0)); } //sizeof each tree element
     uint hash(int node) const;
     QString name(int node) const;
+    bool nameEquals(int node, QStringView segment) const;
     short flags(int node) const;
+    bool matchLocale(int node, const QLocale &locale, int *fallback) const;
+    int findIndexedNode(QStringView path, const QLocale &locale) const;
 public:
     mutable QAtomicInt ref;
 
     inline QResourceRoot(): tree(nullptr), names(nullptr), payloads(nullptr), version(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
-    virtual ~QResourceRoot() { }
+    virtual ~QResourceRoot()
+    {
+#if QT_CONFIG(zstd)
+        ZSTD_freeDDict(zstdDDict.load());
+#endif
+    }
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
     QResource::Compression compressionAlgo(int node)
@@ -141,6 +160,9 @@ public:
         return QResource::NoCompression;
     }
     const uchar *data(int node, qint64 *size) const;
+#if QT_CONFIG(zstd)
+    const ZSTD_DDict *zstdDictionary() const;
+#endif
     qint64 lastModified(int node) const;
     QStringList children(int node) const;
     virtual QString mappingRoot() const { return QString(); }
@@ -154,6 +176,16 @@ public:
 
 protected:
     inline void setSource(int v, const uchar *t, const uchar *n, const uchar *d) {
+        pathIndex = nullptr;
+        dictionary = nullptr;
+        if (v >= QtResourceFormat::HeaderVersion) {
+            if (const quint32 indexOffset = qFromBigEndian<quint32>(t))
+                pathIndex = t + indexOffset;
+            const quint32 dictionaryOffset = qFromBigEndian<quint32>(t + 4);
+            if (dictionaryOffset != QtResourceFormat::NoDictionary)
+                dictionary = d + dictionaryOffset;
+            t += QtResourceFormat::HeaderSize;
+        }
         tree = t;
         names = n;
         payloads = d;
@@ -170,16 +202,86 @@ static QString cleanPath(const QString &_path)
         path.remove(0, 1);
     return path;
 }
-} // unnamed namespace
 
-Q_DECLARE_TYPEINFO(QResourceRoot, Q_RELOCATABLE_TYPE);
+#if QT_CONFIG(zstd)
+// The seek table at the end of contents compressed with zstd in several
+// independent frames, see qresourceformat_p.h.
+class ZstdSeekTable
+{
+public:
+    ZstdSeekTable(const uchar *data, qint64 size)
+    {
+        using namespace QtResourceFormat;
+        if (size < SeekTableFrameHeaderSize + SeekTableFooterSize)
+            return;
+        const uchar *footer = data + size - SeekTableFooterSize;
+        if (qFromLittleEndian<quint32>(footer + 5) != SeekTableFooterMagic)
+            return;
+        const quint32 count = qFromLittleEndian<quint32>(footer);
+        const int entrySize = SeekTableEntrySize + (footer[4] & SeekTableChecksumFlag ? 4 : 0);
+        const qint64 frameSize = qint64(count) * entrySize + SeekTableFooterSize;
+        if (frameSize + SeekTableFrameHeaderSize > size)
+            return;
+        const uchar *frame = footer + SeekTableFooterSize - frameSize - SeekTableFrameHeaderSize;
+        if (qFromLittleEndian<quint32>(frame) != SeekTableSkippableMagic
+            || qFromLittleEndian<quint32>(frame + 4) != frameSize) {
+            return;
+        }
+        entries = frame + SeekTableFrameHeaderSize;
+        frameCount = count;
+        stride = entrySize;
+    }
+
+    bool isValid() const { return entries; }
+    quint32 count() const { return frameCount; }
+    quint32 compressedSize(quint32 frame) const
+    { return qFromLittleEndian<quint32>(entries + frame * stride); }
+    quint32 uncompressedSize(quint32 frame) const
+    { return qFromLittleEndian<quint32>(entries + frame * stride + 4); }
+
+    qint64 totalUncompressedSize() const
+    {
+        qint64 total = 0;
+        for (quint32 i = 0; i < frameCount; ++i)
+            total += uncompressedSize(i);
+        return total;
+    }
+
+private:
+    const uchar *entries = nullptr;
+    quint32 frameCount = 0;
+    int stride = 0;
+};
+
+static ZSTD_DCtx *zstdDecompressionContext()
+{
+    // reused, as creating one allocates more than 100 kB
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>
+            context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+    return context.get();
+}
+#endif
+} // unnamed namespace
 
 typedef QList<QResourceRoot*> ResourceList;
 namespace {
+/*
+    Looking up resources doesn't lock the mutex: readers work on an immutable
+    snapshot of the list of roots, which writers replace while holding the
+    mutex. Before a writer may delete the old snapshot or a root that it no
+    longer contains, it waits until the readers that may still use them are
+    done. Readers announce themselves in one of two counters, chosen by the
+    parity of the epoch; the writer flips the epoch and waits for the counter
+    of the old one to drain, twice, so that new readers can't keep it waiting.
+*/
 struct QResourceGlobalData
 {
+    ~QResourceGlobalData() { delete resourceList.load(); }
+
     QRecursiveMutex resourceMutex;
-    ResourceList resourceList;
+    std::atomic<const ResourceList *> resourceList = new ResourceList;
+    std::atomic<uint> epoch = 0;
+    std::atomic<int> readers[2] = {};
 };
 }
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
@@ -187,8 +289,46 @@ Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 static inline QRecursiveMutex &resourceMutex()
 { return resourceGlobalData->resourceMutex; }
 
-static inline ResourceList *resourceList()
-{ return &resourceGlobalData->resourceList; }
+namespace {
+class ResourceListReader
+{
+    Q_DISABLE_COPY_MOVE(ResourceListReader)
+public:
+    ResourceListReader()
+    {
+        QResourceGlobalData *data = resourceGlobalData();
+        readers = &data->readers[data->epoch.load() & 1];
+        readers->fetch_add(1);
+        list = data->resourceList.load();
+    }
+    ~ResourceListReader() { readers->fetch_sub(1); }
+
+    const ResourceList *operator->() const { return list; }
+
+private:
+    std::atomic<int> *readers;
+    const ResourceList *list;
+};
+}
+
+// Must be called with the resource mutex locked. The returned copy of the
+// list is published with publishResourceList().
+static inline ResourceList *copyResourceList()
+{ return new ResourceList(*resourceGlobalData->resourceList.load()); }
+
+// Must be called with the resource mutex locked. When this returns, no
+// reader uses the previous list or the roots that were removed from it anymore.
+static void publishResourceList(ResourceList *list)
+{
+    QResourceGlobalData *data = resourceGlobalData();
+    const ResourceList *previous = data->resourceList.exchange(list);
+    for (int i = 0; i < 2; ++i) {
+        std::atomic<int> &readers = data->readers[data->epoch.fetch_add(1) & 1];
+        while (readers.load() != 0)
+            QThread::yieldCurrentThread();
+    }
+    delete previous;
+}
 
 /*!
     \class QResource
@@ -293,7 +433,13 @@ public:
     bool load(const QString &file);
     void clear();
 
+#if QT_CONFIG(zstd)
+    qsizetype decompressZstd(char *buffer, qsizetype bufferSize,
+                             const uchar *source, qsizetype sourceSize) const;
+#endif
+
     static bool mayRemapData(const QResource &resource);
+    static const QResourcePrivate *get(const QResource &resource) { return resource.d_func(); }
 
     QLocale locale;
     QString fileName, absoluteFilePath;
@@ -330,8 +476,7 @@ void QResourcePrivate::clear()
 bool QResourcePrivate::load(const QString &file)
 {
     related.clear();
-    const auto locker = qt_scoped_lock(resourceMutex());
-    const ResourceList *list = resourceList();
+    const ResourceListReader list;
     QString cleaned = cleanPath(file);
     for (int i = 0; i < list->size(); ++i) {
         QResourceRoot *res = list->at(i);
@@ -440,6 +585,8 @@ qint64 QResourcePrivate::uncompressedSize() const
 
     case QResource::ZstdCompression: {
 #if QT_CONFIG(zstd)
+        if (const ZstdSeekTable seekTable(data, size); seekTable.isValid())
+            return seekTable.totalUncompressedSize();
         size_t n = ZSTD_getFrameContentSize(data, size);
         return ZSTD_isError(n) ? -1 : qint64(n);
 #else
@@ -482,12 +629,7 @@ qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
 
     case QResource::ZstdCompression: {
 #if QT_CONFIG(zstd)
-        size_t usize = ZSTD_decompress(buffer, bufferSize, data, size);
-        if (ZSTD_isError(usize)) {
-            qWarning("QResource: error decompressing zstd content: %s", ZSTD_getErrorName(usize));
-            return -1;
-        }
-        return usize;
+        return decompressZstd(buffer, bufferSize, data, size);
 #else
         Q_UNREACHABLE();
 #endif
@@ -497,6 +639,26 @@ qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
     return -1;
 }
 
+#if QT_CONFIG(zstd)
+// Decompresses one or more frames, which may need the dictionary of the root.
+qsizetype QResourcePrivate::decompressZstd(char *buffer, qsizetype bufferSize,
+                                           const uchar *source, qsizetype sourceSize) const
+{
+    ZSTD_DCtx *context = zstdDecompressionContext();
+    const ZSTD_DDict *dictionary = nullptr;
+    if (ZSTD_getDictID_fromFrame(source, sourceSize) != 0 && !related.isEmpty())
+        dictionary = related.first()->zstdDictionary();
+    size_t usize = dictionary
+            ? ZSTD_decompress_usingDDict(context, buffer, bufferSize, source, sourceSize, dictionary)
+            : ZSTD_decompressDCtx(context, buffer, bufferSize, source, sourceSize);
+    if (ZSTD_isError(usize)) {
+        qWarning("QResource: error decompressing zstd content: %s", ZSTD_getErrorName(usize));
+        return -1;
+    }
+    return usize;
+}
+#endif
+
 /*!
     Constructs a QResource pointing to \a file. \a locale is used to
     load a specific localization of a resource data.
@@ -620,7 +782,11 @@ bool QResource::isValid() const
 
     If this function returns QResource::ZstdCompression, you need to use the
     Zstandard library functions (\c{<zstd.h>} header). Qt does not provide a
-    wrapper.
+    wrapper. The data may consist of several frames, followed by a seek table
+    in a skippable frame, which \c{ZSTD_decompress} handles. Since Qt 6.9,
+    the data may also require a dictionary that the RCC tool stored in the
+    resource, in which case only uncompressedData() and QFile can decompress
+    it.
 
     See \l{http://facebook.github.io/zstd/zstd_manual.html}{Zstandard manual}.
 
@@ -786,6 +952,109 @@ inline QString QResourceRoot::name(int node) const
     return ret;
 }
 
+inline bool QResourceRoot::nameEquals(int node, QStringView segment) const
+{
+    if (!node) // root
+        return segment.isEmpty();
+    const int offset = findOffset(node);
+
+    qint32 name_offset = qFromBigEndian<qint32>(tree + offset);
+    const quint16 name_length = qFromBigEndian<qint16>(names + name_offset);
+    if (name_length != segment.size())
+        return false;
+    name_offset += 2;
+    name_offset += 4; // jump past hash
+
+    const uchar *data = names + name_offset;
+    for (qsizetype i = 0; i < name_length; ++i) {
+        if (qFromBigEndian<char16_t>(data + 2 * i) != segment[i].unicode())
+            return false;
+    }
+    return true;
+}
+
+// Checks a node matching the last segment of a path against the locale.
+// Returns true if it is the node to use, otherwise stores it in \a fallback
+// if it can be used when none of its siblings matches better.
+inline bool QResourceRoot::matchLocale(int node, const QLocale &locale, int *fallback) const
+{
+    int offset = findOffset(node);
+    offset += 4; // jump past name
+
+    const qint16 flags = qFromBigEndian<qint16>(tree + offset);
+    offset += 2;
+    if (flags & Directory)
+        return true;
+
+    const qint16 territory = qFromBigEndian<qint16>(tree + offset);
+    offset += 2;
+
+    const qint16 language = qFromBigEndian<qint16>(tree + offset);
+    offset += 2;
+#ifdef DEBUG_RESOURCE_MATCH
+    qDebug() << "    " << "LOCALE" << territory << language;
+#endif
+    if (territory == locale.territory() && language == locale.language())
+        return true;
+    if ((territory == QLocale::AnyTerritory && language == locale.language())
+        || (territory == QLocale::AnyTerritory && language == QLocale::C && *fallback == -1)) {
+        *fallback = node;
+    }
+    return false;
+}
+
+// Looks up a path, relative to the root and without empty segments, in the
+// path index that rcc generates for format version 4.
+int QResourceRoot::findIndexedNode(QStringView path, const QLocale &locale) const
+{
+    using QtResourceFormat::pathHash;
+    const quint32 bucketCount = qFromBigEndian<quint32>(pathIndex);
+    const quint32 slotCount = qFromBigEndian<quint32>(pathIndex + 4);
+    const quint32 nodeCount = qFromBigEndian<quint32>(pathIndex + 8);
+    const uchar *displacements = pathIndex + 12;
+    const uchar *slotNodes = displacements + 4 * qsizetype(bucketCount);
+    const uchar *parents = slotNodes + 4 * qsizetype(slotCount);
+    if (!bucketCount || !slotCount)
+        return -1;
+    auto parent = [parents](quint32 node) { return qFromBigEndian<quint32>(parents + 4 * node); };
+
+    const quint32 bucket = pathHash(path, 0) % bucketCount;
+    const qint32 displacement = qFromBigEndian<qint32>(displacements + 4 * bucket);
+    const quint32 slot = displacement < 0 ? quint32(-(displacement + 1))
+                                          : pathHash(path, quint32(displacement)) % slotCount;
+    if (slot >= slotCount)
+        return -1;
+    quint32 node = qFromBigEndian<quint32>(slotNodes + 4 * slot);
+    if (!node || node >= nodeCount)
+        return -1;
+
+    // any path maps to some node, so verify the directories leading to it
+    qsizetype end = path.lastIndexOf(u'/');
+    const QStringView fileName = path.sliced(end + 1);
+    const quint32 directory = parent(node);
+    quint32 ancestor = directory;
+    while (end >= 0) {
+        if (!ancestor || ancestor >= nodeCount)
+            return -1;
+        const qsizetype start = end ? path.lastIndexOf(u'/', end - 1) + 1 : 0;
+        if (!nameEquals(ancestor, path.sliced(start, end - start)))
+            return -1;
+        ancestor = parent(ancestor);
+        end = start - 1;
+    }
+    if (ancestor)
+        return -1;
+
+    // then compare the names of the siblings with the same hash, as findNode() does
+    const uint h = qt_hash(fileName);
+    int fallback = -1;
+    for (; node < nodeCount && parent(node) == directory && hash(node) == h; ++node) {
+        if (nameEquals(node, fileName) && matchLocale(node, locale, &fallback))
+            return node;
+    }
+    return fallback;
+}
+
 int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
 {
     QString path = _path;
@@ -811,6 +1080,16 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
     if (path == "/"_L1)
         return 0;
 
+    if (pathIndex) {
+        QStringView relativePath = path;
+        if (relativePath.startsWith(u'/'))
+            relativePath = relativePath.sliced(1);
+        if (!relativePath.isEmpty() && !relativePath.endsWith(u'/')
+            && !relativePath.contains("//"_L1)) {
+            return findIndexedNode(relativePath, locale);
+        }
+    }
+
     // the root node is always first
     qint32 child_count = qFromBigEndian<qint32>(tree + 6);
     qint32 child       = qFromBigEndian<qint32>(tree + 10);
@@ -852,7 +1131,7 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
                 --sub_node;
             for (; sub_node < child + child_count && hash(sub_node) == h;
                  ++sub_node) { // here we go...
-                if (name(sub_node) == segment) {
+                if (nameEquals(sub_node, segment)) {
                     found = true;
                     int offset = findOffset(sub_node);
 #ifdef DEBUG_RESOURCE_MATCH
@@ -864,35 +1143,12 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
                     offset += 2;
 
                     if (!splitter.hasNext()) {
-                        if (!(flags & Directory)) {
-                            const qint16 territory = qFromBigEndian<qint16>(tree + offset);
-                            offset += 2;
-
-                            const qint16 language = qFromBigEndian<qint16>(tree + offset);
-                            offset += 2;
-#ifdef DEBUG_RESOURCE_MATCH
-                            qDebug() << "    " << "LOCALE" << country << language;
-#endif
-                            if (territory == locale.territory() && language == locale.language()) {
-#ifdef DEBUG_RESOURCE_MATCH
-                                qDebug() << "!!!!" << "FINISHED" << __LINE__ << sub_node;
-#endif
-                                return sub_node;
-                            } else if ((territory == QLocale::AnyTerritory
-                                        && language == locale.language())
-                                       || (territory == QLocale::AnyTerritory
-                                           && language == QLocale::C
-                                           && node == -1)) {
-                                node = sub_node;
-                            }
+                        if (!matchLocale(sub_node, locale, &node))
                             continue;
-                        } else {
 #ifdef DEBUG_RESOURCE_MATCH
-                            qDebug() << "!!!!" << "FINISHED" << __LINE__ << sub_node;
+                        qDebug() << "!!!!" << "FINISHED" << __LINE__ << sub_node;
 #endif
-
-                            return sub_node;
-                        }
+                        return sub_node;
                     }
 
                     if (!(flags & Directory))
@@ -944,6 +1200,27 @@ const uchar *QResourceRoot::data(int node, qint64 *size) const
     return nullptr;
 }
 
+#if QT_CONFIG(zstd)
+const ZSTD_DDict *QResourceRoot::zstdDictionary() const
+{
+    if (!dictionary)
+        return nullptr;
+    if (ZSTD_DDict *ddict = zstdDDict.load(std::memory_order_acquire))
+        return ddict;
+
+    // created on first use, as it costs about as much as decompressing a
+    // small file
+    const quint32 size = qFromBigEndian<quint32>(dictionary);
+    ZSTD_DDict *ddict = ZSTD_createDDict(dictionary + 4, size);
+    ZSTD_DDict *expected = nullptr;
+    if (!zstdDDict.compare_exchange_strong(expected, ddict, std::memory_order_acq_rel)) {
+        ZSTD_freeDDict(ddict);
+        return expected;
+    }
+    return ddict;
+}
+#endif
+
 qint64 QResourceRoot::lastModified(int node) const
 {
     if (node == -1 || version < 0x02)
@@ -1003,10 +1280,10 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
     if (resourceGlobalData.isDestroyed())
         return false;
     const auto locker = qt_scoped_lock(resourceMutex());
-    ResourceList *list = resourceList();
-    if (version >= 0x01 && version <= 0x3) {
+    if (version >= 0x01 && version <= QtResourceFormat::MaxVersion) {
         bool found = false;
         QResourceRoot res(version, tree, name, data);
+        const ResourceList *list = resourceGlobalData->resourceList.load();
         for (int i = 0; i < list->size(); ++i) {
             if (*list->at(i) == res) {
                 found = true;
@@ -1016,7 +1293,9 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
         if (!found) {
             QResourceRoot *root = new QResourceRoot(version, tree, name, data);
             root->ref.ref();
-            list->append(root);
+            ResourceList *newList = copyResourceList();
+            newList->append(root);
+            publishResourceList(newList);
         }
         return true;
     }
@@ -1030,17 +1309,23 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         return false;
 
     const auto locker = qt_scoped_lock(resourceMutex());
-    if (version >= 0x01 && version <= 0x3) {
+    if (version >= 0x01 && version <= QtResourceFormat::MaxVersion) {
         QResourceRoot res(version, tree, name, data);
-        ResourceList *list = resourceList();
-        for (int i = 0; i < list->size();) {
-            if (*list->at(i) == res) {
-                QResourceRoot *root = list->takeAt(i);
-                if (!root->ref.deref())
-                    delete root;
-            } else {
-                ++i;
-            }
+        ResourceList *list = copyResourceList();
+        const auto removed = std::stable_partition(list->begin(), list->end(),
+                                                   [&res](QResourceRoot *root) {
+            return *root != res;
+        });
+        const ResourceList unregistered(removed, list->end());
+        list->erase(removed, list->end());
+        if (unregistered.isEmpty()) {
+            delete list;
+            return true;
+        }
+        publishResourceList(list);
+        for (QResourceRoot *root : unregistered) {
+            if (!root->ref.deref())
+                delete root;
         }
         return true;
     }
@@ -1110,7 +1395,7 @@ public:
         if (file_flags & ~acceptableFlags)
             return false;
 
-        if (version >= 0x01 && version <= 0x03) {
+        if (version >= 0x01 && version <= QtResourceFormat::MaxVersion) {
             buffer = b;
             setSource(version, b + tree_offset, b + name_offset, b + data_offset);
             return true;
@@ -1266,7 +1551,9 @@ bool QResource::registerResource(const QString &rccFilename, const QString &reso
     if (root->registerSelf(rccFilename)) {
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
-        resourceList()->append(root);
+        ResourceList *list = copyResourceList();
+        list->append(root);
+        publishResourceList(list);
         return true;
     }
     delete root;
@@ -1289,13 +1576,15 @@ bool QResource::unregisterResource(const QString &rccFilename, const QString &re
     QString r = qt_resource_fixResourceRoot(resourceRoot);
 
     const auto locker = qt_scoped_lock(resourceMutex());
-    ResourceList *list = resourceList();
+    const ResourceList *list = resourceGlobalData->resourceList.load();
     for (int i = 0; i < list->size(); ++i) {
         QResourceRoot *res = list->at(i);
         if (res->type() == QResourceRoot::Resource_File) {
             QDynamicFileResourceRoot *root = reinterpret_cast<QDynamicFileResourceRoot *>(res);
             if (root->mappingFile() == rccFilename && root->mappingRoot() == r) {
-                list->removeAt(i);
+                ResourceList *newList = copyResourceList();
+                newList->removeAt(i);
+                publishResourceList(newList);
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1335,7 +1624,9 @@ bool QResource::registerResource(const uchar *rccData, const QString &resourceRo
     if (root->registerSelf(rccData, -1)) {
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
-        resourceList()->append(root);
+        ResourceList *list = copyResourceList();
+        list->append(root);
+        publishResourceList(list);
         return true;
     }
     delete root;
@@ -1358,13 +1649,15 @@ bool QResource::unregisterResource(const uchar *rccData, const QString &resource
     QString r = qt_resource_fixResourceRoot(resourceRoot);
 
     const auto locker = qt_scoped_lock(resourceMutex());
-    ResourceList *list = resourceList();
+    const ResourceList *list = resourceGlobalData->resourceList.load();
     for (int i = 0; i < list->size(); ++i) {
         QResourceRoot *res = list->at(i);
         if (res->type() == QResourceRoot::Resource_Buffer) {
             QDynamicBufferResourceRoot *root = reinterpret_cast<QDynamicBufferResourceRoot *>(res);
             if (root->mappingBuffer() == rccData && root->mappingRoot() == r) {
-                list->removeAt(i);
+                ResourceList *newList = copyResourceList();
+                newList->removeAt(i);
+                publishResourceList(newList);
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1389,11 +1682,28 @@ private:
     void mapUncompressed();
     bool mapUncompressed_sys();
     void unmapUncompressed_sys();
+#if QT_CONFIG(zstd)
+    bool setupFrames();
+    qint64 readFrames(char *data, qint64 len);
+#endif
     qint64 offset = 0;
     QResource resource;
     mutable QByteArray uncompressed;
     bool mustUnmap = false;
 
+#if QT_CONFIG(zstd)
+    // Contents compressed with zstd in independent frames are decompressed
+    // one frame at a time, as they are read. The offsets of the frames are
+    // followed by the total sizes.
+    struct FrameOffset {
+        qint64 compressed;
+        qint64 uncompressed;
+    };
+    QList<FrameOffset> frames;
+    qsizetype currentFrame = -1;
+    QByteArray frameData;
+#endif
+
     // minimum size for which we'll try to re-open ourselves in mapUncompressed()
     static constexpr qsizetype RemapCompressedThreshold = 16384;
 protected:
@@ -1441,7 +1751,12 @@ bool QResourceFileEngine::open(QIODevice::OpenMode flags,
     }
     if (flags & QIODevice::WriteOnly)
         return false;
-    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+    bool decompressAll = d->resource.compressionAlgorithm() != QResource::NoCompression;
+#if QT_CONFIG(zstd)
+    if (decompressAll && d->setupFrames())
+        decompressAll = false;  // decompressed as it is read
+#endif
+    if (decompressAll) {
         d->uncompress();
         if (d->uncompressed.isNull()) {
             d->errorString = QSystemError::stdString(EIO);
@@ -1474,6 +1789,10 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
         len = size() - d->offset;
     if (len <= 0)
         return 0;
+#if QT_CONFIG(zstd)
+    if (!d->frames.isEmpty() && d->uncompressed.isNull())
+        return d->readFrames(data, len);
+#endif
     if (!d->uncompressed.isNull())
         memcpy(data, d->uncompressed.constData() + d->offset, len);
     else
@@ -1485,6 +1804,10 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
 qint64 QResourceFileEngine::size() const
 {
     Q_D(const QResourceFileEngine);
+#if QT_CONFIG(zstd)
+    if (!d->frames.isEmpty())
+        return d->frames.constLast().uncompressed;
+#endif
     return d->resource.isValid() ? d->resource.uncompressedSize() : 0;
 }
 
@@ -1623,6 +1946,15 @@ bool QResourceFileEngine::supportsExtension(Extension extension) const
 uchar *QResourceFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
 {
     Q_Q(QResourceFileEngine);
+#if QT_CONFIG(zstd)
+    if (!frames.isEmpty()) {
+        uncompress();   // open() deferred it
+        if (uncompressed.isNull()) {
+            q->setError(QFile::UnspecifiedError, QString());
+            return nullptr;
+        }
+    }
+#endif
     Q_ASSERT_X(resource.compressionAlgorithm() == QResource::NoCompression
                || !uncompressed.isNull(), "QFile::map()",
                "open() should have uncompressed compressed resources");
@@ -1664,6 +1996,70 @@ void QResourceFileEnginePrivate::uncompress() const
     uncompressed = resource.uncompressedData();
 }
 
+#if QT_CONFIG(zstd)
+// Returns true if the resource is compressed with zstd in independent frames,
+// which can be decompressed as they are read.
+bool QResourceFileEnginePrivate::setupFrames()
+{
+    if (!frames.isEmpty())
+        return true;
+    if (resource.compressionAlgorithm() != QResource::ZstdCompression)
+        return false;
+    const ZstdSeekTable seekTable(resource.data(), resource.size());
+    if (!seekTable.isValid() || seekTable.count() < 2)
+        return false;
+
+    QList<FrameOffset> offsets;
+    offsets.reserve(seekTable.count() + 1);
+    FrameOffset frame = {};
+    for (quint32 i = 0; i < seekTable.count(); ++i) {
+        offsets.append(frame);
+        frame.compressed += seekTable.compressedSize(i);
+        frame.uncompressed += seekTable.uncompressedSize(i);
+    }
+    if (frame.compressed > resource.size())
+        return false;
+    offsets.append(frame);
+    frames = std::move(offsets);
+    return true;
+}
+
+qint64 QResourceFileEnginePrivate::readFrames(char *data, qint64 len)
+{
+    const auto *d = QResourcePrivate::get(resource);
+    qint64 done = 0;
+    while (done < len) {
+        // the last element holds the total sizes, so there is always a next one
+        const auto next = std::upper_bound(frames.cbegin(), frames.cend() - 1, offset,
+                                           [](qint64 pos, const FrameOffset &frame) {
+            return pos < frame.uncompressed;
+        });
+        const qsizetype frame = next - frames.cbegin() - 1;
+        const qint64 frameSize = next->uncompressed - frames.at(frame).uncompressed;
+        if (frame != currentFrame) {
+            currentFrame = -1;
+            frameData.resize(frameSize);
+            const qsizetype n = d->decompressZstd(frameData.data(), frameData.size(),
+                                                  d->data + frames.at(frame).compressed,
+                                                  next->compressed - frames.at(frame).compressed);
+            if (n != frameSize) {
+                frameData.clear();
+                break;
+            }
+            currentFrame = frame;
+        }
+        const qint64 start = offset - frames.at(frame).uncompressed;
+        const qint64 n = qMin(len - done, frameSize - start);
+        memcpy(data + done, frameData.constData() + start, n);
+        done += n;
+        offset += n;
+    }
+    if (!done && len)
+        return -1;
+    return done;
+}
+#endif
+
 void QResourceFileEnginePrivate::mapUncompressed()
 {
     Q_ASSERT(resource.compressionAlgorithm() == QResource::NoCompression);
@@ -0,0 +1,99 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QRESOURCEFORMAT_P_H
+#define QRESOURCEFORMAT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Shared between rcc and QResource.
+
+    Starting with format version 4, the tree blob starts with a header of two
+    big-endian 32-bit numbers, which the nodes follow:
+
+        the offset of the path index, relative to the start of the blob, or 0
+        the offset of the zstd dictionary in the payloads, or NoDictionary
+
+    The dictionary is stored like the contents of a file. The frames of the
+    files compressed with zstd that were compressed with it carry its ID.
+
+    The path index is a minimal perfect hash table over the paths of all the
+    nodes except the root, without leading slash. All numbers are big-endian
+    32-bit values:
+
+        bucket count B
+        slot count N
+        node count
+        B displacements (signed)
+        N node numbers, one per slot
+        the number of the parent of each node, 0 for the root
+
+    A path lands in the bucket pathHash(path, 0) % B. A negative displacement
+    d puts its paths in slot -d - 1, any other one in slot
+    pathHash(path, d) % N. The slot holds the first sibling whose name has the
+    hash of the last segment of the path, as used by the binary search over
+    the children of a directory. Paths that are not in the resource also land
+    somewhere, so a lookup needs to verify the names of the node and its
+    parents.
+
+    Independently of the format version, rcc can split big files compressed
+    with zstd into frames that are compressed independently, followed by a
+    skippable frame holding a seek table, as defined by the seekable format
+    of zstd (contrib/seekable_format). Decompressors that don't know about the
+    seek table still decompress all the frames, while QResource uses it to
+    decompress only the frames covering the part of the file that is read.
+*/
+namespace QtResourceFormat {
+
+constexpr int MaxVersion = 4;
+constexpr int HeaderVersion = 4;
+constexpr int HeaderSize = 8;
+constexpr quint32 NoDictionary = 0xffffffffu;
+
+inline quint32 pathHash(QStringView path, quint32 seed) noexcept
+{
+    // FNV-1a over the UTF-16 code units, with the murmur3 finalizer
+    quint32 h = 2166136261u ^ seed;
+    for (QChar c : path) {
+        h ^= c.unicode();
+        h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// The numbers of the seek table are little-endian 32-bit values: the skippable
+// frame header (magic and size), the compressed and decompressed size of each
+// frame, followed by the footer (the number of frames, a descriptor byte and
+// the magic).
+constexpr quint32 SeekTableSkippableMagic = 0x184d2a5eu;
+constexpr quint32 SeekTableFooterMagic = 0x8f92eab1u;
+constexpr int SeekTableFrameHeaderSize = 8;
+constexpr int SeekTableEntrySize = 8;
+constexpr int SeekTableFooterSize = 9;
+constexpr quint8 SeekTableChecksumFlag = 0x80;
+
+} // namespace QtResourceFormat
+
+QT_END_NAMESPACE
+
+#endif // QRESOURCEFORMAT_P_H
@@ -30,6 +30,7 @@
 #ifndef QT_BOOTSTRAPPED
 #include "qsavefile.h"
 #include "qlockfile.h"
+#include "qrandom.h"
 #endif
 
 #ifdef Q_OS_VXWORKS
@@ -98,6 +99,20 @@ Q_GLOBAL_STATIC(ConfFileCache, unusedCacheFunc)
 Q_GLOBAL_STATIC(PathHash, pathHashFunc)
 Q_GLOBAL_STATIC(CustomFormatVector, customFormatVectorFunc)
 
+/*
+    With incremental sync, changes are appended to a log next to the INI file
+    instead of rewriting the file. The log starts with a header line holding
+    a random nonzero ID, which tells readers that it was replaced, followed
+    by transactions: lines setting ("+key=value") or removing ("-key") a key,
+    escaped like in the INI file, and a line holding a single dot. Readers
+    only apply complete transactions, so that they don't need the lock file.
+    Once the log has grown past the size of the file, it gets compacted
+    into the file and removed.
+*/
+static constexpr auto LogSuffix = ".log"_L1;
+static constexpr char LogMagic[] = "; QSettings log ";
+static constexpr qint64 LogCompactionThreshold = 64 * 1024;
+
 Q_CONSTINIT static QBasicMutex settingsGlobalMutex;
 
 Q_CONSTINIT static QSettings::Format globalDefaultFormat = QSettings::NativeFormat;
@@ -1337,15 +1352,23 @@ bool QConfFileSettingsPrivate::isWritable() const
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
+    // Without incremental sync, the log only matters when rewriting the file,
+    // which must include what was logged.
+    const bool withLog = supportsLog() && (incrementalSync || !readOnly);
 
     QFileInfo fileInfo(confFile->name);
+    QFileInfo logInfo;
+    if (withLog)
+        logInfo.setFile(confFile->name + LogSuffix);
     /*
         We can often optimize the read-only case, if the file on disk
         hasn't changed.
     */
-    if (readOnly && confFile->size > 0) {
-        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified(QTimeZone::UTC))
+    if (readOnly && (confFile->size > 0 || confFile->logSize > 0)) {
+        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified(QTimeZone::UTC)
+                && (!withLog || confFile->logSize == logInfo.size())) {
             return;
+        }
     }
 
     if (!readOnly && !confFile->isWritable()) {
@@ -1384,16 +1407,38 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     bool mustReadFile = true;
     bool createFile = !fileInfo.exists();
 
-    if (!readOnly)
+    if (!readOnly || confFile->logSize > 0)
         mustReadFile = (confFile->size != fileInfo.size()
                         || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified(QTimeZone::UTC)));
 
+    /*
+        Apply what was appended to the log since we last read it. The log is
+        read before the file, so that if the log gets compacted in between,
+        we only apply changes that the file already contains.
+    */
+    QByteArray transactions;
+    if (mustReadFile) {
+        confFile->logSize = 0;
+        confFile->logId = 0;
+    }
+    if (withLog) {
+        if (!readLog(confFile, &transactions)) {
+            // the log was compacted into the file since we last read it
+            confFile->logSize = 0;
+            confFile->logId = 0;
+            mustReadFile = true;
+            readLog(confFile, &transactions);
+        }
+    }
+
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
         confFile->originalKeys.clear();
 
         QFile file(confFile->name);
         if (!createFile && !file.open(QFile::ReadOnly)) {
+            confFile->logSize = 0;
+            confFile->logId = 0;
             setStatus(QSettings::AccessError);
             return;
         }
@@ -1442,11 +1487,19 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         confFile->timeStamp = fileInfo.lastModified(QTimeZone::UTC);
     }
 
+    if (!transactions.isEmpty())
+        applyLog(confFile, transactions);
+
     /*
         We also need to save the file. We still hold the file lock,
         so everything is under control.
     */
     if (!readOnly) {
+        if (incrementalSync && withLog && appendToLog(confFile)
+                && confFile->logSize < qMax(LogCompactionThreshold, confFile->size)) {
+            return;
+        }
+
         bool ok = false;
         ensureAllSectionsParsed(confFile);
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
@@ -1501,6 +1554,23 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
 
+            /*
+                The file now contains everything that was in the log, which
+                must not be replayed on top of it. If the log can't be
+                removed (e.g. on Windows while another process has it open),
+                truncate it: a log without a header holds no transactions.
+                A file we didn't recognize as a log is left alone.
+            */
+            if (withLog && confFile->logId != 0) {
+                if (!QFile::remove(logInfo.filePath()) && QFileInfo::exists(logInfo.filePath())) {
+                    QFile log(logInfo.filePath());
+                    if (!log.open(QFile::WriteOnly | QFile::Truncate))
+                        setStatus(QSettings::AccessError);
+                }
+                confFile->logSize = 0;
+                confFile->logId = 0;
+            }
+
             fileInfo.refresh();
             confFile->size = fileInfo.size();
             confFile->timeStamp = fileInfo.lastModified(QTimeZone::UTC);
@@ -1774,6 +1844,22 @@ Q_DECLARE_TYPEINFO(QSettingsIniSection, Q_RELOCATABLE_TYPE);
 
 typedef QMap<QString, QSettingsIniSection> IniMap;
 
+static void iniEscapedValue(const QVariant &value, QByteArray &result)
+{
+    /*
+        The size() != 1 trick is necessary because
+        QVariant(QString("foo")).toList() returns an empty
+        list, not a list containing "foo".
+    */
+    if (value.metaType().id() == QMetaType::QStringList
+            || (value.metaType().id() == QMetaType::QVariantList && value.toList().size() != 1)) {
+        QSettingsPrivate::iniEscapedStringList(
+                QSettingsPrivate::variantListToStringList(value.toList()), result);
+    } else {
+        QSettingsPrivate::iniEscapedString(QSettingsPrivate::variantToString(value), result);
+    }
+}
+
 /*
     This would be more straightforward if we didn't try to remember the original
     key order in the .ini file, but we do.
@@ -1842,20 +1928,7 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
             QByteArray block;
             iniEscapedKey(j.key(), block);
             block += '=';
-
-            const QVariant &value = j.value();
-
-            /*
-                The size() != 1 trick is necessary because
-                QVariant(QString("foo")).toList() returns an empty
-                list, not a list containing "foo".
-            */
-            if (value.metaType().id() == QMetaType::QStringList
-                    || (value.metaType().id() == QMetaType::QVariantList && value.toList().size() != 1)) {
-                iniEscapedStringList(variantListToStringList(value.toList()), block);
-            } else {
-                iniEscapedString(variantToString(value), block);
-            }
+            iniEscapedValue(j.value(), block);
             block += eol;
             if (device.write(block) == -1) {
                 writeError = true;
@@ -1866,6 +1939,169 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
     return !writeError;
 }
 
+// The log only holds INI-encoded values, so the formats that have their own
+// file format always rewrite the file.
+bool QConfFileSettingsPrivate::supportsLog() const
+{
+#ifdef Q_OS_DARWIN
+    if (format == QSettings::NativeFormat)
+        return false;
+#endif
+    return format <= QSettings::IniFormat;
+}
+
+/*
+    Reads the transactions that were appended to the log since the last call
+    into \a transactions. Returns \c false if the log was replaced since then,
+    in which case the file needs to be read again.
+*/
+bool QConfFileSettingsPrivate::readLog(QConfFile *confFile, QByteArray *transactions) const
+{
+    QFile log(confFile->name + LogSuffix);
+    if (!log.open(QFile::ReadOnly))
+        return confFile->logSize == 0;
+
+    const QByteArray header = log.readLine(sizeof(LogMagic) + 32);
+    quint64 id = 0;
+    if (header.startsWith(LogMagic) && header.endsWith('\n'))
+        id = QByteArrayView(header).sliced(sizeof(LogMagic) - 1).chopped(1).toULongLong(nullptr, 16);
+    if (id == 0) {
+        // not completely written yet, or not a log at all
+        return confFile->logSize == 0;
+    }
+    if (confFile->logSize != 0 && id != confFile->logId)
+        return false;
+
+    const qint64 start = confFile->logSize != 0 ? confFile->logSize : header.size();
+    if (log.size() < start || !log.seek(start))
+        return false;
+
+    // a writer may be appending right now
+    QByteArray data = log.readAll();
+    const qsizetype end = data.lastIndexOf("\n.\n");
+    data.truncate(end < 0 ? 0 : end + 3);
+
+    confFile->logId = id;
+    confFile->logSize = start + data.size();
+    *transactions = std::move(data);
+    return true;
+}
+
+void QConfFileSettingsPrivate::applyLog(QConfFile *confFile, QByteArrayView transactions)
+{
+    QStringList strListValue;
+    bool ok = true;
+    qsizetype pos = 0;
+    while (pos < transactions.size()) {
+        const qsizetype eol = transactions.indexOf('\n', pos);
+        Q_ASSERT(eol != -1); // readLog() only returns complete transactions
+        QByteArrayView line = transactions.sliced(pos, eol - pos);
+        pos = eol + 1;
+
+        if (line == ".")
+            continue;
+        const bool isRemoval = line.startsWith('-');
+        if (!isRemoval && !line.startsWith('+')) {
+            ok = false;
+            continue;
+        }
+
+        QByteArrayView key = line.sliced(1);
+        QByteArrayView value;
+        if (!isRemoval) {
+            const qsizetype equalsPos = key.indexOf('=');
+            if (equalsPos == -1) {
+                ok = false;
+                continue;
+            }
+            value = key.sliced(equalsPos + 1);
+            key.truncate(equalsPos);
+        }
+
+        QString strKey;
+        iniUnescapedKey(key, strKey);
+        QSettingsKey theKey(strKey, caseSensitivity, nextPosition++);
+        ensureSectionParsed(confFile, theKey);
+        if (isRemoval) {
+            confFile->originalKeys.remove(theKey);
+            continue;
+        }
+
+        QString strValue;
+        QVariant variant = iniUnescapedStringList(value, strValue, strListValue)
+                           ? stringListToVariantList(strListValue)
+                           : stringToVariant(strValue);
+        confFile->originalKeys.insert(theKey, std::move(variant));
+    }
+
+    if (!ok)
+        setStatus(QSettings::FormatError);
+}
+
+/*
+    Appends the pending changes to the log as one transaction. Returns \c false
+    if that's not possible, in which case the file needs to be rewritten.
+    Must be called with the lock file held, after reading the log.
+*/
+bool QConfFileSettingsPrivate::appendToLog(QConfFile *confFile)
+{
+    QFile log(confFile->name + LogSuffix);
+    if (!log.open(QFile::WriteOnly | QFile::Append))
+        return false;
+
+    // Anything we haven't read is either not a log or a transaction that a
+    // crashed writer left incomplete, which would become part of ours.
+    const qint64 logSize = log.size();
+    if (logSize != confFile->logSize)
+        return false;
+
+    QByteArray data;
+    quint64 id = confFile->logId;
+    if (logSize == 0) {
+        id = QRandomGenerator::system()->generate64() | 1;
+        data = LogMagic + QByteArray::number(id, 16) + '\n';
+    }
+    for (auto i = confFile->removedKeys.cbegin(); i != confFile->removedKeys.cend(); ++i) {
+        if (confFile->addedKeys.contains(i.key()))
+            continue;
+        data += '-';
+        iniEscapedKey(i.key().originalCaseKey(), data);
+        data += '\n';
+    }
+    for (auto i = confFile->addedKeys.cbegin(); i != confFile->addedKeys.cend(); ++i) {
+        data += '+';
+        iniEscapedKey(i.key().originalCaseKey(), data);
+        data += '=';
+        iniEscapedValue(i.value(), data);
+        data += '\n';
+    }
+    data += ".\n";
+
+    if (log.write(data) != data.size() || !log.flush())
+        return false;
+
+    if (logSize == 0) {
+        QFile::Permissions perms = log.permissions() | QFile::ReadOwner | QFile::WriteOwner;
+        if (!confFile->userPerms)
+            perms |= QFile::ReadGroup | QFile::ReadOther;
+        log.setPermissions(perms);
+    }
+
+    for (auto i = confFile->removedKeys.cbegin(); i != confFile->removedKeys.cend(); ++i) {
+        ensureSectionParsed(confFile, i.key());
+        confFile->originalKeys.remove(i.key());
+    }
+    for (auto i = confFile->addedKeys.cbegin(); i != confFile->addedKeys.cend(); ++i) {
+        ensureSectionParsed(confFile, i.key());
+        confFile->originalKeys.insert(i.key(), i.value());
+    }
+    confFile->addedKeys.clear();
+    confFile->removedKeys.clear();
+    confFile->logId = id;
+    confFile->logSize = logSize + data.size();
+    return true;
+}
+
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
 {
     auto i = confFile->unparsedIniSections.constBegin();
@@ -2906,6 +3142,52 @@ void QSettings::setAtomicSyncRequired(bool enable)
     d->atomicSyncOnly = enable;
 }
 
+/*!
+    \since 6.9
+
+    Returns \c true if sync() appends the changes to a log instead of
+    rewriting the whole settings file; otherwise returns \c false.
+
+    The default is \c false.
+
+    \sa setIncrementalSyncEnabled()
+*/
+bool QSettings::isIncrementalSyncEnabled() const
+{
+    Q_D(const QSettings);
+    return d->incrementalSync;
+}
+
+/*!
+    \since 6.9
+
+    Configures whether sync() appends the changes to a log instead of
+    rewriting the whole settings file. If the \a enable argument is \c true,
+    sync() writes the keys that were set or removed since the last
+    synchronization to a file next to the settings file, whose name has
+    \c{.log} appended, and reads only the changes that other processes
+    appended to it. Once the log has grown larger than the settings file, the
+    next sync() compacts it into the settings file and removes it. This keeps
+    the cost of frequently saving small changes independent of the size of
+    the settings file.
+
+    The settings file stays a regular INI file. QSettings objects that don't
+    enable this property ignore the log when reading, so all processes that
+    need to see each other's changes should enable it. A sync() that rewrites
+    the settings file includes the changes from the log, and removes it.
+
+    This property only affects QSettings::IniFormat, and
+    QSettings::NativeFormat on platforms where it uses INI files. It is
+    ignored for other formats.
+
+    \sa isIncrementalSyncEnabled(), sync()
+*/
+void QSettings::setIncrementalSyncEnabled(bool enable)
+{
+    Q_D(QSettings);
+    d->incrementalSync = enable;
+}
+
 /*!
     Appends \a prefix to the current group.
 
@@ -116,6 +116,8 @@ public:
     Status status() const;
     bool isAtomicSyncRequired() const;
     void setAtomicSyncRequired(bool enable);
+    bool isIncrementalSyncEnabled() const;
+    void setIncrementalSyncEnabled(bool enable);
 
 #if QT_CORE_REMOVED_SINCE(6, 4)
     void beginGroup(const QString &prefix);
@@ -130,6 +130,8 @@ public:
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
+    qint64 logSize = 0; // the part of the log that was applied to originalKeys
+    quint64 logId = 0;
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
@@ -213,6 +215,7 @@ protected:
     bool fallbacks;
     bool pendingChanges;
     bool atomicSyncOnly = true;
+    bool incrementalSync = false;
     mutable QSettings::Status status;
 };
 
@@ -250,6 +253,10 @@ private:
     void initFormat();
     virtual void initAccess();
     void syncConfFile(QConfFile *confFile);
+    bool supportsLog() const;
+    bool readLog(QConfFile *confFile, QByteArray *transactions) const;
+    void applyLog(QConfFile *confFile, QByteArrayView transactions);
+    bool appendToLog(QConfFile *confFile);
     bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
 #ifdef Q_OS_DARWIN
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
@@ -8,7 +8,14 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qhash.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
+#include <deque>
+#include <limits>
 #include <memory>
 
 #include <zlib.h>
@@ -25,6 +32,9 @@
 
 QT_BEGIN_NAMESPACE
 
+// the size of the blocks in which contents are streamed to and from the archive
+static constexpr qsizetype StreamingChunkSize = 64 * 1024;
+
 static inline uint readUInt(const uchar *data)
 {
     return (data[0]) + (data[1]<<8) + (data[2]<<16) + (data[3]<<24);
@@ -479,8 +489,21 @@ public:
     }
 
     void scanFiles();
+    int findEntry(const QString &fileName);
+    bool isExtractable(const FileHeader &header) const;
+    qint64 seekToData(const FileHeader &header, int *compressionMethod);
 
     QZipReader::Status status;
+    // the index of the first entry of each name, built on the first lookup
+    QHash<QString, int> fileIndex;
+};
+
+// The contents of an entry, as stored in the archive
+struct EntryData
+{
+    QByteArray data;
+    quint32 crc = 0;
+    bool deflated = false;
 };
 
 class QZipWriterPrivate : public QZipPrivate
@@ -497,10 +520,29 @@ public:
     QZipWriter::Status status;
     QFile::Permissions permissions;
     QZipWriter::CompressionPolicy compressionPolicy;
+    QThreadPool *threadPool = nullptr;
 
     enum EntryType { Directory, File, Symlink };
 
+    bool openDevice();
+    FileHeader makeHeader(EntryType type, const QString &fileName) const;
+    void writeEntry(FileHeader &header, const EntryData &entry, qint64 size);
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void addEntry(const QString &fileName, QIODevice *source);
+    void flushPending(size_t keep = 0);
+
+#if QT_CONFIG(thread)
+    struct CompressionJob;
+    struct PendingEntry
+    {
+        FileHeader header;
+        std::shared_ptr<CompressionJob> job;
+    };
+
+    // entries compressed on the thread pool, in the order they were added
+    std::deque<PendingEntry> pending;
+    void queueEntry(FileHeader &&header, const QByteArray &contents);
+#endif
 };
 
 static LocalFileHeader toLocalHeader(const CentralFileHeader &ch)
@@ -542,62 +584,79 @@ void QZipReaderPrivate::scanFiles()
         return;
     }
 
-    // find EndOfDirectory header
+    // find EndOfDirectory header, which is followed by a comment of up to
+    // 64 KiB, reading all the places it can be in at once
+    const qint64 tailSize = qMin(device->size(), qint64(sizeof(EndOfDirectory)) + 0xffff);
+    const qint64 tailStart = device->size() - tailSize;
+    device->seek(tailStart);
+    const QByteArray tail = device->read(tailSize);
     int i = 0;
-    int start_of_directory = -1;
-    int num_dir_entries = 0;
+    qsizetype eodPos = -1;
     EndOfDirectory eod;
-    while (start_of_directory == -1) {
-        const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
+    while (eodPos == -1) {
+        const qsizetype pos = tail.size() - qsizetype(sizeof(EndOfDirectory)) - i;
         if (pos < 0 || i > 65535) {
             qWarning("QZip: EndOfDirectory not found");
             return;
         }
 
-        device->seek(pos);
-        device->read((char *)&eod, sizeof(EndOfDirectory));
+        memcpy(&eod, tail.constData() + pos, sizeof(EndOfDirectory));
         if (readUInt(eod.signature) == 0x06054b50)
-            break;
-        ++i;
+            eodPos = pos;
+        else
+            ++i;
     }
 
     // have the eod
-    start_of_directory = readUInt(eod.dir_start_offset);
-    num_dir_entries = readUShort(eod.num_dir_entries);
-    ZDEBUG("start_of_directory at %d, num_dir_entries=%d", start_of_directory, num_dir_entries);
+    const uint start_of_directory = readUInt(eod.dir_start_offset);
+    int num_dir_entries = readUShort(eod.num_dir_entries);
+    ZDEBUG("start_of_directory at %u, num_dir_entries=%d", start_of_directory, num_dir_entries);
     int comment_length = readUShort(eod.comment_length);
     if (comment_length != i)
         qWarning("QZip: failed to parse zip file.");
-    comment = device->read(qMin(comment_length, i));
-
+    comment = tail.mid(eodPos + sizeof(EndOfDirectory), qMin(comment_length, i));
+
+    // the central directory ends where the eod starts, read it at once
+    const qint64 directorySize = tailStart + eodPos - start_of_directory;
+    QByteArray directory;
+    if (directorySize > 0) {
+        device->seek(start_of_directory);
+        directory = device->read(directorySize);
+    }
+    qsizetype offset = 0;
+    auto readField = [&](int length) {
+        QByteArray field = directory.mid(offset, length);
+        offset += field.size();
+        return field;
+    };
 
-    device->seek(start_of_directory);
     for (i = 0; i < num_dir_entries; ++i) {
         FileHeader header;
-        int read = device->read((char *) &header.h, sizeof(CentralFileHeader));
-        if (read < (int)sizeof(CentralFileHeader)) {
+        if (directory.size() - offset < qsizetype(sizeof(CentralFileHeader))) {
             qWarning("QZip: Failed to read complete header, index may be incomplete");
             break;
         }
+        memcpy(&header.h, directory.constData() + offset, sizeof(CentralFileHeader));
+        offset += sizeof(CentralFileHeader);
         if (readUInt(header.h.signature) != 0x02014b50) {
             qWarning("QZip: invalid header signature, index may be incomplete");
             break;
         }
 
         int l = readUShort(header.h.file_name_length);
-        header.file_name = device->read(l);
+        header.file_name = readField(l);
         if (header.file_name.size() != l) {
             qWarning("QZip: Failed to read filename from zip index, index may be incomplete");
             break;
         }
         l = readUShort(header.h.extra_field_length);
-        header.extra_field = device->read(l);
+        header.extra_field = readField(l);
         if (header.extra_field.size() != l) {
             qWarning("QZip: Failed to read extra field in zip file, skipping file, index may be incomplete");
             break;
         }
         l = readUShort(header.h.file_comment_length);
-        header.file_comment = device->read(l);
+        header.file_comment = readField(l);
         if (header.file_comment.size() != l) {
             qWarning("QZip: Failed to read read file comment, index may be incomplete");
             break;
@@ -608,57 +667,196 @@ void QZipReaderPrivate::scanFiles()
     }
 }
 
-void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+int QZipReaderPrivate::findEntry(const QString &fileName)
 {
-#ifndef NDEBUG
-    static const char *const entryTypes[] = {
-        "directory",
-        "file     ",
-        "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
-#endif
+    if (fileIndex.isEmpty()) {
+        fileIndex.reserve(fileHeaders.size());
+        for (int i = fileHeaders.size() - 1; i >= 0; --i)
+            fileIndex.insert(QString::fromLocal8Bit(fileHeaders.at(i).file_name), i);
+    }
+    return fileIndex.value(fileName, -1);
+}
 
-    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
-        status = QZipWriter::FileOpenError;
-        return;
+bool QZipReaderPrivate::isExtractable(const FileHeader &header) const
+{
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
     }
-    device->seek(start_of_directory);
 
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+    return true;
+}
+
+// Positions the device at the data of the entry, and returns that position
+// and the compression method of its local header.
+qint64 QZipReaderPrivate::seekToData(const FileHeader &header, int *compressionMethod)
+{
+    uint start = readUInt(header.h.offset_local_header);
+    device->seek(start);
+    LocalFileHeader lh;
+    if (device->read((char *)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader)))
+        return -1;
+    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    const qint64 position = device->pos() + skip;
+    device->seek(position);
+    *compressionMethod = readUShort(lh.compression_method);
+    return position;
+}
+
+// Reads the contents of an entry from the device of the archive, decompressing
+// them on the fly. Every read seeks to where the previous one left off, so that
+// the devices of several entries can be used at the same time.
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(QIODevice *archive, qint64 position, const FileHeader &header, bool deflated)
+        : archive(archive), position(position),
+          compressedLeft(readUInt(header.h.compressed_size)),
+          uncompressedLeft(readUInt(header.h.uncompressed_size)),
+          expectedCrc(readUInt(header.h.crc_32)), deflated(deflated)
+    {
+        memset(&stream, 0, sizeof(stream));
+        if (deflated) {
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                return;
+            inflating = true;
+        }
+        crc = ::crc32(0, nullptr, 0);
+        open(QIODevice::ReadOnly);
+    }
+
+    ~QZipEntryDevice() override
+    {
+        if (inflating)
+            inflateEnd(&stream);
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return QIODevice::bytesAvailable() + uncompressedLeft; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    bool fillInput();
+    qint64 inflateData(char *data, qint64 maxSize);
+
+    QIODevice *archive;
+    QByteArray input;
+    z_stream stream;
+    qint64 position;
+    qint64 compressedLeft;
+    qint64 uncompressedLeft;
+    quint32 expectedCrc;
+    quint32 crc = 0;
+    bool deflated;
+    bool inflating = false;
+};
+
+qint64 QZipEntryDevice::readData(char *data, qint64 maxSize)
+{
+    maxSize = qMin(maxSize, uncompressedLeft);
+    if (maxSize == 0)
+        return 0;
+
+    qint64 bytesRead;
+    if (deflated) {
+        bytesRead = inflateData(data, maxSize);
+    } else {
+        archive->seek(position);
+        bytesRead = archive->read(data, qMin(maxSize, compressedLeft));
+        if (bytesRead > 0) {
+            position += bytesRead;
+            compressedLeft -= bytesRead;
+        } else {
+            setErrorString(tr("Unexpected end of the archive"));
+            bytesRead = -1;
+        }
+    }
+    if (bytesRead <= 0)
+        return bytesRead;
+
+    crc = ::crc32(crc, reinterpret_cast<const uchar *>(data), uInt(bytesRead));
+    uncompressedLeft -= bytesRead;
+    if (uncompressedLeft == 0 && crc != expectedCrc) {
+        setErrorString(tr("Checksum mismatch"));
+        return -1;
+    }
+    return bytesRead;
+}
+
+bool QZipEntryDevice::fillInput()
+{
+    archive->seek(position);
+    input = archive->read(qMin<qint64>(compressedLeft, StreamingChunkSize));
+    if (input.isEmpty())
+        return false;
+    position += input.size();
+    compressedLeft -= input.size();
+    stream.next_in = reinterpret_cast<Bytef *>(input.data());
+    stream.avail_in = uInt(input.size());
+    return true;
+}
+
+qint64 QZipEntryDevice::inflateData(char *data, qint64 maxSize)
+{
+    stream.next_out = reinterpret_cast<Bytef *>(data);
+    stream.avail_out = uInt(qMin<qint64>(maxSize, std::numeric_limits<uInt>::max()));
+    const uInt capacity = stream.avail_out;
+    while (stream.avail_out) {
+        if (stream.avail_in == 0 && !fillInput()) {
+            setErrorString(tr("Unexpected end of the archive"));
+            return -1;
+        }
+        const int res = ::inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END)
+            break;
+        if (res != Z_OK) {
+            setErrorString(tr("Input data is corrupted"));
+            return -1;
+        }
+    }
+    return capacity - stream.avail_out;
+}
+
+// Compresses the contents of an entry according to policy.
+static EntryData compressEntry(const QByteArray &contents, QZipWriter::CompressionPolicy policy)
+{
     // don't compress small files
-    QZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == QZipWriter::AutoCompress) {
+    if (policy == QZipWriter::AutoCompress) {
         if (contents.size() < 64)
-            compression = QZipWriter::NeverCompress;
+            policy = QZipWriter::NeverCompress;
         else
-            compression = QZipWriter::AlwaysCompress;
+            policy = QZipWriter::AlwaysCompress;
     }
 
-    FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
+    EntryData entry;
+    entry.data = contents;
+    if (policy == QZipWriter::AlwaysCompress) {
+        entry.deflated = true;
 
-    writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.size());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-       ulong len = contents.size();
+        ulong len = contents.size();
         // shamelessly copied form zlib
         len += (len >> 12) + (len >> 14) + 11;
         int res;
         do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
+            entry.data.resize(len);
+            res = deflate((uchar*)entry.data.data(), &len, (const uchar*)contents.constData(), contents.size());
 
             switch (res) {
             case Z_OK:
-                data.resize(len);
+                entry.data.resize(len);
                 break;
             case Z_MEM_ERROR:
                 qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
+                entry.data.resize(0);
                 break;
             case Z_BUF_ERROR:
                 len *= 2;
@@ -667,10 +865,79 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         } while (res == Z_BUF_ERROR);
     }
 // TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.size());
-    uint crc_32 = ::crc32(0, nullptr, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.size());
-    writeUInt(header.h.crc_32, crc_32);
+    entry.crc = ::crc32(0, nullptr, 0);
+    entry.crc = ::crc32(entry.crc, (const uchar *)contents.constData(), contents.size());
+    return entry;
+}
+
+#if QT_CONFIG(thread)
+// Compresses an entry on the thread pool, unless the writer needs the result
+// before the pool got to it, in which case the writer does it itself.
+struct QZipWriterPrivate::CompressionJob
+{
+    QByteArray contents;
+    QZipWriter::CompressionPolicy policy;
+    EntryData result;
+    QAtomicInt claimed;
+    QSemaphore done;
+
+    void runIfUnclaimed()
+    {
+        if (!claimed.testAndSetRelaxed(0, 1))
+            return;
+        result = compressEntry(contents, policy);
+        done.release();
+    }
+};
+
+void QZipWriterPrivate::queueEntry(FileHeader &&header, const QByteArray &contents)
+{
+    auto job = std::make_shared<CompressionJob>();
+    job->contents = contents;
+    job->policy = compressionPolicy;
+    threadPool->start([job] { job->runIfUnclaimed(); });
+    pending.push_back({ std::move(header), std::move(job) });
+
+    // limit the memory held by entries that weren't written yet
+    flushPending(2 * size_t(qMax(threadPool->maxThreadCount(), 1)));
+}
+#endif
+
+// Writes the entries compressed on the thread pool, except for the last keep
+// ones.
+void QZipWriterPrivate::flushPending(size_t keep)
+{
+#if QT_CONFIG(thread)
+    while (pending.size() > keep) {
+        PendingEntry &entry = pending.front();
+        entry.job->runIfUnclaimed();
+        entry.job->done.acquire();
+        writeEntry(entry.header, entry.job->result, entry.job->contents.size());
+        pending.pop_front();
+    }
+#else
+    Q_UNUSED(keep);
+#endif
+}
+
+bool QZipWriterPrivate::openDevice()
+{
+    if (device->isOpen() || device->open(QIODevice::WriteOnly))
+        return true;
+    status = QZipWriter::FileOpenError;
+    return false;
+}
+
+// Returns the header of a new entry, without the fields that depend on its
+// contents or on its position in the archive.
+FileHeader QZipWriterPrivate::makeHeader(EntryType type, const QString &fileName) const
+{
+    FileHeader header;
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -708,17 +975,127 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         break;
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
+    return header;
+}
 
+// Appends the entry to the archive, whose device must be open.
+void QZipWriterPrivate::writeEntry(FileHeader &header, const EntryData &entry, qint64 size)
+{
+    if (entry.deflated)
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+    writeUInt(header.h.uncompressed_size, size);
+    writeUInt(header.h.compressed_size, entry.data.size());
+    writeUInt(header.h.crc_32, entry.crc);
+    writeUInt(header.h.offset_local_header, start_of_directory);
 
     fileHeaders.append(header);
 
+    device->seek(start_of_directory);
     LocalFileHeader h = toLocalHeader(header.h);
     device->write((const char *)&h, sizeof(LocalFileHeader));
     device->write(header.file_name);
-    device->write(data);
+    device->write(entry.data);
+    start_of_directory = device->pos();
+    dirtyFileTree = true;
+}
+
+void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+{
+#ifndef NDEBUG
+    static const char *const entryTypes[] = {
+        "directory",
+        "file     ",
+        "symlink  " };
+    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+#endif
+
+    if (!openDevice())
+        return;
+
+    FileHeader header = makeHeader(type, fileName);
+#if QT_CONFIG(thread)
+    if (threadPool && type == File) {
+        queueEntry(std::move(header), contents);
+        return;
+    }
+#endif
+    flushPending();
+    writeEntry(header, compressEntry(contents, compressionPolicy), contents.size());
+}
+
+// Adds a file whose contents are read from source and compressed in blocks,
+// without holding all of them in memory.
+void QZipWriterPrivate::addEntry(const QString &fileName, QIODevice *source)
+{
+    QByteArray contents = source->read(StreamingChunkSize);
+    if (contents.size() < StreamingChunkSize || source->atEnd()) {
+        addEntry(File, fileName, contents + source->readAll());
+        return;
+    }
+
+    if (!openDevice())
+        return;
+    flushPending();
+
+    ZDEBUG() << "adding file      :" << fileName.toUtf8().data();
+    FileHeader header = makeHeader(File, fileName);
+
+    // the contents are big enough to compress with AutoCompress
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    const bool deflated = compressionPolicy != QZipWriter::NeverCompress
+            && deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                            Z_DEFAULT_STRATEGY) == Z_OK;
+    if (deflated)
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+
+    // write the local header now and the sizes and the checksum once known
+    const qint64 headerPosition = start_of_directory;
+    writeUInt(header.h.offset_local_header, start_of_directory);
+    device->seek(start_of_directory);
+    LocalFileHeader h = toLocalHeader(header.h);
+    device->write((const char *)&h, sizeof(LocalFileHeader));
+    device->write(header.file_name);
+
+    const qint64 dataPosition = device->pos();
+    quint32 crc = ::crc32(0, nullptr, 0);
+    qint64 size = 0;
+    QByteArray output(deflated ? StreamingChunkSize : 0, Qt::Uninitialized);
+    for (;;) {
+        const bool last = contents.isEmpty() || source->atEnd();
+        crc = ::crc32(crc, (const uchar *)contents.constData(), uInt(contents.size()));
+        size += contents.size();
+
+        if (deflated) {
+            stream.next_in = (Bytef *)contents.data();
+            stream.avail_in = uInt(contents.size());
+            do {
+                stream.next_out = (Bytef *)output.data();
+                stream.avail_out = uInt(output.size());
+                ::deflate(&stream, last ? Z_FINISH : Z_NO_FLUSH);
+                device->write(output.constData(), output.size() - stream.avail_out);
+            } while (stream.avail_out == 0);
+        } else {
+            device->write(contents);
+        }
+
+        if (last)
+            break;
+        contents = source->read(StreamingChunkSize);
+    }
+    if (deflated)
+        deflateEnd(&stream);
+
     start_of_directory = device->pos();
+    writeUInt(header.h.uncompressed_size, size);
+    writeUInt(header.h.compressed_size, start_of_directory - dataPosition);
+    writeUInt(header.h.crc_32, crc);
+    fileHeaders.append(header);
     dirtyFileTree = true;
+
+    device->seek(headerPosition);
+    h = toLocalHeader(header.h);
+    device->write((const char *)&h, sizeof(LocalFileHeader));
 }
 
 //////////////////////////////  Reader
@@ -899,41 +1276,20 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
     d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    const int i = d->findEntry(fileName);
+    if (i < 0)
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+    const FileHeader &header = d->fileHeaders.at(i);
+    if (!d->isExtractable(header))
         return QByteArray();
-    }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
     int compressed_size = readUInt(header.h.compressed_size);
     int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
-
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+    int compression_method;
+    if (d->seekToData(header, &compression_method) < 0)
         return QByteArray();
-    }
+    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
     //qDebug("file at %lld", d->device->pos());
     QByteArray compressed = d->device->read(compressed_size);
@@ -976,6 +1332,47 @@ QByteArray QZipReader::fileData(const QString &fileName) const
     return QByteArray();
 }
 
+/*!
+    \since 6.9
+
+    Returns a device that reads the contents of the file \a fileName in the
+    archive, decompressing them while they are read, or \nullptr if the archive
+    contains no such file or its contents can't be extracted.
+
+    Unlike fileData(), this doesn't need to hold the whole contents in memory.
+    The returned device is sequential and must not outlive the reader. It
+    reports an error if the contents don't match their checksum.
+
+    \sa fileData()
+*/
+std::unique_ptr<QIODevice> QZipReader::fileDevice(const QString &fileName) const
+{
+    d->scanFiles();
+    const int i = d->findEntry(fileName);
+    if (i < 0)
+        return nullptr;
+
+    const FileHeader &header = d->fileHeaders.at(i);
+    if (!d->isExtractable(header))
+        return nullptr;
+
+    int compression_method;
+    const qint64 position = d->seekToData(header, &compression_method);
+    if (position < 0)
+        return nullptr;
+    if (compression_method != CompressionMethodStored
+            && compression_method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return nullptr;
+    }
+
+    auto device = std::make_unique<QZipEntryDevice>(d->device, position, header,
+                                                    compression_method == CompressionMethodDeflated);
+    if (!device->isOpen())
+        return nullptr;
+    return device;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1042,7 +1439,17 @@ bool QZipReader::extractAll(const QString &destinationDir) const
             QFile f(absPath);
             if (!f.open(QIODevice::WriteOnly))
                 return false;
-            f.write(fileData(fi.filePath));
+            if (const auto entry = fileDevice(fi.filePath)) {
+                char buffer[16 * 1024];
+                qint64 bytesRead;
+                while ((bytesRead = entry->read(buffer, sizeof(buffer))) > 0)
+                    f.write(buffer, bytesRead);
+                if (bytesRead < 0) {
+                    // don't leave a truncated or corrupted file behind
+                    f.remove();
+                    return false;
+                }
+            }
             f.setPermissions(fi.permissions);
             f.close();
         }
@@ -1242,6 +1649,38 @@ QFile::Permissions QZipWriter::creationPermissions() const
     return d->permissions;
 }
 
+/*!
+    \since 6.9
+
+    Sets the thread pool on which the files added with addFile() are
+    compressed to \a pool. The files are compressed in parallel, but they are
+    still stored in the archive in the order in which they were added. The
+    archive is only complete after close().
+
+    If \a pool is \nullptr, which is the default, the files are compressed on
+    the calling thread.
+
+    \sa threadPool()
+*/
+void QZipWriter::setThreadPool(QThreadPool *pool)
+{
+    d->flushPending();
+    d->threadPool = pool;
+}
+
+/*!
+    \since 6.9
+
+    Returns the thread pool on which files are compressed, or \nullptr if they
+    are compressed on the calling thread.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QZipWriter::threadPool() const
+{
+    return d->threadPool;
+}
+
 /*!
     Add a file to the archive with \a data as the file contents.
     The file will be stored in the archive using the \a fileName which
@@ -1253,6 +1692,7 @@ QFile::Permissions QZipWriter::creationPermissions() const
 
     \sa setCreationPermissions()
     \sa setCompressionPolicy()
+    \sa setThreadPool()
 */
 void QZipWriter::addFile(const QString &fileName, const QByteArray &data)
 {
@@ -1261,8 +1701,8 @@ void QZipWriter::addFile(const QString &fileName, const QByteArray &data)
 
 /*!
     Add a file to the archive with \a device as the source of the contents.
-    The contents returned from QIODevice::readAll() will be used as the
-    filedata.
+    The contents are read until the end of \a device and compressed while they
+    are read, so that big files don't need to be held in memory.
     The file will be stored in the archive using the \a fileName which
     includes the full path in the archive.
 */
@@ -1278,7 +1718,7 @@ void QZipWriter::addFile(const QString &fileName, QIODevice *device)
             return;
         }
     }
-    d->addEntry(QZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), device->readAll());
+    d->addEntry(QDir::fromNativeSeparators(fileName), device);
     if (opened)
         device->close();
 }
@@ -1311,6 +1751,7 @@ void QZipWriter::addSymLink(const QString &fileName, const QString &destination)
 */
 void QZipWriter::close()
 {
+    d->flushPending();
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;
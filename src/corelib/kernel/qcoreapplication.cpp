@@ -347,7 +347,10 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 
 qsizetype qGlobalPostedEventsCount()
 {
-    const QPostEventList &l = QThreadData::current()->postEventList;
+    QThreadData *data = QThreadData::current();
+    const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    QCoreApplicationPrivate::takePostEventInbox(data);
+    const QPostEventList &l = data->postEventList;
     return l.size() - l.startOffset;
 }
 
@@ -497,6 +500,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        takePostEventInbox(thisThreadData);
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1691,6 +1695,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the events posted through postMetaCallEvent() in order
+    QCoreApplicationPrivate::takePostEventInbox(data);
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1714,6 +1721,119 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+void QCoreApplicationPrivate::pushToPostEventInbox(QThreadData *data, QObject *receiver,
+                                                   QMetaCallEvent *event)
+{
+    event->inboxReceiver_ = receiver;
+    QMetaCallEvent *head = data->postEventList.inbox.loadRelaxed();
+    do {
+        event->inboxNext_ = head;
+    } while (!data->postEventList.inbox.testAndSetRelease(head, event, head));
+
+    // if the inbox was not empty, whoever made it non-empty woke the thread
+    // up and it has not taken the inbox yet
+    if (!head) {
+        if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+            dispatcher->wakeUp();
+    }
+}
+
+/*!
+    \internal
+
+    Posts \a event to \a receiver like QCoreApplication::postEvent() does with
+    Qt::NormalEventPriority, but without locking the post event list of the
+    receiver's thread: the event is pushed onto a lock-free inbox that the
+    thread moves into its post event list before it next looks at the list.
+    This keeps threads emitting queued signals at a high rate from contending
+    with each other and with the receiving thread on the list's mutex.
+
+    Meta-call events are never compressed, so nothing is lost by not looking
+    at the list when posting.
+
+    The caller must keep \a receiver from being destroyed while this function
+    runs, as queued_activate() does by holding its signalSlotLock().
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QMetaCallEvent *event)
+{
+    Q_ASSERT(receiver);
+    Q_ASSERT(event);
+
+    Q_TRACE_SCOPE(QCoreApplication_postEvent, receiver, event, event->type());
+
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+
+    // synchronizes with the storeRelease in QObject::moveToThread
+    QThreadData *data = threadData.loadAcquire();
+    if (!data) {
+        // posting during destruction? just delete the event to prevent a leak
+        delete event;
+        return;
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    // counted before it is pushed, so that ~QObjectPrivate() removes it even
+    // if another thread has already taken the inbox and is walking it
+    ++receiver->d_func()->postedEvents;
+    pushToPostEventInbox(data, receiver, event);
+
+    // pairs with the fence in QObject::moveToThread: either the thread that
+    // moved the receiver took our event from the inbox after the move and
+    // forwarded it, or we see the receiver in its new thread here and make
+    // sure the event follows it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Q_UNLIKELY(threadData.loadRelaxed() != data)) {
+        const auto locker = qt_scoped_lock(data->postEventList.mutex);
+        takePostEventInbox(data);
+    }
+}
+
+/*!
+    \internal
+
+    Moves the events posted to \a data with postMetaCallEvent() into its
+    post event list. Must be called with the list's mutex locked.
+
+    The events are already counted in their receiver's postedEvents, so a
+    receiver being destroyed waits for this function on the mutex in
+    removePostedEvents().
+*/
+void QCoreApplicationPrivate::takePostEventInbox(QThreadData *data)
+{
+    QMetaCallEvent *event = data->postEventList.inbox.fetchAndStoreAcquire(nullptr);
+    if (!event)
+        return;
+
+    // the inbox is a stack, restore the posting order
+    QMetaCallEvent *first = nullptr;
+    while (event) {
+        QMetaCallEvent *next = std::exchange(event->inboxNext_, first);
+        first = event;
+        event = next;
+    }
+
+    bool added = false;
+    for (event = first; event; ) {
+        QMetaCallEvent *next = std::exchange(event->inboxNext_, nullptr);
+        QObject *receiver = std::exchange(event->inboxReceiver_, nullptr);
+
+        // the receiver cannot leave this thread while we hold the lock, but it
+        // may have left it after the event was posted
+        QThreadData *target = QObjectPrivate::get(receiver)->threadData.loadAcquire();
+        if (target && target != data) {
+            pushToPostEventInbox(target, receiver, event);
+        } else {
+            data->postEventList.addEvent(QPostEvent(receiver, event, Qt::NormalEventPriority));
+            added = true;
+        }
+        event = next;
+    }
+
+    if (added)
+        data->canWait = false;
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1800,6 +1920,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    takePostEventInbox(data);
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1981,6 +2102,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
+    QCoreApplicationPrivate::takePostEventInbox(data);
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -2012,7 +2134,10 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     }
 
 #ifdef QT_DEBUG
-    if (receiver && eventType == 0) {
+    // postMetaCallEvent() counts an event before it reaches the inbox we took
+    // above, so only a receiver that is being destroyed, and thus can no
+    // longer be the target of a queued signal, is known to have none left
+    if (receiver && eventType == 0 && receiver->d_func()->wasDeleted) {
         Q_ASSERT(!receiver->d_func()->postedEvents);
     }
 #endif
@@ -2044,6 +2169,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    takePostEventInbox(data);
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
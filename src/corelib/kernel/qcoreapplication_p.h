@@ -46,6 +46,7 @@ class QAbstractEventDispatcher;
 
 #ifndef QT_NO_QOBJECT
 class QEvent;
+class QMetaCallEvent;
 #endif
 
 class Q_CORE_EXPORT QCoreApplicationPrivate
@@ -113,6 +114,9 @@ public:
     static bool threadRequiresCoreApplication();
 
     static void sendPostedEvents(QObject *receiver, int event_type, QThreadData *data);
+    static void postMetaCallEvent(QObject *receiver, QMetaCallEvent *event);
+    static void takePostEventInbox(QThreadData *data);
+    static void pushToPostEventInbox(QThreadData *data, QObject *receiver, QMetaCallEvent *event);
 
     static void checkReceiverThread(QObject *receiver);
     void cleanupThreadData();
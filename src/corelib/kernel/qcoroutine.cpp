@@ -0,0 +1,231 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcoroutine.h"
+
+#include "qabstracteventdispatcher.h"
+#include "qcoreapplication.h"
+#include "private/qobject_p.h"
+#if QT_CONFIG(future)
+#include "private/qfutureinterface_p.h"
+#endif
+
+#include <new>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace QtCoroutine
+    \inmodule QtCore
+    \since 6.9
+    \brief The QtCoroutine namespace contains awaitables for C++20 coroutines.
+
+    When compiling with C++20, including \c{<QtCore/qcoroutine.h>} lets
+    coroutines \c{co_await} a QFuture, the timeout of a QTimer, or incoming
+    data on a QIODevice, and lets functions returning a QFuture be written as
+    coroutines:
+
+    \code
+    QFuture<QByteArray> readLine(QIODevice *device)
+    {
+        while (!device->canReadLine()) {
+            if (co_await QtCoroutine::readyRead(device) <= 0)
+                co_return QByteArray();
+        }
+        co_return device->readLine();
+    }
+    \endcode
+
+    A suspended coroutine is always resumed by the event dispatcher of the
+    thread it was suspended in, never from within the code that completed the
+    awaited operation, so it keeps running in its thread and can safely delete
+    the objects it was waiting on. Waiting does not create continuation
+    futures or watcher objects, and the events that resume coroutines are
+    recycled.
+
+    A coroutine returning QFuture<T> starts running immediately and its frame
+    is destroyed when it returns. The future is finished once the coroutine
+    \c{co_return}s, and carries the exception if it exits with one.
+
+    \note If the event dispatcher of the awaiting thread is destroyed while a
+    coroutine waits, the coroutine is never resumed.
+*/
+
+/*!
+    \fn template <typename Rep, typename Period> auto QtCoroutine::sleepFor(std::chrono::duration<Rep, Period> duration)
+
+    Returns an awaitable that suspends the awaiting coroutine for \a duration.
+*/
+
+/*!
+    \fn auto QtCoroutine::timeout(QTimer *timer)
+
+    Returns an awaitable that suspends the awaiting coroutine until \a timer
+    next times out. \a timer must live in the thread of the coroutine.
+
+    The \c{co_await} expression evaluates to \c true if \a timer timed out,
+    and to \c false if it was \nullptr or was destroyed while waiting.
+*/
+
+/*!
+    \fn auto QtCoroutine::readyRead(QIODevice *device)
+
+    Returns an awaitable that suspends the awaiting coroutine until \a device
+    has data available for reading, its read channel is finished, or it is
+    about to be closed. The \c{co_await} expression evaluates to the number of
+    bytes available on \a device, which is \c 0 in the latter two cases, or to
+    \c -1 if \a device was \nullptr or was destroyed while waiting.
+
+    Random-access devices have all their data available, so awaiting them does
+    not suspend. \a device must live in the thread of the coroutine.
+*/
+
+/*!
+    \fn template <typename T> auto operator co_await(const QFuture<T> &future)
+    \relates QFuture
+    \since 6.9
+
+    Suspends the awaiting coroutine until \a future is finished. The
+    \c{co_await} expression evaluates to QFuture::result(), or to \c void for
+    QFuture<void>; an exception stored in \a future is rethrown.
+
+    If the awaiting thread has no event dispatcher, this blocks until \a future
+    is finished instead.
+
+    \sa QtCoroutine
+*/
+
+namespace QtPrivate {
+
+class QCoroutineResumeEvent : public QAbstractMetaCallEvent
+{
+public:
+    explicit QCoroutineResumeEvent(QCoroutineAwaiterBase *awaiter)
+        : QAbstractMetaCallEvent(nullptr, -1), awaiter(awaiter)
+    { }
+
+    // The event loop deletes the event after resuming the coroutine, which may
+    // have destroyed the awaiter by then, so the event can't live in the
+    // awaiter. Recycle the memory of queued signal emissions instead.
+    static void *operator new(size_t size) { return QMetaCallEvent::operator new(size); }
+    static void operator delete(void *ptr) noexcept { QMetaCallEvent::operator delete(ptr); }
+
+    ~QCoroutineResumeEvent() override
+    {
+        // dropped without being delivered
+        if (awaiter)
+            awaiter->m_pendingResume = nullptr;
+    }
+
+    void placeMetaCall(QObject *) override
+    {
+        if (QCoroutineAwaiterBase *a = std::exchange(awaiter, nullptr)) {
+            a->m_pendingResume = nullptr;
+            a->m_resume(a->m_coroutine);
+        }
+    }
+
+    QCoroutineAwaiterBase *awaiter;
+};
+
+#if QT_CONFIG(future)
+class QCoroutineFutureWatch : public QFutureCallOutInterface
+{
+public:
+    QCoroutineFutureWatch(QCoroutineAwaiterBase *awaiter, const QFutureInterfaceBase &future)
+        : awaiter(awaiter), future(future)
+    { }
+
+    // called with the future's mutex locked
+    void postCallOutEvent(const QFutureCallOutEvent &event) override
+    {
+        if (event.callOutType == QFutureCallOutEvent::Finished) {
+            if (QCoroutineAwaiterBase *a = std::exchange(awaiter, nullptr))
+                a->resumeLater();
+        }
+    }
+    void callOutInterfaceDisconnected() override { }
+
+    static QCoroutineFutureWatch *of(QCoroutineAwaiterBase *awaiter)
+    {
+        return std::launder(reinterpret_cast<QCoroutineFutureWatch *>(awaiter->m_futureWatch));
+    }
+
+    QCoroutineAwaiterBase *awaiter;
+    QFutureInterfaceBase future;
+};
+#endif
+
+static_assert(sizeof(QCoroutineResumeEvent) <= sizeof(QMetaCallEvent));
+
+QCoroutineAwaiterBase::~QCoroutineAwaiterBase()
+{
+#if QT_CONFIG(future)
+    if (m_watchingFuture) {
+        // after this, the future cannot call us anymore
+        QCoroutineFutureWatch *watch = QCoroutineFutureWatch::of(this);
+        watch->future.d->disconnectOutputInterface(watch);
+        watch->~QCoroutineFutureWatch();
+    }
+#endif
+    // the coroutine is going away without having been resumed
+    if (m_pendingResume)
+        m_pendingResume->awaiter = nullptr;
+}
+
+/*!
+    \internal
+
+    Remembers \a coroutine as the one to resume with \a resume, on the event
+    dispatcher of the calling thread. Returns \c false if the thread has no
+    event dispatcher.
+*/
+bool QCoroutineAwaiterBase::setCoroutine(void *coroutine, ResumeFunction resume)
+{
+    m_dispatcher = QAbstractEventDispatcher::instance();
+    if (!m_dispatcher)
+        return false;
+    m_coroutine = coroutine;
+    m_resume = resume;
+    return true;
+}
+
+/*!
+    \internal
+
+    Makes the event dispatcher of the awaiting thread resume the coroutine.
+    Can be called from any thread, but only once per suspension.
+*/
+void QCoroutineAwaiterBase::resumeLater()
+{
+    if (m_pendingResume)
+        return;
+    m_pendingResume = new QCoroutineResumeEvent(this);
+    QCoreApplication::postEvent(m_dispatcher, m_pendingResume);
+}
+
+#if QT_CONFIG(future)
+/*!
+    \internal
+
+    Arranges for the coroutine to be resumed once \a future is finished.
+    Always suspends.
+*/
+bool QCoroutineAwaiterBase::suspendUntilFinished(const QFutureInterfaceBase &future)
+{
+    static_assert(sizeof(QCoroutineFutureWatch) <= sizeof(m_futureWatch));
+    static_assert(alignof(QCoroutineFutureWatch) <= alignof(void *));
+    Q_ASSERT(m_dispatcher);
+    Q_ASSERT(!m_watchingFuture);
+    auto watch = new (m_futureWatch) QCoroutineFutureWatch(this, future);
+    m_watchingFuture = true;
+    // if the future is finished already, this calls resumeLater() right away
+    future.d->connectOutputInterface(watch);
+    return true;
+}
+#endif
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
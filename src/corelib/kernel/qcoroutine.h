@@ -0,0 +1,309 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOROUTINE_H
+#define QCOROUTINE_H
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFutureInterfaceBase;
+class QObject;
+
+namespace QtPrivate {
+
+class QCoroutineResumeEvent;
+class QCoroutineFutureWatch;
+
+class Q_CORE_EXPORT QCoroutineAwaiterBase
+{
+    Q_DISABLE_COPY_MOVE(QCoroutineAwaiterBase)
+protected:
+    using ResumeFunction = void (*)(void *);
+
+    QCoroutineAwaiterBase() noexcept = default;
+    ~QCoroutineAwaiterBase();
+
+    bool setCoroutine(void *coroutine, ResumeFunction resume);
+    void resumeLater();
+
+#if QT_CONFIG(future)
+    bool suspendUntilFinished(const QFutureInterfaceBase &future);
+#endif
+
+private:
+    friend class QCoroutineResumeEvent;
+    friend class QCoroutineFutureWatch;
+
+    void *m_coroutine = nullptr;
+    ResumeFunction m_resume = nullptr;
+    QObject *m_dispatcher = nullptr;
+    QCoroutineResumeEvent *m_pendingResume = nullptr;
+#if QT_CONFIG(future)
+    // holds a QCoroutineFutureWatch while waiting for a future, so that
+    // waiting doesn't allocate
+    alignas(void *) unsigned char m_futureWatch[4 * sizeof(void *)];
+    bool m_watchingFuture = false;
+#endif
+};
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#if (defined(__cpp_impl_coroutine) && __has_include(<coroutine>)) || defined(Q_QDOC)
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <QtCore/qpromise.h>
+#endif
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+inline void qResumeCoroutine(void *address)
+{
+    std::coroutine_handle<>::from_address(address).resume();
+}
+
+#if QT_CONFIG(future)
+template <typename T>
+class QFutureAwaiter : public QCoroutineAwaiterBase
+{
+public:
+    explicit QFutureAwaiter(const QFuture<T> &future) : m_future(future) { }
+
+    bool await_ready() const { return m_future.isFinished(); }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> coroutine)
+    {
+        if (!setCoroutine(coroutine.address(), &qResumeCoroutine)) {
+            // nothing to resume us, block instead
+            m_future.waitForFinished();
+            return false;
+        }
+        return suspendUntilFinished(m_future.d);
+    }
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+            m_future.waitForFinished();
+        else
+            return m_future.result();
+    }
+
+private:
+    QFuture<T> m_future;
+};
+
+template <typename T>
+class QFutureCoroutinePromiseBase
+{
+public:
+    QFutureCoroutinePromiseBase() { m_promise.start(); }
+
+    QFuture<T> get_return_object() { return m_promise.future(); }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        m_promise.setException(std::current_exception());
+#endif
+        m_promise.finish();
+    }
+
+protected:
+    QPromise<T> m_promise;
+};
+
+template <typename T>
+class QFutureCoroutinePromise : public QFutureCoroutinePromiseBase<T>
+{
+public:
+    template <typename U = T>
+    void return_value(U &&value)
+    {
+        this->m_promise.addResult(std::forward<U>(value));
+        this->m_promise.finish();
+    }
+};
+
+template <>
+class QFutureCoroutinePromise<void> : public QFutureCoroutinePromiseBase<void>
+{
+public:
+    void return_void() { m_promise.finish(); }
+};
+#endif // QT_CONFIG(future)
+
+class QCoroutineSleepAwaiter : public QCoroutineAwaiterBase
+{
+public:
+    explicit QCoroutineSleepAwaiter(std::chrono::nanoseconds duration)
+        : m_duration(duration)
+    { }
+
+    bool await_ready() const noexcept { return m_duration <= std::chrono::nanoseconds::zero(); }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> coroutine)
+    {
+        if (!setCoroutine(coroutine.address(), &qResumeCoroutine)) {
+            qWarning("QtCoroutine::sleepFor: Cannot suspend in a thread without an event "
+                     "dispatcher");
+            return false;
+        }
+        m_timer.setSingleShot(true);
+        m_timer.setTimerType(Qt::PreciseTimer);
+        m_timer.callOnTimeout(&m_timer, [this] { resumeLater(); });
+        m_timer.start(std::chrono::ceil<std::chrono::milliseconds>(m_duration));
+        return true;
+    }
+    void await_resume() const noexcept { }
+
+private:
+    std::chrono::nanoseconds m_duration;
+    QTimer m_timer;
+};
+
+class QCoroutineTimeoutAwaiter : public QCoroutineAwaiterBase
+{
+public:
+    explicit QCoroutineTimeoutAwaiter(QTimer *timer) : m_timer(timer) { }
+    ~QCoroutineTimeoutAwaiter()
+    {
+        for (const QMetaObject::Connection &connection : m_connections)
+            QObject::disconnect(connection);
+    }
+
+    bool await_ready() const noexcept { return !m_timer; }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> coroutine)
+    {
+        Q_ASSERT_X(m_timer->thread() == QThread::currentThread(), "QtCoroutine::timeout",
+                   "The timer must live in the thread of the awaiting coroutine");
+        if (!setCoroutine(coroutine.address(), &qResumeCoroutine)) {
+            qWarning("QtCoroutine::timeout: Cannot suspend in a thread without an event "
+                     "dispatcher");
+            return false;
+        }
+        m_connections[0] = QObject::connect(m_timer, &QTimer::timeout, m_timer, [this] {
+            m_timedOut = true;
+            resumeLater();
+        }, Qt::SingleShotConnection);
+        m_connections[1] = QObject::connect(m_timer, &QObject::destroyed, m_timer,
+                                            [this] { resumeLater(); });
+        return true;
+    }
+    bool await_resume() const noexcept { return m_timedOut; }
+
+private:
+    QTimer *m_timer;
+    QMetaObject::Connection m_connections[2];
+    bool m_timedOut = false;
+};
+
+class QCoroutineReadyReadAwaiter : public QCoroutineAwaiterBase
+{
+public:
+    explicit QCoroutineReadyReadAwaiter(QIODevice *device) : m_device(device) { }
+    ~QCoroutineReadyReadAwaiter()
+    {
+        for (const QMetaObject::Connection &connection : m_connections)
+            QObject::disconnect(connection);
+    }
+
+    bool await_ready() const
+    {
+        // random-access devices never announce data, it is all there already
+        return !m_device || !m_device->isReadable() || !m_device->isSequential()
+                || m_device->bytesAvailable() > 0;
+    }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> coroutine)
+    {
+        Q_ASSERT_X(m_device->thread() == QThread::currentThread(), "QtCoroutine::readyRead",
+                   "The device must live in the thread of the awaiting coroutine");
+        if (!setCoroutine(coroutine.address(), &qResumeCoroutine)) {
+            qWarning("QtCoroutine::readyRead: Cannot suspend in a thread without an event "
+                     "dispatcher");
+            return false;
+        }
+        const auto resume = [this] { resumeLater(); };
+        m_connections[0] = QObject::connect(m_device, &QIODevice::readyRead, m_device, resume);
+        m_connections[1] = QObject::connect(m_device, &QIODevice::readChannelFinished,
+                                            m_device, resume);
+        m_connections[2] = QObject::connect(m_device, &QIODevice::aboutToClose, m_device, resume);
+        m_connections[3] = QObject::connect(m_device, &QObject::destroyed, m_device, [this] {
+            m_device = nullptr;
+            resumeLater();
+        });
+        return true;
+    }
+    qint64 await_resume() const
+    {
+        if (!m_device)
+            return -1;
+        return m_device->isReadable() ? m_device->bytesAvailable() : 0;
+    }
+
+private:
+    QIODevice *m_device;
+    QMetaObject::Connection m_connections[4];
+};
+
+} // namespace QtPrivate
+
+namespace QtCoroutine {
+
+template <typename Rep, typename Period>
+[[nodiscard]] inline auto sleepFor(std::chrono::duration<Rep, Period> duration)
+{
+    return QtPrivate::QCoroutineSleepAwaiter(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+}
+
+[[nodiscard]] inline auto timeout(QTimer *timer)
+{
+    return QtPrivate::QCoroutineTimeoutAwaiter(timer);
+}
+
+[[nodiscard]] inline auto readyRead(QIODevice *device)
+{
+    return QtPrivate::QCoroutineReadyReadAwaiter(device);
+}
+
+} // namespace QtCoroutine
+
+#if QT_CONFIG(future)
+template <typename T>
+inline auto operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::QFutureAwaiter<T>(future);
+}
+#endif
+
+QT_END_NAMESPACE
+
+#if QT_CONFIG(future)
+template <typename T, typename... Args>
+struct std::coroutine_traits<QT_PREPEND_NAMESPACE(QFuture)<T>, Args...>
+{
+    using promise_type = QT_PREPEND_NAMESPACE(QtPrivate)::QFutureCoroutinePromise<T>;
+};
+#endif
+
+#endif // __cpp_impl_coroutine
+
+#endif // QCOROUTINE_H
@@ -176,14 +176,124 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0 && !initEpoll())
+        qErrnoWarning("QEventDispatcherUNIX: Unable to create epoll instance, falling back to poll()");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     timerList.clearTimers();
 }
 
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+// we pass the poll(2) event masks straight through to epoll(7)
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI);
+static_assert(EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        return false;
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpoll(int fd, short oldEvents, short newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+    if (newEvents == 0) {
+        // closing the descriptor removes it from the epoll set implicitly,
+        // so failure here is expected and harmless
+        if (!alwaysReadyFds.removeOne(fd))
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        return;
+    }
+
+    if (alwaysReadyFds.contains(fd))
+        return;
+
+    epoll_event ev = {};
+    ev.events = quint16(newEvents);
+    ev.data.fd = fd;
+
+    int ret = epoll_ctl(epollFd, oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+    if (ret == -1 && errno == ENOENT) {
+        // the old descriptor was closed and its number reused
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else if (ret == -1 && errno == EEXIST) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    if (ret == -1) {
+        if (errno == EPERM)
+            alwaysReadyFds.append(fd);
+        else
+            qErrnoWarning("QSocketNotifier: Unable to watch socket %d", fd);
+    }
+}
+
+int QEventDispatcherUNIXPrivate::processEpoll(QDeadlineTimer deadline)
+{
+    if (!alwaysReadyFds.isEmpty())
+        deadline = QDeadlineTimer();
+
+    // level-triggered: whatever does not fit is reported again next time
+    epollEvents.resize(qBound(qsizetype(1), socketNotifiers.size() + 1, qsizetype(1024)));
+
+    int ret;
+    do {
+        int timeout = -1;
+        if (!deadline.isForever()) {
+            // round up so that we do not wake up before the next timer is due
+            const milliseconds remaining = ceil<milliseconds>(deadline.remainingTimeAsDuration());
+            timeout = int(qMin(remaining.count(), milliseconds::rep(INT_MAX)));
+        }
+        ret = epoll_wait(epollFd, epollEvents.data(), int(epollEvents.size()), timeout);
+    } while (ret == -1 && errno == EINTR);
+
+    if (ret == -1)
+        return -1;
+
+    int nevents = 0;
+    for (int i = 0; i < ret; ++i) {
+        const epoll_event &ev = epollEvents.at(i);
+        if (ev.data.fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = short(ev.events);
+            nevents += threadPipe.check(pfd);
+        } else {
+            markPendingSocketNotifiers(ev.data.fd, short(ev.events));
+        }
+    }
+
+    for (int fd : std::as_const(alwaysReadyFds))
+        markPendingSocketNotifiers(fd, POLLIN | POLLOUT);
+
+    return nevents + activateSocketNotifiers();
+}
+#endif // QT_EVENTDISPATCHER_UNIX_EPOLL
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -205,38 +315,45 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
+        Q_ASSERT(socketNotifiers.contains(pfd.fd));
+        markPendingSocketNotifiers(pfd.fd, pfd.revents);
+    }
+
+    pollfds.clear();
+}
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(int fd, short revents)
+{
+    auto it = socketNotifiers.find(fd);
+    if (it == socketNotifiers.end())
+        return; // stale epoll event for a descriptor that was closed and reused
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+    const QSocketNotifierSetUNIX &sn_set = it.value();
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
 
-            if (!notifier)
-                continue;
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     it.key(), socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -356,12 +473,20 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
 
     Q_D(QEventDispatcherUNIX);
     QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+    const short oldEvents = sn_set.events();
 
     if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
     sn_set.notifiers[type] = notifier;
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (d->epollFd >= 0)
+        d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
+    Q_UNUSED(oldEvents);
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -400,8 +525,16 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+    const short oldEvents = sn_set.events();
     sn_set.notifiers[type] = nullptr;
 
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (d->epollFd >= 0)
+        d->updateEpoll(sockfd, oldEvents, sn_set.events());
+#else
+    Q_UNUSED(oldEvents);
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -445,6 +578,25 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         // ensures the code in the do-while loop in qt_safe_poll runs at least once.
     }
 
+    int nevents = 0;
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (d->epollFd >= 0 && include_notifiers) {
+        const int ret = d->processEpoll(deadline);
+        if (ret == -1) {
+            qErrnoWarning("epoll_wait");
+            if (QT_CONFIG(poll_exit_on_error))
+                abort();
+        } else {
+            nevents += ret;
+        }
+
+        if (include_timers)
+            nevents += d->activateTimers();
+
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -455,7 +607,6 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
     switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), deadline)) {
     case -1:
         qErrnoWarning("qt_safe_poll");
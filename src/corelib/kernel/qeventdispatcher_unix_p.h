@@ -23,6 +23,11 @@
 #include "QtCore/qhash.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if defined(Q_OS_LINUX) && __has_include(<sys/epoll.h>)
+#  include <sys/epoll.h>
+#  define QT_EVENTDISPATCHER_UNIX_EPOLL
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -100,9 +105,25 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifiers(int fd, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    bool initEpoll();
+    void updateEpoll(int fd, short oldEvents, short newEvents);
+    int processEpoll(QDeadlineTimer deadline);
+
+    // When epollFd is valid, the socket notifiers are kept registered in the
+    // kernel and only updated when a notifier is enabled or disabled, instead
+    // of rebuilding (and scanning) pollfds on every loop iteration.
+    int epollFd = -1;
+    QVarLengthArray<epoll_event, 64> epollEvents;
+    // descriptors that epoll refuses (EPERM, e.g. regular files); poll(2)
+    // reports those as always ready, so we do the same
+    QVarLengthArray<int, 4> alwaysReadyFds;
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
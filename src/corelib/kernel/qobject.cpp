@@ -198,6 +198,8 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
+    // this includes the events in the post event inbox, see
+    // QCoreApplicationPrivate::postMetaCallEvent()
     if (postedEvents)
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
@@ -278,6 +280,7 @@ inline void QObjectPrivate::addConnection(int signal, Connection *c)
     cd->resizeSignalVector(signal + 1);
 
     ConnectionList &connectionList = cd->connectionsForSignal(signal);
+    cd->invalidateConnectionArray(connectionList);
     if (connectionList.last.loadRelaxed()) {
         Q_ASSERT(connectionList.last.loadRelaxed()->receiver.loadRelaxed());
         connectionList.last.loadRelaxed()->nextConnectionList.storeRelaxed(c);
@@ -302,6 +305,7 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
 {
     Q_ASSERT(c->receiver.loadRelaxed());
     ConnectionList &connections = signalVector.loadRelaxed()->at(c->signal_index);
+    invalidateConnectionArray(connections);
     c->receiver.storeRelaxed(nullptr);
     QThreadData *td = c->receiverThreadData.loadRelaxed();
     if (td)
@@ -399,6 +403,9 @@ inline void QObjectPrivate::ConnectionData::deleteOrphaned(TaggedSignalVector o)
         if (SignalVector *v = static_cast<SignalVector *>(o)) {
             next = v->nextInOrphanList;
             free(v);
+        } else if (ConnectionArray *a = static_cast<ConnectionArray *>(o)) {
+            next = a->nextInOrphanList;
+            free(a);
         } else {
             QObjectPrivate::Connection *c = static_cast<Connection *>(o);
             next = c->nextInOrphanList;
@@ -411,6 +418,49 @@ inline void QObjectPrivate::ConnectionData::deleteOrphaned(TaggedSignalVector o)
     }
 }
 
+/*! \internal
+
+  Returns the flat snapshot of \a list, building it if needed, or \nullptr if the
+  list should be walked instead: because it is too short to be worth it, because
+  \a vector is no longer the current signal vector, or because the sender's lock
+  is busy. Never blocks, so that activate() doesn't contend with connect().
+*/
+QObjectPrivate::ConnectionArray *
+QObjectPrivate::ConnectionData::connectionArray(QObject *sender, const SignalVector *vector,
+                                                ConnectionList &list)
+{
+    std::unique_lock<QBasicMutex> lock(*signalSlotLock(sender), std::try_to_lock);
+    if (!lock.owns_lock())
+        return nullptr;
+
+    if (signalVector.loadRelaxed() != vector)
+        return nullptr;
+    if (ConnectionArray *array = list.array.loadRelaxed())
+        return array;
+
+    quintptr count = 0;
+    for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed()) {
+        if (c->receiver.loadRelaxed())
+            ++count;
+    }
+    if (count < 2)
+        return nullptr;
+
+    void *ptr = malloc(sizeof(ConnectionArray) + count * sizeof(Connection *));
+    if (!ptr)
+        return nullptr;
+    auto array = new (ptr) ConnectionArray;
+    array->next = nullptr;
+    array->count = count;
+    Connection **it = array->begin();
+    for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed()) {
+        if (c->receiver.loadRelaxed())
+            *it++ = c;
+    }
+    list.array.storeRelease(array);
+    return array;
+}
+
 /*! \internal
 
   Returns \c true if the signal with index \a signal_index from object \a sender is connected.
@@ -480,6 +530,174 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+namespace {
+/*
+    Queued connections allocate a QMetaCallEvent in the emitting thread and
+    delete it in the receiving one. Rather than making both threads go through
+    the global allocator for every event, each thread keeps a cache of event
+    blocks; blocks freed by other threads are returned to their owner through
+    a lock-free list, so a thread streaming signals to another one keeps
+    recycling the same memory. Smaller meta call events can share the blocks.
+*/
+class QMetaCallEventPool
+{
+    struct alignas(std::max_align_t) Header
+    {
+        QMetaCallEventPool *owner;
+        Header *next;
+    };
+    static constexpr qsizetype MaxCachedBlocks = 1024;
+
+public:
+    static void *allocate(size_t size)
+    {
+        QMetaCallEventPool *pool = size <= sizeof(QMetaCallEvent) ? current() : nullptr;
+        Header *block = pool ? pool->take() : nullptr;
+        if (!block) {
+            const size_t blockSize = pool ? sizeof(QMetaCallEvent) : size;
+            block = static_cast<Header *>(::operator new(sizeof(Header) + blockSize));
+        }
+        block->owner = pool;
+        if (pool)
+            pool->refs.fetch_add(1, std::memory_order_relaxed);
+        return block + 1;
+    }
+
+    static void deallocate(void *ptr) noexcept
+    {
+        if (!ptr)
+            return;
+        Header *block = static_cast<Header *>(ptr) - 1;
+        QMetaCallEventPool *pool = block->owner;
+        if (!pool) {
+            ::operator delete(block);
+            return;
+        }
+        if (pool == currentPool)
+            pool->putLocal(block);
+        else
+            pool->putRemote(block);
+        pool->deref();
+    }
+
+private:
+    static inline thread_local QMetaCallEventPool *currentPool = nullptr;
+    static inline thread_local bool threadExited = false;
+
+    struct ThreadExitGuard
+    {
+        ~ThreadExitGuard()
+        {
+            threadExited = true;
+            if (QMetaCallEventPool *pool = std::exchange(currentPool, nullptr))
+                pool->release();
+        }
+    };
+
+    static QMetaCallEventPool *current()
+    {
+        if (Q_LIKELY(currentPool) || threadExited)
+            return currentPool;
+        static thread_local ThreadExitGuard guard;
+        Q_UNUSED(guard);
+        currentPool = new QMetaCallEventPool;
+        return currentPool;
+    }
+
+    Header *take() noexcept
+    {
+        if (!localBlocks) {
+            localBlocks = remoteBlocks.exchange(nullptr, std::memory_order_acquire);
+            remoteCount.store(0, std::memory_order_relaxed);
+            localCount = 0;
+            for (Header *b = localBlocks; b; b = b->next)
+                ++localCount;
+        }
+        Header *block = localBlocks;
+        if (block) {
+            localBlocks = block->next;
+            --localCount;
+        }
+        return block;
+    }
+
+    void putLocal(Header *block) noexcept
+    {
+        if (localCount >= MaxCachedBlocks) {
+            ::operator delete(block);
+            return;
+        }
+        block->next = localBlocks;
+        localBlocks = block;
+        ++localCount;
+    }
+
+    void putRemote(Header *block) noexcept
+    {
+        if (remoteCount.load(std::memory_order_relaxed) >= MaxCachedBlocks) {
+            ::operator delete(block);
+            return;
+        }
+        remoteCount.fetch_add(1, std::memory_order_relaxed);
+        Header *head = remoteBlocks.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!remoteBlocks.compare_exchange_weak(head, block, std::memory_order_release,
+                                                     std::memory_order_relaxed));
+    }
+
+    static void freeList(Header *block) noexcept
+    {
+        while (block)
+            ::operator delete(std::exchange(block, block->next));
+    }
+
+    // called by the owning thread when it exits
+    void release() noexcept
+    {
+        freeList(std::exchange(localBlocks, nullptr));
+        localCount = 0;
+        deref();
+    }
+
+    void deref() noexcept
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            freeList(localBlocks);
+            freeList(remoteBlocks.load(std::memory_order_acquire));
+            delete this;
+        }
+    }
+
+    // owned by the thread the pool belongs to
+    Header *localBlocks = nullptr;
+    qsizetype localCount = 0;
+
+    // blocks freed by other threads
+    std::atomic<Header *> remoteBlocks = nullptr;
+    std::atomic<qsizetype> remoteCount = 0;
+
+    // one for the owning thread plus one per block in use
+    std::atomic<qsizetype> refs = 1;
+};
+} // unnamed namespace
+
+/*!
+    \internal
+ */
+void *QMetaCallEvent::operator new(size_t size)
+{
+    return QMetaCallEventPool::allocate(size);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr) noexcept
+{
+    QMetaCallEventPool::deallocate(ptr);
+}
+
 /*!
     \internal
  */
@@ -1697,6 +1915,9 @@ bool QObject::moveToThread(QThread *targetThread QT6_IMPL_NEW_OVERLOAD_TAIL)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // the events posted to us without locking move along with the others
+    QCoreApplicationPrivate::takePostEventInbox(currentData);
+
     // move the object
     auto threadPrivate =  targetThread
         ? static_cast<QThreadPrivate *>(QThreadPrivate::get(targetThread))
@@ -1709,6 +1930,11 @@ bool QObject::moveToThread(QThread *targetThread QT6_IMPL_NEW_OVERLOAD_TAIL)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // pairs with the fence in QCoreApplicationPrivate::postMetaCallEvent():
+    // forward anything posted to the old thread while we were moving
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    QCoreApplicationPrivate::takePostEventInbox(currentData);
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3991,7 +4217,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
 }
 
 template <bool callbacks_enabled>
@@ -4035,7 +4261,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
     QObjectPrivate::ConnectionDataPointer connections(sp->connections.loadAcquire());
     QObjectPrivate::SignalVector *signalVector = connections->signalVector.loadRelaxed();
 
-    const QObjectPrivate::ConnectionList *list;
+    QObjectPrivate::ConnectionList *list;
     if (signal_index < signalVector->count())
         list = &signalVector->at(signal_index);
     else
@@ -4052,11 +4278,38 @@ void doActivate(QObject *sender, int signal_index, void **argv)
         if (!c)
             continue;
 
+        // With more than one receiver, walk the flat snapshot of the list rather
+        // than chasing nextConnectionList through the heap.
+        QObjectPrivate::Connection **it = nullptr;
+        QObjectPrivate::Connection **end = nullptr;
+        if (c != list->last.loadRelaxed()) {
+            QObjectPrivate::ConnectionArray *array = list->array.loadAcquire();
+            if (!array)
+                array = connections->connectionArray(sender, signalVector, *list);
+            if (array) {
+                it = array->begin();
+                end = array->end();
+                c = *it;
+            }
+        }
+
         do {
             QObject * const receiver = c->receiver.loadRelaxed();
             if (!receiver)
                 continue;
 
+            // A functor connected without a context object has the sender as its
+            // receiver, so when emitting from the sender's thread it's a plain call.
+            if (c->isSlotObject && receiver == sender && inSenderThread && !c->isSingleShot
+                && (c->connectionType == Qt::AutoConnection
+                    || c->connectionType == Qt::DirectConnection)) {
+                QObjectPrivate::Sender senderData(receiver, sender, signal_index, connections.data());
+                SlotObjectGuard obj{c->slotObj};
+                Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, c->slotObj);
+                obj->call(receiver, argv);
+                continue;
+            }
+
             QThreadData *td = c->receiverThreadData.loadRelaxed();
             if (!td)
                 continue;
@@ -4149,7 +4402,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                 if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
                     signal_spy_set->slot_end_callback(receiver, method);
             }
-        } while ((c = c->nextConnectionList.loadRelaxed()) != nullptr && c->id <= highestConnectionId);
+        } while ((c = it ? (++it != end ? *it : nullptr) : c->nextConnectionList.loadRelaxed()) != nullptr
+                 && c->id <= highestConnectionId);
 
     } while (list != &signalVector->at(-1) &&
         //start over for all signals;
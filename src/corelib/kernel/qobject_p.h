@@ -107,6 +107,7 @@ public:
 
     typedef void (*StaticMetaCallFunction)(QObject *, QMetaObject::Call, int, void **);
     struct Connection;
+    struct ConnectionArray;
     struct ConnectionData;
     struct ConnectionList;
     struct ConnectionOrSignalVector;
@@ -394,6 +395,9 @@ public:
 
     ~QMetaCallEvent() override;
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr) noexcept;
+
     template<typename ...Args>
     static QMetaCallEvent *create(QtPrivate::QSlotObjectBase *slotObj, const QObject *sender,
                                   int signal_index, const Args &...argv)
@@ -436,6 +440,8 @@ private:
                                        const QMetaType metaTypes[]);
     inline void allocArgs();
 
+    friend class QCoreApplicationPrivate;
+
     struct Data {
         QtPrivate::SlotObjUniquePtr slotObj_;
         void **args_;
@@ -446,6 +452,11 @@ private:
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+
+    // link in the receiving thread's post event inbox, see
+    // QCoreApplicationPrivate::postMetaCallEvent()
+    QObject *inboxReceiver_ = nullptr;
+    QMetaCallEvent *inboxNext_ = nullptr;
 };
 
 class QBoolBlocker
@@ -30,6 +30,8 @@ struct QObjectPrivate::ConnectionList
 {
     QAtomicPointer<Connection> first;
     QAtomicPointer<Connection> last;
+    // flat copy of the list used by activate(), built lazily and dropped on every change
+    QAtomicPointer<ConnectionArray> array;
 };
 static_assert(std::is_trivially_destructible_v<QObjectPrivate::ConnectionList>);
 Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_RELOCATABLE_TYPE);
@@ -40,12 +42,19 @@ struct QObjectPrivate::TaggedSignalVector
 
     TaggedSignalVector() = default;
     TaggedSignalVector(std::nullptr_t) noexcept : c(0) {}
-    TaggedSignalVector(Connection *v) noexcept : c(reinterpret_cast<quintptr>(v)) { Q_ASSERT(v && (reinterpret_cast<quintptr>(v) & 0x1) == 0);   }
+    TaggedSignalVector(Connection *v) noexcept : c(reinterpret_cast<quintptr>(v)) { Q_ASSERT(v && (reinterpret_cast<quintptr>(v) & 0x3) == 0);   }
     TaggedSignalVector(SignalVector *v) noexcept : c(reinterpret_cast<quintptr>(v) | quintptr(1u)) { Q_ASSERT(v); }
+    TaggedSignalVector(ConnectionArray *v) noexcept : c(reinterpret_cast<quintptr>(v) | quintptr(2u)) { Q_ASSERT(v); }
     explicit operator SignalVector *() const noexcept
     {
-        if (c & 0x1)
-            return reinterpret_cast<SignalVector *>(c & ~quintptr(1u));
+        if ((c & 0x3) == 1)
+            return reinterpret_cast<SignalVector *>(c & ~quintptr(3u));
+        return nullptr;
+    }
+    explicit operator ConnectionArray *() const noexcept
+    {
+        if ((c & 0x3) == 2)
+            return reinterpret_cast<ConnectionArray *>(c & ~quintptr(3u));
         return nullptr;
     }
     explicit operator Connection *() const noexcept
@@ -133,6 +142,17 @@ struct QObjectPrivate::SignalVector : public ConnectionOrSignalVector
 static_assert(
         std::is_trivial_v<QObjectPrivate::SignalVector>); // it doesn't need to be, but it helps
 
+// Immutable snapshot of a ConnectionList, in list order. activate() walks it instead of
+// following nextConnectionList; any change to the list orphans the snapshot.
+struct QObjectPrivate::ConnectionArray : public ConnectionOrSignalVector
+{
+    quintptr count;
+    // Connection *connections[]
+    Connection **begin() { return reinterpret_cast<Connection **>(this + 1); }
+    Connection **end() { return begin() + count; }
+};
+static_assert(std::is_trivial_v<QObjectPrivate::ConnectionArray>);
+
 struct QObjectPrivate::ConnectionData
 {
     // the id below is used to avoid activating new connections. When the object gets
@@ -152,6 +172,8 @@ struct QObjectPrivate::ConnectionData
             deleteOrphaned(c);
         SignalVector *v = signalVector.loadRelaxed();
         if (v) {
+            for (int i = -1; i < v->count(); ++i)
+                free(v->at(i).array.loadRelaxed());
             v->~SignalVector();
             free(v);
         }
@@ -174,6 +196,21 @@ struct QObjectPrivate::ConnectionData
     }
     void cleanOrphanedConnectionsImpl(QObject *sender, LockPolicy lockPolicy);
 
+    // must be called with the sender's lock held, whenever the list is modified
+    void invalidateConnectionArray(ConnectionList &list)
+    {
+        ConnectionArray *array = list.array.loadRelaxed();
+        if (!array)
+            return;
+        list.array.storeRelaxed(nullptr);
+        // an activate() in progress might still be walking the array
+        TaggedSignalVector o = orphaned.load(std::memory_order_acquire);
+        do {
+            array->nextInOrphanList = o;
+        } while (!orphaned.compare_exchange_strong(o, TaggedSignalVector(array), std::memory_order_release));
+    }
+    ConnectionArray *connectionArray(QObject *sender, const SignalVector *vector, ConnectionList &list);
+
     ConnectionList &connectionsForSignal(int signal)
     {
         return signalVector.loadRelaxed()->at(signal);
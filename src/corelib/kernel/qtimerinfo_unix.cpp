@@ -4,6 +4,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -12,6 +13,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 using namespace std::chrono;
 // Implied by "using namespace std::chrono", but be explicit about it, for grep-ability
 using namespace std::chrono_literals;
@@ -37,7 +40,7 @@ steady_clock::time_point QTimerInfoList::updateCurrentTime() const
     Updates the currentTime member to the current time, and returns \c true if
     the first timer's timeout is in the future (after currentTime).
 
-    The list is sorted by timeout, thus it's enough to check the first timer only.
+    The heap is ordered by timeout, thus it's enough to check the first timer only.
 */
 bool QTimerInfoList::hasPendingTimers()
 {
@@ -47,15 +50,84 @@ bool QTimerInfoList::hasPendingTimers()
 }
 
 static bool byTimeout(const QTimerInfo *a, const QTimerInfo *b)
-{ return a->timeout < b->timeout; };
+{
+    if (a->timeout != b->timeout)
+        return a->timeout < b->timeout;
+    return a->sequence < b->sequence;
+};
+
+void QTimerInfoList::siftUp(qsizetype index)
+{
+    QTimerInfo *t = timers.at(index);
+    while (index > 0) {
+        const qsizetype parent = (index - 1) / 2;
+        QTimerInfo *p = timers.at(parent);
+        if (!byTimeout(t, p))
+            break;
+        timers[index] = p;
+        p->heapIndex = index;
+        index = parent;
+    }
+    timers[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::siftDown(qsizetype index)
+{
+    const qsizetype n = timers.size();
+    QTimerInfo *t = timers.at(index);
+    for (;;) {
+        qsizetype child = 2 * index + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && byTimeout(timers.at(child + 1), timers.at(child)))
+            ++child;
+        QTimerInfo *c = timers.at(child);
+        if (!byTimeout(c, t))
+            break;
+        timers[index] = c;
+        c->heapIndex = index;
+        index = child;
+    }
+    timers[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::heapRemove(QTimerInfo *t)
+{
+    const qsizetype index = t->heapIndex;
+    Q_ASSERT(timers.at(index) == t);
+    QTimerInfo *last = timers.takeLast();
+    t->heapIndex = -1;
+    if (last == t)
+        return;
+
+    timers[index] = last;
+    last->heapIndex = index;
+    if (index > 0 && byTimeout(last, timers.at((index - 1) / 2)))
+        siftUp(index);
+    else
+        siftDown(index);
+}
+
+void QTimerInfoList::heapify()
+{
+    for (qsizetype i = 0; i < timers.size(); ++i)
+        timers.at(i)->heapIndex = i;
+    for (qsizetype i = timers.size() / 2 - 1; i >= 0; --i)
+        siftDown(i);
+}
 
 /*
   insert timer info into list
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    timers.insert(std::upper_bound(timers.cbegin(), timers.cend(), ti, byTimeout),
-                  ti);
+    // timers with equal timeouts fire in the order they were (re)inserted
+    ti->sequence = nextSequence++;
+    timers.append(ti);
+    siftUp(timers.size() - 1);
+    timersById.insert(ti->id, ti);
 }
 
 static constexpr milliseconds roundToMillisecond(nanoseconds val)
@@ -239,13 +311,30 @@ std::optional<QTimerInfoList::Duration> QTimerInfoList::timerWait()
 {
     steady_clock::time_point now = updateCurrentTime();
 
-    auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
-    // Find first waiting timer not already active
-    auto it = std::find_if(timers.cbegin(), timers.cend(), isWaiting);
-    if (it == timers.cend())
+    // Find first waiting timer not already active. Only timers currently
+    // being activated further up the stack are skipped, so this only
+    // descends into the subtrees below those few.
+    const QTimerInfo *first = nullptr;
+    QVarLengthArray<qsizetype, 16> pending = { 0 };
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.back();
+        pending.removeLast();
+        if (index >= timers.size())
+            continue;
+        const QTimerInfo *t = timers.at(index);
+        if (first && !byTimeout(t, first))
+            continue;
+        if (!t->activateRef) {
+            first = t;
+        } else {
+            pending.append(2 * index + 1);
+            pending.append(2 * index + 2);
+        }
+    }
+    if (!first)
         return std::nullopt;
 
-    Duration timeToWait = (*it)->timeout - now;
+    Duration timeToWait = first->timeout - now;
     if (timeToWait > 0ns)
         return roundToMillisecond(timeToWait);
     return 0ms;
@@ -260,15 +349,14 @@ QTimerInfoList::Duration QTimerInfoList::remainingDuration(Qt::TimerId timerId)
 {
     const steady_clock::time_point now = updateCurrentTime();
 
-    auto it = findTimerById(timerId);
-    if (it == timers.cend()) {
+    const QTimerInfo *t = findTimerById(timerId);
+    if (!t) {
 #ifndef QT_NO_DEBUG
         qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", int(timerId));
 #endif
         return Duration::min();
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return t->timeout - now;
     return 0ms;
@@ -319,18 +407,17 @@ void QTimerInfoList::registerTimer(Qt::TimerId timerId, QTimerInfoList::Duration
 
 bool QTimerInfoList::unregisterTimer(Qt::TimerId timerId)
 {
-    auto it = findTimerById(timerId);
-    if (it == timers.cend())
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
         return false; // id not found
 
     // set timer inactive
-    QTimerInfo *t = *it;
     if (t == firstTimerInfo)
         firstTimerInfo = nullptr;
     if (t->activateRef)
         *(t->activateRef) = nullptr;
+    heapRemove(t);
     delete t;
-    timers.erase(it);
     return true;
 }
 
@@ -346,6 +433,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
                     firstTimerInfo = nullptr;
                 if (t->activateRef)
                     *(t->activateRef) = nullptr;
+                timersById.remove(t->id);
                 delete t;
                 return true;
             }
@@ -354,16 +442,24 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
     };
 
     qsizetype count = timers.removeIf(associatedWith(object));
+    if (count > 0)
+        heapify();
     return count > 0;
 }
 
 auto QTimerInfoList::registeredTimers(QObject *object) const -> QList<TimerInfo>
 {
-    QList<TimerInfo> list;
+    QVarLengthArray<const QTimerInfo *, 8> matching;
     for (const auto &t : timers) {
         if (t->obj == object)
-            list.emplaceBack(TimerInfo{t->interval, t->id, t->timerType});
+            matching.append(t);
     }
+    std::sort(matching.begin(), matching.end(), byTimeout);
+
+    QList<TimerInfo> list;
+    list.reserve(matching.size());
+    for (const QTimerInfo *t : std::as_const(matching))
+        list.emplaceBack(TimerInfo{t->interval, t->id, t->timerType});
     return list;
 }
 
@@ -379,11 +475,19 @@ int QTimerInfoList::activateTimers()
 
     const steady_clock::time_point now = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << now;
-    // Find out how many timer have expired
-    auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
-    // Find first one still active (list is sorted by timeout)
-    auto it = std::find_if(timers.cbegin(), timers.cend(), stillActive);
-    auto maxCount = it - timers.cbegin();
+    // Find out how many timer have expired (the subtree below a timer that
+    // is still active need not be visited)
+    qsizetype maxCount = 0;
+    QVarLengthArray<qsizetype, 64> pending = { 0 };
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.back();
+        pending.removeLast();
+        if (index >= timers.size() || now < timers.at(index)->timeout)
+            continue;
+        ++maxCount;
+        pending.append(2 * index + 1);
+        pending.append(2 * index + 2);
+    }
 
     int n_act = 0;
     //fire the timers.
@@ -405,15 +509,11 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // determine next timeout time
+        // determine next timeout time, and move "currentTimerInfo" behind
+        // all timers with the same timeout to keep the heap ordered
         calculateNextTimeout(currentTimerInfo, now);
-        if (timers.size() > 1) {
-            // Find where "currentTimerInfo" should be in the list so as
-            // to keep the list ordered by timeout
-            auto afterCurrentIt = timers.begin() + 1;
-            auto iter = std::upper_bound(afterCurrentIt, timers.end(), currentTimerInfo, byTimeout);
-            currentTimerInfo = *std::rotate(timers.begin(), afterCurrentIt, iter);
-        }
+        currentTimerInfo->sequence = nextSequence++;
+        siftDown(0);
 
         if (currentTimerInfo->interval > 0ms)
             n_act++;
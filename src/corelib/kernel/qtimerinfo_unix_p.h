@@ -18,6 +18,7 @@
 #include <QtCore/private/qglobal_p.h>
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timespec
 #include <chrono>
@@ -40,6 +41,8 @@ struct QTimerInfo
     Qt::TimerType timerType; // - timer type
     QObject *obj = nullptr; // - object to receive event
     QTimerInfo **activateRef = nullptr; // - ref from activateTimers
+    quint64 sequence = 0;               // - orders timers with equal timeouts
+    qsizetype heapIndex = -1;           // - position in QTimerInfoList::timers
 };
 
 class Q_CORE_EXPORT QTimerInfoList
@@ -69,24 +72,36 @@ public:
     {
         qDeleteAll(timers);
         timers.clear();
+        timersById.clear();
     }
 
     bool isEmpty() const { return timers.empty(); }
 
     qsizetype size() const { return timers.size(); }
 
-    auto findTimerById(Qt::TimerId timerId) const
+    QTimerInfo *findTimerById(Qt::TimerId timerId) const
     {
-        auto matchesId = [timerId](const auto &t) { return t->id == timerId; };
-        return std::find_if(timers.cbegin(), timers.cend(), matchesId);
+        return timersById.value(timerId);
     }
 
 private:
     std::chrono::steady_clock::time_point updateCurrentTime() const;
 
+    void siftUp(qsizetype index);
+    void siftDown(qsizetype index);
+    void heapRemove(QTimerInfo *t);
+    void heapify();
+
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo = nullptr;
+
+    // binary min-heap ordered by timeout (and by insertion order among equal
+    // timeouts), so that starting and stopping timers is O(log n) instead of
+    // O(n); coarse timers share rounded timeouts and restarts are usually
+    // pushed to the back, so insertion is O(1) in practice
     QList<QTimerInfo *> timers;
+    QHash<Qt::TimerId, QTimerInfo *> timersById;
+    quint64 nextSequence = 0;
 };
 
 QT_END_NAMESPACE
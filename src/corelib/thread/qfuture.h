@@ -21,6 +21,11 @@ QT_BEGIN_NAMESPACE
 template <typename T>
 class QFutureWatcher;
 
+namespace QtPrivate {
+template <typename T>
+class QFutureAwaiter;
+}
+
 template <typename T>
 class QFuture
 {
@@ -295,6 +300,9 @@ private:
 
     friend struct QtPrivate::UnwrapHandler;
 
+    template<typename U>
+    friend class QtPrivate::QFutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
@@ -32,6 +32,8 @@ class CompactContinuation;
 
 class ExceptionStore;
 
+class QCoroutineAwaiterBase;
+
 template<class Function, class ResultType>
 class CanceledHandler;
 
@@ -187,6 +189,8 @@ private:
     template<class T>
     friend class QPromise;
 
+    friend class QtPrivate::QCoroutineAwaiterBase;
+
 protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
@@ -251,6 +255,7 @@ public:
     inline bool reportResult(T &&result, int index = -1);
     inline bool reportResult(const T &result, int index = -1);
     inline bool reportResults(const QList<T> &results, int beginIndex = -1, int count = -1);
+    inline bool reportAndMoveResults(QList<T> &&results, int beginIndex = -1);
     inline bool reportFinished(const T *result);
     void reportFinished()
     {
@@ -369,6 +374,29 @@ inline bool QFutureInterface<T>::reportResults(const QList<T> &_results, int beg
     return true;
 }
 
+template<typename T>
+inline bool QFutureInterface<T>::reportAndMoveResults(QList<T> &&results, int beginIndex)
+{
+    QMutexLocker<QMutex> locker{&mutex()};
+    if (this->queryState(Canceled) || this->queryState(Finished))
+        return false;
+
+    Q_ASSERT(!hasException());
+    auto &store = resultStoreBase();
+
+    const int resultCountBefore = store.count();
+    const int size = int(results.size());
+    const int insertIndex = store.moveResults(beginIndex, std::move(results));
+    if (insertIndex == -1)
+        return false;
+    if (store.filterMode()) {
+        this->reportResultsReady(resultCountBefore, store.count());
+    } else {
+        this->reportResultsReady(insertIndex, insertIndex + size);
+    }
+    return true;
+}
+
 template <typename T>
 inline bool QFutureInterface<T>::reportFinished(const T *result)
 {
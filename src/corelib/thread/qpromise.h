@@ -63,6 +63,8 @@ public:
     }
     bool addResults(const QList<T> &result)
     { return d.reportResults(result); }
+    bool addResults(QList<T> &&result)
+    { return d.reportAndMoveResults(std::move(result)); }
 #ifndef QT_NO_EXCEPTIONS
     void setException(const QException &e) { d.reportException(e); }
 #if QT_VERSION < QT_VERSION_CHECK(7, 0, 0)
@@ -6,6 +6,7 @@
 #include "qplatformdefs.h"
 #include "qreadwritelock.h"
 
+#include "qmath.h"
 #include "qthread.h"
 #include "qreadwritelock_p.h"
 #include "private/qfreelist_p.h"
@@ -25,6 +26,16 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * Recursive locks and locks with a distributed reader count always have a
+ * QReadWriteLockPrivate. In the latter, readers count themselves in one of
+ * several stripes, each on its own cache line, and only look at the number of
+ * writers, so that readers on different CPUs don't touch the same cache line.
+ * A writer first registers in distributedWriters, which sends all new readers
+ * to the slow path, and then waits until the sum of the stripes drops to zero.
+ * Both sides change their own counter before reading the other side's with
+ * sequentially consistent operations, so that at least one of them notices
+ * the other.
  */
 
 using namespace QReadWriteLockStates;
@@ -73,6 +84,17 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
     writer and another writer comes in, that writer will have
     priority over any readers that might also be waiting.
 
+    By default, all readers update a single counter in the lock. When many
+    threads on different CPUs take the lock for reading at a high rate, that
+    counter becomes a point of contention even though the readers never block
+    each other. Constructing the lock with
+    \l{QReadWriteLock::DistributedReaderCount} spreads the readers over several
+    counters on separate cache lines, so that uncontended reads scale with the
+    number of CPUs. In exchange, locking for writing gets more expensive, as the
+    writer has to check all the counters, and the lock takes more memory. The
+    writer preference described above holds in both modes: once a writer waits
+    for the lock, new readers block until it has had its turn.
+
     Like QMutex, a QReadWriteLock can be recursively locked by the
     same thread when constructed with \l{QReadWriteLock::Recursive} as
     \l{QReadWriteLock::RecursionMode}. In such cases,
@@ -99,6 +121,21 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
     \sa QReadWriteLock()
 */
 
+/*!
+    \enum QReadWriteLock::ReaderCountMode
+    \since 6.9
+
+    \value SharedReaderCount All readers update the same counter. This is the
+    cheapest mode for writers and for locks that are rarely contended.
+
+    \value DistributedReaderCount Readers update one of several counters,
+    depending on the thread they are running in. Use this mode for locks that
+    are taken for reading by many threads at the same time and rarely for
+    writing.
+
+    \sa QReadWriteLock()
+*/
+
 /*!
     \fn QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
     \since 4.4
@@ -116,6 +153,37 @@ QReadWriteLockPrivate *QReadWriteLock::initRecursive()
     return d;
 }
 
+/*!
+    \since 6.9
+
+    Constructs a QReadWriteLock object in the given \a recursionMode, which
+    counts its readers as specified by \a readerCountMode.
+
+    A recursive lock keeps track of the threads holding it, so \a
+    readerCountMode is ignored when \a recursionMode is
+    \l{QReadWriteLock::Recursive}.
+
+    \sa lockForRead(), lockForWrite(), RecursionMode, ReaderCountMode
+*/
+QReadWriteLock::QReadWriteLock(RecursionMode recursionMode, ReaderCountMode readerCountMode)
+    : d_ptr(recursionMode == Recursive ? initRecursive()
+            : readerCountMode == DistributedReaderCount ? initDistributed()
+            : nullptr)
+{
+}
+
+QReadWriteLockPrivate *QReadWriteLock::initDistributed()
+{
+    auto d = new QReadWriteLockPrivate;
+    Q_ASSERT_X(!(quintptr(d) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+
+    // a power of two, so that a thread's stripe is found with a mask
+    const int stripeCount = int(qMin(qNextPowerOfTwo(quint32(QThread::idealThreadCount())), 64U));
+    d->readerStripes.reset(new QReadWriteLockPrivate::ReaderStripe[stripeCount]);
+    d->readerStripeMask = stripeCount - 1;
+    return d;
+}
+
 /*!
     \fn QReadWriteLock::~QReadWriteLock()
     Destroys the QReadWriteLock object.
@@ -227,6 +295,8 @@ Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLock
         Q_ASSERT(!isUncontendedLocked(d));
         // d is an actual pointer;
 
+        if (d->isDistributed())
+            return d->distributedLockForRead(timeout);
         if (d->recursive)
             return d->recursiveLockForRead(timeout);
 
@@ -335,6 +405,8 @@ Q_NEVER_INLINE static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLoc
         Q_ASSERT(!isUncontendedLocked(d));
         // d is an actual pointer;
 
+        if (d->isDistributed())
+            return d->distributedLockForWrite(timeout);
         if (d->recursive)
             return d->recursiveLockForWrite(timeout);
 
@@ -382,6 +454,10 @@ void QReadWriteLock::unlock()
 
         Q_ASSERT(!isUncontendedLocked(d));
 
+        if (d->isDistributed()) {
+            d->distributedUnlock();
+            return;
+        }
         if (d->recursive) {
             d->recursiveUnlock();
             return;
@@ -543,6 +619,129 @@ void QReadWriteLockPrivate::recursiveUnlock()
     unlock();
 }
 
+QReadWriteLockPrivate::ReaderStripe &QReadWriteLockPrivate::currentReaderStripe() const
+{
+    // Hand out the stripes round-robin, so that threads only share a cache
+    // line if there are more of them than stripes. The thread may unlock from
+    // another stripe than it locked on, only the sum over all stripes matters.
+    Q_CONSTINIT static QBasicAtomicInt nextStripe = Q_BASIC_ATOMIC_INITIALIZER(0);
+    Q_CONSTINIT thread_local int stripe = -1;
+    if (Q_UNLIKELY(stripe < 0))
+        stripe = nextStripe.fetchAndAddRelaxed(1) & 0xffff;
+    return readerStripes[stripe & readerStripeMask];
+}
+
+int QReadWriteLockPrivate::distributedReaderCount() const
+{
+    int count = 0;
+    for (int i = 0; i <= readerStripeMask; ++i)
+        count += readerStripes[i].readers.load();
+    return count;
+}
+
+bool QReadWriteLockPrivate::distributedLockForRead(QDeadlineTimer timeout)
+{
+    Q_ASSERT(isDistributed());
+    ReaderStripe &stripe = currentReaderStripe();
+
+    // Fast case: no writer is holding or waiting for the lock
+    stripe.readers.fetch_add(1);
+    if (distributedWriters.load() == 0)
+        return true;
+
+    // Back off, and wake up the writer in case it saw us in the stripe
+    stripe.readers.fetch_sub(1);
+    auto lock = qt_unique_lock(mutex);
+    writerCond.notify_all();
+
+    // A writer that registers after the check below needs the mutex before it
+    // looks at the stripes, so it will see this reader.
+    while (distributedWriters.load()) {
+        if (timeout.hasExpired())
+            return false;
+        waitingReaders++;
+        if (!timeout.isForever())
+            readerCond.wait_until(lock, timeout.deadline<steady_clock>());
+        else
+            readerCond.wait(lock);
+        waitingReaders--;
+    }
+    stripe.readers.fetch_add(1);
+    return true;
+}
+
+bool QReadWriteLockPrivate::distributedLockForWrite(QDeadlineTimer timeout)
+{
+    Q_ASSERT(isDistributed());
+
+    // From here on, new readers take the slow path and wait
+    distributedWriters.fetch_add(1);
+    auto lock = qt_unique_lock(mutex);
+
+    const auto waitForWriters = [&] {
+        waitingWriters++;
+        if (!timeout.isForever())
+            writerCond.wait_until(lock, timeout.deadline<steady_clock>());
+        else
+            writerCond.wait(lock);
+        waitingWriters--;
+    };
+    const auto giveUp = [&] {
+        if (distributedWriters.fetch_sub(1) == 1 && waitingReaders)
+            readerCond.notify_all();
+        return false;
+    };
+
+    while (writerCount || drainingWriter) {
+        if (timeout.hasExpired())
+            return giveUp();
+        waitForWriters();
+    }
+    // Keep other writers out while waiting for the readers to leave
+    drainingWriter = true;
+    while (distributedReaderCount() != 0) {
+        if (timeout.hasExpired()) {
+            drainingWriter = false;
+            writerCond.notify_all();
+            return giveUp();
+        }
+        waitForWriters();
+    }
+    drainingWriter = false;
+    writerCount = 1;
+    return true;
+}
+
+void QReadWriteLockPrivate::distributedUnlock()
+{
+    Q_ASSERT(isDistributed());
+
+    // Without any writer around, this has to be a reader
+    if (distributedWriters.load() == 0) {
+        currentReaderStripe().readers.fetch_sub(1);
+        if (distributedWriters.load() == 0)
+            return;
+        // a writer came in and may be waiting for us
+        const auto lock = qt_scoped_lock(mutex);
+        writerCond.notify_all();
+        return;
+    }
+
+    const auto lock = qt_scoped_lock(mutex);
+    // While a writer holds the lock, there are no readers, so it's the writer
+    // unlocking. Otherwise, a writer is waiting for the readers to leave.
+    if (writerCount) {
+        writerCount = 0;
+        if (distributedWriters.fetch_sub(1) > 1)
+            writerCond.notify_all();
+        else if (waitingReaders)
+            readerCond.notify_all();
+    } else {
+        currentReaderStripe().readers.fetch_sub(1);
+        writerCond.notify_all();
+    }
+}
+
 // The freelist management
 namespace {
 struct QReadWriteLockFreeListConstants : QFreeListDefaultConstants
@@ -17,9 +17,11 @@ class Q_CORE_EXPORT QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum ReaderCountMode { SharedReaderCount, DistributedReaderCount };
 
     QT_CORE_INLINE_SINCE(6, 6)
     explicit QReadWriteLock(RecursionMode recursionMode = NonRecursive);
+    QReadWriteLock(RecursionMode recursionMode, ReaderCountMode readerCountMode);
     QT_CORE_INLINE_SINCE(6, 6)
     ~QReadWriteLock();
 
@@ -48,6 +50,7 @@ private:
     QAtomicPointer<QReadWriteLockPrivate> d_ptr;
     friend class QReadWriteLockPrivate;
     static QReadWriteLockPrivate *initRecursive();
+    static QReadWriteLockPrivate *initDistributed();
     static void destroyRecursive(QReadWriteLockPrivate *);
 };
 
@@ -190,7 +193,9 @@ class QT6_ONLY(Q_CORE_EXPORT) QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum ReaderCountMode { SharedReaderCount, DistributedReaderCount };
     inline explicit QReadWriteLock(RecursionMode = NonRecursive) noexcept { }
+    inline QReadWriteLock(RecursionMode, ReaderCountMode) noexcept { }
     inline ~QReadWriteLock() { }
 
     void lockForRead() noexcept { }
@@ -21,6 +21,9 @@
 #include <QtCore/qreadwritelock.h>
 #include <QtCore/qvarlengtharray.h>
 
+#include <atomic>
+#include <memory>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -80,6 +83,25 @@ public:
     bool recursiveLockForRead(QDeadlineTimer timeout);
     void recursiveUnlock();
 
+    // Distributed reader count handling
+    struct alignas(64) ReaderStripe { // one cache line per stripe
+        std::atomic<int> readers = 0;
+    };
+
+    std::unique_ptr<ReaderStripe[]> readerStripes;
+    int readerStripeMask = 0;
+    std::atomic<int> distributedWriters = 0; // holding or waiting writers
+    bool drainingWriter = false; // a writer waits for the readers to leave
+
+    bool isDistributed() const { return readerStripes != nullptr; }
+    ReaderStripe &currentReaderStripe() const;
+    int distributedReaderCount() const;
+
+    // called with the mutex unlocked
+    bool distributedLockForRead(QDeadlineTimer timeout);
+    bool distributedLockForWrite(QDeadlineTimer timeout);
+    void distributedUnlock();
+
     static QReadWriteLockStates::StateForWaitCondition
     stateForWaitCondition(const QReadWriteLock *lock);
 };
@@ -4,8 +4,11 @@
 #ifndef QTCORE_RESULTSTORE_H
 #define QTCORE_RESULTSTORE_H
 
+#include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
 
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 QT_REQUIRE_CONFIG(future);
@@ -128,6 +131,42 @@ protected:
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
 
+    // Appends a result constructed from args to the segment at the end of the
+    // store, or opens a new segment if that one is full. Returns -1 if the
+    // result isn't the next one in order, and the slow path must be taken.
+    template <typename T, typename...Args>
+    int appendToSegment(int index, Args&&...args)
+    {
+        if constexpr (!std::is_copy_constructible_v<T>) {
+            return -1;
+        } else {
+            // the first result is stored on its own, most futures only have one
+            if (m_filterMode || resultCount == 0 || insertIndex != resultCount
+                || (index != -1 && index != insertIndex)) {
+                return -1;
+            }
+
+            const auto tail = std::prev(m_results.end());
+            ResultItem &item = tail.value();
+            if (item.isVector() && item.isValid() && tail.key() + item.count() == insertIndex) {
+                auto segment = static_cast<QList<T> *>(const_cast<void *>(item.result));
+                // a list added by addResults() may still be shared with the caller
+                if (segment->isDetached() && segment->size() < segment->capacity()) {
+                    segment->emplaceBack(std::forward<Args>(args)...);
+                    ++item.m_count;
+                    resultCount = ++insertIndex;
+                    return resultCount - 1;
+                }
+            }
+
+            // grow the segments with the number of results, within bounds
+            auto segment = new QList<T>;
+            segment->reserve(qBound(16, resultCount, 1024));
+            segment->emplaceBack(std::forward<Args>(args)...);
+            return addResults(insertIndex, segment, 1, 1);
+        }
+    }
+
     template <typename T>
     static void clear(QMap<int, ResultItem> &store)
     {
@@ -146,6 +185,10 @@ public:
     template <typename T, typename...Args>
     int emplaceResult(int index, Args&&...args)
     {
+        const int appendIndex = appendToSegment<T>(index, std::forward<Args>(args)...);
+        if (appendIndex != -1)
+            return appendIndex;
+
         if (containsValidResultItem(index)) // reject if already present
             return -1;
         return addResult(index, static_cast<void *>(new T(std::forward<Args>(args)...)));
@@ -154,6 +197,12 @@ public:
     template <typename T>
     int addResult(int index, const T *result)
     {
+        if (result != nullptr) {
+            const int appendIndex = appendToSegment<T>(index, *result);
+            if (appendIndex != -1)
+                return appendIndex;
+        }
+
         if (containsValidResultItem(index)) // reject if already present
             return -1;
 
@@ -183,6 +232,19 @@ public:
         return addResults(index, new QList<T>(*results), results->size(), results->size());
     }
 
+    template<typename T>
+    int moveResults(int index, QList<T> &&results)
+    {
+        if (results.empty()) // reject if results are empty
+            return -1;
+
+        if (containsValidResultItem(index)) // reject if already present
+            return -1;
+
+        const int count = int(results.size());
+        return addResults(index, new QList<T>(std::move(results)), count, count);
+    }
+
     template<typename T>
     int addResults(int index, const QList<T> *results, int totalCount)
     {
@@ -72,6 +72,10 @@ public:
 
     QMutex mutex;
 
+    // events posted without taking the mutex, most recent first; moved into
+    // the list by QCoreApplicationPrivate::takePostEventInbox()
+    QAtomicPointer<QMetaCallEvent> inbox;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
@@ -317,7 +321,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.inbox.loadAcquire();
     }
 
 private:
@@ -29,6 +29,7 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolLocalQueue localQueue;
 };
 
 /*
@@ -57,27 +58,32 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, tasks started by r were queued
+                    // on this thread; run them without taking the pool's lock
+                } while ((r = localQueue.pop()));
                 locker.relock();
             }
 
@@ -85,9 +91,15 @@ void QThreadPoolThread::run()
             if (manager->tooManyThreadsActive())
                 break;
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            if (manager->queue.isEmpty()) {
+                // help the other threads with their local work, if any
+                r = manager->stealTask(this);
+                if (r)
+                    continue;
+
+                // all work is done, time to wait for more
                 break;
+            }
 
             QueuePage *page = manager->queue.constFirst();
             r = page->pop();
@@ -108,10 +120,19 @@ void QThreadPoolThread::run()
         if (manager->tooManyThreadsActive()) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateThreadsAvailable();
             return;
         }
         manager->waitingThreads.enqueue(this);
         registerThreadInactive();
+        manager->updateThreadsAvailable();
+        // a thread may have queued work locally before it could see us idle
+        if (manager->hasStealableTasks()) {
+            manager->waitingThreads.removeOne(this);
+            ++manager->activeThreads;
+            manager->updateThreadsAvailable();
+            continue;
+        }
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
         // this thread is about to be deleted, do not work or expire
@@ -124,6 +145,7 @@ void QThreadPoolThread::run()
             return;
         }
         ++manager->activeThreads;
+        manager->updateThreadsAvailable();
     }
 }
 
@@ -140,9 +162,15 @@ void QThreadPoolThread::registerThreadInactive()
 QThreadPoolPrivate:: QThreadPoolPrivate()
 { }
 
+/*
+    \internal
+
+    A null \a task makes one more thread available without giving it
+    anything to run, so that it steals work from the other threads' local
+    queues.
+*/
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
-    Q_ASSERT(task != nullptr);
     if (allThreads.isEmpty()) {
         // always create at least one thread
         startThread(task);
@@ -155,7 +183,8 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
 
     if (!waitingThreads.isEmpty()) {
         // recycle an available thread
-        enqueueTask(task);
+        if (task)
+            enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
         return true;
     }
@@ -200,6 +229,40 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
 }
 
+void QThreadPoolPrivate::enqueueLocalTask(QThreadPoolThread *thread, QRunnable *task)
+{
+    thread->localQueue.push(task);
+
+    // wake up or start a thief if there is room for one
+    if (threadsAvailable.load()) {
+        QMutexLocker locker(&mutex);
+        tryStart(nullptr);
+        updateThreadsAvailable();
+    }
+}
+
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    if (!workStealing.load(std::memory_order_relaxed))
+        return nullptr;
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        if (thread == thief)
+            continue;
+        if (QRunnable *task = thread->localQueue.steal())
+            return task;
+    }
+    return nullptr;
+}
+
+bool QThreadPoolPrivate::hasStealableTasks() const
+{
+    if (!workStealing.load(std::memory_order_relaxed))
+        return false;
+    return std::any_of(allThreads.cbegin(), allThreads.cend(), [](QThreadPoolThread *thread) {
+        return !thread->localQueue.isEmpty();
+    });
+}
+
 int QThreadPoolPrivate::activeThreadCount() const
 {
     return (allThreads.size()
@@ -223,6 +286,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateThreadsAvailable();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -242,7 +306,6 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
     auto thread = std::make_unique<QThreadPoolThread>(this);
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
@@ -268,6 +331,7 @@ void QThreadPoolPrivate::reset()
     auto allThreadsCopy = std::exchange(allThreads, {});
     expiredThreads.clear();
     waitingThreads.clear();
+    updateThreadsAvailable();
 
     mutex.unlock();
 
@@ -318,6 +382,16 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        const QList<QRunnable *> runnables = thread->localQueue.takeAll();
+        for (QRunnable *r : runnables) {
+            if (r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
 }
 
 /*!
@@ -354,6 +428,10 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             return true;
         }
     }
+    for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+        if (thread->localQueue.tryTake(runnable))
+            return true;
+    }
 
     return false;
 }
@@ -507,10 +585,17 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->workStealing.load(std::memory_order_relaxed)) {
+        auto thread = qobject_cast<QThreadPoolThread *>(QThread::currentThread());
+        if (thread && thread->manager == d)
+            return d->enqueueLocalTask(thread, runnable);
+    }
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
         d->enqueueTask(runnable, priority);
+    d->updateThreadsAvailable();
 }
 
 /*!
@@ -553,8 +638,10 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        d->updateThreadsAvailable();
         return true;
+    }
 
     return false;
 }
@@ -674,6 +761,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateThreadsAvailable();
 }
 
 /*! \property QThreadPool::stackSize
@@ -784,6 +872,7 @@ void QThreadPool::startOnReservedThread(QRunnable *runnable)
         // and something took the one minimum thread.
         d->enqueueTask(runnable, INT_MAX);
     }
+    d->updateThreadsAvailable();
 }
 
 /*!
@@ -837,6 +926,45 @@ void QThreadPool::clear()
     d->clear();
 }
 
+/*!
+    \property QThreadPool::workStealingEnabled
+    \brief whether runnables started from the pool's own threads are queued
+    locally on the starting thread.
+    \since 6.9
+
+    By default all runnables go through a single, priority-ordered queue
+    shared by all threads of the pool. When many short runnables are started
+    concurrently from the pool's own threads, for instance by tasks that
+    split themselves into smaller tasks, that queue becomes a point of
+    contention.
+
+    If this property is \c true, a runnable started with the default priority
+    from one of this pool's threads is instead queued on that thread, which
+    runs it as soon as its current runnable returns, without touching the
+    shared queue. Idle threads steal from the other threads' queues when the
+    shared queue is empty. Runnables started from other threads, or with a
+    non-default priority, still use the shared queue and keep their priority
+    semantics; the shared queue takes precedence over stolen work.
+
+    Locally queued runnables run in last-in, first-out order. They are taken
+    into account by tryTake(), clear() and waitForDone().
+
+    The default is \c false.
+*/
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load(std::memory_order_relaxed);
+}
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->workStealing.store(enabled, std::memory_order_relaxed);
+    d->updateThreadsAvailable();
+}
+
 /*!
     \since 6.0
 
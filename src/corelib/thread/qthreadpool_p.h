@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -107,6 +109,75 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+/*
+    Run queue of a single pool thread, used in work-stealing mode. Only the
+    owning thread pushes and pops (LIFO, while the data is still hot in its
+    cache); other pool threads steal from the opposite end. The owner never
+    touches the pool's mutex, and the queue's own mutex is only contended
+    while a steal is in progress.
+*/
+class QThreadPoolLocalQueue
+{
+public:
+    bool isEmpty() const { return count.load() == 0; }
+
+    void push(QRunnable *runnable)
+    {
+        Q_ASSERT(runnable != nullptr);
+        QMutexLocker locker(&mutex);
+        runnables.append(runnable);
+        count.store(runnables.size());
+    }
+
+    QRunnable *pop()
+    {
+        if (isEmpty())
+            return nullptr;
+        QMutexLocker locker(&mutex);
+        if (runnables.isEmpty())
+            return nullptr;
+        QRunnable *runnable = runnables.takeLast();
+        count.store(runnables.size());
+        return runnable;
+    }
+
+    QRunnable *steal()
+    {
+        if (isEmpty())
+            return nullptr;
+        QMutexLocker locker(&mutex);
+        if (runnables.isEmpty())
+            return nullptr;
+        QRunnable *runnable = runnables.takeFirst();
+        count.store(runnables.size());
+        return runnable;
+    }
+
+    bool tryTake(QRunnable *runnable)
+    {
+        if (isEmpty())
+            return false;
+        QMutexLocker locker(&mutex);
+        if (!runnables.removeOne(runnable))
+            return false;
+        count.store(runnables.size());
+        return true;
+    }
+
+    QList<QRunnable *> takeAll()
+    {
+        QMutexLocker locker(&mutex);
+        count.store(0);
+        return std::exchange(runnables, {});
+    }
+
+private:
+    QMutex mutex;
+    QList<QRunnable *> runnables;
+    // sequentially consistent, see QThreadPoolPrivate::threadsAvailable
+    std::atomic<qsizetype> count = 0;
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -118,6 +189,14 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    void enqueueLocalTask(QThreadPoolThread *thread, QRunnable *task);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    bool hasStealableTasks() const;
+    void updateThreadsAvailable()
+    {
+        if (workStealing.load(std::memory_order_relaxed))
+            threadsAvailable.store(!areAllThreadsActive());
+    }
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -149,6 +228,14 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // Read without holding the mutex by threads queueing work locally.
+    // threadsAvailable mirrors !areAllThreadsActive(); a thread about to go
+    // idle publishes it and then re-checks the local queues, while a thread
+    // queueing locally pushes and then reads it, so at least one of them
+    // notices the other (hence sequential consistency).
+    std::atomic<bool> workStealing = false;
+    std::atomic<bool> threadsAvailable = false;
 };
 
 QT_END_NAMESPACE
@@ -70,6 +70,23 @@ const char *QRingBuffer::readPointerAtPosition(qint64 pos, qint64 &length) const
     return nullptr;
 }
 
+/*!
+    \internal
+
+    Fills \a blocks with views of the leading chunks of the buffer, in order,
+    and returns the number of views filled in.
+*/
+qsizetype QRingBuffer::dataBlocks(QSpan<QByteArrayView> blocks) const
+{
+    qsizetype count = 0;
+    for (const QRingChunk &chunk : buffers) {
+        if (count == blocks.size() || chunk.size() == 0)
+            break;
+        blocks[count++] = QByteArrayView(chunk.data(), chunk.size());
+    }
+    return count;
+}
+
 void QRingBuffer::free(qint64 bytes)
 {
     Q_ASSERT(bytes <= bufferSize);
@@ -77,12 +77,23 @@ void BitOStream::write(QByteArrayView src, bool compressed)
 
     write(byteLen);
 
+    // Integers always end on a byte boundary:
+    Q_ASSERT(!(bitsSet % 8));
     if (compressed) {
-        huffman_encode_string(src, *this);
+        const auto oldSize = buffer.size();
+        buffer.resize(oldSize + byteLen);
+        huffman_encode_string(src, buffer.data() + oldSize);
     } else {
-        bitsSet += quint64(src.size()) * 8;
         buffer.insert(buffer.end(), src.begin(), src.end());
     }
+    bitsSet += quint64(byteLen) * 8;
+}
+
+void BitOStream::writeBytes(const uchar *first, const uchar *last)
+{
+    Q_ASSERT(!(bitsSet % 8));
+    buffer.insert(buffer.end(), first, last);
+    bitsSet += quint64(last - first) * 8;
 }
 
 quint64 BitOStream::bitLength() const
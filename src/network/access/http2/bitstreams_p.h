@@ -44,6 +44,8 @@ public:
     // * strings
     void write(quint32 src);
     void write(QByteArrayView src, bool compressed);
+    // Appends already encoded data, the stream must be on a byte boundary:
+    void writeBytes(const uchar *first, const uchar *last);
 
     quint64 bitLength() const;
     quint64 byteLength() const;
@@ -97,6 +97,15 @@ bool is_request_pseudo_header(QByteArrayView name)
            name == ":authority" || name == ":path";
 }
 
+bool is_response_pseudo_header(QByteArrayView name)
+{
+    return name == ":status";
+}
+
+// Header blocks are small, a handful of them covers the
+// different kinds of requests a client typically sends.
+constexpr std::size_t maxCachedHeaderBlocks = 8;
+
 } // unnamed namespace
 
 Encoder::Encoder(quint32 size, bool compress)
@@ -120,15 +129,7 @@ bool Encoder::encodeRequest(BitOStream &outputStream, const HttpHeader &header)
     if (!encodeRequestPseudoHeaders(outputStream, header))
         return false;
 
-    for (const auto &field : header) {
-        if (is_request_pseudo_header(field.name))
-            continue;
-
-        if (!encodeHeaderField(outputStream, field))
-            return false;
-    }
-
-    return true;
+    return encodeRegularFields(outputStream, header, is_request_pseudo_header);
 }
 
 bool Encoder::encodeResponse(BitOStream &outputStream, const HttpHeader &header)
@@ -141,15 +142,7 @@ bool Encoder::encodeResponse(BitOStream &outputStream, const HttpHeader &header)
     if (!encodeResponsePseudoHeaders(outputStream, header))
         return false;
 
-    for (const auto &field : header) {
-        if (field.name == ":status")
-            continue;
-
-        if (!encodeHeaderField(outputStream, field))
-            return false;
-    }
-
-    return true;
+    return encodeRegularFields(outputStream, header, is_response_pseudo_header);
 }
 
 bool Encoder::encodeSizeUpdate(BitOStream &outputStream, quint32 newSize)
@@ -174,9 +167,88 @@ void Encoder::setMaxDynamicTableSize(quint32 size)
 
 void Encoder::setCompressStrings(bool compress)
 {
+    if (compressStrings != compress)
+        headerBlockCache.clear();
     compressStrings = compress;
 }
 
+void Encoder::setHeaderBlockCachingEnabled(bool enable)
+{
+    cacheHeaderBlocks = enable;
+    if (!enable)
+        headerBlockCache.clear();
+}
+
+bool Encoder::encodeRegularFields(BitOStream &outputStream, const HttpHeader &header,
+                                  bool (*isPseudoHeader)(QByteArrayView))
+{
+    if (!cacheHeaderBlocks) {
+        for (const auto &field : header) {
+            if (isPseudoHeader(field.name))
+                continue;
+
+            if (!encodeHeaderField(outputStream, field))
+                return false;
+        }
+
+        return true;
+    }
+
+    // The encoding of the fields only depends on the dynamic table
+    // (and compressStrings), so any change to the table invalidates
+    // all the blocks encoded so far.
+    if (headerBlockCacheGeneration != lookupTable.generation()) {
+        headerBlockCache.clear();
+        headerBlockCacheGeneration = lookupTable.generation();
+    }
+
+    const auto sameFields = [&header, isPseudoHeader](const HttpHeader &fields) {
+        auto it = fields.begin();
+        for (const auto &field : header) {
+            if (isPseudoHeader(field.name))
+                continue;
+            if (it == fields.end() || !(*it == field))
+                return false;
+            ++it;
+        }
+        return it == fields.end();
+    };
+
+    for (const CachedHeaderBlock &block : headerBlockCache) {
+        if (sameFields(block.fields)) {
+            outputStream.writeBytes(block.encoded.data(),
+                                    block.encoded.data() + block.encoded.size());
+            return true;
+        }
+    }
+
+    // Integers always end on a byte boundary, so the fields'
+    // encoding starts at a byte offset:
+    Q_ASSERT(!(outputStream.bitLength() % 8));
+    const quint64 blockStart = outputStream.byteLength();
+    CachedHeaderBlock block;
+    for (const auto &field : header) {
+        if (isPseudoHeader(field.name))
+            continue;
+
+        if (!encodeHeaderField(outputStream, field))
+            return false;
+        block.fields.push_back(field);
+    }
+
+    // Fields which were added to the table are encoded differently
+    // (indexed) the next time, so there is nothing to cache yet:
+    if (headerBlockCacheGeneration != lookupTable.generation())
+        return true;
+
+    block.encoded.assign(outputStream.begin() + blockStart, outputStream.end());
+    if (headerBlockCache.size() == maxCachedHeaderBlocks)
+        headerBlockCache.erase(headerBlockCache.begin());
+    headerBlockCache.push_back(std::move(block));
+
+    return true;
+}
+
 bool Encoder::encodeRequestPseudoHeaders(BitOStream &outputStream,
                                          const HttpHeader &header)
 {
@@ -222,8 +294,10 @@ bool Encoder::encodeRequestPseudoHeaders(BitOStream &outputStream,
                         qCritical() << "only one" << headerName[j] << "pseudo-header is allowed";
                         return false;
                     }
-                    if (!encodeHeaderField(outputStream, field))
+                    if (field.name == ":path" ? !encodePath(outputStream, field)
+                                              : !encodeHeaderField(outputStream, field)) {
                         return false;
+                    }
                     headerFound[j] = true;
                     break;
                 }
@@ -281,6 +355,23 @@ bool Encoder::encodeMethod(BitOStream &outputStream, const HeaderField &field)
                               index, field.value, compressStrings);
 }
 
+bool Encoder::encodePath(BitOStream &outputStream, const HeaderField &field)
+{
+    Q_ASSERT(field.name == ":path");
+    if (!cacheHeaderBlocks)
+        return encodeHeaderField(outputStream, field);
+
+    // Paths rarely repeat, adding each of them to the dynamic table would
+    // evict other entries and invalidate the cached header blocks.
+    if (const auto index = lookupTable.indexOf(field.name, field.value))
+        return encodeIndexedField(outputStream, index);
+
+    const quint32 index = lookupTable.indexOf(field.name);
+    Q_ASSERT(index); // ":path" is always in the static table ...
+    return encodeLiteralField(outputStream, LiteralNoIndexing,
+                              index, field.value, compressStrings);
+}
+
 bool Encoder::encodeResponsePseudoHeaders(BitOStream &outputStream, const HttpHeader &header)
 {
     bool statusFound = false;
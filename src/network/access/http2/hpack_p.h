@@ -50,14 +50,21 @@ public:
 
     void setMaxDynamicTableSize(quint32 size);
     void setCompressStrings(bool compress);
+    // Reuses the encoding of header fields which were sent before with
+    // the same dynamic table:
+    void setHeaderBlockCachingEnabled(bool enable);
 
 private:
+    bool encodeRegularFields(BitOStream &outputStream, const HttpHeader &header,
+                             bool (*isPseudoHeader)(QByteArrayView));
     bool encodeRequestPseudoHeaders(BitOStream &outputStream,
                                     const HttpHeader &header);
     bool encodeHeaderField(BitOStream &outputStream,
                            const HeaderField &field);
     bool encodeMethod(BitOStream &outputStream,
                       const HeaderField &field);
+    bool encodePath(BitOStream &outputStream,
+                    const HeaderField &field);
 
     bool encodeResponsePseudoHeaders(BitOStream &outputStream,
                                      const HttpHeader &header);
@@ -79,6 +86,15 @@ private:
 
     FieldLookupTable lookupTable;
     bool compressStrings;
+
+    struct CachedHeaderBlock
+    {
+        HttpHeader fields;
+        std::vector<uchar> encoded;
+    };
+    std::vector<CachedHeaderBlock> headerBlockCache;
+    quint64 headerBlockCacheGeneration = 0;
+    bool cacheHeaderBlocks = false;
 };
 
 class Q_AUTOTEST_EXPORT Decoder
@@ -123,6 +123,7 @@ bool FieldLookupTable::prependField(const QByteArray &name, const QByteArray &va
     if (!entrySize.first)
         return false;
 
+    ++tableGeneration;
     if (entrySize.second > tableCapacity) {
         clearDynamicTable();
         return true;
@@ -162,6 +163,7 @@ void FieldLookupTable::evictEntry()
         return;
 
     Q_ASSERT(end != begin);
+    ++tableGeneration;
 
     if (useIndex) {
         const auto res = searchIndex.erase(backKey());
@@ -209,6 +211,7 @@ quint32 FieldLookupTable::dynamicDataSize() const
 
 void FieldLookupTable::clearDynamicTable()
 {
+    ++tableGeneration;
     searchIndex.clear();
     chunks.clear();
     begin = 0;
@@ -137,6 +137,11 @@ public:
     bool updateDynamicTableSize(quint32 size);
     void setMaxDynamicTableSize(quint32 size);
 
+    // Changes whenever the dynamic table does, so that the encoding of a
+    // header that did not change the table can be reused while this stays
+    // the same.
+    quint64 generation() const { return tableGeneration; }
+
     static const std::vector<HeaderField> &staticPart();
 
 private:
@@ -187,6 +192,7 @@ private:
     quint32 begin;
     quint32 end;
     quint32 dataSize;
+    quint64 tableGeneration = 0;
 
     quint32 indexOfChunk(const Chunk *chunk) const;
     quint32 keyToIndex(const SearchEntry &key) const;
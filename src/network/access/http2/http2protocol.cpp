@@ -50,6 +50,11 @@ Frame configurationToSettingsFrame(const QHttp2Configuration &config)
         builder.append(Settings::MAX_FRAME_SIZE_ID);
         builder.append(config.maxFrameSize());
     }
+
+    // The protocol default is "unlimited", so always tell the peer
+    // how many streams it may open:
+    builder.append(Settings::MAX_CONCURRENT_STREAMS_ID);
+    builder.append(config.maxConcurrentStreams());
     // TODO: In future, if the need is proven, we can
     // also send decoding table size and header list size.
     // For now, defaults suffice.
@@ -316,30 +316,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, const CodeEntry &code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -348,22 +324,32 @@ static_assert(std::numeric_limits<uchar>::digits == 8, "octets expected");
 quint64 huffman_encoded_bit_length(QByteArrayView inputData)
 {
     quint64 bitLength = 0;
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+    for (char c : inputData)
+        bitLength += staticHuffmanCodeTable[uchar(c)].bitLength;
 
     return bitLength;
 }
 
-void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream)
+void huffman_encode_string(QByteArrayView inputData, uchar *output)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i) {
-        const auto value = uchar(inputData[i]);
-        write_huffman_code(outputStream, staticHuffmanCodeTable[value]);
+    // The codes are collected in the low bits of an accumulator, which
+    // has room for the (at most 7) bits not written yet plus the longest
+    // code (30 bits), and written out octet by octet.
+    quint64 bits = 0;
+    quint32 pendingBits = 0;
+    for (char c : inputData) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(c)];
+        bits = bits << code.bitLength | code.huffmanCode >> (32 - code.bitLength);
+        pendingBits += code.bitLength;
+        while (pendingBits >= 8) {
+            pendingBits -= 8;
+            *output++ = uchar(bits >> pendingBits);
+        }
     }
 
-    // Pad bits ...
-    if (outputStream.bitLength() % 8)
-        outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
+    // Pad bits with the most significant bits of EOS, which are all set:
+    if (pendingBits)
+        *output = uchar(bits << (8 - pendingBits) | 0xff >> pendingBits);
 }
 
 static constexpr
@@ -459,16 +445,36 @@ HuffmanDecoder::HuffmanDecoder()
 
 bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
 {
+    const quint64 streamLength = inputStream.bitLength();
+    // Every byte takes at least minCodeLength bits:
+    outputBuffer.reserve(outputBuffer.size()
+                         + qsizetype((streamLength - inputStream.streamOffset()) / minCodeLength));
+
+    // Instead of peeking at the stream for every code, the bits are taken
+    // from a reservoir which holds up to 56 bits of the stream, left-aligned,
+    // and is refilled once it has less than the 32 bits a lookup uses.
+    quint64 reservoir = 0;
+    quint64 available = 0;
+    quint64 reservoirEnd = inputStream.streamOffset();
+    const auto finish = [&inputStream](quint64 position, bool result) {
+        inputStream.skipBits(position - inputStream.streamOffset());
+        return result;
+    };
+
     while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
-
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+        if (available < 32 && reservoirEnd < streamLength) {
+            const quint64 position = reservoirEnd - available;
+            available = inputStream.peekBits(position, 56, &reservoir);
+            reservoirEnd = position + available;
         }
+        const quint64 position = reservoirEnd - available;
+        if (!available)
+            return finish(position, true);
+
+        const quint32 chunk = quint32(reservoir >> 32);
+        const quint32 readBits = quint32(std::min<quint64>(available, 32));
+        if (readBits < minCodeLength)
+            return finish(position + readBits, padding_is_valid(chunk, readBits));
 
         quint32 tableIndex = 0;
         const PrefixTable *table = &prefixTables[tableIndex];
@@ -485,19 +491,17 @@ bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuf
             entry = tableEntry(*table, entryIndex);
         }
 
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
+        if (entry.bitLength > readBits)
+            return finish(position + readBits, padding_is_valid(chunk, readBits));
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+            return finish(position + readBits, false);
         }
 
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
+        outputBuffer.append(char(entry.byteValue));
+        reservoir <<= entry.bitLength;
+        available -= entry.bitLength;
     }
 
     return false;
@@ -31,10 +31,9 @@ struct CodeEntry
     quint32 bitLength;
 };
 
-class BitOStream;
-
 quint64 huffman_encoded_bit_length(QByteArrayView inputData);
-void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream);
+// Writes (huffman_encoded_bit_length(inputData) + 7) / 8 bytes to output:
+void huffman_encode_string(QByteArrayView inputData, uchar *output);
 
 // PrefixTable:
 // Huffman codes with a small bit length
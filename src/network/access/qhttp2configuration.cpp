@@ -41,6 +41,9 @@ QT_BEGIN_NAMESPACE
       \li The server push. Allows to enable or disable server push. Sent
          as 'SETTINGS_ENABLE_PUSH' parameter in the initial 'SETTINGS'
          frame.
+      \li The maximum number of concurrent streams the remote peer may
+         open. Sent as 'SETTINGS_MAX_CONCURRENT_STREAMS' parameter in the
+         initial 'SETTINGS' frame.
     \endlist
 
     The QHttp2Configuration class also controls if the header compression
@@ -65,6 +68,7 @@ public:
     unsigned streamWindowSize = Http2::defaultSessionWindowSize;
 
     unsigned maxFrameSize = Http2::minPayloadLimit; // Initial (default) value of 16Kb.
+    unsigned maxConcurrentStreams = Http2::maxConcurrentStreams;
 
     bool pushEnabled = false;
     // TODO: for now those two below are noop.
@@ -81,6 +85,7 @@ public:
         \li Window size for connection-level flow control is 65535 octets
         \li Window size for stream-level flow control is 65535 octets
         \li Frame size is 16384 octets
+        \li Maximum number of concurrent streams is 100
     \endlist
 */
 QHttp2Configuration::QHttp2Configuration()
@@ -253,6 +258,36 @@ unsigned QHttp2Configuration::maxFrameSize() const
     return d->maxFrameSize;
 }
 
+/*!
+    \since 6.9
+
+    Sets the maximum number of concurrent streams the remote peer is
+    allowed to have open on the connection to \a value. This is
+    advertised as 'SETTINGS_MAX_CONCURRENT_STREAMS' in the initial
+    'SETTINGS' frame. Streams the peer opens beyond this limit are
+    refused with a 'RST_STREAM' frame carrying the 'REFUSED_STREAM'
+    error code.
+
+    \sa maxConcurrentStreams()
+*/
+void QHttp2Configuration::setMaxConcurrentStreams(unsigned value)
+{
+    d->maxConcurrentStreams = value;
+}
+
+/*!
+    \since 6.9
+
+    Returns the maximum number of concurrent streams the remote peer
+    is allowed to have open. The default value is 100.
+
+    \sa setMaxConcurrentStreams()
+*/
+unsigned QHttp2Configuration::maxConcurrentStreams() const
+{
+    return d->maxConcurrentStreams;
+}
+
 /*!
     Swaps this configuration with the \a other configuration.
 */
@@ -284,7 +319,8 @@ bool QHttp2Configuration::isEqual(const QHttp2Configuration &other) const noexce
     return d->pushEnabled == other.d->pushEnabled
            && d->huffmanCompressionEnabled == other.d->huffmanCompressionEnabled
            && d->sessionWindowSize == other.d->sessionWindowSize
-           && d->streamWindowSize == other.d->streamWindowSize;
+           && d->streamWindowSize == other.d->streamWindowSize
+           && d->maxConcurrentStreams == other.d->maxConcurrentStreams;
 }
 
 QT_END_NAMESPACE
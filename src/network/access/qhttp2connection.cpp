@@ -41,7 +41,13 @@ QHttp2Stream::QHttp2Stream(QHttp2Connection *connection, quint32 streamID) noexc
     qCDebug(qHttp2ConnectionLog, "[%p] new stream %u", connection, streamID);
 }
 
-QHttp2Stream::~QHttp2Stream() noexcept = default;
+QHttp2Stream::~QHttp2Stream() noexcept
+{
+    if (isActive()) {
+        if (QHttp2Connection *connection = getConnection())
+            connection->streamActivityChanged(m_streamID, false);
+    }
+}
 
 /*!
     \fn quint32 QHttp2Stream::streamID() const noexcept
@@ -559,7 +565,10 @@ void QHttp2Stream::setState(State newState)
         return;
     qCDebug(qHttp2ConnectionLog, "[%p] stream %u, state changed from %d to %d", getConnection(),
             streamID(), int(m_state), int(newState));
+    const bool wasActive = isActive();
     m_state = newState;
+    if (wasActive != isActive())
+        getConnection()->streamActivityChanged(m_streamID, !wasActive);
     emit stateChanged(newState);
 }
 
@@ -649,9 +658,12 @@ void QHttp2Stream::handleDATA(const Frame &inboundFrame)
         m_downloadBuffer.append(std::move(fragment));
     }
 
-    if (!endStream && m_recvWindow < connection->streamInitialReceiveWindowSize / 2) {
+    if (!endStream && m_recvWindow < m_recvWindowLimit / 2) {
         // @future[consider]: emit signal instead
-        sendWINDOW_UPDATE(quint32(connection->streamInitialReceiveWindowSize - m_recvWindow));
+        m_recvWindowLimit = connection->autoTunedWindowSize(
+                m_recvWindowLimit, QHttp2Connection::maxAutoTunedStreamWindowSize,
+                m_lastWindowUpdate);
+        sendWINDOW_UPDATE(quint32(m_recvWindowLimit - m_recvWindow));
     }
 }
 
@@ -866,22 +878,40 @@ QHttp2Connection::createStreamInternal()
 
 QHttp2Stream *QHttp2Connection::createStreamInternal_impl(quint32 streamID)
 {
+    if (m_streams.size() >= m_streamsPurgeThreshold)
+        purgeDeletedStreams();
     qsizetype numStreams = m_streams.size();
     QPointer<QHttp2Stream> &stream = m_streams[streamID];
     if (numStreams == m_streams.size()) // stream already existed
         return nullptr;
     stream = new QHttp2Stream(this, streamID);
     stream->m_recvWindow = streamInitialReceiveWindowSize;
+    stream->m_recvWindowLimit = streamInitialReceiveWindowSize;
     stream->m_sendWindow = streamInitialSendWindowSize;
     return stream;
 }
 
+// Removes the entries of the streams that were deleted. The threshold grows
+// with the number of streams that are still alive, so that the cost of this is
+// amortized over the streams created in the meantime.
+void QHttp2Connection::purgeDeletedStreams()
+{
+    using Entry = std::pair<const quint32 &, QPointer<QHttp2Stream> &>;
+    m_streams.removeIf([](const Entry &entry) { return entry.second.isNull(); });
+    m_streamsPurgeThreshold = std::max(qsizetype(64), m_streams.size() * 2);
+}
+
+void QHttp2Connection::streamActivityChanged(quint32 streamID, bool active) noexcept
+{
+    qsizetype &count = m_numActiveStreams[streamID & 1];
+    count += active ? 1 : -1;
+    Q_ASSERT(count >= 0);
+}
+
 qsizetype QHttp2Connection::numActiveStreamsImpl(quint32 mask) const noexcept
 {
-    const auto shouldCount = [mask](const QPointer<QHttp2Stream> &stream) -> bool {
-        return stream && (stream->streamID() & 1) == mask && stream->isActive();
-    };
-    return std::count_if(m_streams.cbegin(), m_streams.cend(), shouldCount);
+    Q_ASSERT(mask <= 1);
+    return m_numActiveStreams[mask];
 }
 
 /*!
@@ -956,6 +986,37 @@ QHttp2Stream *QHttp2Connection::getStream(quint32 streamID) const
     upgrade to HTTP/2, or \c false otherwise.
 */
 
+/*!
+    \fn void QHttp2Connection::setReceiveWindowAutoTuningEnabled(bool enable) noexcept
+
+    If \a enable is \c true, the receive windows of the connection and of its
+    streams grow when they are not large enough to keep the data flowing for a
+    full round trip. A window is doubled whenever it needs a WINDOW_UPDATE
+    within two round trips of the previous one, up to 16 MiB for a stream and
+    64 MiB for the connection. The windows never shrink.
+
+    Autotuning is disabled by default, in which case the window sizes from the
+    QHttp2Configuration are used as they are.
+
+    \sa isReceiveWindowAutoTuningEnabled(), roundTripTime()
+*/
+
+/*!
+    \fn bool QHttp2Connection::isReceiveWindowAutoTuningEnabled() const noexcept
+
+    Returns \c true if receive window autotuning is enabled.
+
+    \sa setReceiveWindowAutoTuningEnabled()
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QHttp2Connection::roundTripTime() const noexcept
+
+    Returns the smoothed round trip time to the peer, as measured by the time
+    it took to acknowledge our SETTINGS and PING frames, or zero if no
+    measurement was made yet.
+*/
+
 QHttp2Connection::QHttp2Connection(QIODevice *socket) : QObject(socket)
 {
     Q_ASSERT(socket);
@@ -1013,6 +1074,7 @@ bool QHttp2Connection::sendPing(QByteArrayView data)
     Q_ASSERT(data.length() == 8);
     if (!m_lastPingSignature) {
         m_lastPingSignature = data.toByteArray();
+        m_pingTimer.start();
     } else {
         qCWarning(qHttp2ConnectionLog, "[%p] No PING is sent while waiting for the previous PING.", this);
         return false;
@@ -1034,10 +1096,7 @@ void QHttp2Connection::handleReadyRead()
     if (m_connectionType == Type::Server && !serverCheckClientPreface())
         return;
 
-    const auto streamIsActive = [](const QPointer<QHttp2Stream> &stream) {
-        return stream && stream->isActive();
-    };
-    if (m_goingAway && std::none_of(m_streams.cbegin(), m_streams.cend(), streamIsActive)) {
+    if (m_goingAway && !hasActiveStreams()) {
         close();
         return;
     }
@@ -1047,7 +1106,7 @@ void QHttp2Connection::handleReadyRead()
             socket->bytesAvailable());
 
     using namespace Http2;
-    while (!m_goingAway || std::any_of(m_streams.cbegin(), m_streams.cend(), streamIsActive)) {
+    while (!m_goingAway || hasActiveStreams()) {
         const auto result = frameReader.read(*socket);
         if (result != FrameStatus::goodFrame)
             qCDebug(qHttp2ConnectionLog, "[%p] Tried to read frame, got %d", this, int(result));
@@ -1171,6 +1230,7 @@ void QHttp2Connection::setH2Configuration(QHttp2Configuration config)
     pushPromiseEnabled = m_config.serverPushEnabled();
     streamInitialReceiveWindowSize = qint32(m_config.streamReceiveWindowSize());
     encoder.setCompressStrings(m_config.huffmanCompressionEnabled());
+    encoder.setHeaderBlockCachingEnabled(true);
 }
 
 void QHttp2Connection::connectionError(Http2Error errorCode, const char *message)
@@ -1273,6 +1333,7 @@ bool QHttp2Connection::sendSETTINGS()
         return false;
 
     waitingForSettingsACK = true;
+    m_settingsTimer.start();
     return true;
 }
 
@@ -1316,9 +1377,11 @@ void QHttp2Connection::handleDATA()
 
     // RFC9113, 6.1: If a DATA frame is received whose stream is not in the "open" or
     // "half-closed (local)" state, the recipient MUST respond with a stream error.
+    // A stream we reset might have been deleted (or refused without ever creating
+    // it), its DATA still counts towards the connection's flow control though.
     auto stream = getStream(streamID);
-    if (stream->state() == QHttp2Stream::State::HalfClosedRemote
-        || stream->state() == QHttp2Stream::State::Closed) {
+    if (stream && (stream->state() == QHttp2Stream::State::HalfClosedRemote
+        || stream->state() == QHttp2Stream::State::Closed)) {
         return stream->streamError(Http2Error::STREAM_CLOSED,
                                    QLatin1String("Data on closed stream"));
     }
@@ -1333,14 +1396,16 @@ void QHttp2Connection::handleDATA()
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
 
-    auto it = m_streams.constFind(streamID);
-    if (it != m_streams.cend() && it.value())
-        it.value()->handleDATA(inboundFrame);
+    if (stream)
+        stream->handleDATA(inboundFrame);
 
     if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM))
         emit receivedEND_STREAM(streamID);
 
     if (sessionReceiveWindowSize < maxSessionReceiveWindowSize / 2) {
+        maxSessionReceiveWindowSize = autoTunedWindowSize(maxSessionReceiveWindowSize,
+                                                          maxAutoTunedSessionWindowSize,
+                                                          m_lastSessionWindowUpdate);
         // @future[consider]: emit signal instead
         QMetaObject::invokeMethod(this, &QHttp2Connection::sendWINDOW_UPDATE, Qt::QueuedConnection,
                                   quint32(connectionStreamID),
@@ -1366,11 +1431,30 @@ void QHttp2Connection::handleHEADERS()
     const bool isRemotelyInitiatedStream = isClient ^ isClientInitiatedStream;
 
     if (isRemotelyInitiatedStream && streamID > m_lastIncomingStreamID) {
-        QHttp2Stream *newStream = createStreamInternal_impl(streamID);
-        Q_ASSERT(newStream);
         m_lastIncomingStreamID = streamID;
-        qCDebug(qHttp2ConnectionLog, "[%p] Created new incoming stream %d", this, streamID);
-        emit newIncomingStream(newStream);
+        if (size_t(numActiveRemoteStreams()) >= size_t(m_config.maxConcurrentStreams())) {
+            // RFC 9113, 5.1.2: An endpoint that receives a HEADERS frame that causes its
+            // advertised concurrent stream limit to be exceeded MUST treat this as a stream
+            // error of type PROTOCOL_ERROR or REFUSED_STREAM.
+            // No stream is created, but the header block still has to be decoded below,
+            // since it changes the HPACK context.
+            qCDebug(qHttp2ConnectionLog, "[%p] Refusing incoming stream %d, %lld streams active",
+                    this, streamID, qlonglong(numActiveRemoteStreams()));
+            registerStreamAsResetLocally(streamID);
+            frameWriter.start(FrameType::RST_STREAM, FrameFlag::EMPTY, streamID);
+            frameWriter.append(quint32(REFUSE_STREAM));
+            frameWriter.write(*getSocket());
+        } else {
+            QHttp2Stream *newStream = createStreamInternal_impl(streamID);
+            Q_ASSERT(newStream);
+            qCDebug(qHttp2ConnectionLog, "[%p] Created new incoming stream %d", this, streamID);
+            emit newIncomingStream(newStream);
+        }
+    } else if (streamWasResetLocally(streamID)) {
+        // The peer has yet to see our RST_STREAM, and the stream might be gone by now.
+        // The header block is decoded below but otherwise ignored.
+        qCDebug(qHttp2ConnectionLog, "[%p] Received HEADERS on locally reset stream %d", this,
+                streamID);
     } else if (auto it = m_streams.constFind(streamID); it == m_streams.cend()) {
         // RFC 9113, 6.2: HEADERS frames MUST be associated with a stream.
         // A connection error is not required but it seems to be the right thing to do.
@@ -1458,7 +1542,7 @@ void QHttp2Connection::handleRST_STREAM()
     Q_ASSERT(inboundFrame.payloadSize() == 4);
 
     const auto error = qFromBigEndian<quint32>(inboundFrame.dataBegin());
-    if (QPointer<QHttp2Stream> stream = m_streams[streamID])
+    if (QPointer<QHttp2Stream> stream = m_streams.value(streamID))
         emit stream->rstFrameRecived(error);
 
     // Verify that whatever stream is being RST'd is not in the idle state:
@@ -1475,7 +1559,7 @@ void QHttp2Connection::handleRST_STREAM()
 
     Q_ASSERT(inboundFrame.dataSize() == 4);
 
-    if (QPointer<QHttp2Stream> stream = m_streams[streamID])
+    if (QPointer<QHttp2Stream> stream = m_streams.value(streamID))
         stream->handleRST_STREAM(inboundFrame);
 }
 
@@ -1498,6 +1582,7 @@ void QHttp2Connection::handleSETTINGS()
             return connectionError(PROTOCOL_ERROR, "unexpected SETTINGS ACK");
         qCDebug(qHttp2ConnectionLog, "[%p] Received SETTINGS ACK", this);
         waitingForSettingsACK = false;
+        addRoundTripTimeSample(m_settingsTimer.durationElapsed());
         return;
     }
     qCDebug(qHttp2ConnectionLog, "[%p] Received SETTINGS frame", this);
@@ -1632,6 +1717,7 @@ void QHttp2Connection::handlePING()
             emit pingFrameRecived(PingState::PongSignatureChanged);
             qCWarning(qHttp2ConnectionLog, "[%p] PING signature does not match the last PING.", this);
         } else {
+            addRoundTripTimeSample(m_pingTimer.durationElapsed());
             emit pingFrameRecived(PingState::PongSignatureIdentical);
         }
         m_lastPingSignature.reset();
@@ -1693,8 +1779,7 @@ void QHttp2Connection::handleGOAWAY()
             stream->finishWithError(errorCode, "Received GOAWAY"_L1);
     }
 
-    const auto isActive = [](const QHttp2Stream *stream) { return stream && stream->isActive(); };
-    if (std::none_of(m_streams.cbegin(), m_streams.cend(), isActive))
+    if (!hasActiveStreams())
         closeSession();
 }
 
@@ -1779,10 +1864,11 @@ void QHttp2Connection::handleContinuedHEADERS()
 
     const auto streamID = continuedFrames[0].streamID();
 
-    const auto streamIt = m_streams.constFind(streamID);
+    // The entry of a stream that was deleted stays until the next purge, so
+    // treat it like a missing one.
+    QHttp2Stream *stream = m_streams.value(streamID);
     if (firstFrameType == FrameType::HEADERS) {
-        if (streamIt != m_streams.cend()) {
-            QHttp2Stream *stream = streamIt.value();
+        if (stream) {
             if (stream->state() != QHttp2Stream::State::HalfClosedLocal
                 && stream->state() != QHttp2Stream::State::ReservedRemote
                 && stream->state() != QHttp2Stream::State::Idle
@@ -1814,9 +1900,9 @@ void QHttp2Connection::handleContinuedHEADERS()
             // not include a complete and valid set of header fields or the :method
             // pseudo-header field identifies a method that is not safe, it MUST
             // respond with a stream error (Section 5.4.2) of type PROTOCOL_ERROR."
-            if (streamIt != m_streams.cend()) {
-                (*streamIt)->streamError(PROTOCOL_ERROR,
-                                         QLatin1String("PUSH_PROMISE with incomplete headers"));
+            if (stream) {
+                stream->streamError(PROTOCOL_ERROR,
+                                    QLatin1String("PUSH_PROMISE with incomplete headers"));
             }
             return;
         }
@@ -1829,12 +1915,12 @@ void QHttp2Connection::handleContinuedHEADERS()
             return connectionError(FRAME_SIZE_ERROR, "HEADERS frame too large");
     }
 
-    if (streamIt == m_streams.cend()) // No more processing without a stream from here on.
+    if (!stream) // No more processing without a stream from here on.
         return;
 
     switch (firstFrameType) {
     case FrameType::HEADERS:
-        streamIt.value()->handleHEADERS(continuedFrames[0].flags(), decoder.decodedHeader());
+        stream->handleHEADERS(continuedFrames[0].flags(), decoder.decodedHeader());
         break;
     case FrameType::PUSH_PROMISE: {
         std::optional<QUrl> promiseKey = HPack::makePromiseKeyUrl(decoder.decodedHeader());
@@ -1843,10 +1929,10 @@ void QHttp2Connection::handleContinuedHEADERS()
         if (m_promisedStreams.contains(*promiseKey))
             return; // already promised!
         const auto promiseID = qFromBigEndian<quint32>(continuedFrames[0].dataBegin());
-        QHttp2Stream *stream = m_streams.value(promiseID);
-        stream->transitionState(QHttp2Stream::StateTransition::CloseLocal);
-        stream->handleHEADERS(continuedFrames[0].flags(), decoder.decodedHeader());
-        emit newPromisedStream(stream); // @future[consider] add promise key as argument?
+        QHttp2Stream *promisedStream = m_streams.value(promiseID);
+        promisedStream->transitionState(QHttp2Stream::StateTransition::CloseLocal);
+        promisedStream->handleHEADERS(continuedFrames[0].flags(), decoder.decodedHeader());
+        emit newPromisedStream(promisedStream); // @future[consider] add promise key as argument?
         m_promisedStreams.emplace(*promiseKey, promiseID);
         break;
     }
@@ -1855,6 +1941,34 @@ void QHttp2Connection::handleContinuedHEADERS()
     }
 }
 
+void QHttp2Connection::addRoundTripTimeSample(std::chrono::nanoseconds sample) noexcept
+{
+    // Smoothed like TCP does it (RFC 6298), so that a single late
+    // acknowledgment does not throw off the window autotuning:
+    if (m_roundTripTime.count() == 0)
+        m_roundTripTime = sample;
+    else
+        m_roundTripTime = (7 * m_roundTripTime + sample) / 8;
+}
+
+// Returns the size a receive window of windowSize should have after the
+// WINDOW_UPDATE that is about to be sent for it. lastUpdate tracks when the
+// previous one was sent.
+qint32 QHttp2Connection::autoTunedWindowSize(qint32 windowSize, qint32 maxWindowSize,
+                                             QElapsedTimer &lastUpdate) const
+{
+    if (!m_windowAutoTuning)
+        return windowSize;
+    // If the peer used up half of the window within two round trips, the
+    // window is what limits the throughput, rather than the peer or us.
+    const bool windowLimited = lastUpdate.isValid() && m_roundTripTime.count() > 0
+            && lastUpdate.durationElapsed() < 2 * m_roundTripTime;
+    lastUpdate.start();
+    if (!windowLimited || windowSize >= maxWindowSize)
+        return windowSize;
+    return qint32(std::min(2 * qint64(windowSize), qint64(maxWindowSize)));
+}
+
 bool QHttp2Connection::acceptSetting(Http2::Settings identifier, quint32 newValue)
 {
     switch (identifier) {
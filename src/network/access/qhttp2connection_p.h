@@ -18,6 +18,7 @@
 #include <private/qtnetworkglobal_p.h>
 
 #include <QtCore/qobject.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qxpfunctional.h>
@@ -29,6 +30,7 @@
 #include <private/http2frames_p.h>
 #include <private/hpack_p.h>
 
+#include <chrono>
 #include <variant>
 #include <optional>
 #include <type_traits>
@@ -185,7 +187,10 @@ private:
     // Keep it const since it never changes after creation
     const quint32 m_streamID = 0;
     qint32 m_recvWindow = 0;
+    // The window we top m_recvWindow up to, grows with window autotuning:
+    qint32 m_recvWindowLimit = 0;
     qint32 m_sendWindow = 0;
+    QElapsedTimer m_lastWindowUpdate;
     bool m_endStreamAfterDATA = false;
     std::optional<quint32> m_RST_STREAM_received;
     std::optional<quint32> m_RST_STREAM_sent;
@@ -251,6 +256,10 @@ public:
 
     bool isUpgradedConnection() const noexcept { return m_upgradedConnection; }
 
+    void setReceiveWindowAutoTuningEnabled(bool enable) noexcept { m_windowAutoTuning = enable; }
+    bool isReceiveWindowAutoTuningEnabled() const noexcept { return m_windowAutoTuning; }
+    std::chrono::nanoseconds roundTripTime() const noexcept { return m_roundTripTime; }
+
 Q_SIGNALS:
     void newIncomingStream(QHttp2Stream *stream);
     void newPromisedStream(QHttp2Stream *stream);
@@ -285,6 +294,14 @@ private:
     qsizetype numActiveStreamsImpl(quint32 mask) const noexcept;
     qsizetype numActiveRemoteStreams() const noexcept;
     qsizetype numActiveLocalStreams() const noexcept;
+    bool hasActiveStreams() const noexcept
+    { return m_numActiveStreams[0] != 0 || m_numActiveStreams[1] != 0; }
+    void streamActivityChanged(quint32 streamID, bool active) noexcept;
+    void purgeDeletedStreams();
+
+    qint32 autoTunedWindowSize(qint32 windowSize, qint32 maxWindowSize,
+                               QElapsedTimer &lastUpdate) const;
+    void addRoundTripTimeSample(std::chrono::nanoseconds sample) noexcept;
 
     bool sendClientPreface();
     bool sendSETTINGS();
@@ -325,10 +342,16 @@ private:
 
     QHttp2Configuration m_config;
     QHash<quint32, QPointer<QHttp2Stream>> m_streams;
+    // Entries of deleted streams are purged once the hash grows past this:
+    qsizetype m_streamsPurgeThreshold = 64;
+    // Number of active streams, indexed by the lowest bit of their ID:
+    qsizetype m_numActiveStreams[2] = {};
     QHash<QUrl, quint32> m_promisedStreams;
     QList<quint32> m_resetStreamIDs;
 
     std::optional<QByteArray> m_lastPingSignature = std::nullopt;
+    QElapsedTimer m_pingTimer;
+    QElapsedTimer m_settingsTimer;
     quint32 m_nextStreamID = 1;
 
     // Peer's max frame size (this min is the default value
@@ -349,14 +372,22 @@ private:
     // This is how many concurrent streams our peer allows us, 100 is the
     // initial value, can be updated by the server's SETTINGS frame(s):
     quint32 m_maxConcurrentStreams = Http2::maxConcurrentStreams;
-    // While we allow sending SETTTINGS_MAX_CONCURRENT_STREAMS to limit our peer,
-    // it's just a hint and we do not actually enforce it (and we can continue
-    // sending requests and creating streams while maxConcurrentStreams allows).
+    // The limit we advertise with SETTINGS_MAX_CONCURRENT_STREAMS comes from
+    // QHttp2Configuration, streams our peer opens beyond it are refused.
 
-    // This is our (client-side) maximum possible receive window size, we set
-    // it in a ctor from QHttp2Configuration, it does not change after that.
+    // This is our maximum possible receive window size, we set it in a ctor
+    // from QHttp2Configuration, only window autotuning changes it after that.
     // The default is 64Kb:
     qint32 maxSessionReceiveWindowSize = Http2::defaultSessionWindowSize;
+    QElapsedTimer m_lastSessionWindowUpdate;
+
+    // Receive window autotuning doubles a window when it has to be updated
+    // twice within two round trips, up to these limits:
+    static constexpr qint32 maxAutoTunedStreamWindowSize = 16 * 1024 * 1024;
+    static constexpr qint32 maxAutoTunedSessionWindowSize = 64 * 1024 * 1024;
+    bool m_windowAutoTuning = false;
+    // Smoothed round trip time, measured with SETTINGS and PING frames:
+    std::chrono::nanoseconds m_roundTripTime{0};
 
     // Our session current receive window size, updated in a ctor from
     // QHttp2Configuration. Signed integer since it can become negative
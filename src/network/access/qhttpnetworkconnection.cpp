@@ -21,6 +21,8 @@
 #include <qspan.h>
 #include <qvarlengtharray.h>
 
+#include <algorithm>
+
 #ifndef QT_NO_SSL
 #    include <private/qsslsocket_p.h>
 #    include <QtNetwork/qsslkey.h>
@@ -1065,16 +1067,26 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
             return;
 
         // try to get a free AND connected socket
+        QVarLengthArray<int> idleChannels;
         for (int i = 0; i < activeChannelCount; ++i) {
             if (channels[i].socket) {
                 if (!channels[i].reply && !channels[i].isSocketBusy()
                     && QSocketAbstraction::socketState(channels[i].socket)
                             == QAbstractSocket::ConnectedState) {
-                    if (dequeueRequest(channels[i].socket))
-                        channels[i].sendRequest();
+                    idleChannels.push_back(i);
                 }
             }
         }
+        if (poolConfiguration.lifoReuseEnabled()) {
+            // The most recently used channel first:
+            std::stable_sort(idleChannels.begin(), idleChannels.end(), [this](int lhs, int rhs) {
+                return channels[lhs].lastUsed > channels[rhs].lastUsed;
+            });
+        }
+        for (int i : idleChannels) {
+            if (dequeueRequest(channels[i].socket))
+                channels[i].sendRequest();
+        }
         break;
     }
     case QHttpNetworkConnection::ConnectionTypeHTTP2Direct:
@@ -1466,6 +1478,18 @@ void QHttpNetworkConnection::setHttp2Parameters(const QHttp2Configuration &param
     d->http2Parameters = params;
 }
 
+QNetworkConnectionPoolConfiguration QHttpNetworkConnection::poolConfiguration() const
+{
+    Q_D(const QHttpNetworkConnection);
+    return d->poolConfiguration;
+}
+
+void QHttpNetworkConnection::setPoolConfiguration(const QNetworkConnectionPoolConfiguration &config)
+{
+    Q_D(QHttpNetworkConnection);
+    d->poolConfiguration = config;
+}
+
 // SSL support below
 #ifndef QT_NO_SSL
 void QHttpNetworkConnection::setSslConfiguration(const QSslConfiguration &config)
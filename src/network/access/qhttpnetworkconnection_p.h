@@ -21,6 +21,7 @@
 #include <QtNetwork/qabstractsocket.h>
 
 #include <qhttp2configuration.h>
+#include <qnetworkconnectionpool.h>
 
 #include <private/qobject_p.h>
 #include <qauthenticator.h>
@@ -96,6 +97,9 @@ public:
     QHttp2Configuration http2Parameters() const;
     void setHttp2Parameters(const QHttp2Configuration &params);
 
+    QNetworkConnectionPoolConfiguration poolConfiguration() const;
+    void setPoolConfiguration(const QNetworkConnectionPoolConfiguration &config);
+
 #ifndef QT_NO_SSL
     void setSslConfiguration(const QSslConfiguration &config);
     void ignoreSslErrors(int channel = -1);
@@ -250,6 +254,10 @@ public:
 #endif
 
     QHttp2Configuration http2Parameters;
+    QNetworkConnectionPoolConfiguration poolConfiguration;
+    // Incremented whenever a channel finishes a request, see
+    // QHttpNetworkConnectionChannel::lastUsed
+    quint64 channelUseCounter = 0;
 
     QString peerVerifyName;
     // If network status monitoring is enabled, we activate connectionMonitor
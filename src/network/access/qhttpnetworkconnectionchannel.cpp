@@ -517,6 +517,7 @@ void QHttpNetworkConnectionChannel::allDone()
     // now the channel can be seen as free/idle again, all signal emissions for the reply have been done
     if (state != QHttpNetworkConnectionChannel::ClosingState)
         state = QHttpNetworkConnectionChannel::IdleState;
+    lastUsed = ++connection->d_func()->channelUseCounter;
 
     // if it does not need to be sent again we can set it to 0
     // the previous code did not do that and we had problems with accidental re-sending of a
@@ -908,7 +909,8 @@ void QHttpNetworkConnectionChannel::_q_connected_abstract_socket(QAbstractSocket
     // the requests into one TCP packet.
 
     // not sure yet if it helps, but it makes sense
-    absSocket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+    const bool keepAlive = connection->d_func()->poolConfiguration.keepAliveProbesEnabled();
+    absSocket->setSocketOption(QAbstractSocket::KeepAliveOption, keepAlive ? 1 : 0);
 
     pipeliningSupported = QHttpNetworkConnectionChannel::PipeliningSupportUnknown;
 
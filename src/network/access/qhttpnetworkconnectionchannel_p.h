@@ -88,6 +88,7 @@ public:
     int lastStatus; // last status received on this channel
     bool pendingEncrypt; // for https (send after encrypted)
     int reconnectAttempts; // maximum 2 reconnection attempts
+    quint64 lastUsed = 0; // connection's channelUseCounter when the last request finished
     QAuthenticator authenticator;
     QAuthenticator proxyAuthenticator;
     bool authenticationCredentialsSent;
@@ -239,6 +239,8 @@ void QHttpThreadDelegate::startRequest()
 #ifdef QHTTPTHREADDELEGATE_DEBUG
     qDebug() << "QHttpThreadDelegate::startRequest() thread=" << QThread::currentThreadId();
 #endif
+    poolWaitTimer.start();
+
     // Check QThreadStorage for the QNetworkAccessCache
     // If not there, create this connection cache
     if (!connections.hasLocalData()) {
@@ -306,6 +308,10 @@ void QHttpThreadDelegate::startRequest()
 #endif
         cacheKey = makeCacheKey(urlCopy, nullptr, httpRequest.peerVerifyName());
 
+    // connectToHost() doesn't make requests of its own, so it isn't counted
+    QNetworkConnectionPoolCounters *counters = httpRequest.isPreConnect() ? nullptr
+                                                                          : poolCounters.get();
+
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
     if (!httpConnection) {
@@ -317,11 +323,19 @@ void QHttpThreadDelegate::startRequest()
                 host = path;
         }
 
+        if (counters)
+            counters->misses.fetchAndAddRelaxed(1);
+
+        // A QHttp1Configuration set on the request overrides the pool's limit:
+        const qsizetype connectionCount = http1Parameters == QHttp1Configuration()
+                ? poolConfiguration.maximumConnectionsPerHost()
+                : http1Parameters.numberOfConnectionsPerHost();
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
         httpConnection = new QNetworkAccessCachedHttpConnection(
-                http1Parameters.numberOfConnectionsPerHost(), host, urlCopy.port(), ssl,
-                isLocalSocket, connectionType);
+                quint16(connectionCount), host, urlCopy.port(), ssl, isLocalSocket,
+                connectionType);
+        httpConnection->setPoolConfiguration(poolConfiguration);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
             httpConnection->setHttp2Parameters(http2Parameters);
@@ -340,6 +354,8 @@ void QHttpThreadDelegate::startRequest()
         // cache the QHttpNetworkConnection corresponding to this cache key
         connections.localData()->addEntry(cacheKey, httpConnection, connectionCacheExpiryTimeoutSeconds);
     } else {
+        if (counters)
+            counters->hits.fetchAndAddRelaxed(1);
         if (httpRequest.withCredentials()) {
             QNetworkAuthenticationCredential credential = authenticationManager->fetchCachedCredentials(httpRequest.url(), nullptr);
             if (!credential.user.isEmpty() && !credential.password.isEmpty()) {
@@ -355,6 +371,13 @@ void QHttpThreadDelegate::startRequest()
     httpReply = httpConnection->sendRequest(httpRequest);
     httpReply->setParent(this);
 
+    if (counters) {
+        connect(httpReply, &QHttpNetworkReply::requestSent, this, [this] {
+            poolCounters->sentRequests.fetchAndAddRelaxed(1);
+            poolCounters->totalWaitTimeNSecs.fetchAndAddRelaxed(poolWaitTimer.nsecsElapsed());
+        }, Qt::SingleShotConnection);
+    }
+
     // Connect the reply signals that we need to handle and then forward
     if (synchronous) {
         connect(httpReply,SIGNAL(headerChanged()), this, SLOT(synchronousHeaderChangedSlot()));
@@ -28,7 +28,9 @@
 #include "qhttpnetworkconnection_p.h"
 #include "qhttp1configuration.h"
 #include "qhttp2configuration.h"
+#include "qnetworkconnectionpool_p.h"
 #include <QSharedPointer>
+#include <QElapsedTimer>
 #include <QScopedPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
@@ -87,6 +89,8 @@ public:
     QString incomingErrorDetail;
     QHttp1Configuration http1Parameters;
     QHttp2Configuration http2Parameters;
+    QNetworkConnectionPoolConfiguration poolConfiguration;
+    std::shared_ptr<QNetworkConnectionPoolCounters> poolCounters;
 
 protected:
     // The zerocopy download buffer, if used:
@@ -95,6 +99,8 @@ protected:
     QNetworkAccessCachedHttpConnection *httpConnection;
     QByteArray cacheKey;
     QHttpNetworkReply *httpReply;
+    // Measures how long the request waited to be sent
+    QElapsedTimer poolWaitTimer;
 
     // Used for implementing the synchronous HTTP, see startRequestSynchronously()
     QEventLoop *synchronousRequestLoop;
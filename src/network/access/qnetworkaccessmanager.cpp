@@ -1046,6 +1046,11 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
         request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
 
     request.setPeerVerifyName(peerName);
+#if QT_CONFIG(http)
+    Q_D(QNetworkAccessManager);
+    for (qsizetype i = 1; i < d->connectionPoolConfiguration.preconnectCount(); ++i)
+        get(request);
+#endif
     get(request);
 }
 #endif
@@ -1059,7 +1064,8 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
 
     \note This function has no possibility to report errors.
 
-    \sa connectToHostEncrypted(), get(), post(), put(), deleteResource()
+    \sa connectToHostEncrypted(), get(), post(), put(), deleteResource(),
+    QNetworkConnectionPoolConfiguration::setPreconnectCount()
 */
 void QNetworkAccessManager::connectToHost(const QString &hostName, quint16 port)
 {
@@ -1068,9 +1074,69 @@ void QNetworkAccessManager::connectToHost(const QString &hostName, quint16 port)
     url.setPort(port);
     url.setScheme("preconnect-http"_L1);
     QNetworkRequest request(url);
+#if QT_CONFIG(http)
+    Q_D(QNetworkAccessManager);
+    for (qsizetype i = 1; i < d->connectionPoolConfiguration.preconnectCount(); ++i)
+        get(request);
+#endif
     get(request);
 }
 
+#if QT_CONFIG(http)
+/*!
+    \since 6.9
+
+    Sets the configuration of the pool of HTTP connections the manager
+    keeps to \a configuration.
+
+    The configuration applies to connections that are opened after this
+    call. Use clearConnectionCache() to close the existing ones.
+
+    \sa connectionPoolConfiguration(), connectionPoolStatistics()
+*/
+void QNetworkAccessManager::setConnectionPoolConfiguration(
+        const QNetworkConnectionPoolConfiguration &configuration)
+{
+    Q_D(QNetworkAccessManager);
+    d->connectionPoolConfiguration = configuration;
+}
+
+/*!
+    \since 6.9
+
+    Returns the configuration of the pool of HTTP connections.
+
+    \sa setConnectionPoolConfiguration()
+*/
+QNetworkConnectionPoolConfiguration QNetworkAccessManager::connectionPoolConfiguration() const
+{
+    Q_D(const QNetworkAccessManager);
+    return d->connectionPoolConfiguration;
+}
+
+/*!
+    \since 6.9
+
+    Returns how many HTTP requests the manager sent on connections it
+    already had, how many needed new connections, and how long the
+    requests waited to be sent. The counters cover all requests since
+    the manager was created.
+
+    \sa setConnectionPoolConfiguration()
+*/
+QNetworkConnectionPoolStatistics QNetworkAccessManager::connectionPoolStatistics() const
+{
+    Q_D(const QNetworkAccessManager);
+    const QNetworkConnectionPoolCounters &counters = *d->connectionPoolCounters;
+    QNetworkConnectionPoolStatistics statistics;
+    statistics.m_hits = counters.hits.loadRelaxed();
+    statistics.m_misses = counters.misses.loadRelaxed();
+    statistics.m_sentRequests = counters.sentRequests.loadRelaxed();
+    statistics.m_totalWaitTime = std::chrono::nanoseconds(counters.totalWaitTimeNSecs.loadRelaxed());
+    return statistics;
+}
+#endif // QT_CONFIG(http)
+
 /*!
     \since 5.9
 
@@ -9,6 +9,9 @@
 #include <QtCore/QString>
 #include <QtCore/QList>
 #include <QtCore/QObject>
+#if QT_CONFIG(http)
+#include <QtNetwork/qnetworkconnectionpool.h>
+#endif
 #ifndef QT_NO_SSL
 #include <QtNetwork/QSslConfiguration>
 #include <QtNetwork/QSslPreSharedKeyAuthenticator>
@@ -115,6 +118,12 @@ public:
 #endif
     void connectToHost(const QString &hostName, quint16 port = 80);
 
+#if QT_CONFIG(http)
+    void setConnectionPoolConfiguration(const QNetworkConnectionPoolConfiguration &configuration);
+    QNetworkConnectionPoolConfiguration connectionPoolConfiguration() const;
+    QNetworkConnectionPoolStatistics connectionPoolStatistics() const;
+#endif
+
     void setRedirectPolicy(QNetworkRequest::RedirectPolicy policy);
     QNetworkRequest::RedirectPolicy redirectPolicy() const;
 
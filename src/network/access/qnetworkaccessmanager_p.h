@@ -25,6 +25,9 @@
 #include "private/qobject_p.h"
 #include "QtNetwork/qnetworkproxy.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
+#if QT_CONFIG(http)
+#include "qnetworkconnectionpool_p.h"
+#endif
 
 #if QT_CONFIG(settings)
 #include "qhstsstore_p.h"
@@ -133,6 +136,12 @@ public:
 
     std::chrono::milliseconds transferTimeout{0};
 
+#if QT_CONFIG(http)
+    QNetworkConnectionPoolConfiguration connectionPoolConfiguration;
+    std::shared_ptr<QNetworkConnectionPoolCounters> connectionPoolCounters
+            = std::make_shared<QNetworkConnectionPoolCounters>();
+#endif
+
     Q_DECLARE_PUBLIC(QNetworkAccessManager)
 };
 
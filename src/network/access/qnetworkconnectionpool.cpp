@@ -0,0 +1,346 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qnetworkconnectionpool.h"
+
+#include <QtCore/private/qnumeric_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace std::chrono_literals;
+
+/*!
+    \class QNetworkConnectionPoolConfiguration
+    \brief The QNetworkConnectionPoolConfiguration class controls how
+    QNetworkAccessManager keeps and reuses HTTP connections.
+    \since 6.9
+    \reentrant
+
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkAccessManager keeps the connections it opened to a host
+    after the requests on them finished, and sends later requests
+    to the same host on them. QNetworkConnectionPoolConfiguration
+    controls:
+
+    \list
+      \li The number of HTTP/1 connections opened per host.
+      \li How long unused connections are kept open.
+      \li Whether the operating system probes idle connections
+          (TCP keep-alive).
+      \li How many connections connectToHost() and
+          connectToHostEncrypted() open in advance.
+      \li Whether the connection that was used most recently is
+          picked first for the next request (LIFO reuse).
+    \endlist
+
+    \note The configuration applies to connections opened after it was
+    set; call QNetworkAccessManager::clearConnectionCache() to drop the
+    existing ones.
+
+    \sa QNetworkAccessManager::setConnectionPoolConfiguration(),
+    QNetworkConnectionPoolStatistics, QHttp1Configuration
+*/
+
+class QNetworkConnectionPoolConfigurationPrivate : public QSharedData
+{
+public:
+    std::chrono::seconds idleTimeout = 120s; // QNetworkAccessCache's ExpiryTime
+    quint8 maximumConnectionsPerHost = 6; // QHttpNetworkConnectionPrivate::defaultHttpChannelCount
+    quint8 preconnectCount = 1;
+    bool keepAliveProbesEnabled = true;
+    bool lifoReuseEnabled = false;
+};
+
+/*!
+    Default constructs a QNetworkConnectionPoolConfiguration object.
+
+    Such a configuration has the following values:
+    \list
+        \li Six connections per host
+        \li Idle connections are closed after 120 seconds
+        \li TCP keep-alive probes are enabled
+        \li connectToHost() opens one connection
+        \li LIFO reuse is disabled
+    \endlist
+*/
+QNetworkConnectionPoolConfiguration::QNetworkConnectionPoolConfiguration()
+    : d(new QNetworkConnectionPoolConfigurationPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QNetworkConnectionPoolConfiguration.
+*/
+QNetworkConnectionPoolConfiguration::QNetworkConnectionPoolConfiguration(
+        const QNetworkConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-constructs this QNetworkConnectionPoolConfiguration from \a other
+*/
+QNetworkConnectionPoolConfiguration::QNetworkConnectionPoolConfiguration(
+        QNetworkConnectionPoolConfiguration &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QNetworkConnectionPoolConfiguration.
+*/
+QNetworkConnectionPoolConfiguration &
+QNetworkConnectionPoolConfiguration::operator=(const QNetworkConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-assigns \a other to this QNetworkConnectionPoolConfiguration.
+*/
+QNetworkConnectionPoolConfiguration &
+QNetworkConnectionPoolConfiguration::operator=(QNetworkConnectionPoolConfiguration &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QNetworkConnectionPoolConfiguration::~QNetworkConnectionPoolConfiguration()
+{
+}
+
+/*!
+    Sets the number of HTTP/1 connections (minimum: 1; maximum: 255)
+    opened per \e{host}:\e{port} combination to \a number. If \a number
+    is ≤ 0, does nothing. If \a number is > 255, 255 is used.
+
+    A QHttp1Configuration set on the request that opens the connections
+    takes precedence, unless it is default-constructed.
+
+    \sa maximumConnectionsPerHost(), QHttp1Configuration::setNumberOfConnectionsPerHost()
+*/
+void QNetworkConnectionPoolConfiguration::setMaximumConnectionsPerHost(qsizetype number)
+{
+    const auto n = qt_saturate<quint8>(number);
+    if (n == 0)
+        return;
+    d->maximumConnectionsPerHost = n;
+}
+
+/*!
+    Returns the number of HTTP/1 connections opened per
+    \e{host}:\e{port} combination. The default is six (6).
+
+    \sa setMaximumConnectionsPerHost()
+*/
+qsizetype QNetworkConnectionPoolConfiguration::maximumConnectionsPerHost() const
+{
+    return d->maximumConnectionsPerHost;
+}
+
+/*!
+    Sets the time after which the connections to a host are closed
+    when no request used them to \a timeout.
+
+    QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute, when
+    set on the request that opens the connections, takes precedence.
+    Negative values are ignored.
+
+    \sa idleTimeout()
+*/
+void QNetworkConnectionPoolConfiguration::setIdleTimeout(std::chrono::seconds timeout)
+{
+    if (timeout < 0s)
+        return;
+    d->idleTimeout = timeout;
+}
+
+/*!
+    Returns the time after which unused connections are closed.
+    The default is 120 seconds.
+
+    \sa setIdleTimeout()
+*/
+std::chrono::seconds QNetworkConnectionPoolConfiguration::idleTimeout() const
+{
+    return d->idleTimeout;
+}
+
+/*!
+    If \a enable is \c true, the operating system periodically probes
+    idle connections (TCP keep-alive), so that connections which were
+    dropped by the network are detected before a request is sent on them.
+
+    \sa keepAliveProbesEnabled(), QAbstractSocket::KeepAliveOption
+*/
+void QNetworkConnectionPoolConfiguration::setKeepAliveProbesEnabled(bool enable)
+{
+    d->keepAliveProbesEnabled = enable;
+}
+
+/*!
+    Returns \c true if TCP keep-alive probes are enabled on the
+    connections. The default is \c true.
+
+    \sa setKeepAliveProbesEnabled()
+*/
+bool QNetworkConnectionPoolConfiguration::keepAliveProbesEnabled() const
+{
+    return d->keepAliveProbesEnabled;
+}
+
+/*!
+    Sets the number of connections that
+    QNetworkAccessManager::connectToHost() and
+    QNetworkAccessManager::connectToHostEncrypted() open in advance to
+    \a count (minimum: 1; maximum: 255). If \a count is ≤ 0, does
+    nothing.
+
+    At most maximumConnectionsPerHost() connections are opened. HTTP/2
+    always uses a single connection.
+
+    \sa preconnectCount()
+*/
+void QNetworkConnectionPoolConfiguration::setPreconnectCount(qsizetype count)
+{
+    const auto n = qt_saturate<quint8>(count);
+    if (n == 0)
+        return;
+    d->preconnectCount = n;
+}
+
+/*!
+    Returns the number of connections opened in advance by
+    QNetworkAccessManager::connectToHost(). The default is one (1).
+
+    \sa setPreconnectCount()
+*/
+qsizetype QNetworkConnectionPoolConfiguration::preconnectCount() const
+{
+    return d->preconnectCount;
+}
+
+/*!
+    If \a enable is \c true, a request is sent on the idle connection
+    that finished its last request most recently. This keeps a small
+    set of connections busy, and lets the others time out, instead of
+    spreading requests over all connections. It also avoids the
+    connections that were idle long enough to be closed by the server.
+
+    \sa lifoReuseEnabled()
+*/
+void QNetworkConnectionPoolConfiguration::setLifoReuseEnabled(bool enable)
+{
+    d->lifoReuseEnabled = enable;
+}
+
+/*!
+    Returns \c true if the most recently used connection is reused first.
+    The default is \c false, in which case idle connections are reused in
+    the order they were opened.
+
+    \sa setLifoReuseEnabled()
+*/
+bool QNetworkConnectionPoolConfiguration::lifoReuseEnabled() const
+{
+    return d->lifoReuseEnabled;
+}
+
+/*!
+    \fn void QNetworkConnectionPoolConfiguration::swap(QNetworkConnectionPoolConfiguration &other)
+
+    Swaps this configuration with the \a other configuration.
+*/
+
+/*!
+    \fn bool QNetworkConnectionPoolConfiguration::operator==(const QNetworkConnectionPoolConfiguration &lhs, const QNetworkConnectionPoolConfiguration &rhs) noexcept
+
+    Returns \c true if \a lhs and \a rhs have the same set of connection
+    pool parameters.
+*/
+
+/*!
+    \fn bool QNetworkConnectionPoolConfiguration::operator!=(const QNetworkConnectionPoolConfiguration &lhs, const QNetworkConnectionPoolConfiguration &rhs) noexcept
+
+    Returns \c true if \a lhs and \a rhs have different sets of
+    connection pool parameters.
+*/
+
+/*!
+    \internal
+*/
+bool QNetworkConnectionPoolConfiguration::isEqual(
+        const QNetworkConnectionPoolConfiguration &other) const noexcept
+{
+    if (d == other.d)
+        return true;
+
+    return d->idleTimeout == other.d->idleTimeout
+           && d->maximumConnectionsPerHost == other.d->maximumConnectionsPerHost
+           && d->preconnectCount == other.d->preconnectCount
+           && d->keepAliveProbesEnabled == other.d->keepAliveProbesEnabled
+           && d->lifoReuseEnabled == other.d->lifoReuseEnabled;
+}
+
+/*!
+    \class QNetworkConnectionPoolStatistics
+    \brief The QNetworkConnectionPoolStatistics class reports how
+    QNetworkAccessManager reused its HTTP connections.
+    \since 6.9
+    \reentrant
+
+    \inmodule QtNetwork
+    \ingroup network
+
+    The manager keeps a pool of connections for each host (and protocol,
+    proxy and TLS peer name). A request is a \e miss if it created the pool
+    for its host, and a \e hit if that pool already existed, which it does
+    until the connections have been idle for
+    QNetworkConnectionPoolConfiguration::idleTimeout(). A hit is not
+    necessarily sent over a connection that was already established: the
+    pool opens further connections as needed, up to
+    QNetworkConnectionPoolConfiguration::maximumConnectionsPerHost(), and
+    reconnects connections that the server closed. The requests that
+    QNetworkAccessManager::connectToHost() and
+    QNetworkAccessManager::connectToHostEncrypted() make are not counted.
+
+    The wait time of a request is the time from starting it until it was
+    written to a connection; it includes waiting for a free connection and
+    establishing the connection, if one had to be opened.
+
+    \sa QNetworkAccessManager::connectionPoolStatistics(),
+    QNetworkConnectionPoolConfiguration
+*/
+
+/*!
+    \fn QNetworkConnectionPoolStatistics::QNetworkConnectionPoolStatistics() noexcept
+
+    Constructs statistics with all counters set to zero.
+*/
+
+/*!
+    \fn qint64 QNetworkConnectionPoolStatistics::hits() const noexcept
+
+    Returns the number of requests that were started while the manager had a
+    pool of connections for their host.
+*/
+
+/*!
+    \fn qint64 QNetworkConnectionPoolStatistics::misses() const noexcept
+
+    Returns the number of requests that created the pool of connections for
+    their host.
+*/
+
+/*!
+    \fn qint64 QNetworkConnectionPoolStatistics::sentRequests() const noexcept
+
+    Returns the number of requests that were written to a connection.
+
+    \sa totalWaitTime()
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QNetworkConnectionPoolStatistics::totalWaitTime() const noexcept
+
+    Returns the sum of the wait times of the sentRequests(). Divide it by
+    sentRequests() to get the average wait time.
+*/
+
+QT_END_NAMESPACE
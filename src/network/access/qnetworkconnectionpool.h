@@ -0,0 +1,82 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNETWORKCONNECTIONPOOL_H
+#define QNETWORKCONNECTIONPOOL_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+
+#include <QtCore/qshareddata.h>
+
+#include <chrono>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QNetworkConnectionPoolConfigurationPrivate;
+class Q_NETWORK_EXPORT QNetworkConnectionPoolConfiguration
+{
+public:
+    QNetworkConnectionPoolConfiguration();
+    QNetworkConnectionPoolConfiguration(const QNetworkConnectionPoolConfiguration &other);
+    QNetworkConnectionPoolConfiguration(QNetworkConnectionPoolConfiguration &&other) noexcept;
+    QNetworkConnectionPoolConfiguration &operator=(const QNetworkConnectionPoolConfiguration &other);
+    QNetworkConnectionPoolConfiguration &operator=(QNetworkConnectionPoolConfiguration &&other) noexcept;
+
+    ~QNetworkConnectionPoolConfiguration();
+
+    void setMaximumConnectionsPerHost(qsizetype number);
+    qsizetype maximumConnectionsPerHost() const;
+
+    void setIdleTimeout(std::chrono::seconds timeout);
+    std::chrono::seconds idleTimeout() const;
+
+    void setKeepAliveProbesEnabled(bool enable);
+    bool keepAliveProbesEnabled() const;
+
+    void setPreconnectCount(qsizetype count);
+    qsizetype preconnectCount() const;
+
+    void setLifoReuseEnabled(bool enable);
+    bool lifoReuseEnabled() const;
+
+    void swap(QNetworkConnectionPoolConfiguration &other) noexcept { d.swap(other.d); }
+
+private:
+    QSharedDataPointer<QNetworkConnectionPoolConfigurationPrivate> d;
+
+    bool isEqual(const QNetworkConnectionPoolConfiguration &other) const noexcept;
+
+    friend bool operator==(const QNetworkConnectionPoolConfiguration &lhs,
+                           const QNetworkConnectionPoolConfiguration &rhs) noexcept
+    { return lhs.isEqual(rhs); }
+    friend bool operator!=(const QNetworkConnectionPoolConfiguration &lhs,
+                           const QNetworkConnectionPoolConfiguration &rhs) noexcept
+    { return !lhs.isEqual(rhs); }
+};
+
+Q_DECLARE_SHARED(QNetworkConnectionPoolConfiguration)
+
+class QNetworkConnectionPoolStatistics
+{
+public:
+    constexpr QNetworkConnectionPoolStatistics() noexcept = default;
+
+    constexpr qint64 hits() const noexcept { return m_hits; }
+    constexpr qint64 misses() const noexcept { return m_misses; }
+    constexpr qint64 sentRequests() const noexcept { return m_sentRequests; }
+    constexpr std::chrono::nanoseconds totalWaitTime() const noexcept { return m_totalWaitTime; }
+
+private:
+    friend class QNetworkAccessManager;
+
+    qint64 m_hits = 0;
+    qint64 m_misses = 0;
+    qint64 m_sentRequests = 0;
+    std::chrono::nanoseconds m_totalWaitTime{0};
+};
+
+QT_END_NAMESPACE
+
+#endif // QNETWORKCONNECTIONPOOL_H
@@ -0,0 +1,39 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNETWORKCONNECTIONPOOL_P_H
+#define QNETWORKCONNECTIONPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include <QtNetwork/qnetworkconnectionpool.h>
+
+#include <QtCore/qatomic.h>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+// Shared by a QNetworkAccessManager and the QHttpThreadDelegates of its
+// requests, which update it from the HTTP thread.
+struct QNetworkConnectionPoolCounters
+{
+    QAtomicInteger<qint64> hits;
+    QAtomicInteger<qint64> misses;
+    QAtomicInteger<qint64> sentRequests;
+    QAtomicInteger<qint64> totalWaitTimeNSecs;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNETWORKCONNECTIONPOOL_P_H
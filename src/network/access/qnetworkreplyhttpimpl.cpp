@@ -822,8 +822,13 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     delegate->http2Parameters = request.http2Configuration();
     delegate->http1Parameters = request.http1Configuration();
 
+    delegate->poolConfiguration = managerPrivate->connectionPoolConfiguration;
+    delegate->poolCounters = managerPrivate->connectionPoolCounters;
+
     if (request.attribute(QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute).isValid())
         delegate->connectionCacheExpiryTimeoutSeconds = request.attribute(QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute).toInt();
+    else
+        delegate->connectionCacheExpiryTimeoutSeconds = managerPrivate->connectionPoolConfiguration.idleTimeout().count();
 
     // For the synchronous HTTP, this is the normal way the delegate gets deleted
     // For the asynchronous HTTP this is a safety measure, the delegate deletes itself when HTTP is finished
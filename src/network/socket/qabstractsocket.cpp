@@ -769,11 +769,14 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
-
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    // Attempt to write several chunks with a single call.
+    QByteArrayView blocks[16];
+    const qsizetype blockCount = writeBuffer.dataBlocks(blocks);
+    qint64 written = Q_INT64_C(0);
+    if (blockCount > 1)
+        written = socketEngine->writeGathered(QSpan(blocks).first(blockCount));
+    else if (blockCount == 1)
+        written = socketEngine->write(blocks[0].data(), blocks[0].size());
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -806,6 +809,53 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Hands the blocks of \a data to the socket engine at once if the socket
+    is unbuffered, like writeData() does for a single block. Otherwise, they
+    are appended to the write buffer, which writeToSocket() flushes with
+    gathering writes.
+*/
+qint64 QAbstractSocketPrivate::writeGathered(QSpan<const QByteArrayView> data)
+{
+    if (state == QAbstractSocket::UnconnectedState || !socketEngine || isBuffered
+        || (socketType == QAbstractSocket::TcpSocket && !writeBuffer.isEmpty())) {
+        return QIODevicePrivate::writeGathered(data);
+    }
+
+    if (socketType != QAbstractSocket::TcpSocket) {
+        // This is for a QUdpSocket that was connect()ed
+        const qint64 written = socketEngine->writeGathered(data);
+        if (written < 0)
+            setError(socketEngine->error(), socketEngine->errorString());
+        else
+            emitBytesWritten(written);
+        return written;
+    }
+
+    // This is for the unbuffered QTcpSocket
+    qint64 size = 0;
+    for (QByteArrayView block : data)
+        size += block.size();
+    qint64 written = size ? socketEngine->writeGathered(data) : Q_INT64_C(0);
+    if (written < 0) {
+        setError(socketEngine->error(), socketEngine->errorString());
+    } else if (written < size) {
+        // Buffer what was not written yet
+        for (QByteArrayView block : data) {
+            if (written >= block.size()) {
+                written -= block.size();
+                continue;
+            }
+            writeBuffer.append(block.data() + written, block.size() - written);
+            written = 0;
+        }
+        written = size;
+        socketEngine->setWriteNotificationEnabled(true);
+    }
+    return written; // written = actually written + what has been buffered
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -223,6 +223,94 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+qint64 QAbstractSocketEngine::writeGathered(QSpan<const QByteArrayView> data)
+{
+    if (socketType() == QAbstractSocket::UdpSocket) {
+        // a datagram must be sent as a whole
+        QByteArray datagram;
+        for (QByteArrayView block : data)
+            datagram += block;
+        return write(datagram.constData(), datagram.size());
+    }
+
+    qint64 writtenSoFar = 0;
+    for (QByteArrayView block : data) {
+        if (block.isEmpty())
+            continue;
+        const qint64 written = write(block.data(), block.size());
+        if (written <= 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < block.size())
+            break;
+    }
+    return writtenSoFar;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    \internal
+
+    Receives up to \c{data.size()} datagrams, each no larger than \a maxlen
+    bytes or of any size if \a maxlen is negative, into \a data and their
+    packet headers into \a headers, which must be as large as \a data.
+
+    Returns the number of datagrams received, which is 0 if there were none
+    pending, or -1 if an error occurred before any datagram was received.
+    This implementation calls readDatagram() for each datagram.
+*/
+qsizetype QAbstractSocketEngine::readDatagrams(QSpan<QByteArray> data,
+                                               QSpan<QIpPacketHeader> headers, qint64 maxlen,
+                                               PacketHeaderOptions options)
+{
+    Q_ASSERT(headers.size() == data.size());
+    qsizetype count = 0;
+    for (; count < data.size() && hasPendingDatagrams(); ++count) {
+        const qint64 size = maxlen < 0 ? pendingDatagramSize() : maxlen;
+        if (size < 0)
+            break;
+        QByteArray &datagram = data[count];
+        datagram.resize(size);
+        const qint64 readBytes = readDatagram(datagram.data(), size, &headers[count], options);
+        if (readBytes < 0) {
+            datagram.clear();
+            if (count)
+                break;
+            return readBytes == -2 ? 0 : -1;
+        }
+        datagram.truncate(readBytes);
+    }
+    return count;
+}
+
+/*!
+    \internal
+
+    Sends each block of \a data as a datagram with the corresponding packet
+    header of \a headers, which must be as large as \a data.
+
+    Returns the number of datagrams sent, which is less than \c{data.size()}
+    if the send buffer of the socket was full, or -1 if an error occurred
+    before any datagram was sent. This implementation calls writeDatagram()
+    for each datagram.
+*/
+qsizetype QAbstractSocketEngine::writeDatagrams(QSpan<const QByteArrayView> data,
+                                                QSpan<const QIpPacketHeader> headers)
+{
+    Q_ASSERT(headers.size() == data.size());
+    qsizetype count = 0;
+    for (; count < data.size(); ++count) {
+        const qint64 sent = writeDatagram(data[count].data(), data[count].size(), headers[count]);
+        if (sent < 0) {
+            if (count)
+                break;
+            return sent == -2 ? 0 : -1;
+        }
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
@@ -116,6 +116,9 @@ public:
     void _q_abortConnectionAttempt();
     void cancelDelayedConnect();
     void describeSocket(qintptr socketDescriptor);
+    QByteArrayView peekChunk() override;
+    QByteArray readChunk() override;
+    qint64 writeGathered(QSpan<const QByteArrayView> data) override;
     static bool parseSockaddr(const sockaddr_un &addr, uint len,
                               QString &fullServerName, QString &serverName, bool &abstractNamespace);
     QSocketNotifier *delayConnect;
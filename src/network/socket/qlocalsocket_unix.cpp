@@ -448,6 +448,32 @@ qint64 QLocalSocket::readData(char *data, qint64 c)
     return d->unixSocket.read(data, c);
 }
 
+QByteArrayView QLocalSocketPrivate::peekChunk()
+{
+    // Unless a transaction keeps it in our own buffer, the received data is
+    // still in the one of the underlying socket.
+    if (buffer.isEmpty() && unixSocket.isReadable())
+        return unixSocket.peekChunk();
+    return QIODevicePrivate::peekChunk();
+}
+
+QByteArray QLocalSocketPrivate::readChunk()
+{
+    if (buffer.isEmpty() && unixSocket.isReadable()) {
+        // read() hands out the chunk without copying it if the sizes match
+        const qint64 size = unixSocket.peekChunk().size();
+        return size ? unixSocket.read(size) : QByteArray();
+    }
+    return QIODevicePrivate::readChunk();
+}
+
+qint64 QLocalSocketPrivate::writeGathered(QSpan<const QByteArrayView> data)
+{
+    if (!unixSocket.isWritable())
+        return QIODevicePrivate::writeGathered(data);
+    return unixSocket.write(data);
+}
+
 qint64 QLocalSocket::readLineData(char *data, qint64 maxSize)
 {
     if (!maxSize)
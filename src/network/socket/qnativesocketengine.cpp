@@ -866,6 +866,56 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Receives up to \c{data.size()} datagrams into \a data and their packet
+    headers into \a headers. On Linux, all of them are received with one
+    call to the system.
+
+    \sa QAbstractSocketEngine::readDatagrams()
+*/
+qsizetype QNativeSocketEngine::readDatagrams(QSpan<QByteArray> data,
+                                             QSpan<QIpPacketHeader> headers, qint64 maxSize,
+                                             PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_ASSERT(headers.size() == data.size());
+
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    return d->nativeReceiveDatagrams(data, headers, maxSize, options);
+#else
+    return QAbstractSocketEngine::readDatagrams(data, headers, maxSize, options);
+#endif
+}
+
+/*!
+    Sends the datagrams in \a data with the packet headers in \a headers.
+    On Linux, they are sent with one call to the system, and consecutive
+    datagrams of the same size and to the same destination are passed to
+    the kernel as one message, which it segments into the datagrams.
+
+    \sa QAbstractSocketEngine::writeDatagrams()
+*/
+qsizetype QNativeSocketEngine::writeDatagrams(QSpan<const QByteArrayView> data,
+                                              QSpan<const QIpPacketHeader> headers)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_ASSERT(headers.size() == data.size());
+
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    return d->nativeSendDatagrams(data, headers);
+#else
+    return QAbstractSocketEngine::writeDatagrams(data, headers);
+#endif
+}
+#endif // QT_NO_UDPSOCKET
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -882,6 +932,18 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the blocks of \a data to the socket with a single call to the
+    system. Returns the number of bytes written, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeGathered(QSpan<const QByteArrayView> data)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeGathered(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeGathered(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteGathered(data);
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -123,6 +123,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeGathered(QSpan<const QByteArrayView> data) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -141,6 +142,12 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#ifndef QT_NO_UDPSOCKET
+    qsizetype readDatagrams(QSpan<QByteArray> data, QSpan<QIpPacketHeader> headers,
+                            qint64 maxlen, PacketHeaderOptions options = WantNone) override;
+    qsizetype writeDatagrams(QSpan<const QByteArrayView> data,
+                             QSpan<const QIpPacketHeader> headers) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
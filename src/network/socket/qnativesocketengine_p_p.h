@@ -60,6 +60,11 @@ typedef INT (WSAAPI *LPFN_WSASENDMSG)(SOCKET s, LPWSAMSG lpMsg, DWORD dwFlags,
 #  endif // !WSAID_WSASENDMSG
 #endif // Q_OS_WIN
 
+#if defined(Q_OS_LINUX)
+// recvmmsg() and sendmmsg() receive and send several datagrams in one call
+#  define QT_NATIVESOCKETENGINE_MMSG
+#endif
+
 union qt_sockaddr {
     sockaddr a;
     sockaddr_in a4;
@@ -144,8 +149,21 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    qsizetype nativeReceiveDatagrams(QSpan<QByteArray> data, QSpan<QIpPacketHeader> headers,
+                                     qint64 maxLength,
+                                     QAbstractSocketEngine::PacketHeaderOptions options);
+    qsizetype nativeSendDatagrams(QSpan<const QByteArrayView> data,
+                                  QSpan<const QIpPacketHeader> headers);
+
+    // the datagrams received by nativeReceiveDatagrams() are copied out of it
+    QByteArray datagramBuffer;
+    // set once sending a message segmented by the kernel failed
+    bool udpSegmentationFailed = false;
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+    qint64 nativeWriteGathered(QSpan<const QByteArrayView> data);
     int nativeSelect(QDeadlineTimer deadline, bool selectForRead) const;
     int nativeSelect(QDeadlineTimer deadline, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -17,6 +17,7 @@
 #include <time.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits>
 #ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
 #endif
@@ -34,6 +35,9 @@
 #ifdef Q_OS_BSD4
 #  include <net/if_dl.h>
 #endif
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+#  include <netinet/udp.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -93,6 +97,14 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
     case QNativeSocketEngine::AddressReusable:
         n = SO_REUSEADDR;
         break;
+    case QNativeSocketEngine::PortReusable:
+        // only where the kernel balances the connections among the sockets
+#if defined(SO_REUSEPORT_LB)
+        n = SO_REUSEPORT_LB;
+#elif defined(SO_REUSEPORT) && defined(Q_OS_LINUX)
+        n = SO_REUSEPORT;
+#endif
+        break;
     case QNativeSocketEngine::ReceiveOutOfBandData:
         n = SO_OOBINLINE;
         break;
@@ -867,11 +879,11 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// The buffers for the ancillary data; we use quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -879,161 +891,127 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
 
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-    char c;
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-
-    // we need to receive at least one byte, even if our user isn't interested in it
-    vec.iov_base = maxSize ? data : &c;
-    vec.iov_len = maxSize ? maxSize : 1;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
+struct SendControlBuffer
+{
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+#ifdef UDP_SEGMENT
+                   + CMSG_SPACE(sizeof(quint16))
+#endif
+                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+} // unnamed namespace
+
+// Sets up \a msg for receiving a datagram into the \a size bytes at \a data,
+// with room for the parts of the packet header requested by \a options.
+static void prepareReceiveMessage(msghdr *msg, iovec *vec, qt_sockaddr *aa,
+                                  ReceiveControlBuffer *cbuf, char *data, size_t size,
+                                  QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
+    vec->iov_base = data;
+    vec->iov_len = size;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
     if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
+        msg->msg_name = aa;
+        msg->msg_namelen = sizeof(*aa);
     }
     if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
                    | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
+        msg->msg_control = cbuf->data;
+        msg->msg_controllen = sizeof(cbuf->data);
     }
+}
 
-    ssize_t recvResult = 0;
-    do {
-        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
-    } while (recvResult == -1 && errno == EINTR);
-
-    if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+// Fills \a header from the sender address \a aa and the ancillary data of
+// the received message \a msg.
+static void parseReceivedHeader(msghdr *msg, const qt_sockaddr &aa, quint16 localPort,
+                                QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
         }
-        if (header)
-            header->clear();
-    } else if (options != QAbstractSocketEngine::WantNone) {
-        Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
 
 #ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
 #else
 #  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
 #  endif
 #  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
 #  endif
 #endif
 
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
 
 #ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
 
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
+            header->streamNumber = int(rcvInfo->sinfo_stream);
         }
-    }
-
-#if defined (QNATIVESOCKETENGINE_DEBUG)
-    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagram(%p \"%s\", %lli, %s, %i) == %lli",
-           data, QtDebugUtils::toPrintable(data, recvResult, 16).constData(), maxSize,
-           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
-           ? header->senderAddress.toString().toLatin1().constData() : "(unknown)",
-           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
-           ? header->senderPort : 0, (qint64) recvResult);
 #endif
-
-    return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
+    }
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+// Fills the ancillary data of \a msg, whose destination must already be set,
+// for the options of \a header. With a non-zero \a segmentSize, the kernel
+// splits the message into datagrams of that size.
+static void setSendControl(msghdr *msg, SendControlBuffer *cbuf, const QIpPacketHeader &header,
+                           int segmentSize = 0)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
-#endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
-
-    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
-
-    if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
-        setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
-    }
+    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf->data);
+    msg->msg_control = cbuf->data;
+    msg->msg_controllen = 0;
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(sockaddr_in6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1043,7 +1021,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1055,7 +1033,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1077,7 +1055,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1088,7 +1066,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1097,29 +1075,134 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+#ifdef UDP_SEGMENT
+    if (segmentSize) {
+        const quint16 size = quint16(segmentSize);
+        msg->msg_controllen += CMSG_SPACE(sizeof(size));
+        cmsgptr->cmsg_len = CMSG_LEN(sizeof(size));
+        cmsgptr->cmsg_level = SOL_UDP;
+        cmsgptr->cmsg_type = UDP_SEGMENT;
+        memcpy(CMSG_DATA(cmsgptr), &size, sizeof(size));
+    }
+#else
+    Q_ASSERT(!segmentSize);
+#endif
 
-    if (sentBytes < 0) {
-        switch (errno) {
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
+
+// Sets the error for the errno value \a error of a failed receive. Returns -2
+// if no datagram was available for reading, -1 otherwise.
+static qint64 receiveDatagramError(const QNativeSocketEnginePrivate *d, int error)
+{
+    switch (error) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        d->setError(QAbstractSocket::ConnectionRefusedError,
+                    QNativeSocketEnginePrivate::ConnectionRefusedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError,
+                    QNativeSocketEnginePrivate::ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+// Sets the error for the errno value \a error of a failed send. Returns -2
+// if the send buffer is full, -1 otherwise.
+static qint64 sendDatagramError(const QNativeSocketEnginePrivate *d, int error)
+{
+    switch (error) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        d->setError(QAbstractSocket::DatagramTooLargeError,
+                    QNativeSocketEnginePrivate::DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        d->setError(QAbstractSocket::RemoteHostClosedError,
+                    QNativeSocketEnginePrivate::RemoteHostClosedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError,
+                    QNativeSocketEnginePrivate::SendDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    char c;
+
+    // we need to receive at least one byte, even if our user isn't interested in it
+    prepareReceiveMessage(&msg, &vec, &aa, &cbuf, maxSize ? data : &c, maxSize ? maxSize : 1,
+                          options);
+
+    ssize_t recvResult = 0;
+    do {
+        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
+    } while (recvResult == -1 && errno == EINTR);
+
+    if (recvResult == -1) {
+        recvResult = receiveDatagramError(this, errno);
+        if (header)
+            header->clear();
+    } else if (options != QAbstractSocketEngine::WantNone) {
+        Q_ASSERT(header);
+        parseReceivedHeader(&msg, aa, localPort, header);
     }
 
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagram(%p \"%s\", %lli, %s, %i) == %lli",
+           data, QtDebugUtils::toPrintable(data, recvResult, 16).constData(), maxSize,
+           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
+           ? header->senderAddress.toString().toLatin1().constData() : "(unknown)",
+           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
+           ? header->senderPort : 0, (qint64) recvResult);
+#endif
+
+    return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    SendControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(&aa, 0, sizeof(aa));
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = len;
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+
+    if (header.destinationPort != 0) {
+        msg.msg_name = &aa.a;
+        setPortAndAddress(header.destinationPort, header.destinationAddress,
+                          &aa, &msg.msg_namelen);
+    }
+    setSendControl(&msg, &cbuf, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = sendDatagramError(this, errno);
+
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
            QtDebugUtils::toPrintable(data, len, 16).constData(), len,
@@ -1130,6 +1213,159 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+// the number of datagrams that one call receives or sends at most
+static constexpr int MaxDatagramBatch = 64;
+
+qsizetype QNativeSocketEnginePrivate::nativeReceiveDatagrams(QSpan<QByteArray> data,
+                                                             QSpan<QIpPacketHeader> headers,
+                                                             qint64 maxSize,
+                                                             QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    // No datagram is larger, unless it's an IPv6 jumbogram. The buffer the
+    // datagrams are received into before being copied out is bounded, which
+    // limits the size of a batch of large datagrams.
+    constexpr qint64 MaxDatagramSize = 65536;
+    constexpr qint64 MaxBufferSize = 1024 * 1024;
+
+    const qint64 capacity = maxSize < 0 ? MaxDatagramSize : qMin(maxSize, MaxDatagramSize);
+    // we need to receive at least one byte, even if our user isn't interested in it
+    const qint64 slotSize = qMax(capacity, Q_INT64_C(1));
+    const int count = int(qMin(qMin(data.size(), qsizetype(MaxDatagramBatch)),
+                               qMax(MaxBufferSize / slotSize, Q_INT64_C(1))));
+    if (count <= 0)
+        return 0;
+    if (datagramBuffer.size() < count * slotSize)
+        datagramBuffer.resize(count * slotSize);
+
+    mmsghdr msgs[MaxDatagramBatch];
+    iovec vecs[MaxDatagramBatch];
+    qt_sockaddr addresses[MaxDatagramBatch];
+    ReceiveControlBuffer cbufs[MaxDatagramBatch];
+    for (int i = 0; i < count; ++i) {
+        msgs[i].msg_len = 0;
+        prepareReceiveMessage(&msgs[i].msg_hdr, &vecs[i], &addresses[i], &cbufs[i],
+                              datagramBuffer.data() + i * slotSize, size_t(slotSize), options);
+    }
+
+    int result;
+    QT_EINTR_LOOP(result, ::recvmmsg(int(socketDescriptor), msgs, unsigned(count), 0, nullptr));
+    if (result < 0)
+        return receiveDatagramError(this, errno) == -2 ? 0 : -1;
+
+    for (int i = 0; i < result; ++i) {
+        data[i] = QByteArray(datagramBuffer.constData() + i * slotSize,
+                             qMin(qint64(msgs[i].msg_len), capacity));
+        if (options != QAbstractSocketEngine::WantNone)
+            parseReceivedHeader(&msgs[i].msg_hdr, addresses[i], localPort, &headers[i]);
+    }
+    return result;
+}
+
+#ifdef UDP_SEGMENT
+static bool isSameDestination(const QIpPacketHeader &h1, const QIpPacketHeader &h2)
+{
+    return h1.destinationPort == h2.destinationPort && h1.ifindex == h2.ifindex
+            && h1.hopLimit == h2.hopLimit && h1.streamNumber == h2.streamNumber
+            && h1.destinationAddress == h2.destinationAddress
+            && h1.senderAddress == h2.senderAddress;
+}
+#endif
+
+qsizetype QNativeSocketEnginePrivate::nativeSendDatagrams(QSpan<const QByteArrayView> data,
+                                                          QSpan<const QIpPacketHeader> headers)
+{
+#ifdef UDP_SEGMENT
+    // With generic segmentation offload, the kernel splits one message into
+    // datagrams of the segment size; only the last one may be shorter. The
+    // payload of a message needs to fit into an IP packet.
+    constexpr qsizetype MaxSegments = 64;
+    constexpr qsizetype MaxSegmentedSize = 65000;
+#endif
+
+    mmsghdr msgs[MaxDatagramBatch];
+    iovec vecs[MaxDatagramBatch];
+    qt_sockaddr addresses[MaxDatagramBatch];
+    SendControlBuffer cbufs[MaxDatagramBatch];
+    // the number of datagrams in each message
+    qsizetype segments[MaxDatagramBatch];
+
+    qsizetype sent = 0;
+    while (sent < data.size()) {
+        int messages = 0;
+        qsizetype next = sent;
+        while (next < data.size() && next - sent < MaxDatagramBatch) {
+            qsizetype group = 1;
+            int segmentSize = 0;
+#ifdef UDP_SEGMENT
+            if (socketType == QAbstractSocket::UdpSocket && !udpSegmentationFailed
+                && data[next].size() > 0) {
+                const qsizetype limit = qMin(qMin(data.size() - next, MaxSegments),
+                                             MaxDatagramBatch - (next - sent));
+                qsizetype total = data[next].size();
+                while (group < limit) {
+                    const qsizetype size = data[next + group].size();
+                    if (size == 0 || size > data[next].size() || total + size > MaxSegmentedSize
+                        || !isSameDestination(headers[next], headers[next + group])) {
+                        break;
+                    }
+                    total += size;
+                    ++group;
+                    if (size < data[next].size())
+                        break;
+                }
+                if (group > 1)
+                    segmentSize = int(data[next].size());
+            }
+#endif
+
+            msghdr &msg = msgs[messages].msg_hdr;
+            memset(&msg, 0, sizeof(msg));
+            msgs[messages].msg_len = 0;
+            msg.msg_iov = vecs + (next - sent);
+            msg.msg_iovlen = group;
+            for (qsizetype i = 0; i < group; ++i) {
+                msg.msg_iov[i].iov_base = const_cast<char *>(data[next + i].data());
+                msg.msg_iov[i].iov_len = size_t(data[next + i].size());
+            }
+            const QIpPacketHeader &header = headers[next];
+            if (header.destinationPort != 0) {
+                qt_sockaddr &aa = addresses[messages];
+                memset(&aa, 0, sizeof(aa));
+                msg.msg_name = &aa.a;
+                setPortAndAddress(header.destinationPort, header.destinationAddress,
+                                  &aa, &msg.msg_namelen);
+            }
+            setSendControl(&msg, &cbufs[messages], header, segmentSize);
+            segments[messages++] = group;
+            next += group;
+        }
+
+        int result;
+        QT_EINTR_LOOP(result, ::sendmmsg(int(socketDescriptor), msgs, unsigned(messages), 0));
+        if (result < 0) {
+            const int error = errno;
+#ifdef UDP_SEGMENT
+            if (segments[0] > 1 && error != EAGAIN && error != EWOULDBLOCK
+                && error != ECONNREFUSED && error != ECONNRESET) {
+                // the kernel or the network device doesn't support segmenting
+                // this message, send the datagrams separately from now on
+                udpSegmentationFailed = true;
+                continue;
+            }
+#endif
+            if (sent)
+                break;
+            return sendDatagramError(this, error) == -2 ? 0 : -1;
+        }
+        // after a partial send, the next call reports why the rest failed
+        for (int i = 0; i < result; ++i)
+            sent += segments[i];
+    }
+    return sent;
+}
+#endif // QT_NATIVESOCKETENGINE_MMSG
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1261,6 +1497,34 @@ void QNativeSocketEnginePrivate::nativeClose()
     qt_safe_close(socketDescriptor);
 }
 
+/*
+    Handles the errno of a failed send: returns 0 if the socket would block,
+    and -1 otherwise.
+*/
+static ssize_t failedWriteResult(QNativeSocketEnginePrivate *d, QNativeSocketEngine *q)
+{
+    switch (errno) {
+    case EPIPE:
+    case ECONNRESET:
+        d->setError(QAbstractSocket::RemoteHostClosedError,
+                    QNativeSocketEnginePrivate::RemoteHostClosedErrorString);
+        q->close();
+        break;
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        return 0;
+    case EMSGSIZE:
+        d->setError(QAbstractSocket::DatagramTooLargeError,
+                    QNativeSocketEnginePrivate::DatagramTooLargeErrorString);
+        break;
+    default:
+        break;
+    }
+    return -1;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 {
     Q_Q(QNativeSocketEngine);
@@ -1268,35 +1532,70 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     ssize_t writtenBytes;
     writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
 
-    if (writtenBytes < 0) {
-        switch (errno) {
-        case EPIPE:
-        case ECONNRESET:
-            writtenBytes = -1;
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            q->close();
-            break;
-#if EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    if (writtenBytes < 0)
+        writtenBytes = failedWriteResult(this, q);
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWrite(%p \"%s\", %llu) == %i", data,
+           QtDebugUtils::toPrintable(data, len, 16).constData(), len, (int) writtenBytes);
 #endif
-        case EAGAIN:
-            writtenBytes = 0;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        default:
+
+    return qint64(writtenBytes);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeWriteGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QNativeSocketEngine);
+
+#ifdef IOV_MAX
+    constexpr qsizetype MaxBlocks = IOV_MAX;
+#else
+    constexpr qsizetype MaxBlocks = _XOPEN_IOV_MAX;
+#endif
+
+    // Stream sockets may stop anywhere, so the system limits on the number of
+    // blocks and on the result of sendmsg() only shorten the write. Datagrams
+    // must be sent as a whole.
+    QVarLengthArray<iovec, 16> blocks;
+    qint64 len = 0;
+    for (QByteArrayView block : data) {
+        if (block.isEmpty())
+            continue;
+        if (blocks.size() == MaxBlocks
+            || len + block.size() > std::numeric_limits<int>::max()) {
+            if (socketType == QAbstractSocket::UdpSocket) {
+                setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+                return -1;
+            }
+            if (blocks.isEmpty())
+                return nativeWrite(block.data(), block.size());
             break;
         }
+        blocks.append({ const_cast<char *>(block.data()), size_t(block.size()) });
+        len += block.size();
+    }
+    if (blocks.size() <= 1) {
+        return blocks.isEmpty() ? 0
+                                : nativeWrite(static_cast<const char *>(blocks.front().iov_base),
+                                              len);
     }
 
+    msghdr msg = {};
+    msg.msg_iov = blocks.data();
+    msg.msg_iovlen = blocks.size();
+
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (writtenBytes < 0)
+        writtenBytes = failedWriteResult(this, q);
+
 #if defined (QNATIVESOCKETENGINE_DEBUG)
-    qDebug("QNativeSocketEnginePrivate::nativeWrite(%p \"%s\", %llu) == %i", data,
-           QtDebugUtils::toPrintable(data, len, 16).constData(), len, (int) writtenBytes);
+    qDebug("QNativeSocketEnginePrivate::nativeWriteGathered(%lld blocks, %lld) == %i",
+           qint64(blocks.size()), len, (int) writtenBytes);
 #endif
 
     return qint64(writtenBytes);
 }
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <limits>
 
 //#define QNATIVESOCKETENGINE_DEBUG
 #if defined(QNATIVESOCKETENGINE_DEBUG)
@@ -150,6 +151,7 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
     case QNativeSocketEngine::NonBlockingSocketOption:      // WSAIoctl
     case QNativeSocketEngine::TypeOfServiceOption:          // not supported
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::PortReusable:
         Q_UNREACHABLE();
 
     case QNativeSocketEngine::ReceiveBufferSocketOption:
@@ -365,6 +367,7 @@ int QNativeSocketEnginePrivate::option(QNativeSocketEngine::SocketOption opt) co
     }
     case QNativeSocketEngine::TypeOfServiceOption:
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::PortReusable:
         return -1;
 
     default:
@@ -415,6 +418,7 @@ bool QNativeSocketEnginePrivate::setOption(QNativeSocketEngine::SocketOption opt
         }
     case QNativeSocketEngine::TypeOfServiceOption:
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::PortReusable:
         return false;
 
     default:
@@ -1382,6 +1386,48 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteGathered(QSpan<const QByteArrayView> data)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<WSABUF, 16> bufs;
+    for (QByteArrayView block : data) {
+        if (block.isEmpty())
+            continue;
+        WSABUF buf;
+        buf.buf = const_cast<char *>(block.data());
+        buf.len = ULONG(qMin<qint64>(block.size(), std::numeric_limits<ULONG>::max()));
+        bufs.append(buf);
+        if (qint64(buf.len) != block.size())
+            break;
+    }
+    if (bufs.isEmpty())
+        return 0;
+
+    DWORD bytesWritten = 0;
+    if (::WSASend(socketDescriptor, bufs.data(), DWORD(bufs.size()), &bytesWritten, 0, 0, 0)
+        != SOCKET_ERROR) {
+        return qint64(bytesWritten);
+    }
+
+    qint64 ret = 0;
+    const int err = WSAGetLastError();
+    if (err != WSAEWOULDBLOCK && err != WSAENOBUFS) {
+        WS_ERROR_DEBUG(err);
+        switch (err) {
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+            ret = -1;
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            q->close();
+            break;
+        default:
+            break;
+        }
+    }
+    return ret;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
@@ -43,6 +43,12 @@
     use waitForNewConnection(), which blocks until either a
     connection is available or a timeout expires.
 
+    To accept connections in several threads, enable port sharing with
+    setPortSharingEnabled() and create one server in each thread, listening
+    on the same address and port. The operating system then distributes the
+    incoming connections among them, and each connection is handled in the
+    thread that accepted it.
+
     \sa QTcpSocket, {Fortune Server}, {Threaded Fortune Server},
         {Torrent Example}
 */
@@ -317,6 +323,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    if (d->portSharing && !d->socketEngine->setOption(QAbstractSocketEngine::PortReusable, 1)) {
+        d->serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+        d->serverSocketErrorString = tr("Port sharing is not supported");
+        return false;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -672,6 +684,46 @@ int QTcpServer::listenBacklogSize() const
     return d_func()->listenBacklog;
 }
 
+/*!
+    \since 6.9
+
+    Sets whether several servers may listen on the same address and port to
+    \a enabled. The operating system distributes the incoming connections
+    among the servers that have port sharing enabled, so that each of them
+    can accept connections in its own thread, without handing the sockets
+    over from a single accepting thread. By default, port sharing is
+    disabled.
+
+    Port sharing is supported on Linux and FreeBSD. Elsewhere, and when a
+    proxy is used, listen() fails with
+    QAbstractSocket::UnsupportedSocketOperationError if it is enabled. Only
+    processes of the same user can share a port.
+
+    \note This property must be set prior to calling listen().
+
+    \note When one of the servers is closed, the connections that the
+    operating system assigned to it, but that it did not accept yet, are
+    reset.
+
+    \sa isPortSharingEnabled(), listen()
+*/
+void QTcpServer::setPortSharingEnabled(bool enabled)
+{
+    d_func()->portSharing = enabled;
+}
+
+/*!
+    \since 6.9
+
+    Returns whether several servers may listen on the same address and port.
+
+    \sa setPortSharingEnabled()
+*/
+bool QTcpServer::isPortSharingEnabled() const
+{
+    return d_func()->portSharing;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -36,6 +36,9 @@ public:
     void setListenBacklogSize(int size);
     int listenBacklogSize() const;
 
+    void setPortSharingEnabled(bool enabled);
+    bool isPortSharingEnabled() const;
+
     quint16 serverPort() const;
     QHostAddress serverAddress() const;
 
@@ -36,6 +36,10 @@
     \note An incoming datagram should be read when you receive the readyRead()
     signal, otherwise this signal will not be emitted for the next datagram.
 
+    Applications that handle many datagrams can use receiveDatagrams() and
+    writeDatagrams() to transfer several of them at once, which saves calls
+    to the operating system.
+
     Example:
 
     \snippet code/src_network_socket_qudpsocket.cpp 0
@@ -66,6 +70,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include <QtCore/qvarlengtharray.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -395,6 +400,58 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.9
+
+    Sends the \a datagrams in order, like writeDatagram() does for each of
+    them, but with as few calls to the operating system as possible. On
+    Linux, all of them are passed to the kernel at once, and consecutive
+    datagrams of the same size and with the same destination and options are
+    segmented by the kernel or the network device.
+
+    Returns the number of datagrams sent, which is less than the number of
+    \a datagrams if the send buffer of the operating system was full, or -1
+    if an error occurred before any datagram was sent. The bytesWritten()
+    signal is emitted once, with the total size of the datagrams sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(QSpan<const QNetworkDatagram> datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qlonglong(datagrams.size()));
+#endif
+    if (datagrams.empty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.front().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<QByteArrayView, 64> data;
+    QVarLengthArray<QIpPacketHeader, 64> headers;
+    data.reserve(datagrams.size());
+    headers.reserve(datagrams.size());
+    for (const QNetworkDatagram &datagram : datagrams) {
+        data.append(datagram.d->data);
+        headers.append(datagram.d->header);
+    }
+
+    const qsizetype sent = d->socketEngine->writeDatagrams(data, headers);
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent > 0) {
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < sent; ++i)
+            bytes += data[i].size();
+        emit bytesWritten(bytes);
+    } else if (sent < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -441,6 +498,55 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.9
+
+    Receives up to \a maxCount datagrams, each no larger than \a maxSize
+    bytes, and returns them along with their packet headers, as
+    receiveDatagram() does. On Linux, all of them are received with one call
+    to the operating system.
+
+    Returns an empty list if no datagram was pending or an error occurred.
+    If \a maxSize is too small, the rest of a datagram will be lost. If
+    \a maxSize is -1 (the default), the datagrams will be read entirely.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lld, %lld)", qlonglong(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    QList<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+
+    QVarLengthArray<QByteArray, 64> data(qMin(maxCount, qsizetype(64)));
+    QVarLengthArray<QIpPacketHeader, 64> headers(data.size());
+    qsizetype received = d->socketEngine->readDatagrams(data, headers, maxSize,
+                                                        QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->hasPendingDatagram = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        received = 0;
+    }
+
+    result.reserve(received);
+    for (qsizetype i = 0; i < received; ++i) {
+        QNetworkDatagram datagram;
+        datagram.d->data = std::move(data[i]);
+        datagram.d->header = std::move(headers[i]);
+        result.append(std::move(datagram));
+    }
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
@@ -160,6 +160,16 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption noZstdOption(QStringLiteral("no-zstd"), QStringLiteral("Disable usage of zstd compression."));
     parser.addOption(noZstdOption);
 
+    QCommandLineOption zstdDictionaryOption(QStringLiteral("zstd-dictionary"),
+                                            QStringLiteral("Train a shared dictionary of <size> bytes for the files compressed with zstd (requires format version 4)."),
+                                            QStringLiteral("size"));
+    parser.addOption(zstdDictionaryOption);
+
+    QCommandLineOption zstdChunkSizeOption(QStringLiteral("zstd-chunk-size"),
+                                           QStringLiteral("Compress files bigger than <size> bytes with zstd in independent chunks, so that they can be read without decompressing them entirely."),
+                                           QStringLiteral("size"));
+    parser.addOption(zstdChunkSizeOption);
+
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
@@ -211,7 +221,7 @@ int runRcc(int argc, char *argv[])
         formatVersion = parser.value(formatVersionOption).toUInt(&ok);
         if (!ok) {
             errorMsg = "Invalid format version specified"_L1;
-        } else if (formatVersion < 1 || formatVersion > 3) {
+        } else if (formatVersion < 1 || formatVersion > 4) {
             errorMsg = "Unsupported format version specified"_L1;
         }
     }
@@ -235,6 +245,28 @@ int runRcc(int argc, char *argv[])
         if (library.noZstd())
             errorMsg = "--compression-algo=zstd and --no-zstd both specified."_L1;
     }
+    const auto parseZstdSize = [&](const QCommandLineOption &option) {
+        bool ok = false;
+        const int size = parser.value(option).toInt(&ok);
+        if (!ok || size <= 0)
+            errorMsg = "Invalid size for --"_L1 + option.names().constFirst();
+#if !QT_CONFIG(zstd)
+        errorMsg = "--"_L1 + option.names().constFirst() + " requires zstd support."_L1;
+#endif
+        if (library.noZstd())
+            errorMsg = "--"_L1 + option.names().constFirst() + " and --no-zstd both specified."_L1;
+        return size;
+    };
+    if (parser.isSet(zstdDictionaryOption)) {
+        library.setZstdDictionarySize(parseZstdSize(zstdDictionaryOption));
+        if (formatVersion < 4)
+            errorMsg = "zstd dictionaries require format version 4 or higher"_L1;
+    }
+    if (parser.isSet(zstdChunkSizeOption)) {
+        library.setZstdChunkSize(parseZstdSize(zstdChunkSizeOption));
+        if (formatVersion < 3)
+            errorMsg = "Zstandard compression requires format version 3 or higher"_L1;
+    }
     if (parser.isSet(nocompressOption))
         library.setCompressionAlgorithm(RCCResourceLibrary::CompressionAlgorithm::None);
     if (parser.isSet(compressOption) && errorMsg.isEmpty()) {
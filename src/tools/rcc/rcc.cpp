@@ -11,15 +11,21 @@
 #include <qdebug.h>
 #include <qdir.h>
 #include <qdirlisting.h>
+#include <qendian.h>
 #include <qfile.h>
 #include <qiodevice.h>
 #include <qlocale.h>
 #include <qstack.h>
+#include <qvarlengtharray.h>
 #include <qxmlstream.h>
 
+#include <private/qresourceformat_p.h>
+
 #include <algorithm>
+#include <numeric>
 
 #if QT_CONFIG(zstd)
+#  include <zdict.h>
 #  include <zstd.h>
 #endif
 
@@ -249,12 +255,6 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
                                   DeduplicationMultiHash &dedupByContent,
                                   QString *errorMessage)
 {
-    const bool text = lib.m_format == RCCResourceLibrary::C_Code;
-    const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
-    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
-    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
-    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
-
     //capture the offset
     m_dataOffset = offset;
     QByteArray data;
@@ -302,42 +302,35 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
             m_compressLevel = 19;   // not ZSTD_maxCLevel(), as 20+ are experimental
         }
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zstd && !m_noZstd) {
-            if (lib.m_zstdCCtx == nullptr)
-                lib.m_zstdCCtx = ZSTD_createCCtx();
-            qsizetype size = data.size();
-            size = ZSTD_COMPRESSBOUND(size);
-
             int compressLevel = m_compressLevel;
             if (compressLevel < 0)
                 compressLevel = CONSTANT_ZSTDCOMPRESSLEVEL_CHECK;
 
-            QByteArray compressed(size, Qt::Uninitialized);
-            char *dst = const_cast<char *>(compressed.constData());
-            size_t n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                         data.constData(), data.size(),
-                                         compressLevel);
-            if (n * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold) ) {
+            QString zstdError;
+            QByteArray compressed = lib.zstdCompress(data, compressLevel, &zstdError);
+            if (!compressed.isNull()
+                && compressed.size() * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold)) {
                 // compressing is worth it
                 if (m_compressLevel < 0) {
                     // heuristic compression, so recompress
-                    n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                          data.constData(), data.size(),
-                                          CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
+                    compressed = lib.zstdCompress(data, CONSTANT_ZSTDCOMPRESSLEVEL_STORE,
+                                                  &zstdError);
                 }
-                if (ZSTD_isError(n)) {
-                    QString msg = QString::fromLatin1("%1: error: compression with zstd failed: %2\n")
-                            .arg(m_name, QString::fromUtf8(ZSTD_getErrorName(n)));
-                    lib.m_errorDevice->write(msg.toUtf8());
-                } else if (lib.verbose()) {
+            }
+            if (compressed.isNull()) {
+                QString msg = QString::fromLatin1("%1: error: compression with zstd failed: %2\n")
+                        .arg(m_name, zstdError);
+                lib.m_errorDevice->write(msg.toUtf8());
+            } else if (compressed.size() * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold)) {
+                if (lib.verbose()) {
                     QString msg = QString::fromLatin1("%1: note: compressed using zstd (%2 -> %3)\n")
-                            .arg(m_name).arg(data.size()).arg(n);
+                            .arg(m_name).arg(data.size()).arg(compressed.size());
                     lib.m_errorDevice->write(msg.toUtf8());
                 }
 
                 lib.m_overallFlags |= CompressedZstd;
                 m_flags |= CompressedZstd;
                 data = std::move(compressed);
-                data.truncate(n);
             } else if (lib.verbose()) {
                 QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
                 lib.m_errorDevice->write(msg.toUtf8());
@@ -371,45 +364,57 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
 #endif // QT_NO_COMPRESS
     }
 
+    return lib.writeBlob(data, offset, m_fileInfo.fileName().toLocal8Bit());
+}
+
+qint64 RCCResourceLibrary::writeBlob(const QByteArray &data, qint64 offset,
+                                     const QByteArray &comment)
+{
+    const bool text = m_format == C_Code;
+    const bool pass1 = m_format == Pass1;
+    const bool pass2 = m_format == Pass2;
+    const bool binary = m_format == Binary;
+    const bool python = m_format == Python_Code;
+
     // some info
     if (text || pass1) {
-        lib.writeString("  // ");
-        lib.writeByteArray(m_fileInfo.fileName().toLocal8Bit());
-        lib.writeString("\n  ");
+        writeString("  // ");
+        writeByteArray(comment);
+        writeString("\n  ");
     }
 
     // write the length
     if (text || binary || pass2 || python)
-        lib.writeNumber4(data.size());
+        writeNumber4(data.size());
     if (text || pass1)
-        lib.writeString("\n  ");
+        writeString("\n  ");
     else if (python)
-        lib.writeString("\\\n");
+        writeString("\\\n");
     offset += 4;
 
     // write the payload
     const char *p = data.constData();
     if (text || python) {
         for (int i = data.size(), j = 0; --i >= 0; --j) {
-            lib.writeHex(*p++);
+            writeHex(*p++);
             if (j == 0) {
                 if (text)
-                    lib.writeString("\n  ");
+                    writeString("\n  ");
                 else
-                    lib.writeString("\\\n");
+                    writeString("\\\n");
                 j = 16;
             }
         }
     } else if (binary || pass2) {
-        lib.writeByteArray(data);
+        writeByteArray(data);
     }
     offset += data.size();
 
     // done
     if (text || pass1)
-        lib.writeString("\n  ");
+        writeString("\n  ");
     else if (python)
-        lib.writeString("\\\n");
+        writeString("\\\n");
 
     return offset;
 }
@@ -502,7 +507,10 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_errorDevice(nullptr),
     m_outDevice(nullptr),
     m_formatVersion(formatVersion),
-    m_noZstd(false)
+    m_noZstd(false),
+    m_zstdDictionarySize(0),
+    m_zstdChunkSize(0),
+    m_zstdDictionaryOffset(QtResourceFormat::NoDictionary)
 {
     m_out.reserve(30 * 1000 * 1000);
 #if QT_CONFIG(zstd)
@@ -515,6 +523,8 @@ RCCResourceLibrary::~RCCResourceLibrary()
     delete m_root;
 #if QT_CONFIG(zstd)
     ZSTD_freeCCtx(m_zstdCCtx);
+    for (ZSTD_CDict *cdict : std::as_const(m_zstdCDicts))
+        ZSTD_freeCDict(cdict);
 #endif
 }
 
@@ -1041,6 +1051,124 @@ bool RCCResourceLibrary::output(QIODevice &outDevice, QIODevice &tempDevice, QIO
     return true;
 }
 
+#if QT_CONFIG(zstd)
+// Trains a dictionary on the contents of the files that get compressed with
+// zstd, so that small files with similar contents compress well. Leaves the
+// dictionary empty if there isn't enough data to train it.
+void RCCResourceLibrary::trainZstdDictionary()
+{
+    // only the start of big files, so that they don't dominate the samples
+    constexpr qint64 MaxSampleSize = 128 * 1024;
+
+    m_zstdDictionary.clear();
+    QByteArray samples;
+    std::vector<size_t> sampleSizes;
+    QStack<RCCFileInfo *> pending;
+    pending.push(m_root);
+    while (!pending.isEmpty()) {
+        const RCCFileInfo *file = pending.pop();
+        for (RCCFileInfo *child : file->m_children) {
+            if (child->m_flags & RCCFileInfo::Directory) {
+                pending.push(child);
+                continue;
+            }
+            const bool zstd = !child->m_noZstd
+                    && (child->m_compressAlgo == CompressionAlgorithm::Zstd
+                        || child->m_compressAlgo == CompressionAlgorithm::Best);
+            if (!zstd || child->m_isEmpty)
+                continue;
+            QFile input(child->m_fileInfo.absoluteFilePath());
+            if (!input.open(QFile::ReadOnly))
+                continue;   // reported when writing the data
+            const QByteArray sample = input.read(MaxSampleSize);
+            if (sample.isEmpty())
+                continue;
+            samples += sample;
+            sampleSizes.push_back(size_t(sample.size()));
+        }
+    }
+
+    QByteArray dictionary(m_zstdDictionarySize, Qt::Uninitialized);
+    const size_t n = sampleSizes.empty()
+            ? size_t(0)
+            : ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.constData(),
+                                    sampleSizes.data(), unsigned(sampleSizes.size()));
+    if (sampleSizes.empty() || ZDICT_isError(n)) {
+        if (m_verbose) {
+            const QByteArray reason = sampleSizes.empty()
+                    ? QByteArrayLiteral("no files to compress with zstd")
+                    : QByteArray(ZDICT_getErrorName(n));
+            m_errorDevice->write("note: not using a zstd dictionary: " + reason + '\n');
+        }
+        return;
+    }
+    dictionary.truncate(n);
+    if (m_verbose) {
+        m_errorDevice->write("note: trained a zstd dictionary of " + QByteArray::number(n)
+                             + " bytes on " + QByteArray::number(qsizetype(sampleSizes.size()))
+                             + " files\n");
+    }
+    m_zstdDictionary = std::move(dictionary);
+}
+
+size_t RCCResourceLibrary::zstdCompressFrame(char *dst, size_t capacity, const char *src,
+                                             size_t size, int level)
+{
+    if (m_zstdCCtx == nullptr)
+        m_zstdCCtx = ZSTD_createCCtx();
+    if (m_zstdDictionary.isEmpty())
+        return ZSTD_compressCCtx(m_zstdCCtx, dst, capacity, src, size, level);
+
+    ZSTD_CDict *&cdict = m_zstdCDicts[level];
+    if (!cdict)
+        cdict = ZSTD_createCDict(m_zstdDictionary.constData(), m_zstdDictionary.size(), level);
+    return ZSTD_compress_usingCDict(m_zstdCCtx, dst, capacity, src, size, cdict);
+}
+
+// Compresses the data in one frame or, if it is bigger than the chunk size, in
+// independent frames followed by a seek table. Returns a null QByteArray if
+// an error occurs.
+QByteArray RCCResourceLibrary::zstdCompress(const QByteArray &data, int level,
+                                            QString *errorMessage)
+{
+    using namespace QtResourceFormat;
+    const qsizetype chunkSize = m_zstdChunkSize > 0 && data.size() > m_zstdChunkSize
+            ? m_zstdChunkSize : data.size();
+    QByteArray compressed;
+    QByteArray seekTable;
+    auto appendNumber = [](QByteArray &out, quint32 number) {
+        const quint32 le = qToLittleEndian(number);
+        out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+    };
+
+    for (qsizetype pos = 0; pos < data.size(); pos += chunkSize) {
+        const qsizetype size = qMin(chunkSize, data.size() - pos);
+        const qsizetype start = compressed.size();
+        compressed.resize(start + ZSTD_COMPRESSBOUND(size));
+        const size_t n = zstdCompressFrame(compressed.data() + start, compressed.size() - start,
+                                           data.constData() + pos, size, level);
+        if (ZSTD_isError(n)) {
+            *errorMessage = QString::fromUtf8(ZSTD_getErrorName(n));
+            return QByteArray();
+        }
+        compressed.truncate(start + n);
+        appendNumber(seekTable, quint32(n));
+        appendNumber(seekTable, quint32(size));
+    }
+
+    if (chunkSize < data.size()) {
+        const quint32 frameCount = quint32(seekTable.size() / SeekTableEntrySize);
+        appendNumber(compressed, SeekTableSkippableMagic);
+        appendNumber(compressed, quint32(seekTable.size() + SeekTableFooterSize));
+        compressed += seekTable;
+        appendNumber(compressed, frameCount);
+        compressed += char(0);  // no checksums
+        appendNumber(compressed, SeekTableFooterMagic);
+    }
+    return compressed;
+}
+#endif
+
 void RCCResourceLibrary::writeDecimal(int value)
 {
     Q_ASSERT(m_format != RCCResourceLibrary::Binary);
@@ -1218,9 +1346,21 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    qint64 offset = 0;
+    m_zstdDictionaryOffset = QtResourceFormat::NoDictionary;
+#if QT_CONFIG(zstd)
+    if (m_zstdDictionarySize > 0) {
+        // stored first, like the contents of a file
+        trainZstdDictionary();
+        if (!m_zstdDictionary.isEmpty()) {
+            m_zstdDictionaryOffset = quint32(offset);
+            offset = writeBlob(m_zstdDictionary, offset, "zstd dictionary");
+        }
+    }
+#endif
+
     QStack<RCCFileInfo*> pending;
     pending.push(m_root);
-    qint64 offset = 0;
     RCCFileInfo::DeduplicationMultiHash dedupByContent;
     QString errorMessage;
     while (!pending.isEmpty()) {
@@ -1321,6 +1461,77 @@ struct qt_rcc_compare_hash
     }
 };
 
+// Builds a minimal perfect hash table over the paths with the hash and
+// displace method, in the layout described in qresourceformat_p.h.
+static bool buildPathIndex(const QHash<QString, quint32> &pathNodes,
+                           QList<qint32> *displacements, QList<quint32> *slotNodes)
+{
+    using QtResourceFormat::pathHash;
+    constexpr qint32 MaxDisplacement = 1 << 16;
+
+    const QList<QString> keys = pathNodes.keys();
+    const quint32 slotCount = quint32(keys.size());
+    for (quint32 bucketCount = qMax(slotCount / 4, 1u); bucketCount <= 8 * slotCount;
+         bucketCount *= 2) {
+        QList<QList<qsizetype>> buckets(bucketCount);
+        for (qsizetype i = 0; i < keys.size(); ++i)
+            buckets[pathHash(keys.at(i), 0) % bucketCount].append(i);
+
+        // place the biggest buckets first, while most slots are still free
+        QList<quint32> order(bucketCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&buckets](quint32 a, quint32 b) {
+            return buckets.at(a).size() > buckets.at(b).size();
+        });
+
+        displacements->fill(0, bucketCount);
+        slotNodes->fill(0, slotCount);
+        QList<bool> taken(slotCount, false);
+        quint32 nextFree = 0;
+        bool failed = false;
+        for (quint32 b : std::as_const(order)) {
+            const QList<qsizetype> &bucket = buckets.at(b);
+            if (bucket.isEmpty())
+                break;
+            if (bucket.size() == 1) {
+                // no need to search: point the bucket directly at a free slot
+                while (taken.at(nextFree))
+                    ++nextFree;
+                taken[nextFree] = true;
+                (*displacements)[b] = -qint32(nextFree) - 1;
+                (*slotNodes)[nextFree] = pathNodes.value(keys.at(bucket.first()));
+                continue;
+            }
+
+            QVarLengthArray<quint32, 16> candidates;
+            qint32 d = 1;
+            for (; d < MaxDisplacement; ++d) {
+                candidates.clear();
+                for (qsizetype i : bucket) {
+                    const quint32 slot = pathHash(keys.at(i), quint32(d)) % slotCount;
+                    if (taken.at(slot) || candidates.contains(slot))
+                        break;
+                    candidates.append(slot);
+                }
+                if (candidates.size() == bucket.size())
+                    break;
+            }
+            if (d == MaxDisplacement) {
+                failed = true;
+                break;
+            }
+            (*displacements)[b] = d;
+            for (qsizetype i = 0; i < bucket.size(); ++i) {
+                taken[candidates.at(i)] = true;
+                (*slotNodes)[candidates.at(i)] = pathNodes.value(keys.at(bucket.at(i)));
+            }
+        }
+        if (!failed)
+            return true;
+    }
+    return false;
+}
+
 bool RCCResourceLibrary::writeDataStructure()
 {
     switch (m_format) {
@@ -1343,6 +1554,14 @@ bool RCCResourceLibrary::writeDataStructure()
     if (!m_root)
         return false;
 
+    const bool withIndex = m_formatVersion >= QtResourceFormat::HeaderVersion;
+    QList<quint32> parents; // the parent of each node
+    QHash<QString, quint32> pathNodes; // the node to start looking at for each path
+    QHash<const RCCFileInfo *, QString> directoryPaths;
+    QHash<const RCCFileInfo *, quint32> directoryNodes;
+    if (withIndex)
+        parents.append(0);
+
     //calculate the child offsets (flat)
     pending.push(m_root);
     int offset = 1;
@@ -1355,14 +1574,46 @@ bool RCCResourceLibrary::writeDataStructure()
         std::sort(m_children.begin(), m_children.end(), qt_rcc_compare_hash());
 
         //write out the actual data now
+        const QString directoryPath = directoryPaths.value(file);
+        const quint32 directoryNode = directoryNodes.value(file);
+        quint32 hashRunStart = 0;
         for (int i = 0; i < m_children.size(); ++i) {
             RCCFileInfo *child = m_children.at(i);
+            if (withIndex) {
+                // QResource compares the names of all the siblings with the
+                // same hash, starting with the first one
+                const quint32 node = quint32(offset);
+                if (i == 0 || qt_hash(m_children.at(i - 1)->m_name) != qt_hash(child->m_name))
+                    hashRunStart = node;
+                const QString path = directoryPath.isEmpty()
+                        ? child->m_name : directoryPath + u'/' + child->m_name;
+                if (!pathNodes.contains(path))
+                    pathNodes.insert(path, hashRunStart);
+                parents.append(directoryNode);
+                if (child->m_flags & RCCFileInfo::Directory) {
+                    directoryPaths.insert(child, path);
+                    directoryNodes.insert(child, node);
+                }
+            }
             ++offset;
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
         }
     }
 
+    QList<qint32> displacements;
+    QList<quint32> slotNodes;
+    if (withIndex) {
+        if (!pathNodes.isEmpty() && !buildPathIndex(pathNodes, &displacements, &slotNodes)) {
+            m_errorDevice->write("Could not build the path index\n");
+            return false;
+        }
+        // the offset of the index, relative to the start of the tree
+        const int nodeSize = 14 + (m_formatVersion >= 2 ? 8 : 0);
+        writeNumber4(slotNodes.isEmpty() ? 0 : QtResourceFormat::HeaderSize + offset * nodeSize);
+        writeNumber4(m_zstdDictionaryOffset);
+    }
+
     //write out the structure (ie iterate again!)
     pending.push(m_root);
     m_root->writeDataInfo(*this);
@@ -1381,6 +1632,17 @@ bool RCCResourceLibrary::writeDataStructure()
                 pending.push(child);
         }
     }
+    if (!slotNodes.isEmpty()) {
+        writeNumber4(displacements.size());
+        writeNumber4(slotNodes.size());
+        writeNumber4(parents.size());
+        for (qint32 displacement : std::as_const(displacements))
+            writeNumber4(quint32(displacement));
+        for (quint32 node : std::as_const(slotNodes))
+            writeNumber4(node);
+        for (quint32 parent : std::as_const(parents))
+            writeNumber4(parent);
+    }
     switch (m_format) {
     case C_Code:
     case Pass1:
@@ -12,6 +12,7 @@
 #include <qstring.h>
 
 typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+typedef struct ZSTD_CDict_s ZSTD_CDict;
 
 QT_BEGIN_NAMESPACE
 
@@ -87,6 +88,12 @@ public:
     void setNoZstd(bool v) { m_noZstd = v; }
     bool noZstd() const { return m_noZstd; }
 
+    void setZstdDictionarySize(int size) { m_zstdDictionarySize = size; }
+    int zstdDictionarySize() const { return m_zstdDictionarySize; }
+
+    void setZstdChunkSize(int size) { m_zstdChunkSize = size; }
+    int zstdChunkSize() const { return m_zstdChunkSize; }
+
 private:
     struct Strings {
         Strings();
@@ -109,6 +116,12 @@ private:
         QString currentPath = QString(), bool listMode = false);
     bool writeHeader();
     bool writeDataBlobs();
+    qint64 writeBlob(const QByteArray &data, qint64 offset, const QByteArray &comment);
+#if QT_CONFIG(zstd)
+    void trainZstdDictionary();
+    size_t zstdCompressFrame(char *dst, size_t capacity, const char *src, size_t size, int level);
+    QByteArray zstdCompress(const QByteArray &data, int level, QString *errorMessage);
+#endif
     bool writeDataNames();
     bool writeDataStructure();
     bool writeInitializer();
@@ -127,6 +140,8 @@ private:
 
 #if QT_CONFIG(zstd)
     ZSTD_CCtx *m_zstdCCtx;
+    QByteArray m_zstdDictionary;
+    QHash<int, ZSTD_CDict *> m_zstdCDicts; // by compression level
 #endif
 
     const Strings m_strings;
@@ -152,6 +167,9 @@ private:
     QByteArray m_out;
     quint8 m_formatVersion;
     bool m_noZstd;
+    int m_zstdDictionarySize;
+    int m_zstdChunkSize;
+    quint32 m_zstdDictionaryOffset;
 };
 
 QT_END_NAMESPACE
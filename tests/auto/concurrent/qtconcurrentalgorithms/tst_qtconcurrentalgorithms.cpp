@@ -0,0 +1,251 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <qtconcurrentalgorithms.h>
+#include <qexception.h>
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+public:
+    tst_QtConcurrentAlgorithms() { pool.setMaxThreadCount(8); }
+
+private slots:
+    void sort_data();
+    void sort();
+    void sortIterators();
+    void sortNonDefaultConstructible();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void inclusiveScanNonCommutative();
+    void partition_data() { sort_data(); }
+    void partition();
+    void partitionAllOrNothing();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+
+private:
+    QThreadPool pool;
+};
+
+static QList<int> randomList(qsizetype size, int bound)
+{
+    QList<int> list(size);
+    QRandomGenerator generator(size);
+    for (int &value : list)
+        value = generator.bounded(bound);
+    return list;
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<qsizetype>("size");
+
+    QTest::newRow("empty") << qsizetype(0);
+    QTest::newRow("one") << qsizetype(1);
+    QTest::newRow("small") << qsizetype(100);
+    QTest::newRow("two-chunks") << qsizetype(9000);
+    QTest::newRow("uneven-chunks") << qsizetype(100003);
+    QTest::newRow("large") << qsizetype(1000000);
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(qsizetype, size);
+
+    QList<int> list = randomList(size, 1000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::blockingSort(&pool, list);
+    QCOMPARE(list, expected);
+
+    QtConcurrent::blockingSort(list, std::greater<>());
+    std::reverse(expected.begin(), expected.end());
+    QCOMPARE(list, expected);
+
+    QFuture<void> future = QtConcurrent::sort(&pool, list);
+    future.waitForFinished();
+    std::reverse(expected.begin(), expected.end());
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::sortIterators()
+{
+    std::vector<double> vector(50000);
+    QRandomGenerator generator(42);
+    for (double &value : vector)
+        value = generator.generateDouble();
+    std::vector<double> expected = vector;
+
+    // only sort a part of the vector
+    std::sort(expected.begin() + 100, expected.end() - 100);
+    QtConcurrent::sort(&pool, vector.begin() + 100, vector.end() - 100).waitForFinished();
+    QVERIFY(vector == expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    QtConcurrent::blockingSort(vector.data(), vector.data() + vector.size(),
+                               [](double a, double b) { return a > b; });
+    QVERIFY(vector == expected);
+}
+
+struct NoDefault
+{
+    explicit NoDefault(int value) : value(value) { }
+    int value;
+    friend bool operator<(const NoDefault &lhs, const NoDefault &rhs)
+    { return lhs.value < rhs.value; }
+};
+
+void tst_QtConcurrentAlgorithms::sortNonDefaultConstructible()
+{
+    const QList<int> values = randomList(100000, 1 << 20);
+    std::vector<NoDefault> vector;
+    for (int value : values)
+        vector.emplace_back(value);
+
+    QtConcurrent::blockingSort(&pool, vector);
+    QVERIFY(std::is_sorted(vector.begin(), vector.end()));
+}
+
+void tst_QtConcurrentAlgorithms::stableSort()
+{
+    QFETCH(qsizetype, size);
+
+    // few distinct keys, so that there are many equivalent items
+    const QList<int> keys = randomList(size, 10);
+    QList<std::pair<int, qsizetype>> list;
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        list.emplace_back(keys.at(i), i);
+    QList<std::pair<int, qsizetype>> expected = list;
+
+    const auto byKey = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    QtConcurrent::blockingStableSort(&pool, list, byKey);
+    QCOMPARE(list, expected);
+
+    std::stable_sort(expected.begin(), expected.end(), std::greater<>());
+    QtConcurrent::stableSort(&pool, list.begin(), list.end(), std::greater<>()).waitForFinished();
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(qsizetype, size);
+
+    QList<qint64> list(size);
+    std::iota(list.begin(), list.end(), qint64(-1000));
+    QList<qint64> expected(size);
+    std::inclusive_scan(list.cbegin(), list.cend(), expected.begin());
+
+    QList<qint64> output(size);
+    QtConcurrent::blockingInclusiveScan(&pool, list.cbegin(), list.cend(), output.begin());
+    QCOMPARE(output, expected);
+
+    QtConcurrent::inclusiveScan(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::inclusive_scan(expected.cbegin(), expected.cend(), expected.begin(),
+                        [](qint64 a, qint64 b) { return qMax(a, b); });
+    QtConcurrent::blockingInclusiveScan(list, [](qint64 a, qint64 b) { return qMax(a, b); });
+    QCOMPARE(list, expected);
+}
+
+// Composition of functions x -> a * x + b
+struct Affine
+{
+    quint64 a = 1;
+    quint64 b = 0;
+    friend bool operator==(const Affine &lhs, const Affine &rhs)
+    { return lhs.a == rhs.a && lhs.b == rhs.b; }
+};
+
+static Affine compose(const Affine &first, const Affine &second)
+{
+    const quint64 modulus = 1000000007;
+    return Affine{ first.a * second.a % modulus, (first.b * second.a + second.b) % modulus };
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScanNonCommutative()
+{
+    QList<Affine> list(200000);
+    QRandomGenerator generator(7);
+    for (Affine &f : list)
+        f = Affine{ generator.bounded(1000u), generator.bounded(1000u) };
+
+    QList<Affine> expected(list.size());
+    std::inclusive_scan(list.cbegin(), list.cend(), expected.begin(), compose);
+
+    QtConcurrent::blockingInclusiveScan(&pool, list, compose);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(qsizetype, size);
+
+    const auto isEven = [](int value) { return value % 2 == 0; };
+    QList<int> list = randomList(size, 1000);
+    QList<int> sorted = list;
+    std::sort(sorted.begin(), sorted.end());
+    const qsizetype evenCount = std::count_if(list.cbegin(), list.cend(), isEven);
+
+    QList<int>::iterator point = QtConcurrent::blockingPartition(&pool, list, isEven);
+    QCOMPARE(point - list.begin(), evenCount);
+    QVERIFY(std::is_partitioned(list.begin(), list.end(), isEven));
+    QVERIFY(std::all_of(list.begin(), point, isEven));
+
+    QtConcurrent::blockingSort(&pool, list);
+    QCOMPARE(list, sorted);
+
+    QFuture<QList<int>::iterator> future =
+            QtConcurrent::partition(&pool, list.begin(), list.end(),
+                                    [](int value) { return value >= 500; });
+    point = future.result();
+    QVERIFY(std::all_of(list.begin(), point, [](int value) { return value >= 500; }));
+    QVERIFY(std::none_of(point, list.end(), [](int value) { return value >= 500; }));
+}
+
+void tst_QtConcurrentAlgorithms::partitionAllOrNothing()
+{
+    QList<int> list = randomList(100000, 1000);
+
+    auto point = QtConcurrent::blockingPartition(&pool, list, [](int) { return true; });
+    QCOMPARE(point, list.end());
+    point = QtConcurrent::blockingPartition(&pool, list, [](int) { return false; });
+    QCOMPARE(point, list.begin());
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QtConcurrentAlgorithms::exceptions()
+{
+    QList<int> list = randomList(100000, 1000);
+    const auto throwingCompare = [](int lhs, int rhs) {
+        if (lhs == 999 || rhs == 999)
+            throw QException();
+        return lhs < rhs;
+    };
+    QVERIFY_THROWS_EXCEPTION(QException,
+                             QtConcurrent::blockingSort(&pool, list, throwingCompare));
+
+    const auto throwingPredicate = [](int value) {
+        if (value == 999)
+            throw QException();
+        return value < 500;
+    };
+    QVERIFY_THROWS_EXCEPTION(QException,
+                             QtConcurrent::blockingPartition(&pool, list, throwingPredicate));
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
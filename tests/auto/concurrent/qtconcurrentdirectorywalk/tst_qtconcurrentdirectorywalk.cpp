@@ -0,0 +1,216 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <qtconcurrentdirectorywalk.h>
+#include <qexception.h>
+
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::StringLiterals;
+
+using F = QDirListing::IteratorFlag;
+
+class tst_QtConcurrentDirectoryWalk : public QObject
+{
+    Q_OBJECT
+public:
+    tst_QtConcurrentDirectoryWalk() { pool.setMaxThreadCount(4); }
+
+private slots:
+    void initTestCase();
+    void unordered_data();
+    void unordered();
+    void depthFirst_data();
+    void depthFirst();
+    void nameFilters();
+    void function();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+
+private:
+    QStringList listing(QDirListing::IteratorFlags flags,
+                        const QStringList &nameFilters = {}) const;
+
+    QThreadPool pool;
+    QTemporaryDir tempDir;
+    QString root;
+};
+
+void tst_QtConcurrentDirectoryWalk::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    root = tempDir.path();
+
+    const auto createFile = [](const QString &path) {
+        QFile file(path);
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        file.write(path.toUtf8());
+    };
+
+    // a few levels, wide enough for several directories to be read at once
+    QDir dir(root);
+    for (int i = 0; i < 6; ++i) {
+        const QString level1 = u"dir%1"_s.arg(i);
+        QVERIFY(dir.mkpath(level1 + u"/sub/deeper"_s));
+        QVERIFY(dir.mkpath(level1 + u"/empty"_s));
+        for (int j = 0; j < 5; ++j) {
+            createFile(root + u'/' + level1 + u"/file%1.txt"_s.arg(j));
+            createFile(root + u'/' + level1 + u"/sub/file%1.dat"_s.arg(j));
+            createFile(root + u'/' + level1 + u"/sub/deeper/file%1.txt"_s.arg(j));
+        }
+    }
+    QVERIFY(dir.mkpath(u".hidden/inside"_s));
+    createFile(root + u"/.hidden/inside/secret.txt"_s);
+    createFile(root + u"/top.txt"_s);
+#ifdef Q_OS_UNIX
+    QVERIFY(QFile::link(u"../.."_s, root + u"/dir0/sub/loop"_s));
+    QVERIFY(QFile::link(u"dir1"_s, root + u"/linktodir1"_s));
+#endif
+}
+
+QStringList tst_QtConcurrentDirectoryWalk::listing(QDirListing::IteratorFlags flags,
+                                                   const QStringList &nameFilters) const
+{
+    QStringList result;
+    for (const auto &entry : QDirListing(root, nameFilters, flags))
+        result.append(entry.filePath());
+    return result;
+}
+
+void tst_QtConcurrentDirectoryWalk::unordered_data()
+{
+    QTest::addColumn<QDirListing::IteratorFlags>("flags");
+
+    QTest::newRow("flat") << QDirListing::IteratorFlags(F::Default);
+    QTest::newRow("recursive") << QDirListing::IteratorFlags(F::Recursive);
+    QTest::newRow("hidden") << (F::Recursive | F::IncludeHidden);
+    QTest::newRow("files-only") << (F::Recursive | F::FilesOnly);
+    QTest::newRow("dirs-only") << (F::Recursive | F::DirsOnly);
+    QTest::newRow("exclude-dirs") << (F::Recursive | F::ExcludeDirs);
+    QTest::newRow("follow-symlinks") << (F::Recursive | F::FollowDirSymlinks);
+    QTest::newRow("follow-symlinks-files-only")
+            << (F::Recursive | F::FollowDirSymlinks | F::FilesOnly);
+}
+
+void tst_QtConcurrentDirectoryWalk::unordered()
+{
+    QFETCH(QDirListing::IteratorFlags, flags);
+
+    QStringList expected = listing(flags);
+    expected.sort();
+
+    QStringList paths = QtConcurrent::walkDirectory(&pool, root, flags).results();
+    paths.sort();
+    QCOMPARE(paths, expected);
+
+    paths = QtConcurrent::walkDirectory(root, flags).results();
+    paths.sort();
+    QCOMPARE(paths, expected);
+}
+
+void tst_QtConcurrentDirectoryWalk::depthFirst_data()
+{
+    QTest::addColumn<QDirListing::IteratorFlags>("flags");
+
+    QTest::newRow("recursive") << QDirListing::IteratorFlags(F::Recursive);
+    QTest::newRow("hidden") << (F::Recursive | F::IncludeHidden);
+    QTest::newRow("follow-symlinks") << (F::Recursive | F::FollowDirSymlinks);
+}
+
+void tst_QtConcurrentDirectoryWalk::depthFirst()
+{
+    QFETCH(QDirListing::IteratorFlags, flags);
+
+    // without filters hiding directories, the order is the one of QDirListing
+    const QStringList paths = QtConcurrent::walkDirectory(
+            &pool, root, flags, QtConcurrent::DirectoryWalkOrder::DepthFirst).results();
+    QCOMPARE(paths, listing(flags));
+
+    // directories that are filtered out are walked after their siblings
+    const QStringList files = QtConcurrent::walkDirectory(
+            &pool, root, flags | F::ExcludeDirs,
+            QtConcurrent::DirectoryWalkOrder::DepthFirst).results();
+    QStringList expected = listing(flags | F::ExcludeDirs);
+    // so the entries of each directory are contiguous
+    QSet<QString> leftDirs;
+    for (qsizetype i = 1; i < files.size(); ++i) {
+        const QString previousDir = QFileInfo(files.at(i - 1)).path();
+        const QString dir = QFileInfo(files.at(i)).path();
+        if (dir != previousDir) {
+            leftDirs.insert(previousDir);
+            QVERIFY2(!leftDirs.contains(dir), qPrintable(files.at(i)));
+        }
+    }
+    QStringList sortedFiles = files;
+    sortedFiles.sort();
+    expected.sort();
+    QCOMPARE(sortedFiles, expected);
+}
+
+void tst_QtConcurrentDirectoryWalk::nameFilters()
+{
+    const QStringList filters = { u"*.txt"_s };
+    QStringList expected = listing(F::Recursive, filters);
+    expected.sort();
+    QVERIFY(!expected.isEmpty());
+
+    QStringList paths = QtConcurrent::walkDirectory(&pool, root, filters).results();
+    paths.sort();
+    QCOMPARE(paths, expected);
+
+    // the subdirectories don't match the filter, but are walked nonetheless
+    paths = QtConcurrent::walkDirectory(&pool, root, filters, F::Recursive,
+                                        QtConcurrent::DirectoryWalkOrder::DepthFirst).results();
+    QCOMPARE(paths.size(), expected.size());
+}
+
+void tst_QtConcurrentDirectoryWalk::function()
+{
+    QMutex mutex;
+    QStringList paths;
+    qint64 totalSize = 0;
+    QtConcurrent::blockingWalkDirectory(&pool, root, F::Recursive | F::FilesOnly,
+                                        [&](const QDirListing::DirEntry &entry) {
+        QMutexLocker locker(&mutex);
+        paths.append(entry.filePath());
+        totalSize += entry.size();
+    });
+
+    QStringList expected = listing(F::Recursive | F::FilesOnly);
+    qint64 expectedSize = 0;
+    for (const QString &path : std::as_const(expected))
+        expectedSize += QFileInfo(path).size();
+    expected.sort();
+    paths.sort();
+    QCOMPARE(paths, expected);
+    QCOMPARE(totalSize, expectedSize);
+
+    QAtomicInt count;
+    QFuture<void> future = QtConcurrent::walkDirectory(root, F::Recursive,
+                                                       [&](const QDirListing::DirEntry &) {
+        count.ref();
+    });
+    future.waitForFinished();
+    QCOMPARE(count.loadRelaxed(), listing(F::Recursive).size());
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QtConcurrentDirectoryWalk::exceptions()
+{
+    const auto throwing = [](const QDirListing::DirEntry &entry) {
+        if (entry.fileName() == "file3.dat"_L1)
+            throw QException();
+    };
+    QVERIFY_THROWS_EXCEPTION(QException,
+                             QtConcurrent::blockingWalkDirectory(&pool, root, F::Recursive,
+                                                                 throwing));
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentDirectoryWalk)
+#include "tst_qtconcurrentdirectorywalk.moc"
@@ -33,6 +33,7 @@ private slots:
     void noDetach();
     void stlContainers();
     void stlContainersLambda();
+    void splittingMode();
 };
 
 using namespace QtConcurrent;
@@ -1544,5 +1545,40 @@ void tst_QtConcurrentFilter::stlContainersLambda()
     QCOMPARE(*list.begin(), 1);
 }
 
+void tst_QtConcurrentFilter::splittingMode()
+{
+    QThreadPool pool;
+    const QList<int> list{ 1, 2, 3, 4, 5 };
+    const QList<int> even{ 2, 4 };
+    const auto isEven = [](int x) { return (x & 1) == 0; };
+    const auto add = [](int &sum, int x) { sum += x; };
+
+    for (SplittingMode mode : { SplittingMode::Blocks, SplittingMode::Lazy }) {
+        QList<int> copy = list;
+        QtConcurrent::filter(mode, copy, isEven).waitForFinished();
+        QCOMPARE(copy, even);
+        copy = list;
+        QtConcurrent::blockingFilter(mode, &pool, copy, isEven);
+        QCOMPARE(copy, even);
+
+        QCOMPARE(QtConcurrent::filtered(mode, list, isEven).results(), even);
+        QCOMPARE(QtConcurrent::filtered(mode, &pool, list.begin(), list.end(), isEven).results(),
+                 even);
+        QCOMPARE(QtConcurrent::blockingFiltered(mode, list, isEven), even);
+        QCOMPARE(QtConcurrent::blockingFiltered<QList<int>>(mode, &pool, list.begin(),
+                                                            list.end(), isEven),
+                 even);
+
+        QCOMPARE(QtConcurrent::filteredReduced<int>(mode, list, isEven, add).result(), 6);
+        QCOMPARE(QtConcurrent::filteredReduced(mode, &pool, list, isEven, add, 10).result(), 16);
+        QCOMPARE(QtConcurrent::blockingFilteredReduced<int>(mode, list.begin(), list.end(),
+                                                            isEven, add),
+                 6);
+        QCOMPARE(QtConcurrent::blockingFilteredReduced(mode, &pool, list, isEven, add, 10,
+                                                       OrderedReduce),
+                 16);
+    }
+}
+
 QTEST_MAIN(tst_QtConcurrentFilter)
 #include "tst_qtconcurrentfilter.moc"
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 #include <QThread>
 #include <QSet>
+#include <list>
+#include <vector>
 
 struct TestIterator
 {
@@ -58,6 +60,10 @@ private slots:
     void noIterations();
     void throttling();
     void multipleResults();
+    void splittingMode();
+    void lazySplitting();
+    void lazySplittingResults();
+    void lazySplittingNoIterations();
 };
 
 QAtomicInt iterations;
@@ -227,7 +233,9 @@ void tst_QtConcurrentIterateKernel::throttling()
 class MultipleResultsFor : public IterateKernel<TestIterator, int>
 {
 public:
-    MultipleResultsFor(TestIterator begin, TestIterator end) : IterateKernel<TestIterator, int>(QThreadPool::globalInstance(), begin, end) { }
+    MultipleResultsFor(TestIterator begin, TestIterator end,
+                       QThreadPool *pool = QThreadPool::globalInstance())
+        : IterateKernel<TestIterator, int>(pool, begin, end) { }
     inline bool runIterations(TestIterator, int begin, int end, int *results) override
     {
         for (int i = begin; i < end; ++i)
@@ -246,6 +254,100 @@ void tst_QtConcurrentIterateKernel::multipleResults()
     f.waitForFinished();
 }
 
+class VisitFor : public IterateKernel<TestIterator, void>
+{
+public:
+    VisitFor(QThreadPool *pool, TestIterator begin, TestIterator end, std::vector<QAtomicInt> *visits)
+        : IterateKernel<TestIterator, void>(pool, begin, end), visits(visits) { }
+    inline bool runIterations(TestIterator, int begin, int end, void *) override
+    {
+        for (int i = begin; i < end; ++i) {
+            // the first iterations are much more expensive than the others
+            if (i < 20)
+                QTest::qSleep(5);
+            (*visits)[i].ref();
+        }
+        QMutexLocker locker(&threadsMutex);
+        threads.insert(QThread::currentThread());
+        return false;
+    }
+    std::vector<QAtomicInt> *visits;
+};
+
+void tst_QtConcurrentIterateKernel::splittingMode()
+{
+    using Kernel = IterateKernel<TestIterator, void>;
+    using ListKernel = IterateKernel<std::list<int>::iterator, void>;
+    QThreadPool pool;
+    // work stealing of the pool is unrelated
+    pool.setWorkStealingEnabled(true);
+    Kernel kernel(&pool, 0, 10);
+    QVERIFY(!kernel.lazySplitting);
+    kernel.setSplittingMode(SplittingMode::Lazy);
+    QVERIFY(kernel.lazySplitting);
+    // only random-access sequences are split
+    ListKernel listKernel(&pool, {}, {});
+    listKernel.setSplittingMode(SplittingMode::Lazy);
+    QVERIFY(!listKernel.lazySplitting);
+
+    // the mode requested for a call only applies to the kernel it creates
+    {
+        SplittingModeScope scope(SplittingMode::Lazy);
+        QVERIFY(Kernel(&pool, 0, 10).lazySplitting);
+        QVERIFY(!Kernel(&pool, 0, 10).lazySplitting);
+    }
+    {
+        SplittingModeScope scope(SplittingMode::Lazy);
+    }
+    QVERIFY(!Kernel(&pool, 0, 10).lazySplitting);
+}
+
+void tst_QtConcurrentIterateKernel::lazySplitting()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    for (int iterationCount : { 1, 2, 7, 1000, 100000 }) {
+        std::vector<QAtomicInt> visits(iterationCount);
+        threads.clear();
+        auto kernel = new VisitFor(&pool, 0, iterationCount, &visits);
+        kernel->setSplittingMode(SplittingMode::Lazy);
+        startThreadEngine(kernel).startAsynchronously().waitForFinished();
+        for (int i = 0; i < iterationCount; ++i)
+            QCOMPARE(visits[i].loadRelaxed(), 1);
+        // the other threads take over the iterations behind the expensive ones
+        if (iterationCount >= 1000)
+            QCOMPARE_GT(threads.size(), 1);
+    }
+}
+
+void tst_QtConcurrentIterateKernel::lazySplittingResults()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    auto kernel = new MultipleResultsFor(0, 10000, &pool);
+    kernel->setSplittingMode(SplittingMode::Lazy);
+    QFuture<int> f = startThreadEngine(kernel).startAsynchronously();
+    const QList<int> results = f.results();
+    QCOMPARE(results.size(), 10000);
+    // results are reported in iteration order, whichever thread ran them
+    for (int i = 0; i < results.size(); ++i)
+        QCOMPARE(results.at(i), i);
+    f.waitForFinished();
+}
+
+void tst_QtConcurrentIterateKernel::lazySplittingNoIterations()
+{
+    QThreadPool pool;
+    for (int i = 0; i < 1000; ++i) {
+        auto kernel = new IterateKernel<TestIterator, void>(&pool, 0, 0);
+        kernel->setSplittingMode(SplittingMode::Lazy);
+        auto future = startThreadEngine(kernel).startAsynchronously();
+        future.waitForFinished();
+    }
+}
+
 QTEST_MAIN(tst_QtConcurrentIterateKernel)
 
 #include "tst_qtconcurrentiteratekernel.moc"
@@ -44,6 +44,7 @@ private slots:
     void qFutureAssignmentLeak();
     void stressTest();
     void persistentResultTest();
+    void splittingMode();
 public slots:
     void throttling();
 };
@@ -2190,5 +2191,40 @@ void tst_QtConcurrentMap::persistentResultTest()
     QCOMPARE(ref.loadAcquire(), 3);
 }
 
+void tst_QtConcurrentMap::splittingMode()
+{
+    QThreadPool pool;
+    const QList<int> list{ 1, 2, 3, 4, 5 };
+    const QList<int> doubled{ 2, 4, 6, 8, 10 };
+    const auto multiplyBy2 = [](int x) { return 2 * x; };
+    const auto add = [](int &sum, int x) { sum += x; };
+
+    for (SplittingMode mode : { SplittingMode::Blocks, SplittingMode::Lazy }) {
+        QList<int> copy = list;
+        QtConcurrent::map(mode, copy, [](int &x) { x *= 2; }).waitForFinished();
+        QCOMPARE(copy, doubled);
+        QtConcurrent::blockingMap(mode, &pool, copy.begin(), copy.end(), [](int &x) { x /= 2; });
+        QCOMPARE(copy, list);
+
+        QCOMPARE(QtConcurrent::mapped(mode, list, multiplyBy2).results(), doubled);
+        QCOMPARE(QtConcurrent::mapped(mode, &pool, list.begin(), list.end(), multiplyBy2)
+                         .results(),
+                 doubled);
+        QCOMPARE(QtConcurrent::blockingMapped(mode, list, multiplyBy2), doubled);
+        QCOMPARE(QtConcurrent::blockingMapped<QList<int>>(mode, &pool, list, multiplyBy2),
+                 doubled);
+
+        QCOMPARE(QtConcurrent::mappedReduced<int>(mode, list, multiplyBy2, add).result(), 30);
+        QCOMPARE(QtConcurrent::mappedReduced(mode, &pool, list, multiplyBy2, add, 10,
+                                             OrderedReduce).result(),
+                 40);
+        QCOMPARE(QtConcurrent::blockingMappedReduced<int>(mode, list.begin(), list.end(),
+                                                          multiplyBy2, add),
+                 30);
+        QCOMPARE(QtConcurrent::blockingMappedReduced(mode, &pool, list, multiplyBy2, add, 10),
+                 40);
+    }
+}
+
 QTEST_MAIN(tst_QtConcurrentMap)
 #include "tst_qtconcurrentmap.moc"
@@ -10,6 +10,7 @@
 #include <qstringlist.h>
 #include <QSet>
 #include <QString>
+#include <QTimeZone>
 
 #include <QtCore/private/qfsfileengine_p.h>
 
@@ -89,6 +90,7 @@ private slots:
 #endif
 
     void withStdAlgorithms();
+    void prefetchMetaData();
 
 private:
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -726,6 +728,29 @@ void tst_QDirListing::withStdAlgorithms()
     QCOMPARE(it->fileName(), fileName);
 }
 
+void tst_QDirListing::prefetchMetaData()
+{
+    const auto describe = [](QDirListing::IteratorFlags flags) {
+        QStringList result;
+        for (const auto &dirEntry : QDirListing(u"entrylist"_s, flags | ItFlag::Recursive)) {
+            result.emplace_back(u"%1 dir=%2 file=%3 link=%4 exists=%5 size=%6 mtime=%7"_s
+                    .arg(dirEntry.filePath())
+                    .arg(dirEntry.isDir()).arg(dirEntry.isFile())
+                    .arg(dirEntry.isSymLink()).arg(dirEntry.exists())
+                    .arg(dirEntry.size())
+                    .arg(dirEntry.lastModified(QTimeZone::UTC).toMSecsSinceEpoch()));
+        }
+        result.sort();
+        return result;
+    };
+
+    const QStringList expected = describe(ItFlag::Default);
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(describe(ItFlag::PrefetchMetaData), expected);
+    QCOMPARE(describe(ItFlag::PrefetchMetaData | ItFlag::ResolveSymlinks),
+             describe(ItFlag::ResolveSymlinks));
+}
+
 QTEST_MAIN(tst_QDirListing)
 
 #include "tst_qdirlisting.moc"
@@ -13,6 +13,7 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
 #include <QOperatingSystemVersion>
 #include <QRandomGenerator>
 #include <QStorageInfo>
@@ -24,6 +25,7 @@
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
 #include <private/qfilesystemengine_p.h>
+#include <private/qasyncfileio_p.h>
 
 #ifdef Q_OS_WIN
 #include <QtCore/private/qfunctions_win_p.h>
@@ -227,6 +229,17 @@ private slots:
     void fullDisk();
     void writeLargeDataBlock_data();
     void writeLargeDataBlock();
+    void writeGathered_data();
+    void writeGathered();
+    void readAsync();
+    void writeAsync();
+    void asyncContinuation();
+#ifdef QT_BUILD_INTERNAL
+    void asyncFileIOBackends_data();
+    void asyncFileIOBackends();
+    void asyncFileIOSaturated_data() { asyncFileIOBackends_data(); }
+    void asyncFileIOSaturated();
+#endif
     void readFromWriteOnlyFile();
     void writeToReadOnlyFile();
 #if defined(Q_OS_LINUX)
@@ -2629,6 +2642,258 @@ void tst_QFile::writeLargeDataBlock()
     QVERIFY( QFile::remove(fileName) );
 }
 
+void tst_QFile::writeGathered_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<bool>("unbuffered");
+    QTest::addColumn<int>("payloadSize");
+
+    for (int payloadSize : { 100, 100000 }) {
+        QTest::addRow("QFile-%d", payloadSize) << int(OpenQFile) << false << payloadSize;
+        QTest::addRow("QFile-unbuffered-%d", payloadSize) << int(OpenQFile) << true << payloadSize;
+        QTest::addRow("Fd-%d", payloadSize) << int(OpenFd) << false << payloadSize;
+        QTest::addRow("Stream-%d", payloadSize) << int(OpenStream) << false << payloadSize;
+    }
+}
+
+void tst_QFile::writeGathered()
+{
+    QFETCH(int, type);
+    QFETCH(bool, unbuffered);
+    QFETCH(int, payloadSize);
+
+    const QByteArray header("header");
+    QByteArray payload(payloadSize, Qt::Uninitialized);
+    for (int i = 0; i < payload.size(); ++i)
+        payload[i] = char('a' + i % 26);
+    const QByteArray trailer("\n");
+    const QByteArrayView blocks[] = { header, {}, payload, trailer };
+
+    const QString fileName("./gatheredwrite.txt");
+    {
+        QFile file(fileName);
+        if (unbuffered)
+            QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Unbuffered), msgOpenFailed(file));
+        else
+            QVERIFY2(openFile(file, QIODevice::WriteOnly, FileType(type)), msgOpenFailed(file));
+        QCOMPARE(file.write("start"), qint64(5));
+        QCOMPARE(file.write(blocks), qint64(header.size() + payload.size() + trailer.size()));
+        QCOMPARE(file.pos(), qint64(5 + header.size() + payload.size() + trailer.size()));
+        QCOMPARE(file.write(QSpan<const QByteArrayView>()), qint64(0));
+        QCOMPARE(file.write("end"), qint64(3));
+        closeFile(file);
+    }
+
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file));
+    QCOMPARE(file.readAll(), "start" + header + payload + trailer + "end");
+    file.close();
+    QVERIFY(QFile::remove(fileName));
+}
+
+void tst_QFile::readAsync()
+{
+    QByteArray content;
+    for (int i = 0; i < 10000; ++i)
+        content += QByteArray::number(i) + ' ';
+    QFile file(u"readAsync.txt"_s);
+    QVERIFY2(file.open(QFile::WriteOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.write(content), qint64(content.size()));
+    file.close();
+
+    QVERIFY2(file.open(QFile::ReadOnly), msgOpenFailed(file).constData());
+    QVERIFY(file.seek(10));
+    QFuture<QByteArray> head = file.readAsync(0, 100);
+    QFuture<QByteArray> middle = file.readAsync(1000, 5000);
+    QFuture<QByteArray> tail = file.readAsync(content.size() - 10, 100);
+    QFuture<QByteArray> all = file.readAsync(0, std::numeric_limits<qint64>::max());
+    QFuture<QByteArray> pastEnd = file.readAsync(content.size() + 10, 100);
+    // doesn't interfere with the synchronous API
+    QCOMPARE(file.pos(), qint64(10));
+    QCOMPARE(file.read(10), content.mid(10, 10));
+
+    QCOMPARE(head.result(), content.first(100));
+    QCOMPARE(middle.result(), content.sliced(1000, 5000));
+    QCOMPARE(tail.result(), content.last(10));
+    QCOMPARE(all.result(), content);
+    QVERIFY(pastEnd.result().isEmpty());
+    QCOMPARE(file.pos(), qint64(20));
+
+    // the operations keep the file open
+    QList<QFuture<QByteArray>> pending;
+    for (qsizetype offset = 0; offset < content.size(); offset += 1000)
+        pending.append(file.readAsync(offset, 1000));
+    file.close();
+    QByteArray reassembled;
+    for (QFuture<QByteArray> &future : pending)
+        reassembled += future.result();
+    QCOMPARE(reassembled, content);
+
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::readAsync: IODevice is not open");
+    QVERIFY(file.readAsync(0, 10).result().isEmpty());
+    QVERIFY2(file.open(QFile::WriteOnly | QFile::Append), msgOpenFailed(file).constData());
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::readAsync: WriteOnly device");
+    QVERIFY(file.readAsync(0, 10).result().isEmpty());
+}
+
+void tst_QFile::writeAsync()
+{
+    QFile file(u"writeAsync.txt"_s);
+    QVERIFY2(file.open(QFile::ReadWrite | QFile::Truncate), msgOpenFailed(file).constData());
+
+    // buffered data is flushed before the asynchronous writes
+    QCOMPARE(file.write("0123456789"), qint64(10));
+    const QByteArray block(4096, 'x');
+    QList<QFuture<qint64>> pending;
+    for (int i = 0; i < 64; ++i) {
+        QByteArray data = block;
+        data[0] = char('A' + i % 26);
+        pending.append(file.writeAsync(10 + i * block.size(), data));
+    }
+    QCOMPARE(file.pos(), qint64(10));
+    QCOMPARE(file.writeAsync(0, QByteArray()).result(), qint64(0));
+    for (QFuture<qint64> &future : pending)
+        QCOMPARE(future.result(), qint64(block.size()));
+
+    QCOMPARE(file.size(), qint64(10 + 64 * block.size()));
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(10), "0123456789");
+    for (int i = 0; i < 64; ++i) {
+        const QByteArray data = file.read(block.size());
+        QCOMPARE(data.size(), block.size());
+        QCOMPARE(data.at(0), char('A' + i % 26));
+        QCOMPARE(data.count('x'), block.size() - 1);
+    }
+
+    // a write racing with a read of another region
+    QFuture<qint64> write = file.writeAsync(0, "abc");
+    QFuture<QByteArray> read = file.readAsync(10, 1);
+    QCOMPARE(write.result(), qint64(3));
+    QCOMPARE(read.result(), "A");
+    QCOMPARE(file.readAsync(0, 10).result(), "abc3456789");
+    file.close();
+
+    QVERIFY2(file.open(QFile::ReadOnly), msgOpenFailed(file).constData());
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::writeAsync: ReadOnly device");
+    QCOMPARE(file.writeAsync(0, "abc").result(), qint64(-1));
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::writeAsync: Called with offset < 0");
+    QCOMPARE(file.writeAsync(-1, "abc").result(), qint64(-1));
+}
+
+void tst_QFile::asyncContinuation()
+{
+    QFile file(u"asyncContinuation.txt"_s);
+    QVERIFY2(file.open(QFile::ReadWrite | QFile::Truncate), msgOpenFailed(file).constData());
+
+    QObject context;
+    QThread *continuationThread = nullptr;
+    qint64 written = 0;
+    QByteArray data;
+    file.writeAsync(0, "hello world").then(&context, [&](qint64 result) {
+        written = result;
+        return file.readAsync(6, 5);
+    }).unwrap().then(&context, [&](const QByteArray &result) {
+        continuationThread = QThread::currentThread();
+        data = result;
+    });
+    QTRY_COMPARE(data, "world");
+    QCOMPARE(written, qint64(11));
+    QCOMPARE(continuationThread, QThread::currentThread());
+}
+
+#ifdef QT_BUILD_INTERNAL
+void tst_QFile::asyncFileIOBackends_data()
+{
+    QTest::addColumn<QAsyncFileIO::Backend>("backend");
+
+    QTest::newRow("threadpool") << QAsyncFileIO::Backend::ThreadPool;
+#ifdef Q_OS_LINUX
+    QTest::newRow("io_uring") << QAsyncFileIO::Backend::IoUring;
+#endif
+}
+
+void tst_QFile::asyncFileIOBackends()
+{
+    QFETCH(QAsyncFileIO::Backend, backend);
+    QAsyncFileIO *io = QAsyncFileIO::instance(backend);
+    if (!io)
+        QSKIP("This backend isn't available");
+    QCOMPARE(io->backend(), backend);
+
+    QFile file(u"asyncFileIOBackends.dat"_s);
+    QVERIFY2(file.open(QFile::ReadWrite | QFile::Truncate), msgOpenFailed(file).constData());
+    const auto handle = QAsyncFileHandle::create(file.handle(), file.openMode());
+    QVERIFY(handle);
+
+    // more operations than can be in flight at once
+    const int blockSize = 1000;
+    QList<QFuture<qint64>> writes;
+    for (int i = 0; i < 1000; ++i)
+        writes.append(io->write(handle, i * blockSize, QByteArray(blockSize, char('0' + i % 10))));
+    for (QFuture<qint64> &future : writes)
+        QCOMPARE(future.result(), qint64(blockSize));
+    QCOMPARE(handle->size(), qint64(1000 * blockSize));
+
+    QList<QFuture<QByteArray>> reads;
+    for (int i = 0; i < 1000; ++i)
+        reads.append(io->read(handle, i * blockSize + 1, blockSize));
+    for (int i = 0; i < 1000; ++i) {
+        const QByteArray data = reads[i].result();
+        QCOMPARE(data.size(), i == 999 ? blockSize - 1 : blockSize);
+        QCOMPARE(data.front(), char('0' + i % 10));
+        QCOMPARE(data.back(), char('0' + (i == 999 ? i : i + 1) % 10));
+    }
+    QCOMPARE(file.pos(), qint64(0));
+    QCOMPARE(file.size(), qint64(1000 * blockSize));
+}
+
+void tst_QFile::asyncFileIOSaturated()
+{
+    QFETCH(QAsyncFileIO::Backend, backend);
+    QAsyncFileIO *io = QAsyncFileIO::instance(backend);
+    if (!io)
+        QSKIP("This backend isn't available");
+
+    QFile file(u"asyncFileIOSaturated.dat"_s);
+    QVERIFY2(file.open(QFile::ReadWrite | QFile::Truncate), msgOpenFailed(file).constData());
+    const auto handle = QAsyncFileHandle::create(file.handle(), file.openMode());
+    QVERIFY(handle);
+
+    // several threads keep the ring full while completions are reaped, and
+    // every single operation must finish, including the last ones queued
+    const int threadCount = 4;
+    const int operationsPerThread = 500;
+    const int blockSize = 100;
+    QList<QFuture<qint64>> writes[threadCount];
+    QScopedPointer<QThread> threads[threadCount];
+    for (int t = 0; t < threadCount; ++t) {
+        threads[t].reset(QThread::create([&, t] {
+            for (int i = 0; i < operationsPerThread; ++i) {
+                const qint64 offset = qint64(i * threadCount + t) * blockSize;
+                writes[t].append(io->write(handle, offset, QByteArray(blockSize, char('a' + t))));
+            }
+        }));
+        threads[t]->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    for (const auto &futures : writes) {
+        for (const QFuture<qint64> &future : futures) {
+            QTRY_VERIFY(future.isFinished());
+            QCOMPARE(future.result(), qint64(blockSize));
+        }
+    }
+
+    QList<QFuture<QByteArray>> reads;
+    for (int i = 0; i < threadCount * operationsPerThread; ++i)
+        reads.append(io->read(handle, qint64(i) * blockSize, blockSize));
+    for (int i = 0; i < reads.size(); ++i) {
+        QTRY_VERIFY(reads[i].isFinished());
+        QCOMPARE(reads[i].result(), QByteArray(blockSize, char('a' + i % threadCount)));
+    }
+}
+#endif
+
 void tst_QFile::readFromWriteOnlyFile()
 {
     QFile file("writeonlyfile");
@@ -34,6 +34,9 @@ private slots:
     void skip();
     void skipAfterPeek_data();
     void skipAfterPeek();
+    void peekChunk_data();
+    void peekChunk();
+    void readAllTakesChunk();
 
     void transaction_data();
     void transaction();
@@ -711,6 +714,88 @@ void tst_QIODevice::skipAfterPeek()
     QCOMPARE(readSoFar, data.size());
 }
 
+void tst_QIODevice::peekChunk_data()
+{
+    QTest::addColumn<int>("deviceType");
+    QTest::addColumn<QByteArray>("data");
+
+    QByteArray bigData;
+    for (int i = 0; i < 1000; ++i)
+        bigData += "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    QTest::newRow("sequential") << 0 << bigData;
+    QTest::newRow("random-access") << 1 << bigData;
+    QTest::newRow("qbuffer") << 2 << bigData;
+    QTest::newRow("empty") << 0 << QByteArray();
+}
+
+void tst_QIODevice::peekChunk()
+{
+    QFETCH(int, deviceType);
+    QFETCH(QByteArray, data);
+
+    QScopedPointer<QIODevice> dev;
+    switch (deviceType) {
+    case 0: dev.reset(new SequentialReadBuffer(&data)); break;
+    case 1: dev.reset(new RandomAccessBuffer(data.constData())); break;
+    default: dev.reset(new QBuffer(&data)); break;
+    }
+    QVERIFY(dev->open(QIODevice::ReadOnly));
+
+    QByteArray result;
+    QCOMPARE(dev->read(1), data.left(1));
+    result += data.left(1);
+    forever {
+        const QByteArrayView chunk = dev->peekChunk();
+        if (chunk.isEmpty())
+            break;
+        // peeking has no side effects
+        QCOMPARE(dev->peekChunk().data(), chunk.data());
+        QCOMPARE(dev->peek(chunk.size()), chunk.toByteArray());
+        result += chunk;
+        QCOMPARE(dev->skip(chunk.size()), qint64(chunk.size()));
+    }
+    QCOMPARE(result, data);
+    QVERIFY(dev->atEnd());
+
+    // transactions keep the data
+    if (deviceType == 0 && !data.isEmpty()) {
+        SequentialReadBuffer seqDev(&data);
+        QVERIFY(seqDev.open(QIODevice::ReadOnly));
+        seqDev.startTransaction();
+        QCOMPARE(seqDev.read(2), data.left(2));
+        const QByteArrayView chunk = seqDev.peekChunk();
+        QVERIFY(data.mid(2).startsWith(chunk));
+        seqDev.rollbackTransaction();
+        QCOMPARE(seqDev.peekChunk().left(2).toByteArray(), data.left(2));
+    }
+}
+
+// readAll() on a sequential device takes over the buffered chunk
+void tst_QIODevice::readAllTakesChunk()
+{
+    QByteArray data("Hello world!");
+    SequentialReadBuffer dev(&data);
+    QVERIFY(dev.open(QIODevice::ReadOnly));
+
+    const QByteArrayView chunk = dev.peekChunk();
+    QCOMPARE(chunk.toByteArray(), data);
+
+    const QByteArray result = dev.readAll();
+    QCOMPARE(result, data);
+    QCOMPARE(result.constData(), chunk.data());
+    QVERIFY(dev.peekChunk().isEmpty());
+
+    // more data than what was buffered
+    QByteArray bigData;
+    for (int i = 0; i < 5000; ++i)
+        bigData += "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    SequentialReadBuffer bigDev(&bigData);
+    QVERIFY(bigDev.open(QIODevice::ReadOnly));
+    QVERIFY(!bigDev.peekChunk().isEmpty());
+    QCOMPARE(bigDev.readAll(), bigData);
+}
+
 void tst_QIODevice::transaction_data()
 {
     QTest::addColumn<bool>("sequential");
@@ -6,6 +6,7 @@
 #include <QResource>
 #include <QtPlugin>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDirIterator>
 #include <QtCore/QScopeGuard>
 #include <QtCore/private/qglobal_p.h>
 
@@ -18,9 +19,17 @@ public:
 #ifdef Q_OS_ANDROID
         : m_runtimeResourceRcc(
             QFileInfo(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
-                      + QStringLiteral("/runtime_resource.rcc")).absoluteFilePath())
+                      + QStringLiteral("/runtime_resource.rcc")).absoluteFilePath()),
+          m_indexedResourceRcc(
+            QFileInfo(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                      + QStringLiteral("/indexed_resource.rcc")).absoluteFilePath()),
+          m_zstdResourceRcc(
+            QFileInfo(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                      + QStringLiteral("/zstd_resource.rcc")).absoluteFilePath())
 #else
-        : m_runtimeResourceRcc(QFINDTESTDATA("runtime_resource.rcc"))
+        : m_runtimeResourceRcc(QFINDTESTDATA("runtime_resource.rcc")),
+          m_indexedResourceRcc(QFINDTESTDATA("indexed_resource.rcc")),
+          m_zstdResourceRcc(QFINDTESTDATA("zstd_resource.rcc"))
 #endif
     {}
 
@@ -39,12 +48,16 @@ private slots:
     void doubleSlashInRoot();
     void setLocale_data();
     void setLocale();
+    void pathIndex();
+    void zstdDictionaryAndChunks();
     void lastModified();
     void resourcesInStaticPlugins();
     void qtResourceEmpty();
 
 private:
     const QString m_runtimeResourceRcc;
+    const QString m_indexedResourceRcc;
+    const QString m_zstdResourceRcc;
     QByteArray m_runtimeResourceData;
 };
 
@@ -87,6 +100,10 @@ void tst_QResourceEngine::initTestCase()
     m_runtimeResourceData = resourceFile.readAll();
     auto resourcePtr = reinterpret_cast<const uchar *>(m_runtimeResourceData.constData());
     QVERIFY(QResource::registerResource(resourcePtr, "/secondary_root/"));
+
+    // format version 4, with a path index
+    QVERIFY(!m_indexedResourceRcc.isEmpty());
+    QVERIFY(QResource::registerResource(m_indexedResourceRcc));
 }
 
 void tst_QResourceEngine::cleanupTestCase()
@@ -95,6 +112,7 @@ void tst_QResourceEngine::cleanupTestCase()
     QVERIFY(QResource::unregisterResource(m_runtimeResourceRcc));
     auto resourcePtr = reinterpret_cast<const uchar *>(m_runtimeResourceData.constData());
     QVERIFY(QResource::unregisterResource(resourcePtr, "/secondary_root/"));
+    QVERIFY(QResource::unregisterResource(m_indexedResourceRcc));
 }
 
 void tst_QResourceEngine::compressedResource_data()
@@ -183,6 +201,7 @@ void tst_QResourceEngine::checkStructure_data()
                  << QLatin1String("android_testdata")
 #endif
                  << QLatin1String("empty")
+                 << QLatin1String("indexed_resource")
                  << QLatin1String("otherdir")
                  << QLatin1String("runtime_resource")
                  << QLatin1String("searchpath1")
@@ -221,7 +240,8 @@ void tst_QResourceEngine::checkStructure_data()
                                      << qlonglong(0);
 
     QStringList roots;
-    roots << QString(":/") << QString(":/runtime_resource/") << QString(":/secondary_root/runtime_resource/");
+    roots << QString(":/") << QString(":/runtime_resource/") << QString(":/secondary_root/runtime_resource/")
+          << QString(":/indexed_resource/");
     for(int i = 0; i < roots.size(); ++i) {
         const QString root = roots.at(i);
 
@@ -606,6 +626,7 @@ void tst_QResourceEngine::setLocale_data()
     QTest::addColumn<QString>("prefix");
     QTest::newRow("built-in") << QString();
     QTest::newRow("runtime") << "/runtime_resource/";
+    QTest::newRow("indexed") << "/indexed_resource/";
 }
 
 void tst_QResourceEngine::setLocale()
@@ -631,6 +652,86 @@ void tst_QResourceEngine::setLocale()
     QLocale::setDefault(QLocale::system());
 }
 
+void tst_QResourceEngine::pathIndex()
+{
+    const QString root = QStringLiteral(":/indexed_resource/");
+
+    // paths that aren't in the index land on some other entry
+    QVERIFY(!QFile::exists(root + "test/abc/123/+++/nonexistent.txt"));
+    QVERIFY(!QFile::exists(root + "test/abc/123/currentdir.txt"));
+    QVERIFY(!QFile::exists(root + "abc/123/+++/currentdir.txt"));
+    QVERIFY(!QFile::exists(root + "test/abc/123/+++/currentdir.txt/currentdir.txt"));
+    QVERIFY(!QFile::exists(root + "nonexistent/test"));
+
+    // same as QResourceRoot::findNode() without the index
+    QResource resource(root + "test/abc/123/+++/currentdir.txt");
+    QVERIFY(resource.isValid());
+    QCOMPARE(resource.size(), QFileInfo(QFINDTESTDATA("testqrc/currentdir.txt")).size());
+    QVERIFY(QResource(root + "test/abc/123/+++/currentdir.txt", QLocale::c()).isValid());
+    QVERIFY(QResource("/indexed_resource//test/abc/123/+++/currentdir.txt").isValid());
+    QVERIFY(QResource("indexed_resource/test/abc/123/+++/").isValid());
+    QVERIFY(QFileInfo(root + "test/abc/123/+++").isDir());
+}
+
+void tst_QResourceEngine::zstdDictionaryAndChunks()
+{
+#if !QT_CONFIG(zstd)
+    QSKIP("This test requires zstd support");
+#else
+    // compressed with a shared dictionary, big files in chunks of 4096 bytes
+    QVERIFY(!m_zstdResourceRcc.isEmpty());
+    QVERIFY(QResource::registerResource(m_zstdResourceRcc));
+    auto unregister = qScopeGuard([this] { QResource::unregisterResource(m_zstdResourceRcc); });
+
+    const QString root = QStringLiteral(":/zstd_resource/");
+    int fileCount = 0;
+    QDirIterator it(root, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const QString builtinPath = QLatin1String(":/") + QStringView(path).sliced(root.size());
+        QFile builtin(builtinPath);
+        QVERIFY2(builtin.open(QIODevice::ReadOnly), qPrintable(builtinPath));
+        const QByteArray expected = builtin.readAll();
+
+        QResource resource(path);
+        QCOMPARE(resource.uncompressedSize(), expected.size());
+        QCOMPARE(resource.uncompressedData(), expected);
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.size(), expected.size());
+        QCOMPARE(file.readAll(), expected);
+        ++fileCount;
+    }
+    QVERIFY(fileCount > 1);
+
+    // reads that start and end in the middle of chunks
+    QLocale::setDefault(QLocale("de_CH"));
+    auto resetLocale = qScopeGuard([] { QLocale::setDefault(QLocale::system()); });
+    const QString path = root + QLatin1String("aliasdir/aliasdir.txt");
+    QFile builtin(QStringLiteral(":/uncompresseddir/uncompressed.txt"));
+    QVERIFY(builtin.open(QIODevice::ReadOnly));
+    const QByteArray expected = builtin.readAll();
+    QVERIFY(expected.size() > 3 * 4096);
+    QCOMPARE(QResource(path).compressionAlgorithm(), QResource::ZstdCompression);
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+    for (qint64 pos : { qint64(4096 * 3 - 10), qint64(1), qint64(4096 * 2),
+                        qint64(expected.size() - 100) }) {
+        QVERIFY(file.seek(pos));
+        QCOMPARE(file.read(5000), expected.mid(pos, 5000));
+        QCOMPARE(file.pos(), qMin(pos + 5000, qint64(expected.size())));
+    }
+    QVERIFY(file.seek(expected.size()));
+    QVERIFY(file.read(10).isEmpty());
+
+    uchar *ptr = file.map(4000, 200);
+    QVERIFY2(ptr, qPrintable(file.errorString()));
+    QCOMPARE(QByteArrayView(ptr, 200), QByteArrayView(expected).sliced(4000, 200));
+#endif
+}
+
 void tst_QResourceEngine::lastModified()
 {
     {
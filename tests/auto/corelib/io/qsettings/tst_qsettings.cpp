@@ -15,6 +15,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QEventLoop>
+#include <QtCore/QScopeGuard>
 #include <QtCore/QtGlobal>
 #include <QtCore/QThread>
 #include <QtCore/QSysInfo>
@@ -129,6 +130,10 @@ private slots:
     void syncNonWriteableDir();
 #ifdef Q_OS_WIN
     void syncAlternateDataStream();
+#endif
+    void incrementalSync();
+#ifndef Q_OS_WIN
+    void incrementalSyncUnremovableLog();
 #endif
     void setFallbacksEnabled();
     void setFallbacksEnabled_data() { populateWithFormats(); }
@@ -1915,6 +1920,175 @@ void tst_QSettings::syncAlternateDataStream()
 }
 #endif
 
+void tst_QSettings::incrementalSync()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qUtf8Printable(tempDir.errorString()));
+    const QString filename = tempDir.path() + "/config.ini";
+    const QString logname = filename + ".log";
+
+    auto appendToLog = [&](const QByteArray &data) {
+        QFile log(logname);
+        QVERIFY2(log.open(QIODevice::WriteOnly | QIODevice::Append),
+                 qUtf8Printable(log.errorString()));
+        QCOMPARE(log.write(data), data.size());
+    };
+    auto readFile = [](const QString &name) {
+        QFile file(name);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    {
+        QSettings settings(filename, QSettings::IniFormat);
+        QVERIFY(!settings.isIncrementalSyncEnabled());
+        settings.setIncrementalSyncEnabled(true);
+        settings.setValue("alpha", 1);
+        settings.setValue("beta/gamma", QStringList{ "a", "b" });
+        settings.setValue("delta", "text with\nnewline");
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVERIFY(!QFile::exists(filename));
+        QVERIFY(QFile::exists(logname));
+    }
+
+    // a full rewrite compacts the log
+    {
+        QSettings settings(filename, QSettings::IniFormat);
+        settings.setIncrementalSyncEnabled(true);
+        settings.sync();
+        QCOMPARE(settings.value("alpha"), QVariant(1));
+        QCOMPARE(settings.value("beta/gamma"), QVariant(QStringList{ "a", "b" }));
+        QCOMPARE(settings.value("delta"), QVariant("text with\nnewline"));
+        settings.setIncrementalSyncEnabled(false);
+        settings.setValue("epsilon", 2);
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVERIFY(QFile::exists(filename));
+        QVERIFY(!QFile::exists(logname));
+    }
+
+    QSettings settings(filename, QSettings::IniFormat);
+    settings.setIncrementalSyncEnabled(true);
+    const QByteArray contents = readFile(filename);
+    settings.setValue("alpha", 3);
+    settings.remove("beta");
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QCOMPARE(readFile(filename), contents);
+    QVERIFY(QFile::exists(logname));
+
+    // what other processes append gets picked up, but only complete transactions
+    appendToLog("+zeta=4\n.\n");
+    settings.sync();
+    QCOMPARE(settings.value("zeta"), QVariant(4));
+    appendToLog("-zeta\n+eta\\theta=5\n");
+    settings.sync();
+    QCOMPARE(settings.value("zeta"), QVariant(4));
+    QVERIFY(!settings.contains("eta/theta"));
+    appendToLog(".\n");
+    settings.sync();
+    QVERIFY(!settings.contains("zeta"));
+    QCOMPARE(settings.value("eta/theta"), QVariant(5));
+    QCOMPARE(settings.status(), QSettings::NoError);
+
+    // a log bigger than the file gets compacted
+    settings.setValue("big", QString(100 * 1024, u'x'));
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QVERIFY(!QFile::exists(logname));
+
+    const QString iniFile = QString::fromLatin1(readFile(filename));
+    QVERIFY(iniFile.contains("alpha=3"));
+    QVERIFY(!iniFile.contains("gamma"));
+    QVERIFY(iniFile.contains("theta=5"));
+    QVERIFY(iniFile.contains("epsilon=2"));
+
+    // only objects with incremental sync enabled read the log
+    const QString otherName = tempDir.path() + "/other.ini";
+    {
+        QFile log(otherName + ".log");
+        QVERIFY2(log.open(QIODevice::WriteOnly), qUtf8Printable(log.errorString()));
+        QVERIFY(log.write("; QSettings log 1\n+alpha=1\n.\n") > 0);
+    }
+    {
+        QSettings other(otherName, QSettings::IniFormat);
+        QVERIFY(!other.contains("alpha"));
+        other.setIncrementalSyncEnabled(true);
+        other.sync();
+        QCOMPARE(other.value("alpha"), QVariant(1));
+    }
+
+    // a file that isn't a log is left alone
+    const QString foreignName = tempDir.path() + "/foreign.ini";
+    const QByteArray foreignLog = "not a settings log\n";
+    {
+        QFile log(foreignName + ".log");
+        QVERIFY2(log.open(QIODevice::WriteOnly), qUtf8Printable(log.errorString()));
+        QCOMPARE(log.write(foreignLog), foreignLog.size());
+    }
+    QSettings foreign(foreignName, QSettings::IniFormat);
+    foreign.setValue("alpha", 1);
+    foreign.sync();
+    QCOMPARE(foreign.status(), QSettings::NoError);
+    foreign.setIncrementalSyncEnabled(true);
+    foreign.setValue("beta", 2);
+    foreign.sync();
+    QCOMPARE(foreign.status(), QSettings::NoError);
+    QCOMPARE(readFile(foreignName + ".log"), foreignLog);
+    QVERIFY(readFile(foreignName).contains("beta=2"));
+}
+
+#ifndef Q_OS_WIN
+void tst_QSettings::incrementalSyncUnremovableLog()
+{
+    if (::getuid() == 0)
+        QSKIP("Running this test as root doesn't work, since file perms do not bother him");
+
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qUtf8Printable(tempDir.errorString()));
+    const QString filename = tempDir.path() + "/config.ini";
+    const QString logname = filename + ".log";
+
+    {
+        QSettings settings(filename, QSettings::IniFormat);
+        settings.setValue("alpha", 1);
+        settings.sync();
+        settings.setIncrementalSyncEnabled(true);
+        settings.setValue("alpha", 2);
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVERIFY(QFile::exists(logname));
+    }
+
+    // the directory doesn't allow removing the log, but the files are writable
+    QFile dir(tempDir.path());
+    const QFile::Permissions dirPerms = dir.permissions();
+    QVERIFY(dir.setPermissions(QFile::ReadOwner | QFile::ExeOwner));
+    auto restorePerms = qScopeGuard([&] { dir.setPermissions(dirPerms); });
+    {
+        QSettings settings(filename, QSettings::IniFormat);
+        settings.setAtomicSyncRequired(false);
+        QCOMPARE(settings.value("alpha"), QVariant(2));
+        settings.setValue("alpha", 3);
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+    }
+    QVERIFY(QFile::exists(logname));
+    QVERIFY(dir.setPermissions(dirPerms));
+
+    // the log was invalidated, so its old value isn't replayed
+    QSettings settings(filename, QSettings::IniFormat);
+    QCOMPARE(settings.value("alpha"), QVariant(3));
+    settings.setIncrementalSyncEnabled(true);
+    settings.setValue("beta", 4);
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QSettings other(filename, QSettings::IniFormat);
+    QCOMPARE(other.value("alpha"), QVariant(3));
+    QCOMPARE(other.value("beta"), QVariant(4));
+}
+#endif
+
 void tst_QSettings::setFallbacksEnabled()
 {
     QFETCH(QSettings::Format, format);
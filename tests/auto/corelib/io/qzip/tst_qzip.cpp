@@ -4,6 +4,8 @@
 #include <QTest>
 #include <QDebug>
 #include <QBuffer>
+#include <QTemporaryDir>
+#include <QThreadPool>
 
 #include <private/qzipwriter_p.h>
 #include <private/qzipreader_p.h>
@@ -17,8 +19,25 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void fileDevice_data();
+    void fileDevice();
+    void fileDeviceChecksum();
+    void extractAllChecksum();
+    void addFileFromDevice_data();
+    void addFileFromDevice();
+    void threadPool();
 };
 
+static QByteArray testContents(int size, int seed = 0)
+{
+    QByteArray contents;
+    contents.reserve(size);
+    for (int i = 0; contents.size() < size; ++i)
+        contents += QByteArray::number(i * 7 + seed) + (i % 13 ? ' ' : '\n');
+    contents.truncate(size);
+    return contents;
+}
+
 void tst_QZip::basicUnpack()
 {
     QZipReader zip(QFINDTESTDATA("/testdata/test.zip"), QIODevice::ReadOnly);
@@ -112,5 +131,180 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+void tst_QZip::fileDevice_data()
+{
+    QTest::addColumn<int>("policy");
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("stored-empty") << int(QZipWriter::NeverCompress) << 0;
+    QTest::newRow("stored") << int(QZipWriter::NeverCompress) << 100000;
+    QTest::newRow("deflated-empty") << int(QZipWriter::AlwaysCompress) << 0;
+    QTest::newRow("deflated") << int(QZipWriter::AlwaysCompress) << 300000;
+}
+
+void tst_QZip::fileDevice()
+{
+    QFETCH(int, policy);
+    QFETCH(int, size);
+
+    const QByteArray contents = testContents(size);
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    writer.setCompressionPolicy(QZipWriter::CompressionPolicy(policy));
+    writer.addFile("first", "something else");
+    writer.addFile("dir/file", contents);
+    writer.close();
+
+    QBuffer buffer2(&buffer.buffer());
+    QZipReader reader(&buffer2);
+    QVERIFY(!reader.fileDevice("missing"));
+    const auto first = reader.fileDevice("first");
+    const auto device = reader.fileDevice("dir/file");
+    QVERIFY(first);
+    QVERIFY(device);
+    QVERIFY(device->isSequential());
+    QCOMPARE(device->bytesAvailable(), size);
+    QCOMPARE(device->atEnd(), size == 0);
+
+    // read both entries at the same time, in small pieces
+    QByteArray data;
+    QByteArray chunk;
+    while (!(chunk = device->read(1000)).isEmpty()) {
+        data += chunk;
+        if (data.size() == 1000)
+            QCOMPARE(first->readAll(), QByteArray("something else"));
+    }
+    QCOMPARE(data, contents);
+    QVERIFY(device->atEnd());
+    QCOMPARE(reader.fileData("dir/file"), contents);
+}
+
+void tst_QZip::fileDeviceChecksum()
+{
+    const QByteArray contents = testContents(10000);
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    writer.setCompressionPolicy(QZipWriter::NeverCompress);
+    writer.addFile("file", contents);
+    writer.close();
+
+    // corrupt the stored contents
+    QByteArray archive = buffer.buffer();
+    const qsizetype pos = archive.indexOf(contents.left(100));
+    QVERIFY(pos > 0);
+    archive[pos + 5000] = archive[pos + 5000] ^ 1;
+
+    QBuffer buffer2(&archive);
+    QZipReader reader(&buffer2);
+    const auto device = reader.fileDevice("file");
+    QVERIFY(device);
+    QByteArray data;
+    char chunk[1024];
+    qint64 bytesRead;
+    while ((bytesRead = device->read(chunk, sizeof(chunk))) > 0)
+        data.append(chunk, bytesRead);
+    QCOMPARE(bytesRead, -1);
+    QVERIFY(!device->errorString().isEmpty());
+}
+
+void tst_QZip::extractAllChecksum()
+{
+    const QByteArray contents = testContents(10000);
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    writer.setCompressionPolicy(QZipWriter::NeverCompress);
+    writer.addFile("file", contents);
+    writer.close();
+
+    // corrupt the stored contents
+    QByteArray archive = buffer.buffer();
+    const qsizetype pos = archive.indexOf(contents.left(100));
+    QVERIFY(pos > 0);
+    archive[pos + 5000] = archive[pos + 5000] ^ 1;
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QBuffer buffer2(&archive);
+    QZipReader reader(&buffer2);
+    QVERIFY(!reader.extractAll(dir.path()));
+    QVERIFY(!QFile::exists(dir.filePath("file")));
+}
+
+void tst_QZip::addFileFromDevice_data()
+{
+    QTest::addColumn<int>("policy");
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("auto-small") << int(QZipWriter::AutoCompress) << 10;
+    QTest::newRow("auto-big") << int(QZipWriter::AutoCompress) << 1000000;
+    QTest::newRow("stored-big") << int(QZipWriter::NeverCompress) << 1000000;
+    QTest::newRow("deflated-big") << int(QZipWriter::AlwaysCompress) << 1000000;
+    QTest::newRow("deflated-chunk") << int(QZipWriter::AlwaysCompress) << 64 * 1024;
+}
+
+void tst_QZip::addFileFromDevice()
+{
+    QFETCH(int, policy);
+    QFETCH(int, size);
+
+    QByteArray contents = testContents(size);
+    QBuffer source(&contents);
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    writer.setCompressionPolicy(QZipWriter::CompressionPolicy(policy));
+    writer.addFile("before", "first file");
+    writer.addFile("file", &source);
+    QVERIFY(!source.isOpen());
+    writer.addFile("after", "last file");
+    writer.close();
+
+    const bool compressed = policy != QZipWriter::NeverCompress && size >= 64;
+    QCOMPARE(buffer.size() < size, compressed);
+
+    QBuffer buffer2(&buffer.buffer());
+    QZipReader reader(&buffer2);
+    const QList<QZipReader::FileInfo> files = reader.fileInfoList();
+    QCOMPARE(files.size(), 3);
+    QCOMPARE(files.at(1).filePath, QString("file"));
+    QCOMPARE(files.at(1).size, size);
+    QCOMPARE(reader.fileData("before"), QByteArray("first file"));
+    QCOMPARE(reader.fileData("file"), contents);
+    QCOMPARE(reader.fileData("after"), QByteArray("last file"));
+}
+
+void tst_QZip::threadPool()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    QCOMPARE(writer.threadPool(), nullptr);
+    writer.setThreadPool(&pool);
+    QCOMPARE(writer.threadPool(), &pool);
+
+    QStringList names;
+    QList<QByteArray> contents;
+    for (int i = 0; i < 20; ++i) {
+        names << QString("file%1").arg(i);
+        contents << testContents(1000 * (i + 1), i);
+        writer.addFile(names.last(), contents.last());
+        if (i == 10)
+            writer.addDirectory("dir");
+    }
+    writer.close();
+
+    QBuffer buffer2(&buffer.buffer());
+    QZipReader reader(&buffer2);
+    const QList<QZipReader::FileInfo> files = reader.fileInfoList();
+    QCOMPARE(files.size(), 21);
+    QCOMPARE(files.at(11).filePath, QString("dir"));
+    QVERIFY(files.at(11).isDir);
+    for (int i = 0; i < 20; ++i) {
+        QCOMPARE(files.at(i < 11 ? i : i + 1).filePath, names.at(i));
+        QCOMPARE(reader.fileData(names.at(i)), contents.at(i));
+    }
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
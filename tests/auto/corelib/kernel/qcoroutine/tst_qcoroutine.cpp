@@ -0,0 +1,332 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/qcoroutine.h>
+
+#include <QTest>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+
+using namespace std::chrono_literals;
+
+class tst_QCoroutine : public QObject
+{
+    Q_OBJECT
+private slots:
+    void awaitFinishedFuture();
+    void awaitFutureFromOtherThread();
+    void awaitVoidFuture();
+    void resumesInAwaitingThread();
+    void nestedCoroutines();
+    void exceptionIsPropagated();
+    void sleepFor();
+    void timerTimeout();
+    void readyRead();
+    void readyReadOnClose();
+    void awaitedObjectDestroyed();
+};
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+static QFuture<int> addOne(QFuture<int> future)
+{
+    const int value = co_await future;
+    co_return value + 1;
+}
+
+static QFuture<QThread *> awaitAndReportThread(QFuture<void> future)
+{
+    co_await future;
+    co_return QThread::currentThread();
+}
+
+static QFuture<int> sum(QList<QFuture<int>> futures)
+{
+    int total = 0;
+    for (const QFuture<int> &future : futures)
+        total += co_await addOne(future);
+    co_return total;
+}
+
+#ifndef QT_NO_EXCEPTIONS
+static QFuture<void> throwAfter(QFuture<void> future)
+{
+    co_await future;
+    throw std::runtime_error("oops");
+}
+#endif
+
+static QFuture<qint64> sleepAndMeasure(std::chrono::milliseconds duration)
+{
+    QElapsedTimer timer;
+    timer.start();
+    co_await QtCoroutine::sleepFor(duration);
+    co_return timer.elapsed();
+}
+
+static QFuture<int> countTimeouts(QTimer *timer, int count)
+{
+    for (int i = 0; i < count; ++i)
+        co_await QtCoroutine::timeout(timer);
+    co_return count;
+}
+
+static QFuture<bool> awaitTimeout(QTimer *timer)
+{
+    co_return co_await QtCoroutine::timeout(timer);
+}
+
+static QFuture<qint64> awaitReadyRead(QIODevice *device)
+{
+    co_return co_await QtCoroutine::readyRead(device);
+}
+
+static QFuture<QByteArray> readAll(QIODevice *device)
+{
+    QByteArray data;
+    while (co_await QtCoroutine::readyRead(device) > 0)
+        data += device->readAll();
+    co_return data;
+}
+
+class SequentialDevice : public QIODevice
+{
+public:
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return buffer.size() + QIODevice::bytesAvailable(); }
+
+    void append(const QByteArray &data)
+    {
+        buffer += data;
+        emit readyRead();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 size = qMin(maxSize, qint64(buffer.size()));
+        memcpy(data, buffer.constData(), size);
+        buffer.remove(0, size);
+        return size;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray buffer;
+};
+
+void tst_QCoroutine::awaitFinishedFuture()
+{
+    QFuture<int> future = addOne(QtFuture::makeReadyValueFuture(41));
+    // nothing to wait for, the coroutine ran to completion right away
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), 42);
+}
+
+void tst_QCoroutine::awaitFutureFromOtherThread()
+{
+    QPromise<int> promise;
+    promise.start();
+    QFuture<int> future = addOne(promise.future());
+    QVERIFY(!future.isFinished());
+
+    std::unique_ptr<QThread> thread(QThread::create([&promise] {
+        promise.addResult(1);
+        promise.finish();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    // resuming requires the event loop of this thread
+    QVERIFY(!future.isFinished());
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), 2);
+}
+
+void tst_QCoroutine::awaitVoidFuture()
+{
+    QPromise<void> promise;
+    promise.start();
+    QFuture<QThread *> future = awaitAndReportThread(promise.future());
+    QVERIFY(!future.isFinished());
+
+    promise.finish();
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), QThread::currentThread());
+}
+
+void tst_QCoroutine::resumesInAwaitingThread()
+{
+    QThread thread;
+    thread.start();
+    QObject context;
+    context.moveToThread(&thread);
+
+    QPromise<void> promise;
+    promise.start();
+    QFuture<QThread *> future;
+    QMetaObject::invokeMethod(&context, [&] {
+        future = awaitAndReportThread(promise.future());
+    }, Qt::BlockingQueuedConnection);
+    QVERIFY(!future.isFinished());
+
+    promise.finish();
+    future.waitForFinished();
+    QCOMPARE(future.result(), &thread);
+
+    thread.quit();
+    QVERIFY(thread.wait());
+}
+
+void tst_QCoroutine::nestedCoroutines()
+{
+    QPromise<int> first;
+    first.start();
+    QPromise<int> second;
+    second.start();
+    QFuture<int> total = sum({ first.future(), second.future(),
+                               QtFuture::makeReadyValueFuture(3) });
+    QFuture<int> doubled = total.then([](int value) { return value * 2; });
+
+    second.addResult(2);
+    second.finish();
+    QTest::qWait(10);
+    QVERIFY(!total.isFinished());
+
+    first.addResult(1);
+    first.finish();
+    QTRY_VERIFY(doubled.isFinished());
+    QCOMPARE(total.result(), 2 + 3 + 4);
+    QCOMPARE(doubled.result(), 18);
+}
+
+void tst_QCoroutine::exceptionIsPropagated()
+{
+#ifdef QT_NO_EXCEPTIONS
+    QSKIP("Exceptions are disabled");
+#else
+    QPromise<void> promise;
+    promise.start();
+    QFuture<void> future = throwAfter(promise.future());
+    promise.finish();
+    QTRY_VERIFY(future.isFinished());
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, future.waitForFinished());
+
+    QPromise<int> failing;
+    failing.start();
+    QFuture<int> result = addOne(failing.future());
+    failing.setException(std::make_exception_ptr(std::logic_error("failed")));
+    failing.finish();
+    QTRY_VERIFY(result.isFinished());
+    QVERIFY_THROWS_EXCEPTION(std::logic_error, result.waitForFinished());
+#endif
+}
+
+void tst_QCoroutine::sleepFor()
+{
+    QFuture<qint64> elapsed = sleepAndMeasure(50ms);
+    QVERIFY(!elapsed.isFinished());
+    QTRY_VERIFY(elapsed.isFinished());
+    QCOMPARE_GE(elapsed.result(), 50);
+
+    QVERIFY(sleepAndMeasure(0ms).isFinished());
+}
+
+void tst_QCoroutine::timerTimeout()
+{
+    QTimer timer;
+    timer.setInterval(10ms);
+    timer.start();
+    QFuture<int> future = countTimeouts(&timer, 3);
+    QVERIFY(!future.isFinished());
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), 3);
+}
+
+void tst_QCoroutine::readyRead()
+{
+    SequentialDevice device;
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QFuture<QByteArray> future = readAll(&device);
+
+    device.append("Hello, ");
+    // the coroutine is resumed by the event loop, not from within readyRead()
+    QCOMPARE(device.bytesAvailable(), qint64(7));
+    QTRY_COMPARE(device.bytesAvailable(), qint64(0));
+    device.append("World");
+    QTRY_COMPARE(device.bytesAvailable(), qint64(0));
+    QVERIFY(!future.isFinished());
+
+    device.close();
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), "Hello, World");
+}
+
+void tst_QCoroutine::readyReadOnClose()
+{
+    SequentialDevice device;
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    {
+        QFuture<QByteArray> future = readAll(&device);
+        device.close();
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result().isEmpty());
+    }
+
+    // random-access devices never suspend
+    QBuffer buffer;
+    buffer.setData("data");
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QFuture<QByteArray> future = readAll(&buffer);
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), "data");
+}
+
+void tst_QCoroutine::awaitedObjectDestroyed()
+{
+    auto timer = std::make_unique<QTimer>();
+    timer->start(10ms);
+    QFuture<bool> timedOut = awaitTimeout(timer.get());
+    QTRY_VERIFY(timedOut.isFinished());
+    QVERIFY(timedOut.result());
+
+    // the coroutines are resumed, rather than left suspended forever
+    timer->start(1h);
+    timedOut = awaitTimeout(timer.get());
+    QVERIFY(!timedOut.isFinished());
+    timer.reset();
+    QTRY_VERIFY(timedOut.isFinished());
+    QVERIFY(!timedOut.result());
+    QVERIFY(!awaitTimeout(nullptr).result());
+
+    auto device = std::make_unique<SequentialDevice>();
+    QVERIFY(device->open(QIODevice::ReadOnly));
+    QFuture<qint64> available = awaitReadyRead(device.get());
+    QVERIFY(!available.isFinished());
+    device.reset();
+    QTRY_VERIFY(available.isFinished());
+    QCOMPARE(available.result(), qint64(-1));
+    QCOMPARE(awaitReadyRead(nullptr).result(), qint64(-1));
+}
+
+#else
+
+void tst_QCoroutine::awaitFinishedFuture() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::awaitFutureFromOtherThread() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::awaitVoidFuture() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::resumesInAwaitingThread() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::nestedCoroutines() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::exceptionIsPropagated() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::sleepFor() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::timerTimeout() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::readyRead() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::readyReadOnClose() { QSKIP("This test requires C++20 coroutines"); }
+void tst_QCoroutine::awaitedObjectDestroyed() { QSKIP("This test requires C++20 coroutines"); }
+
+#endif
+
+QTEST_MAIN(tst_QCoroutine)
+#include "tst_qcoroutine.moc"
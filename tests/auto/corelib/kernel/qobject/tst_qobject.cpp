@@ -35,7 +35,9 @@
 #include <private/qobject_p.h>
 #endif
 
+#include <atomic>
 #include <functional>
+#include <memory>
 
 #include <math.h>
 
@@ -70,6 +72,7 @@ private slots:
     void thread();
     void thread0();
     void moveToThread();
+    void deleteReceiverWhileOtherThreadsPost();
     void senderTest();
     void declareInterface();
     void qpointerResetBeforeDestroyedSignal();
@@ -87,6 +90,7 @@ private slots:
     void installEventFilterOrder();
     void deleteSelfInSlot();
     void disconnectSelfInSlotAndDeleteAfterEmit();
+    void modifyConnectionsDuringEmission();
     void dumpObjectInfo();
     void dumpObjectTree();
     void connectToSender();
@@ -2006,6 +2010,53 @@ void tst_QObject::moveToThread()
     }
 }
 
+void tst_QObject::deleteReceiverWhileOtherThreadsPost()
+{
+    // Queued signals to objects in this thread are pushed onto the post
+    // event inbox of this thread, which a thread posting an event to this
+    // thread drains. The receivers are deleted while both happen.
+    SenderObject sender;
+    QObject target;
+    std::atomic<bool> stop = false;
+    std::atomic<int> running = 0;
+
+    std::unique_ptr<QThread> emitter(QThread::create([&] {
+        ++running;
+        while (!stop.load(std::memory_order_relaxed))
+            sender.emitSignal1();
+    }));
+    std::unique_ptr<QThread> poster(QThread::create([&] {
+        ++running;
+        while (!stop.load(std::memory_order_relaxed)) {
+            QCoreApplication::postEvent(&target, new QEvent(QEvent::User));
+            QThread::yieldCurrentThread();
+        }
+    }));
+    emitter->start();
+    poster->start();
+    while (running.load() != 2)
+        QThread::yieldCurrentThread();
+
+    int calls = 0;
+    const QDeadlineTimer deadline(500);
+    for (int i = 0; !deadline.hasExpired(); ++i) {
+        auto receiver = std::make_unique<QObject>();
+        connect(&sender, &SenderObject::signal1, receiver.get(), [&calls] { ++calls; },
+                Qt::QueuedConnection);
+        if (i % 2)
+            QCoreApplication::sendPostedEvents(receiver.get());
+        receiver.reset();
+        if (i % 100 == 0)
+            QCoreApplication::removePostedEvents(&target);
+    }
+
+    stop = true;
+    QVERIFY(emitter->wait());
+    QVERIFY(poster->wait());
+    QCoreApplication::removePostedEvents(&target);
+    QCoreApplication::sendPostedEvents();
+}
+
 
 void tst_QObject::property()
 {
@@ -3610,6 +3661,40 @@ void tst_QObject::disconnectSelfInSlotAndDeleteAfterEmit()
     }
 }
 
+void tst_QObject::modifyConnectionsDuringEmission()
+{
+    // activate() walks a snapshot of the connection list once there are several
+    // receivers; changes made during an emission must still behave as with the list
+    SenderObject sender;
+    QObject context;
+    QList<int> calls;
+    QMetaObject::Connection toDisconnect;
+
+    for (int i = 0; i < 4; ++i) {
+        QMetaObject::Connection c = connect(&sender, &SenderObject::signal1, &context, [&, i] {
+            calls << i;
+            if (i == 1) {
+                QObject::disconnect(toDisconnect);
+                connect(&sender, &SenderObject::signal1, &context, [&] { calls << 10; });
+            }
+        });
+        if (i == 2)
+            toDisconnect = c;
+    }
+
+    sender.emitSignal1();
+    QCOMPARE(calls, QList<int>({ 0, 1, 3 }));
+
+    calls.clear();
+    sender.emitSignal1();
+    QCOMPARE(calls, QList<int>({ 0, 1, 3, 10 }));
+
+    calls.clear();
+    QVERIFY(QObject::disconnect(&sender, nullptr, &context, nullptr));
+    sender.emitSignal1();
+    QVERIFY(calls.isEmpty());
+}
+
 void tst_QObject::dumpObjectInfo()
 {
     QObject a, b;
@@ -24,6 +24,13 @@
 #  undef min
 #endif // Q_CC_MSVC
 
+#ifdef ENABLE_EPOLL
+static bool epollEnabled = []() {
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    return true;
+}();
+#endif
+
 using namespace std::chrono_literals;
 
 class tst_QSocketNotifier : public QObject
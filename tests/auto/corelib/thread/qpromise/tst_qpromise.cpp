@@ -5,6 +5,7 @@
 
 #define QPROMISE_TEST
 
+#include <QSignalSpy>
 #include <QTest>
 #include <qfuture.h>
 #include <qfuturewatcher.h>
@@ -15,6 +16,7 @@
 #include <chrono>
 
 using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
 
 class tst_QPromise : public QObject
 {
@@ -26,6 +28,7 @@ private slots:
     void addResult();
     void addResultWithBracedInitializer();
     void addResultOutOfOrder();
+    void addResultsByMove();
 #ifndef QT_NO_EXCEPTIONS
     void setException();
 #endif
@@ -35,6 +38,7 @@ private slots:
     // complicated test cases
     void addInThread();
     void addInThreadMoveOnlyObject();  // separate test case - QTBUG-84736
+    void addManyInThreadWhileReading();
     void reportFromMultipleThreads();
     void reportFromMultipleThreadsByMovedPromise();
     void doNotCancelWhenFinished();
@@ -221,6 +225,35 @@ void tst_QPromise::addResultWithBracedInitializer() // QTBUG-111826
     }
 }
 
+void tst_QPromise::addResultsByMove()
+{
+    QPromise<QString> promise;
+    auto f = promise.future();
+    QFutureWatcher<QString> watcher;
+    QSignalSpy readySpy(&watcher, &QFutureWatcher<QString>::resultsReadyAt);
+    watcher.setFuture(f);
+    promise.start();
+
+    QList<QString> results = { u"one"_s, u"two"_s, u"three"_s };
+    QVERIFY(promise.addResults(std::move(results)));
+    QVERIFY(results.isEmpty());
+    QCOMPARE(f.resultCount(), 3);
+    QCOMPARE(f.resultAt(2), u"three"_s);
+
+    // single results are appended behind the batch
+    QVERIFY(promise.addResult(u"four"_s));
+    QVERIFY(!promise.addResults(QList<QString>()));
+
+    promise.finish();
+    QCOMPARE(f.results(), QStringList({ u"one"_s, u"two"_s, u"three"_s, u"four"_s }));
+    QVERIFY(!promise.addResults(QList<QString>{ u"five"_s }));
+
+    // the watcher is notified once for the whole batch
+    QTRY_COMPARE(readySpy.size(), 2);
+    QCOMPARE(readySpy.at(0), QVariantList({ 0, 3 }));
+    QCOMPARE(readySpy.at(1), QVariantList({ 3, 4 }));
+}
+
 void tst_QPromise::addResultOutOfOrder()
 {
     // Compare results available in QFuture to expected results
@@ -380,6 +413,30 @@ void tst_QPromise::addInThreadMoveOnlyObject()
 #endif
 }
 
+void tst_QPromise::addManyInThreadWhileReading()
+{
+#if QT_CONFIG(cxx11_future)
+    constexpr int Count = 100000;
+    QPromise<QString> promise;
+    promise.start();
+    auto f = promise.future();
+
+    ThreadWrapper thr([p = std::move(promise)] () mutable {
+        for (int i = 0; i < Count; ++i)
+            p.emplaceResult(QString::number(i));
+        p.finish();
+    });
+
+    // results that were read must stay valid while more are added
+    const QString *second = &*std::next(f.constBegin());
+    for (int i = 0; i < Count; ++i)
+        QCOMPARE(f.resultAt(i), QString::number(i));
+    QCOMPARE(*second, u"1"_s);
+    f.waitForFinished();
+    QCOMPARE(f.resultCount(), Count);
+#endif
+}
+
 void tst_QPromise::reportFromMultipleThreads()
 {
 #if QT_CONFIG(cxx11_future)
@@ -26,6 +26,9 @@
 
 #include <stdio.h>
 
+#include <memory>
+#include <vector>
+
 using namespace std::chrono_literals;
 
 class tst_QReadWriteLock : public QObject
@@ -70,6 +73,12 @@ private slots:
     // recursive locking tests
     void recursiveReadLock();
     void recursiveWriteLock();
+
+    // distributed reader count tests
+    void distributedLockUnlock();
+    void distributedWriterPreference();
+    void distributedReadersWritersLoop();
+    void distributedWaitCondition();
 };
 
 void tst_QReadWriteLock::constructDestruct()
@@ -1068,6 +1077,143 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+void tst_QReadWriteLock::distributedLockUnlock()
+{
+    QReadWriteLock rwlock(QReadWriteLock::NonRecursive, QReadWriteLock::DistributedReaderCount);
+    QVERIFY(rwlock.tryLockForRead());
+    QVERIFY(rwlock.tryLockForRead());
+    QVERIFY(!rwlock.tryLockForWrite());
+    QVERIFY(!rwlock.tryLockForWrite(10ms));
+    rwlock.unlock();
+    QVERIFY(!rwlock.tryLockForWrite());
+    rwlock.unlock();
+
+    QVERIFY(rwlock.tryLockForWrite());
+    QVERIFY(!rwlock.tryLockForRead());
+    QVERIFY(!rwlock.tryLockForWrite(10ms));
+    rwlock.unlock();
+
+    // the lock is usable after the timeouts
+    for (int i = 0; i < 10000; ++i) {
+        rwlock.lockForRead();
+        rwlock.unlock();
+        rwlock.lockForWrite();
+        rwlock.unlock();
+    }
+
+    // readers may unlock from another thread
+    rwlock.lockForRead();
+    QScopedPointer<QThread> thread(QThread::create([&rwlock] { rwlock.unlock(); }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(rwlock.tryLockForWrite());
+    rwlock.unlock();
+
+    // the reader count mode doesn't apply to recursive locks
+    QReadWriteLock recursive(QReadWriteLock::Recursive, QReadWriteLock::DistributedReaderCount);
+    recursive.lockForWrite();
+    QVERIFY(recursive.tryLockForWrite());
+    recursive.unlock();
+    recursive.unlock();
+}
+
+void tst_QReadWriteLock::distributedWriterPreference()
+{
+    QReadWriteLock rwlock(QReadWriteLock::NonRecursive, QReadWriteLock::DistributedReaderCount);
+    QSemaphore writerLocked;
+    rwlock.lockForRead();
+
+    QScopedPointer<QThread> writer(QThread::create([&] {
+        rwlock.lockForWrite();
+        writerLocked.release();
+        rwlock.unlock();
+    }));
+    writer->start();
+
+    // once the writer waits, new readers have to wait for it
+    const auto tryRead = [&rwlock] {
+        if (!rwlock.tryLockForRead())
+            return false;
+        rwlock.unlock();
+        return true;
+    };
+    QTRY_VERIFY(!tryRead());
+    QVERIFY(!writerLocked.tryAcquire(1, 10ms));
+
+    rwlock.unlock();
+    QVERIFY(writerLocked.tryAcquire(1, 10s));
+    QVERIFY(writer->wait());
+    QVERIFY(rwlock.tryLockForRead());
+    rwlock.unlock();
+}
+
+void tst_QReadWriteLock::distributedReadersWritersLoop()
+{
+    QReadWriteLock rwlock(QReadWriteLock::NonRecursive, QReadWriteLock::DistributedReaderCount);
+    QAtomicInt readers;
+    QAtomicInt writers;
+    QAtomicInt failures;
+    constexpr int Iterations = 20000;
+
+    const auto read = [&] {
+        for (int i = 0; i < Iterations; ++i) {
+            if (i % 2)
+                rwlock.lockForRead();
+            else if (!rwlock.tryLockForRead(1s))
+                continue;
+            readers.ref();
+            if (writers.loadRelaxed() != 0)
+                failures.ref();
+            readers.deref();
+            rwlock.unlock();
+        }
+    };
+    const auto write = [&] {
+        for (int i = 0; i < Iterations / 10; ++i) {
+            if (i % 2)
+                rwlock.lockForWrite();
+            else if (!rwlock.tryLockForWrite(1ms))
+                continue;
+            if (!writers.ref() || writers.loadRelaxed() != 1 || readers.loadRelaxed() != 0)
+                failures.ref();
+            writers.deref();
+            rwlock.unlock();
+        }
+    };
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < 6; ++i)
+        threads.emplace_back(QThread::create(read));
+    for (int i = 0; i < 2; ++i)
+        threads.emplace_back(QThread::create(write));
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
+void tst_QReadWriteLock::distributedWaitCondition()
+{
+    QReadWriteLock rwlock(QReadWriteLock::NonRecursive, QReadWriteLock::DistributedReaderCount);
+    QWaitCondition condition;
+    bool ready = false;
+
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QWriteLocker locker(&rwlock);
+        ready = true;
+        condition.wakeAll();
+    }));
+
+    {
+        QReadLocker locker(&rwlock);
+        thread->start();
+        while (!ready)
+            QVERIFY(condition.wait(&rwlock, QDeadlineTimer(10s)));
+    }
+    QVERIFY(thread->wait());
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
@@ -28,6 +28,7 @@ private slots:
     void iterators();
     void addResult();
     void addResults();
+    void addResultsInOrder();
     void resultIndex();
     void resultAt();
     void contains();
@@ -182,6 +183,47 @@ void tst_QtConcurrentResultStore::addResults()
     QCOMPARE(store.count(), countBefore + vec1.size());
 }
 
+void tst_QtConcurrentResultStore::addResultsInOrder()
+{
+    QtPrivate::ResultStoreBase store;
+    IntResultsCleaner cleanGuard(store);
+
+    QCOMPARE(store.emplaceResult<int>(-1, 0), 0);
+    QCOMPARE(store.addResult(-1, &int1), 1);
+    const int *second = store.resultAt(1).pointer<int>();
+
+    for (int i = 2; i < 10000; ++i) {
+        if (i % 2)
+            QCOMPARE(store.emplaceResult<int>(-1, i), i);
+        else
+            QCOMPARE(store.addResult(i, &i), i);
+    }
+    QCOMPARE(store.count(), 10000);
+    // appending doesn't move the results that are already stored
+    QCOMPARE(store.resultAt(1).pointer<int>(), second);
+
+    int batches = 0;
+    for (ResultIteratorBase it = store.begin(); it != store.end(); it.batchedAdvance())
+        ++batches;
+    QCOMPARE_LT(batches, 100);
+
+    int expected = 0;
+    for (ResultIteratorBase it = store.begin(); it != store.end(); ++it) {
+        QCOMPARE(it.resultIndex(), expected);
+        QCOMPARE(it.value<int>(), expected);
+        ++expected;
+    }
+
+    // a result can't be added twice, nor a list the caller still shares
+    QCOMPARE(store.emplaceResult<int>(9999, -1), -1);
+    QList<int> shared = vec0;
+    shared.reserve(10);
+    QCOMPARE(store.addResults(-1, &shared), 10000);
+    QCOMPARE(store.addResult(-1, &int2), 10002);
+    QCOMPARE(shared, vec0);
+    QCOMPARE(store.resultAt(10002).value<int>(), int2);
+}
+
 void tst_QtConcurrentResultStore::resultIndex()
 {
     QtPrivate::ResultStoreBase store;
@@ -88,6 +88,9 @@ private slots:
     void waitForDoneAfterTake();
     void threadReuse();
     void nullFunctions();
+    void workStealing();
+    void workStealingWakesThief();
+    void workStealingTakeAndClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1488,5 +1491,87 @@ void tst_QThreadPool::nullFunctions()
     }
 }
 
+void tst_QThreadPool::workStealing()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(4);
+    QVERIFY(!manager.isWorkStealingEnabled());
+    manager.setWorkStealingEnabled(true);
+    QVERIFY(manager.isWorkStealingEnabled());
+
+    constexpr int Fanout = 100;
+    QAtomicInt count;
+    for (int i = 0; i < 4; ++i) {
+        manager.start([&] {
+            for (int j = 0; j < Fanout; ++j) {
+                manager.start([&] {
+                    for (int k = 0; k < Fanout; ++k)
+                        manager.start([&] { count.ref(); });
+                });
+            }
+        });
+    }
+
+    WAIT_FOR_DONE(manager);
+    QCOMPARE(count.loadRelaxed(), 4 * Fanout * Fanout);
+}
+
+void tst_QThreadPool::workStealingWakesThief()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(2);
+    manager.setWorkStealingEnabled(true);
+
+    // both tasks end up on the first thread's queue, but can only finish if
+    // they run concurrently
+    QSemaphore first, second;
+    manager.start([&] {
+        manager.start([&] {
+            first.release();
+            QVERIFY(second.tryAcquire(1, 60 * 1000));
+        });
+        manager.start([&] {
+            second.release();
+            QVERIFY(first.tryAcquire(1, 60 * 1000));
+        });
+    });
+
+    WAIT_FOR_DONE(manager);
+}
+
+void tst_QThreadPool::workStealingTakeAndClear()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(1);
+    manager.setWorkStealingEnabled(true);
+
+    class CountingRunnable : public QRunnable
+    {
+    public:
+        explicit CountingRunnable(QAtomicInt &runs) : runs(runs) { setAutoDelete(false); }
+        void run() override { runs.ref(); }
+        QAtomicInt &runs;
+    };
+
+    QAtomicInt runs;
+    CountingRunnable taken(runs);
+    CountingRunnable cleared(runs);
+    QSemaphore queued, done;
+    manager.start([&] {
+        manager.start(&taken);
+        manager.start(&cleared);
+        QVERIFY(manager.tryTake(&taken));
+        queued.release();
+        QVERIFY(done.tryAcquire(1, 60 * 1000));
+    });
+
+    QVERIFY(queued.tryAcquire(1, 60 * 1000));
+    manager.clear();
+    done.release();
+
+    WAIT_FOR_DONE(manager);
+    QCOMPARE(runs.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
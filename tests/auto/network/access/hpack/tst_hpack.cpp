@@ -29,6 +29,7 @@ private Q_SLOTS:
     void bitstreamWrite();
     void bitstreamReadWrite();
     void bitstreamCompression();
+    void bitstreamCompressionAllBytes();
     void bitstreamErrors();
 
     void lookupTableConstructor();
@@ -46,6 +47,9 @@ private Q_SLOTS:
     void hpackDecodeResponse_data();
     void hpackDecodeResponse();
 
+    void hpackHeaderBlockCaching_data();
+    void hpackHeaderBlockCaching();
+
     // TODO: more-more-more tests needed!
 
 private:
@@ -293,6 +297,27 @@ void tst_Hpack::bitstreamCompression()
     }
 }
 
+void tst_Hpack::bitstreamCompressionAllBytes()
+{
+    QByteArray data;
+    for (int i = 0; i < 256; ++i)
+        data.append(char(i));
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    out.write(data, true);
+    out.write(42u);
+
+    BitIStream in(out.begin(), out.end());
+    QByteArray decoded;
+    QVERIFY(in.read(&decoded));
+    QCOMPARE(decoded, data);
+    quint32 value = 0;
+    QVERIFY(in.read(&value));
+    QCOMPARE(value, 42u);
+    QVERIFY(!in.hasMoreBits());
+}
+
 void tst_Hpack::bitstreamErrors()
 {
     {
@@ -800,6 +825,62 @@ void tst_Hpack::hpackDecodeResponse()
     }
 }
 
+void tst_Hpack::hpackHeaderBlockCaching_data()
+{
+    hpackEncodeRequest_data();
+}
+
+void tst_Hpack::hpackHeaderBlockCaching()
+{
+    QFETCH(bool, compression);
+
+    Encoder encoder(FieldLookupTable::DefaultSize, compression);
+    encoder.setHeaderBlockCachingEnabled(true);
+    Decoder decoder(FieldLookupTable::DefaultSize);
+
+    HttpHeader header = {{":method", "GET"},
+                         {":scheme", "https"},
+                         {":authority", "www.example.com"},
+                         {":path", "/"},
+                         {"user-agent", "tst_hpack"},
+                         {"accept", "*/*"}};
+    quint64 firstSize = 0;
+    quint64 secondSize = 0;
+    quint32 tableSize = 0;
+    for (int i = 0; i < 8; ++i) {
+        // Only the :path changes, and it is not added to the table:
+        header[3].value = "/resource/" + QByteArray::number(i);
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        QVERIFY(encoder.encodeRequest(out, header));
+
+        BitIStream in(out.begin(), out.end());
+        QVERIFY(decoder.decodeHeaderFields(in));
+        QVERIFY(decoder.decodedHeader() == header);
+
+        if (i == 0) {
+            firstSize = out.byteLength();
+            tableSize = encoder.dynamicTableSize();
+        } else if (i == 1) {
+            secondSize = out.byteLength();
+            QCOMPARE_LT(secondSize, firstSize);
+        } else {
+            QCOMPARE(out.byteLength(), secondSize);
+        }
+        QCOMPARE(encoder.dynamicTableSize(), tableSize);
+        QCOMPARE(decoder.dynamicTableSize(), tableSize);
+    }
+
+    // A different header must not be served from the cache:
+    header[4].value = "another-agent";
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    QVERIFY(encoder.encodeRequest(out, header));
+    BitIStream in(out.begin(), out.end());
+    QVERIFY(decoder.decodeHeaderFields(in));
+    QVERIFY(decoder.decodedHeader() == header);
+}
+
 QTEST_MAIN(tst_Hpack)
 
 #include "tst_hpack.moc"
@@ -31,6 +31,9 @@ private slots:
     void connectToServer();
     void WINDOW_UPDATE();
     void testCONTINUATIONFrame();
+    void refuseStreamsAboveLimit();
+    void receiveWindowAutoTuning();
+    void headersOnDeletedResetStream();
 
 private:
     enum PeerType { Client, Server };
@@ -205,7 +208,9 @@ void tst_QHttp2Connection::testSETTINGSFrame()
     constexpr bool ServerPushEnabled = false;
     constexpr quint32 StreamReceiveWindowSize = 50000;
     constexpr quint32 SessionReceiveWindowSize = 50001;
+    constexpr quint32 MaxConcurrentStreams = 1000;
     config.setMaxFrameSize(MaxFrameSize);
+    config.setMaxConcurrentStreams(MaxConcurrentStreams);
     config.setServerPushEnabled(ServerPushEnabled);
     config.setStreamReceiveWindowSize(StreamReceiveWindowSize);
     config.setSessionReceiveWindowSize(SessionReceiveWindowSize);
@@ -240,9 +245,9 @@ void tst_QHttp2Connection::testSETTINGSFrame()
     ExpectedSetting expectedSettings[]{
         // { Http2::Settings::HEADER_TABLE_SIZE_ID, HPack::FieldLookupTable::DefaultSize },
         { Http2::Settings::ENABLE_PUSH_ID, ServerPushEnabled ? 1 : 0 },
-        // { Http2::Settings::MAX_CONCURRENT_STREAMS_ID, Http2::maxConcurrentStreams },
         { Http2::Settings::INITIAL_WINDOW_SIZE_ID, StreamReceiveWindowSize },
         { Http2::Settings::MAX_FRAME_SIZE_ID, MaxFrameSize },
+        { Http2::Settings::MAX_CONCURRENT_STREAMS_ID, MaxConcurrentStreams },
         // { Http2::Settings::MAX_HEADER_LIST_SIZE_ID, ??? },
     };
 
@@ -840,6 +845,150 @@ void tst_QHttp2Connection::testCONTINUATIONFrame()
     }
 }
 
+void tst_QHttp2Connection::refuseStreamsAboveLimit()
+{
+    auto [client, server] = makeFakeConnectedSockets();
+    auto connection = makeHttp2Connection(client.get(), {}, Client);
+
+    QHttp2Configuration config;
+    config.setMaxConcurrentStreams(2);
+    auto serverConnection = makeHttp2Connection(server.get(), config, Server);
+
+    QVERIFY(waitForSettingsExchange(connection, serverConnection));
+    QCOMPARE(connection->maxConcurrentStreams(), 2u);
+    // Pretend the client ignores the limit the server advertised
+    connection->m_maxConcurrentStreams = 3;
+
+    QSignalSpy newIncomingStreamSpy{ serverConnection, &QHttp2Connection::newIncomingStream };
+
+    QHttp2Stream *clientStreams[3];
+    for (QHttp2Stream *&clientStream : clientStreams) {
+        clientStream = connection->createStream().unwrap();
+        QVERIFY(clientStream);
+    }
+    QSignalSpy rstSpy{ clientStreams[2], &QHttp2Stream::rstFrameRecived };
+    for (QHttp2Stream *clientStream : clientStreams)
+        QVERIFY(clientStream->sendHEADERS(getRequiredHeaders(), false));
+
+    QVERIFY(rstSpy.wait());
+    QCOMPARE(rstSpy.front().front().toUInt(), quint32(Http2::REFUSE_STREAM));
+    QCOMPARE(clientStreams[2]->state(), QHttp2Stream::State::Closed);
+    QCOMPARE(newIncomingStreamSpy.count(), 2);
+    QCOMPARE(serverConnection->numActiveRemoteStreams(), 2);
+    QVERIFY(!serverConnection->getStream(clientStreams[2]->streamID()));
+
+    // DATA the client sent before seeing the RST_STREAM is not an error
+    QSignalSpy closedServerSpy{ serverConnection, &QHttp2Connection::connectionClosed };
+    clientStreams[2]->setState(QHttp2Stream::State::Open);
+    clientStreams[2]->sendDATA("Hello World"_ba, true);
+    QCOMPARE(clientStreams[2]->state(), QHttp2Stream::State::HalfClosedLocal);
+
+    // Closing one of the streams makes room for a new one, and the HPACK
+    // context is still in sync after the refused HEADERS
+    auto *serverStream = newIncomingStreamSpy.front().front().value<QHttp2Stream *>();
+    QSignalSpy rstServerSpy{ serverStream, &QHttp2Stream::rstFrameRecived };
+    clientStreams[0]->sendRST_STREAM(Http2::CANCEL);
+    QVERIFY(rstServerSpy.wait());
+    QCOMPARE(serverConnection->numActiveRemoteStreams(), 1);
+    delete serverStream;
+
+    QHttp2Stream *clientStream = connection->createStream().unwrap();
+    QVERIFY(clientStream);
+    QVERIFY(clientStream->sendHEADERS(getRequiredHeaders(), true));
+    QVERIFY(newIncomingStreamSpy.wait());
+    QCOMPARE(newIncomingStreamSpy.count(), 3);
+    serverStream = newIncomingStreamSpy.back().front().value<QHttp2Stream *>();
+    QCOMPARE(serverStream->streamID(), clientStream->streamID());
+    QCOMPARE(serverStream->receivedHeaders(), getRequiredHeaders());
+    QCOMPARE(serverConnection->numActiveRemoteStreams(), 2);
+    QCOMPARE(closedServerSpy.count(), 0);
+}
+
+void tst_QHttp2Connection::receiveWindowAutoTuning()
+{
+    auto [client, server] = makeFakeConnectedSockets();
+    auto connection = makeHttp2Connection(client.get(), {}, Client);
+    auto serverConnection = makeHttp2Connection(server.get(), {}, Server);
+    QVERIFY(!connection->isReceiveWindowAutoTuningEnabled());
+    connection->setReceiveWindowAutoTuningEnabled(true);
+    QVERIFY(connection->isReceiveWindowAutoTuningEnabled());
+
+    QVERIFY(waitForSettingsExchange(connection, serverConnection));
+    QTRY_VERIFY(connection->roundTripTime() > std::chrono::nanoseconds(0));
+    // Make sure all the window updates happen within two round trips
+    connection->m_roundTripTime = std::chrono::hours(1);
+
+    QSignalSpy newIncomingStreamSpy{ serverConnection, &QHttp2Connection::newIncomingStream };
+    QHttp2Stream *clientStream = connection->createStream().unwrap();
+    QVERIFY(clientStream);
+    QSignalSpy clientDataReceivedSpy{ clientStream, &QHttp2Stream::dataReceived };
+    clientStream->sendHEADERS(getRequiredHeaders(), true);
+    QVERIFY(newIncomingStreamSpy.wait());
+    auto *serverStream = newIncomingStreamSpy.front().front().value<QHttp2Stream *>();
+
+    const QByteArray payload(1024 * 1024, 'a');
+    serverStream->sendHEADERS({ { ":status", "200" } }, false);
+    serverStream->sendDATA(payload, true);
+
+    QTRY_VERIFY(!clientDataReceivedSpy.isEmpty() && clientDataReceivedSpy.back().back().toBool());
+    qsizetype received = 0;
+    for (const QList<QVariant> &emission : std::as_const(clientDataReceivedSpy))
+        received += emission.front().toByteArray().size();
+    QCOMPARE(received, payload.size());
+
+    QCOMPARE_GT(clientStream->m_recvWindowLimit, Http2::defaultSessionWindowSize);
+    QCOMPARE_LE(clientStream->m_recvWindowLimit, QHttp2Connection::maxAutoTunedStreamWindowSize);
+    QCOMPARE_GT(connection->maxSessionReceiveWindowSize, Http2::defaultSessionWindowSize);
+    // The server did not enable autotuning
+    QCOMPARE(serverConnection->maxSessionReceiveWindowSize, Http2::defaultSessionWindowSize);
+}
+
+void tst_QHttp2Connection::headersOnDeletedResetStream()
+{
+    auto [client, server] = makeFakeConnectedSockets();
+    auto connection = makeHttp2Connection(client.get(), {}, Client);
+    auto serverConnection = makeHttp2Connection(server.get(), {}, Server);
+
+    QVERIFY(waitForSettingsExchange(connection, serverConnection));
+
+    QSignalSpy newIncomingStreamSpy{ serverConnection, &QHttp2Connection::newIncomingStream };
+    QHttp2Stream *clientStream = connection->createStream().unwrap();
+    QVERIFY(clientStream);
+    const quint32 streamID = clientStream->streamID();
+    QVERIFY(clientStream->sendHEADERS(getRequiredHeaders(), false));
+    QVERIFY(newIncomingStreamSpy.wait());
+    auto *serverStream = newIncomingStreamSpy.front().front().value<QHttp2Stream *>();
+
+    QSignalSpy rstServerSpy{ serverStream, &QHttp2Stream::rstFrameRecived };
+    clientStream->sendRST_STREAM(Http2::CANCEL);
+    QVERIFY(rstServerSpy.wait());
+
+    // The stream is gone, but its entry stays until the connection purges it
+    delete clientStream;
+    QVERIFY(!connection->getStream(streamID));
+
+    // Send HEADERS as if we didn't receive the RST_STREAM; they have to be
+    // decoded and dropped without closing the connection
+    QSignalSpy closedClientSpy{ connection, &QHttp2Connection::connectionClosed };
+    const HPack::HttpHeader responseHeaders{ { ":status", "200" }, { "x-test", "stale" } };
+    serverStream->setState(QHttp2Stream::State::Open);
+    QVERIFY(serverStream->sendHEADERS(responseHeaders, true));
+
+    // The HPACK context is still in sync for the next stream
+    QSignalSpy secondIncomingStreamSpy{ serverConnection, &QHttp2Connection::newIncomingStream };
+    clientStream = connection->createStream().unwrap();
+    QVERIFY(clientStream);
+    QSignalSpy clientHeadersSpy{ clientStream, &QHttp2Stream::headersReceived };
+    QVERIFY(clientStream->sendHEADERS(getRequiredHeaders(), true));
+    QVERIFY(secondIncomingStreamSpy.wait());
+    serverStream = secondIncomingStreamSpy.front().front().value<QHttp2Stream *>();
+    QVERIFY(serverStream->sendHEADERS(responseHeaders, true));
+
+    QVERIFY(clientHeadersSpy.wait());
+    QCOMPARE(clientStream->receivedHeaders(), responseHeaders);
+    QCOMPARE(closedClientSpy.count(), 0);
+}
+
 QTEST_MAIN(tst_QHttp2Connection)
 
 #include "tst_qhttp2connection.moc"
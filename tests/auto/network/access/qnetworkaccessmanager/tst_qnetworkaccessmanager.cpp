@@ -5,6 +5,8 @@
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 
 #include <QtCore/QDebug>
 
@@ -17,8 +19,39 @@ public:
 
 private slots:
     void alwaysCacheRequest();
+    void connectionPoolConfiguration();
+    void connectionPoolStatistics();
+    void preconnectCount();
 };
 
+namespace {
+// Answers every HTTP/1.1 request with a short response and keeps
+// the connections open.
+class MiniServer : public QTcpServer
+{
+public:
+    MiniServer()
+    {
+        connect(this, &QTcpServer::pendingConnectionAvailable, this, [this] {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                ++connectionCount;
+                connect(socket, &QIODevice::readyRead, socket, [socket] {
+                    QByteArray data = socket->property("data").toByteArray() + socket->readAll();
+                    qsizetype end;
+                    while ((end = data.indexOf("\r\n\r\n")) != -1) {
+                        data.remove(0, end + 4);
+                        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+                    }
+                    socket->setProperty("data", data);
+                });
+            }
+        });
+    }
+
+    int connectionCount = 0;
+};
+} // unnamed namespace
+
 tst_QNetworkAccessManager::tst_QNetworkAccessManager()
 {
 }
@@ -34,5 +67,94 @@ void tst_QNetworkAccessManager::alwaysCacheRequest()
     delete reply;
 }
 
+void tst_QNetworkAccessManager::connectionPoolConfiguration()
+{
+    using namespace std::chrono_literals;
+
+    QNetworkConnectionPoolConfiguration config;
+    QCOMPARE(config.maximumConnectionsPerHost(), 6);
+    QCOMPARE(config.idleTimeout(), 120s);
+    QVERIFY(config.keepAliveProbesEnabled());
+    QCOMPARE(config.preconnectCount(), 1);
+    QVERIFY(!config.lifoReuseEnabled());
+
+    config.setMaximumConnectionsPerHost(0);
+    QCOMPARE(config.maximumConnectionsPerHost(), 6);
+    config.setMaximumConnectionsPerHost(1000);
+    QCOMPARE(config.maximumConnectionsPerHost(), 255);
+    config.setIdleTimeout(-1s);
+    QCOMPARE(config.idleTimeout(), 120s);
+    config.setIdleTimeout(5s);
+    QCOMPARE(config.idleTimeout(), 5s);
+    QVERIFY(config != QNetworkConnectionPoolConfiguration());
+
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.connectionPoolConfiguration(), QNetworkConnectionPoolConfiguration());
+    manager.setConnectionPoolConfiguration(config);
+    QCOMPARE(manager.connectionPoolConfiguration(), config);
+}
+
+void tst_QNetworkAccessManager::connectionPoolStatistics()
+{
+    MiniServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QNetworkConnectionPoolConfiguration config;
+    config.setMaximumConnectionsPerHost(2);
+    config.setLifoReuseEnabled(true);
+    manager.setConnectionPoolConfiguration(config);
+
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+    constexpr int RequestCount = 10;
+    int finished = 0;
+    for (int i = 0; i < RequestCount; ++i) {
+        QNetworkReply *reply = manager.get(QNetworkRequest(url));
+        connect(reply, &QNetworkReply::finished, this, [reply, &finished] {
+            QCOMPARE(reply->error(), QNetworkReply::NoError);
+            QCOMPARE(reply->readAll(), "ok");
+            reply->deleteLater();
+            ++finished;
+        });
+    }
+    QTRY_COMPARE(finished, RequestCount);
+
+    QCOMPARE_LE(server.connectionCount, 2);
+    const QNetworkConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.misses(), 1);
+    QCOMPARE(statistics.hits(), RequestCount - 1);
+    QCOMPARE(statistics.sentRequests(), RequestCount);
+    QVERIFY(statistics.totalWaitTime() > std::chrono::nanoseconds(0));
+}
+
+void tst_QNetworkAccessManager::preconnectCount()
+{
+    MiniServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QNetworkConnectionPoolConfiguration config;
+    config.setPreconnectCount(3);
+    manager.setConnectionPoolConfiguration(config);
+    manager.connectToHost(QStringLiteral("127.0.0.1"), server.serverPort());
+    QTRY_COMPARE(server.connectionCount, 3);
+
+    // preconnecting doesn't count as requests
+    QNetworkConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.misses(), 0);
+    QCOMPARE(statistics.hits(), 0);
+
+    QNetworkReply *reply =
+            manager.get(QNetworkRequest(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort())));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    delete reply;
+    statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.misses(), 0);
+    QCOMPARE(statistics.hits(), 1);
+    QCOMPARE(statistics.sentRequests(), 1);
+    QCOMPARE(server.connectionCount, 3);
+}
+
 QTEST_MAIN(tst_QNetworkAccessManager)
 #include "tst_qnetworkaccessmanager.moc"
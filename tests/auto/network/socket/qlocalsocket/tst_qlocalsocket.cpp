@@ -76,6 +76,9 @@ private slots:
     void skip_data();
     void skip();
 
+    void peekChunk();
+    void writeGathered();
+
     void readBufferOverflow();
 
     void simpleCommandProtocol1();
@@ -860,6 +863,90 @@ void tst_QLocalSocket::skip()
     QCOMPARE(lastChar, expect);
 }
 
+void tst_QLocalSocket::peekChunk()
+{
+    const QString serverName = QLatin1String("tst_localsocket");
+    LocalServer server;
+    QVERIFY2(server.listen(serverName), qUtf8Printable(server.errorString()));
+
+    LocalSocket client;
+    client.connectToServer(serverName);
+    QVERIFY(server.waitForNewConnection());
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+    QCOMPARE(client.state(), QLocalSocket::ConnectedState);
+
+    QByteArray data;
+    for (int i = 0; i < 4000; ++i)
+        data += "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    QCOMPARE(serverSocket->write(data), data.size());
+
+    QByteArray received;
+    while (received.size() < data.size()) {
+        const QByteArrayView chunk = client.peekChunk();
+        if (chunk.isEmpty()) {
+            QVERIFY(serverSocket->bytesToWrite() == 0 || serverSocket->waitForBytesWritten());
+            QVERIFY(client.waitForReadyRead());
+            continue;
+        }
+        received += chunk;
+        QCOMPARE(client.skip(chunk.size()), qint64(chunk.size()));
+    }
+    QCOMPARE(received, data);
+
+    // readAll() hands out what was received
+    const QByteArray message("Hello world!");
+    QCOMPARE(serverSocket->write(message), message.size());
+    QVERIFY(serverSocket->waitForBytesWritten());
+    QVERIFY(client.waitForReadyRead());
+    QCOMPARE(client.peekChunk().toByteArray(), message);
+    QCOMPARE(client.readAll(), message);
+    QVERIFY(client.peekChunk().isEmpty());
+}
+
+void tst_QLocalSocket::writeGathered()
+{
+    const QString serverName = QLatin1String("tst_localsocket");
+    LocalServer server;
+    QVERIFY2(server.listen(serverName), qUtf8Printable(server.errorString()));
+
+    LocalSocket client;
+    client.connectToServer(serverName);
+    QVERIFY(server.waitForNewConnection());
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+    QCOMPARE(client.state(), QLocalSocket::ConnectedState);
+
+    // many blocks, so that the write buffer holds more than one chunk
+    QList<QByteArray> messages;
+    QList<QByteArrayView> blocks;
+    QByteArray expected;
+    for (int i = 0; i < 100; ++i) {
+        messages.append(QByteArray::number(i) + ':' + QByteArray(i * 100, char('a' + i % 26)));
+        expected += messages.last();
+    }
+    for (const QByteArray &message : std::as_const(messages))
+        blocks.append(message);
+
+    QSignalSpy spyBytesWritten(&client, &QLocalSocket::bytesWritten);
+    QCOMPARE(client.write(blocks), qint64(expected.size()));
+    QCOMPARE(client.bytesToWrite(), qint64(expected.size()));
+
+    QByteArray received;
+    while (received.size() < expected.size()) {
+        QVERIFY(client.bytesToWrite() == 0 || client.waitForBytesWritten());
+        if (!serverSocket->bytesAvailable())
+            QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, expected);
+
+    qint64 bytesWritten = 0;
+    for (const QList<QVariant> &args : std::as_const(spyBytesWritten))
+        bytesWritten += args.at(0).toLongLong();
+    QCOMPARE(bytesWritten, qint64(expected.size()));
+}
+
 void tst_QLocalSocket::readBufferOverflow()
 {
     const int readBufferSize = 128;
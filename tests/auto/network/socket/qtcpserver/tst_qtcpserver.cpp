@@ -35,6 +35,8 @@
 #include <QNetworkProxy>
 #include <QSet>
 #include <QList>
+#include <QSemaphore>
+#include <QThread>
 
 #include "../../../network-settings.h"
 
@@ -95,6 +97,9 @@ private slots:
     void pendingConnectionAvailable_data();
     void pendingConnectionAvailable();
 
+    void portSharing();
+    void portSharingThreads();
+
 private:
     bool shouldSkipIpv6TestsForBrokenGetsockopt();
 #ifdef SHOULD_CHECK_SYSCALL_SUPPORT
@@ -1149,5 +1154,136 @@ void tst_QTcpServer::pendingConnectionAvailable()
     QCOMPARE(pendingConnectionSpy.size(), 1);
 }
 
+void tst_QTcpServer::portSharing()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Port sharing is not supported with proxies");
+
+    QTcpServer first;
+    QVERIFY(!first.isPortSharingEnabled());
+    first.setPortSharingEnabled(true);
+    QVERIFY(first.isPortSharingEnabled());
+    if (!first.listen(QHostAddress::LocalHost, 0)) {
+        QCOMPARE(first.serverError(), QAbstractSocket::UnsupportedSocketOperationError);
+        QSKIP("Port sharing is not supported on this platform");
+    }
+    const quint16 port = first.serverPort();
+
+    // all the servers need to share the port
+    QTcpServer exclusive;
+    QVERIFY(!exclusive.listen(QHostAddress::LocalHost, port));
+    QCOMPARE(exclusive.serverError(), QAbstractSocket::AddressInUseError);
+
+    QTcpServer second;
+    second.setPortSharingEnabled(true);
+    QVERIFY2(second.listen(QHostAddress::LocalHost, port), qPrintable(second.errorString()));
+    QCOMPARE(second.serverPort(), port);
+
+    constexpr int ClientCount = 32;
+    int accepted = 0;
+    for (QTcpServer *server : { &first, &second }) {
+        connect(server, &QTcpServer::newConnection, server, [server, &accepted] {
+            while (QTcpSocket *socket = server->nextPendingConnection()) {
+                ++accepted;
+                delete socket;
+            }
+        });
+    }
+
+    QList<QTcpSocket *> clients;
+    for (int i = 0; i < ClientCount; ++i) {
+        auto client = new QTcpSocket(this);
+        client->connectToHost(QHostAddress::LocalHost, port);
+        clients.append(client);
+    }
+    QTRY_COMPARE(accepted, ClientCount);
+    qDeleteAll(clients);
+}
+
+namespace {
+class SharedPortServerThread : public QThread
+{
+public:
+    SharedPortServerThread(quint16 port, QSemaphore *listening)
+        : port(port), listening(listening)
+    {}
+
+    QAtomicInt accepted;
+    bool listenSucceeded = false;
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.setPortSharingEnabled(true);
+        listenSucceeded = server.listen(QHostAddress::LocalHost, port);
+        listening->release();
+        if (!listenSucceeded)
+            return;
+        connect(&server, &QTcpServer::newConnection, &server, [this, &server] {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                Q_ASSERT(socket->thread() == QThread::currentThread());
+                accepted.fetchAndAddRelaxed(1);
+                delete socket;
+            }
+        });
+        exec();
+    }
+
+private:
+    quint16 port;
+    QSemaphore *listening;
+};
+} // unnamed namespace
+
+void tst_QTcpServer::portSharingThreads()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Port sharing is not supported with proxies");
+
+    // reserve a port that the threads can share
+    QTcpServer reserved;
+    reserved.setPortSharingEnabled(true);
+    if (!reserved.listen(QHostAddress::LocalHost, 0))
+        QSKIP("Port sharing is not supported on this platform");
+    const quint16 port = reserved.serverPort();
+
+    constexpr int ThreadCount = 4;
+    QSemaphore listening;
+    std::vector<std::unique_ptr<SharedPortServerThread>> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+        threads.push_back(std::make_unique<SharedPortServerThread>(port, &listening));
+        threads.back()->start();
+    }
+    listening.acquire(ThreadCount);
+    for (const auto &thread : threads)
+        QVERIFY(thread->listenSucceeded);
+    // the connections are only distributed among the threads from now on
+    reserved.close();
+
+    constexpr int ClientCount = 64;
+    QList<QTcpSocket *> clients;
+    for (int i = 0; i < ClientCount; ++i) {
+        auto client = new QTcpSocket(this);
+        client->connectToHost(QHostAddress::LocalHost, port);
+        clients.append(client);
+    }
+    const auto totalAccepted = [&threads] {
+        int total = 0;
+        for (const auto &thread : threads)
+            total += thread->accepted.loadRelaxed();
+        return total;
+    };
+    QTRY_COMPARE(totalAccepted(), ClientCount);
+    qDeleteAll(clients);
+
+    for (const auto &thread : threads) {
+        thread->quit();
+        QVERIFY(thread->wait(5000));
+    }
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
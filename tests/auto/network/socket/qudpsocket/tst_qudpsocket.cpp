@@ -73,6 +73,10 @@ private slots:
     void dualStackNoIPv4onV6only();
     void connectToHost();
     void bindAndConnectToHost();
+    void writeGathered();
+    void writeDatagrams_data();
+    void writeDatagrams();
+    void receiveDatagramsMaxSize();
     void pendingDatagramSize();
     void writeDatagram();
     void performance();
@@ -803,6 +807,118 @@ void tst_QUdpSocket::bindAndConnectToHost()
 
 //----------------------------------------------------------------------------------
 
+void tst_QUdpSocket::writeGathered()
+{
+    QUdpSocket server;
+    QVERIFY2(server.bind(), server.errorString().toLatin1().constData());
+
+    QUdpSocket client;
+    client.connectToHost(makeNonAny(server.localAddress()), server.localPort());
+    QVERIFY(client.waitForConnected(5000));
+
+    // the blocks form a single datagram
+    const QByteArrayView blocks[] = { "header", "", "payload" };
+    QSignalSpy spyBytesWritten(&client, &QUdpSocket::bytesWritten);
+    QCOMPARE(client.write(blocks), qint64(13));
+    QCOMPARE(spyBytesWritten.size(), 1);
+    QCOMPARE(spyBytesWritten.at(0).at(0).toLongLong(), qint64(13));
+
+    QVERIFY2(server.waitForReadyRead(), QtNetworkSettings::msgSocketError(server).constData());
+    const QNetworkDatagram datagram = server.receiveDatagram();
+    QCOMPARE(datagram.data(), QByteArray("headerpayload"));
+    QVERIFY(!server.hasPendingDatagrams());
+}
+
+//----------------------------------------------------------------------------------
+
+void tst_QUdpSocket::writeDatagrams_data()
+{
+    QTest::addColumn<QList<int>>("sizes");
+
+    // consecutive datagrams of the same size may be segmented by the kernel
+    QTest::newRow("same-size") << QList<int>(100, 1200);
+    QTest::newRow("shorter-last") << QList<int>{ 1000, 1000, 1000, 10, 1000, 1000 };
+    QTest::newRow("mixed") << QList<int>{ 1, 500, 20, 20, 1400, 1400, 1401, 7 };
+    QTest::newRow("empty") << QList<int>{ 100, 100, 0, 100, 0, 0 };
+    QTest::newRow("large") << QList<int>(10, 16000);
+}
+
+void tst_QUdpSocket::writeDatagrams()
+{
+    QFETCH(QList<int>, sizes);
+
+    QUdpSocket server;
+    QVERIFY2(server.bind(), server.errorString().toLatin1().constData());
+    server.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4 * 1024 * 1024);
+    const QHostAddress serverAddress = makeNonAny(server.localAddress());
+
+    QList<QNetworkDatagram> datagrams;
+    for (qsizetype i = 0; i < sizes.size(); ++i) {
+        QByteArray data(sizes.at(i), Qt::Uninitialized);
+        for (qsizetype j = 0; j < data.size(); ++j)
+            data[j] = char('a' + (i + j) % 26);
+        datagrams.append(QNetworkDatagram(data, serverAddress, server.localPort()));
+    }
+
+    QUdpSocket client;
+    QSignalSpy spyBytesWritten(&client, &QUdpSocket::bytesWritten);
+    qsizetype sent = 0;
+    while (sent < datagrams.size()) {
+        const qsizetype result = client.writeDatagrams(QSpan(datagrams).subspan(sent));
+        QVERIFY2(result > 0, QtNetworkSettings::msgSocketError(client).constData());
+        sent += result;
+    }
+    qint64 bytesWritten = 0;
+    for (const QList<QVariant> &arguments : std::as_const(spyBytesWritten))
+        bytesWritten += arguments.at(0).toLongLong();
+    qint64 totalSize = 0;
+    for (int size : std::as_const(sizes))
+        totalSize += size;
+    QCOMPARE(bytesWritten, totalSize);
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < datagrams.size()) {
+        if (!server.hasPendingDatagrams())
+            QVERIFY2(server.waitForReadyRead(), QtNetworkSettings::msgSocketError(server).constData());
+        received += server.receiveDatagrams(datagrams.size());
+    }
+    QVERIFY(!server.hasPendingDatagrams());
+
+    for (qsizetype i = 0; i < datagrams.size(); ++i) {
+        QCOMPARE(received.at(i).data().size(), datagrams.at(i).data().size());
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderPort(), int(client.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(server.localPort()));
+    }
+}
+
+void tst_QUdpSocket::receiveDatagramsMaxSize()
+{
+    QUdpSocket server;
+    QVERIFY2(server.bind(), server.errorString().toLatin1().constData());
+    const QHostAddress serverAddress = makeNonAny(server.localAddress());
+
+    QUdpSocket client;
+    QCOMPARE(client.writeDatagram("first datagram", serverAddress, server.localPort()), qint64(14));
+    QCOMPARE(client.writeDatagram("second", serverAddress, server.localPort()), qint64(6));
+    QCOMPARE(client.writeDatagram("third datagram", serverAddress, server.localPort()), qint64(14));
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < 3) {
+        if (!server.hasPendingDatagrams())
+            QVERIFY2(server.waitForReadyRead(), QtNetworkSettings::msgSocketError(server).constData());
+        received += server.receiveDatagrams(3 - received.size(), 6);
+    }
+    QCOMPARE(received.at(0).data(), QByteArray("first "));
+    QCOMPARE(received.at(1).data(), QByteArray("second"));
+    QCOMPARE(received.at(2).data(), QByteArray("third "));
+    QCOMPARE(received.at(2).senderPort(), int(client.localPort()));
+    QVERIFY(!server.hasPendingDatagrams());
+    QVERIFY(server.receiveDatagrams(10).isEmpty());
+}
+
+//----------------------------------------------------------------------------------
+
 void tst_QUdpSocket::pendingDatagramSize()
 {
     if (m_workaroundLinuxKernelBug)
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtConcurrent/qtconcurrentalgorithms.h>
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sort_data();
+    void sort();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void partition_data() { sort_data(); }
+    void partition();
+};
+
+static QList<quint32> randomList(qsizetype size)
+{
+    QList<quint32> list(size);
+    QRandomGenerator(size).fillRange(list.data(), list.size());
+    return list;
+}
+
+// A thread count of 0 selects the sequential std:: algorithm.
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<int>("threadCount");
+
+    for (qsizetype size : { 10000, 1000000, 10000000 }) {
+        QTest::addRow("%lld items, std", qlonglong(size)) << size << 0;
+        for (int threadCount : { 1, 2, 4, 8, 16 })
+            QTest::addRow("%lld items, %d threads", qlonglong(size), threadCount)
+                    << size << threadCount;
+    }
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(qsizetype, size);
+    QFETCH(int, threadCount);
+
+    const QList<quint32> input = randomList(size);
+    QList<quint32> list;
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threadCount, 1));
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threadCount == 0)
+            std::sort(list.begin(), list.end());
+        else
+            QtConcurrent::blockingSort(&pool, list);
+    }
+    QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::stableSort()
+{
+    QFETCH(qsizetype, size);
+    QFETCH(int, threadCount);
+
+    const QList<quint32> input = randomList(size);
+    QList<quint32> list;
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threadCount, 1));
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threadCount == 0)
+            std::stable_sort(list.begin(), list.end());
+        else
+            QtConcurrent::blockingStableSort(&pool, list);
+    }
+    QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(qsizetype, size);
+    QFETCH(int, threadCount);
+
+    const QList<quint32> input = randomList(size);
+    QList<quint32> output(size);
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threadCount, 1));
+
+    QBENCHMARK {
+        if (threadCount == 0)
+            std::inclusive_scan(input.cbegin(), input.cend(), output.begin());
+        else
+            QtConcurrent::blockingInclusiveScan(&pool, input.cbegin(), input.cend(),
+                                                output.begin());
+    }
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(qsizetype, size);
+    QFETCH(int, threadCount);
+
+    const QList<quint32> input = randomList(size);
+    QList<quint32> list;
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threadCount, 1));
+    const auto isOdd = [](quint32 value) { return value & 1; };
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threadCount == 0)
+            std::partition(list.begin(), list.end(), isOdd);
+        else
+            QtConcurrent::blockingPartition(&pool, list, isOdd);
+    }
+    QVERIFY(std::is_partitioned(list.cbegin(), list.cend(), isOdd));
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+
+#include "tst_bench_qtconcurrentalgorithms.moc"
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtConcurrent/qtconcurrentmap.h>
+
+#include <QTest>
+
+#include <cmath>
+#include <numeric>
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void map_data();
+    void map();
+    void mappedReduced_data() { map_data(); }
+    void mappedReduced();
+};
+
+enum Workload { Uniform, FrontLoaded, Sparse };
+Q_DECLARE_METATYPE(Workload)
+
+// Returns how many units of work the item at \a index costs.
+static int cost(Workload workload, int index, int count)
+{
+    switch (workload) {
+    case Uniform:
+        return 10;
+    case FrontLoaded:
+        // the first 1% of the items carry most of the work
+        return index < count / 100 ? 5000 : 10;
+    case Sparse:
+        return index % 1000 == 0 ? 20000 : 10;
+    }
+    Q_UNREACHABLE_RETURN(0);
+}
+
+static double work(int units)
+{
+    double value = 0;
+    for (int i = 0; i < units; ++i)
+        value += std::sqrt(double(i));
+    return value;
+}
+
+void tst_QtConcurrentMap::map_data()
+{
+    QTest::addColumn<Workload>("workload");
+    QTest::addColumn<bool>("lazySplitting");
+
+    const struct { Workload workload; const char *name; } workloads[] = {
+        { Uniform, "uniform" }, { FrontLoaded, "front-loaded" }, { Sparse, "sparse" },
+    };
+    for (const auto &w : workloads) {
+        QTest::addRow("%s, block sizes", w.name) << w.workload << false;
+        QTest::addRow("%s, lazy splitting", w.name) << w.workload << true;
+    }
+}
+
+void tst_QtConcurrentMap::map()
+{
+    QFETCH(Workload, workload);
+    QFETCH(bool, lazySplitting);
+
+    QList<int> list(100000);
+    QThreadPool pool;
+    const auto mode = lazySplitting ? QtConcurrent::SplittingMode::Lazy
+                                    : QtConcurrent::SplittingMode::Blocks;
+
+    QBENCHMARK {
+        std::iota(list.begin(), list.end(), 0);
+        QtConcurrent::blockingMap(mode, &pool, list, [&](int &value) {
+            value = int(work(cost(workload, value, int(list.size()))));
+        });
+    }
+}
+
+void tst_QtConcurrentMap::mappedReduced()
+{
+    QFETCH(Workload, workload);
+    QFETCH(bool, lazySplitting);
+
+    QList<int> list(100000);
+    std::iota(list.begin(), list.end(), 0);
+    QThreadPool pool;
+    const auto mode = lazySplitting ? QtConcurrent::SplittingMode::Lazy
+                                    : QtConcurrent::SplittingMode::Blocks;
+
+    QBENCHMARK {
+        const double sum = QtConcurrent::blockingMappedReduced<double>(
+                mode, &pool, list,
+                [&](int value) { return work(cost(workload, value, int(list.size()))); },
+                [](double &sum, double value) { sum += value; },
+                QtConcurrent::OrderedReduce);
+        Q_UNUSED(sum);
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "tst_bench_qtconcurrentmap.moc"
@@ -48,22 +48,28 @@ private slots:
     void diriterator_data() { data(); }
     void dirlisting();
     void dirlisting_data() { data(); }
+    void dirlistingMetaData();
+    void dirlistingMetaData_data();
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
 };
 
-void tst_QDirIterator::data()
+static QByteArray corelibPath()
 {
     const char hereRelative[] = "tests/benchmarks/corelib/io/qdiriterator";
     QByteArray dir(QT_TESTCASE_SOURCEDIR);
     // qDebug("Source dir: %s", dir.constData());
     dir.chop(sizeof(hereRelative)); // Counts the '\0', making up for the omitted leading '/'
     // qDebug("Root dir: %s", dir.constData());
+    return dir + "/src/corelib";
+}
 
+void tst_QDirIterator::data()
+{
     QTest::addColumn<QByteArray>("dirpath");
-    const QByteArray ba = dir + "/src/corelib";
+    const QByteArray ba = corelibPath();
 
     if (!QFileInfo(QString::fromLocal8Bit(ba)).isDir())
         QSKIP("Missing Qt directory");
@@ -226,6 +232,43 @@ void tst_QDirIterator::dirlisting()
     qDebug() << count;
 }
 
+void tst_QDirIterator::dirlistingMetaData_data()
+{
+    QTest::addColumn<QByteArray>("dirpath");
+    QTest::addColumn<bool>("prefetch");
+    const QByteArray ba = corelibPath();
+
+    if (!QFileInfo(QString::fromLocal8Bit(ba)).isDir())
+        QSKIP("Missing Qt directory");
+
+    QTest::newRow("corelib, on demand") << ba << false;
+    QTest::newRow("corelib, prefetch") << ba << true;
+    QTest::newRow("corelib/io, on demand") << (ba + "/io") << false;
+    QTest::newRow("corelib/io, prefetch") << (ba + "/io") << true;
+}
+
+void tst_QDirIterator::dirlistingMetaData()
+{
+    QFETCH(QByteArray, dirpath);
+    QFETCH(bool, prefetch);
+
+    using F = QDirListing::IteratorFlag;
+    const QDirListing::IteratorFlags flags = F::Recursive | F::IncludeHidden
+            | (prefetch ? F::PrefetchMetaData : F::Default);
+
+    qint64 totalSize = 0;
+
+    QBENCHMARK {
+        qint64 size = 0;
+        for (const auto &dirEntry : QDirListing(dirpath, flags)) {
+            if (dirEntry.isFile())
+                size += dirEntry.size();
+        }
+        totalSize = size;
+    }
+    qDebug() << totalSize;
+}
+
 void tst_QDirIterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
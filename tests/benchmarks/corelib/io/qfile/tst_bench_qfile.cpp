@@ -81,6 +81,9 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void writeGathered_data();
+    void writeGathered();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +591,58 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::writeGathered_data()
+{
+    QTest::addColumn<QIODevice::OpenMode>("openMode");
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<bool>("gathered");
+
+    const QIODevice::OpenMode unbuffered = QIODevice::WriteOnly | QIODevice::Unbuffered;
+    for (int payloadSize : { 1024, 64 * 1024 }) {
+        const QByteArray size = QByteArray::number(payloadSize);
+        QTest::newRow("buffered:" + size + ":separate")
+                << QIODevice::OpenMode(QIODevice::WriteOnly) << payloadSize << false;
+        QTest::newRow("buffered:" + size + ":gathered")
+                << QIODevice::OpenMode(QIODevice::WriteOnly) << payloadSize << true;
+        QTest::newRow("unbuffered:" + size + ":separate") << unbuffered << payloadSize << false;
+        QTest::newRow("unbuffered:" + size + ":gathered") << unbuffered << payloadSize << true;
+    }
+}
+
+void tst_qfile::writeGathered()
+{
+    QFETCH(QIODevice::OpenMode, openMode);
+    QFETCH(int, payloadSize);
+    QFETCH(bool, gathered);
+
+    // a record made of a small header, a payload and a trailer
+    const QByteArray header(16, 'h');
+    const QByteArray payload(payloadSize, 'p');
+    const QByteArray trailer(4, 't');
+    const QByteArrayView record[] = { header, payload, trailer };
+    const int records = 256;
+
+    QFile file(tempDir.filePath("writeGathered"));
+    QVERIFY(file.open(openMode | QIODevice::Truncate));
+
+    QBENCHMARK {
+        file.seek(0);
+        if (gathered) {
+            for (int i = 0; i < records; ++i)
+                file.write(record);
+        } else {
+            for (int i = 0; i < records; ++i) {
+                for (QByteArrayView block : record)
+                    file.write(block.data(), block.size());
+            }
+        }
+        file.flush();
+    }
+    QCOMPARE(file.size(), records * (header.size() + payload.size() + trailer.size()));
+    file.close();
+    file.remove();
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
@@ -4,6 +4,7 @@
 #include <QTest>
 #include <QSignalSpy>
 #include <QtCore/QProcess>
+#include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 
 class tst_QProcess : public QObject
@@ -13,6 +14,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startLatency_data();
+    void startLatency();
 };
 
 #ifdef Q_OS_WIN
@@ -66,5 +69,51 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startLatency_data()
+{
+    QTest::addColumn<bool>("customEnvironment");
+    QTest::addColumn<bool>("workingDirectory");
+    QTest::addColumn<bool>("childProcessModifier");
+
+    QTest::newRow("plain") << false << false << false;
+    QTest::newRow("environment") << true << false << false;
+    QTest::newRow("working-directory") << false << true << false;
+#ifdef Q_OS_UNIX
+    QTest::newRow("child-process-modifier") << false << false << true;
+#endif
+}
+
+// the time it takes to start a process that exits right away and to reap it
+void tst_QProcess::startLatency()
+{
+    QFETCH(bool, customEnvironment);
+    QFETCH(bool, workingDirectory);
+    QFETCH(bool, childProcessModifier);
+
+    QProcess process;
+    process.setProgram(QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE));
+    process.setStandardInputFile(QProcess::nullDevice());
+    if (customEnvironment) {
+        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+        for (int i = 0; i < 100; ++i)
+            environment.insert(QString::fromLatin1("QT_BENCH_VARIABLE_%1").arg(i), "value");
+        process.setProcessEnvironment(environment);
+    }
+    if (workingDirectory)
+        process.setWorkingDirectory(QDir::tempPath());
+#ifdef Q_OS_UNIX
+    if (childProcessModifier)
+        process.setChildProcessModifier([] {});
+#else
+    Q_UNUSED(childProcessModifier);
+#endif
+
+    QBENCHMARK {
+        process.start();
+        QVERIFY2(process.waitForFinished(), qPrintable(process.errorString()));
+        QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    }
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <QTest>
+#include <QtCore/QSettings>
+#include <QtCore/QTemporaryDir>
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void syncSmallChange_data();
+    void syncSmallChange();
+
+private:
+    QTemporaryDir tempDir;
+};
+
+void tst_QSettings::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+}
+
+void tst_QSettings::syncSmallChange_data()
+{
+    QTest::addColumn<int>("keyCount");
+    QTest::addColumn<bool>("incremental");
+
+    for (int keyCount : { 10, 1000, 100000 }) {
+        QTest::addRow("rewrite-%d", keyCount) << keyCount << false;
+        QTest::addRow("incremental-%d", keyCount) << keyCount << true;
+    }
+}
+
+// the cost of saving one changed key, depending on the size of the file
+void tst_QSettings::syncSmallChange()
+{
+    QFETCH(int, keyCount);
+    QFETCH(bool, incremental);
+
+    const QString fileName = tempDir.filePath(QString::fromLatin1(QTest::currentDataTag())
+                                              + QLatin1String(".ini"));
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        for (int i = 0; i < keyCount; ++i) {
+            settings.setValue(QStringLiteral("group%1/key%2").arg(i % 100).arg(i),
+                              QStringLiteral("value %1").arg(i));
+        }
+    }
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    settings.setIncrementalSyncEnabled(incremental);
+    int counter = 0;
+    QBENCHMARK {
+        settings.setValue("state/counter", ++counter);
+        settings.sync();
+    }
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+QTEST_MAIN(tst_QSettings)
+
+#include "tst_bench_qsettings.moc"
@@ -1,7 +1,9 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 #include <QtCore>
+#ifndef QT_NO_WIDGETS
 #include <QtWidgets/QTreeView>
+#endif
 #include <qtest.h>
 #include "object.h"
 #include <qcoreapplication.h>
@@ -20,11 +22,15 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void queued_signal_throughput();
+    void queued_signal_throughput_data();
+#ifndef QT_NO_WIDGETS
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
+#endif
     void receiver_destroyed_benchmark();
 
     void stdAllocator();
@@ -153,26 +159,82 @@ void tst_QObject::signal_slot_benchmark()
 
 void tst_QObject::signal_many_receivers_data()
 {
+    QTest::addColumn<bool>("functor");
     QTest::addColumn<int>("receiverCount");
-    QTest::newRow("100 receivers") << 100;
-    QTest::newRow("1 000 receivers") << 1000;
-    QTest::newRow("10 000 receivers") << 10000;
+    for (int receiverCount : { 1, 10, 100, 1000, 10000 }) {
+        const QByteArray receivers = receiverCount == 1 ? "1 receiver"
+                : QByteArray::number(receiverCount) + " receivers";
+        QTest::newRow("slot, " + receivers) << false << receiverCount;
+        QTest::newRow("functor, " + receivers) << true << receiverCount;
+    }
 }
 
 void tst_QObject::signal_many_receivers()
 {
+    QFETCH(bool, functor);
     QFETCH(int, receiverCount);
     Object sender;
-    std::vector<Object> receivers(receiverCount);
+    std::vector<Object> receivers(functor ? 0 : receiverCount);
+    int calls = 0;
 
-    for (Object &receiver : receivers)
-        QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+    if (functor) {
+        for (int i = 0; i < receiverCount; ++i)
+            QObject::connect(&sender, &Object::signal0, [&calls] { ++calls; });
+    } else {
+        for (Object &receiver : receivers)
+            QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+    }
 
     QBENCHMARK {
         sender.emitSignal0();
     }
 }
 
+void tst_QObject::queued_signal_throughput_data()
+{
+    QTest::addColumn<int>("senderCount");
+    QTest::newRow("1 sender thread") << 1;
+    QTest::newRow("2 sender threads") << 2;
+    QTest::newRow("4 sender threads") << 4;
+    QTest::newRow("8 sender threads") << 8;
+}
+
+void tst_QObject::queued_signal_throughput()
+{
+    QFETCH(int, senderCount);
+    constexpr int SignalsPerSender = 20000;
+    const int total = senderCount * SignalsPerSender;
+
+    QEventLoop loop;
+    Object receiver;
+    int received = 0;
+    std::vector<std::unique_ptr<Object>> senders;
+    for (int i = 0; i < senderCount; ++i) {
+        senders.push_back(std::make_unique<Object>());
+        // emitted from other threads, so the connections are queued
+        QObject::connect(senders.back().get(), &Object::signal0, &receiver, [&] {
+            if (++received == total)
+                loop.quit();
+        });
+    }
+
+    QBENCHMARK {
+        received = 0;
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (const auto &sender : senders) {
+            threads.emplace_back(QThread::create([object = sender.get()] {
+                for (int i = 0; i < SignalsPerSender; ++i)
+                    object->emitSignal0();
+            }));
+            threads.back()->start();
+        }
+        loop.exec();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
+#ifndef QT_NO_WIDGETS
 void tst_QObject::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
@@ -271,6 +333,8 @@ void tst_QObject::connect_disconnect_benchmark()
     }
 }
 
+#endif // QT_NO_WIDGETS
+
 void tst_QObject::receiver_destroyed_benchmark()
 {
     Object sender;
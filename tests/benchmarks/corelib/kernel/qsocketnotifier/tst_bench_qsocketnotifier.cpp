@@ -0,0 +1,140 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <QtCore>
+#include <qtest.h>
+
+#include <errno.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// Measures the cost of one event loop iteration as a function of the number
+// of enabled socket notifiers. Only one descriptor is ever active, so the
+// difference between rows is pure dispatcher overhead.
+//
+// Run with QT_EVENT_DISPATCHER_EPOLL=1 to measure the epoll backend of
+// QEventDispatcherUNIX.
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void processEvents_data();
+    void processEvents();
+    void toggleNotifier_data();
+    void toggleNotifier();
+
+private:
+    int maxNotifiers = 0;
+};
+
+struct Pipe
+{
+    int fds[2] = { -1, -1 };
+    Pipe() { if (::pipe(fds) != 0) fds[0] = fds[1] = -1; }
+    ~Pipe() { ::close(fds[0]); ::close(fds[1]); }
+};
+
+// idle notifiers share one pipe that is never written to
+class IdleNotifiers
+{
+public:
+    explicit IdleNotifiers(int count, int fd)
+    {
+        notifiers.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int dupped = ::dup(fd);
+            if (dupped == -1)
+                break;
+            notifiers.push_back(std::make_unique<QSocketNotifier>(dupped, QSocketNotifier::Read));
+        }
+    }
+    ~IdleNotifiers()
+    {
+        for (auto &n : notifiers) {
+            const int fd = int(n->socket());
+            n.reset();
+            ::close(fd);
+        }
+    }
+    int size() const { return int(notifiers.size()); }
+
+private:
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+};
+
+void tst_QSocketNotifier::initTestCase()
+{
+    rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+        getrlimit(RLIMIT_NOFILE, &rl);
+        maxNotifiers = int(qMin<rlim_t>(rl.rlim_cur, INT_MAX)) - 64;
+    }
+    qDebug() << "Event dispatcher:" << QAbstractEventDispatcher::instance()->metaObject()->className()
+             << (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0 ? "(epoll requested)" : "");
+}
+
+void tst_QSocketNotifier::processEvents_data()
+{
+    QTest::addColumn<int>("count");
+    for (int count : { 0, 10, 100, 1000, 5000, 20000 })
+        QTest::addRow("%d notifiers", count) << count;
+}
+
+void tst_QSocketNotifier::processEvents()
+{
+    QFETCH(int, count);
+    if (count > maxNotifiers)
+        QSKIP("Not enough file descriptors available");
+
+    Pipe idle;
+    Pipe active;
+    IdleNotifiers notifiers(count, idle.fds[0]);
+    QCOMPARE(notifiers.size(), count);
+
+    int activations = 0;
+    QSocketNotifier notifier(active.fds[0], QSocketNotifier::Read);
+    connect(&notifier, &QSocketNotifier::activated, this, [&] {
+        char c;
+        if (::read(active.fds[0], &c, 1) == 1)
+            ++activations;
+    });
+
+    QBENCHMARK {
+        const char c = 'x';
+        QVERIFY(::write(active.fds[1], &c, 1) == 1);
+        QCoreApplication::processEvents();
+    }
+    QVERIFY(activations > 0);
+}
+
+void tst_QSocketNotifier::toggleNotifier_data()
+{
+    processEvents_data();
+}
+
+void tst_QSocketNotifier::toggleNotifier()
+{
+    QFETCH(int, count);
+    if (count > maxNotifiers)
+        QSKIP("Not enough file descriptors available");
+
+    Pipe idle;
+    IdleNotifiers notifiers(count, idle.fds[0]);
+    QCOMPARE(notifiers.size(), count);
+
+    // enabling/disabling a notifier between loop iterations, as
+    // QAbstractSocket does for its write notifier
+    QSocketNotifier notifier(idle.fds[1], QSocketNotifier::Write);
+    QBENCHMARK {
+        notifier.setEnabled(false);
+        QCoreApplication::processEvents();
+        notifier.setEnabled(true);
+    }
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "tst_bench_qsocketnotifier.moc"
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <QtCore>
+#include <qtest.h>
+
+// Servers typically keep one timeout per connection and restart it whenever
+// there is activity, so the cost of starting and stopping a timer while many
+// others are registered matters more than the cost of firing one.
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void restart_data();
+    void restart();
+    void startStop_data();
+    void startStop();
+};
+
+static void addRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("type");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        QTest::addRow("%d precise", count) << count << Qt::PreciseTimer;
+        QTest::addRow("%d coarse", count) << count << Qt::CoarseTimer;
+        QTest::addRow("%d verycoarse", count) << count << Qt::VeryCoarseTimer;
+    }
+}
+
+static std::vector<std::unique_ptr<QTimer>> createTimers(int count, Qt::TimerType type)
+{
+    std::vector<std::unique_ptr<QTimer>> timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto timer = std::make_unique<QTimer>();
+        timer->setTimerType(type);
+        // timeouts between 30 and 90 seconds, none of which fire while measuring
+        timer->setInterval(std::chrono::milliseconds(30'000 + (i * 7919) % 60'000));
+        timers.push_back(std::move(timer));
+    }
+    return timers;
+}
+
+void tst_QTimer::restart_data()
+{
+    addRows();
+}
+
+void tst_QTimer::restart()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    auto timers = createTimers(count, type);
+    for (auto &timer : timers)
+        timer->start();
+
+    // restarting an active timer unregisters and registers it again
+    qsizetype i = 0;
+    QBENCHMARK {
+        timers[i]->start();
+        i = (i + 1) % count;
+    }
+}
+
+void tst_QTimer::startStop_data()
+{
+    addRows();
+}
+
+void tst_QTimer::startStop()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    auto timers = createTimers(count, type);
+    QBENCHMARK {
+        for (auto &timer : timers)
+            timer->start();
+        for (auto &timer : timers)
+            timer->stop();
+    }
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
@@ -24,6 +24,11 @@ struct QRecursiveReadWriteLock : QReadWriteLock
     QRecursiveReadWriteLock() : QReadWriteLock(Recursive) {}
 };
 
+struct QDistributedReadWriteLock : QReadWriteLock
+{
+    QDistributedReadWriteLock() : QReadWriteLock(NonRecursive, DistributedReaderCount) {}
+};
+
 template <typename T, size_t N>
   // requires N = 2^M for some Integral M >= 0
 struct Recursive
@@ -82,6 +87,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readScaling_data();
+    void readScaling();
     // void readWrite();
 };
 
@@ -123,6 +130,10 @@ void tst_QReadWriteLock::uncontended_data()
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QReadLocker>);
     QTest::newRow("QReadWriteLock, write")
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("QReadWriteLock, read, distributed")
+        << FunctionPtrHolder(testUncontended<QDistributedReadWriteLock, QReadLocker>);
+    QTest::newRow("QReadWriteLock, write, distributed")
+        << FunctionPtrHolder(testUncontended<QDistributedReadWriteLock, QWriteLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, %s, recursive: %d", "read", n) \
         << FunctionPtrHolder(testUncontended<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>); \
@@ -199,6 +210,8 @@ void tst_QReadWriteLock::readOnly_data()
     QTest::newRow("nothing") << FunctionPtrHolder(testReadOnly<int, FakeLock>);
     QTest::newRow("QMutex") << FunctionPtrHolder(testReadOnly<QMutex, QMutexLocker<QMutex>>);
     QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testReadOnly<QReadWriteLock, QReadLocker>);
+    QTest::newRow("QReadWriteLock, distributed")
+        << FunctionPtrHolder(testReadOnly<QDistributedReadWriteLock, QReadLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, recursive: %d", n) \
         << FunctionPtrHolder(testReadOnly<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>)
@@ -267,6 +280,8 @@ void tst_QReadWriteLock::writeOnly_data()
     // QTest::newRow("nothing") << FunctionPtrHolder(testWriteOnly<int, FakeLock>);
     QTest::newRow("QMutex") << FunctionPtrHolder(testWriteOnly<QMutex, QMutexLocker<QMutex>>);
     QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testWriteOnly<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("QReadWriteLock, distributed")
+        << FunctionPtrHolder(testWriteOnly<QDistributedReadWriteLock, QWriteLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, recursive: %d", n) \
         << FunctionPtrHolder(testWriteOnly<QRecursiveReadWriteLock, QRecursiveWriteLocker<n>>)
@@ -294,5 +309,53 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+// Many threads taking the lock for reading around a tiny critical section,
+// which is where contention on the lock's own state shows the most.
+template <typename Mutex, typename Locker>
+void testReadScaling(int threads)
+{
+    static int shared = 0;
+    Mutex lock;
+    std::vector<std::unique_ptr<QThread>> workers;
+    QBENCHMARK {
+        workers.clear();
+        for (int i = 0; i < threads; ++i) {
+            workers.emplace_back(QThread::create([&lock] {
+                int sum = 0;
+                for (int i = 0; i < Iterations; ++i) {
+                    Locker locker(&lock);
+                    sum += shared;
+                }
+                Q_UNUSED(sum);
+            }));
+        }
+        for (auto &t : workers)
+            t->start();
+        for (auto &t : workers)
+            t->wait();
+    }
+}
+
+void tst_QReadWriteLock::readScaling_data()
+{
+    QTest::addColumn<bool>("distributed");
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= qMax(64, threadCount); threads *= 2) {
+        QTest::addRow("QReadWriteLock, %d threads", threads) << false << threads;
+        QTest::addRow("QReadWriteLock, distributed, %d threads", threads) << true << threads;
+    }
+}
+
+void tst_QReadWriteLock::readScaling()
+{
+    QFETCH(bool, distributed);
+    QFETCH(int, threads);
+    if (distributed)
+        testReadScaling<QDistributedReadWriteLock, QReadLocker>(threads);
+    else
+        testReadScaling<QReadWriteLock, QReadLocker>(threads);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void startFromPoolThreads_data();
+    void startFromPoolThreads();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,43 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::startFromPoolThreads_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    for (int threadCount : { 1, 2, 4, 8, 16, 32, 64 }) {
+        QTest::addRow("%d threads, shared queue", threadCount) << threadCount << false;
+        QTest::addRow("%d threads, work stealing", threadCount) << threadCount << true;
+    }
+}
+
+// Each pool thread floods the pool with tiny tasks, which is where the
+// shared queue's mutex becomes the bottleneck.
+void tst_QThreadPool::startFromPoolThreads()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    constexpr int TasksPerThread = 10000;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QAtomicInt count;
+    QBENCHMARK {
+        count.storeRelaxed(0);
+        for (int i = 0; i < threadCount; ++i) {
+            threadPool.start([&] {
+                for (int j = 0; j < TasksPerThread; ++j)
+                    threadPool.start([&] { count.ref(); });
+            });
+        }
+        threadPool.waitForDone();
+    }
+    QCOMPARE(count.loadRelaxed(), threadCount * TasksPerThread);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
@@ -0,0 +1,127 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QTest>
+
+#include <QtNetwork/private/bitstreams_p.h>
+#include <QtNetwork/private/hpack_p.h>
+
+using namespace HPack;
+
+class tst_Hpack : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encodeRequest_data();
+    void encodeRequest();
+    void huffmanEncode_data();
+    void huffmanEncode();
+    void huffmanDecode_data();
+    void huffmanDecode();
+};
+
+namespace {
+
+HttpHeader typicalRequest()
+{
+    return {
+        { ":method", "GET" },
+        { ":scheme", "https" },
+        { ":authority", "www.example.com" },
+        { ":path", "/" },
+        { "user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)" },
+        { "accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8" },
+        { "accept-language", "en-US,en;q=0.5" },
+        { "accept-encoding", "gzip, deflate, br" },
+        { "cookie", "session=0123456789abcdef0123456789abcdef; theme=dark" },
+    };
+}
+
+void addStrings()
+{
+    QTest::addColumn<QByteArray>("string");
+    QTest::newRow("token") << QByteArray("gzip, deflate, br");
+    QTest::newRow("user-agent") << typicalRequest()[4].value;
+    QTest::newRow("4KiB-text") << QByteArray("The quick brown fox jumps over the lazy dog. ")
+                                          .repeated(92);
+    QByteArray binary(4096, Qt::Uninitialized);
+    for (qsizetype i = 0; i < binary.size(); ++i)
+        binary[i] = char(i * 37);
+    QTest::newRow("4KiB-binary") << binary;
+}
+
+} // unnamed namespace
+
+void tst_Hpack::encodeRequest_data()
+{
+    QTest::addColumn<bool>("compressStrings");
+    QTest::addColumn<bool>("headerBlockCaching");
+    QTest::newRow("plain") << false << false;
+    QTest::newRow("plain-cached") << false << true;
+    QTest::newRow("huffman") << true << false;
+    QTest::newRow("huffman-cached") << true << true;
+}
+
+void tst_Hpack::encodeRequest()
+{
+    QFETCH(bool, compressStrings);
+    QFETCH(bool, headerBlockCaching);
+
+    Encoder encoder(FieldLookupTable::DefaultSize, compressStrings);
+    encoder.setHeaderBlockCachingEnabled(headerBlockCaching);
+    HttpHeader header = typicalRequest();
+    std::vector<uchar> buffer;
+    buffer.reserve(1024);
+    int requestNumber = 0;
+
+    QBENCHMARK {
+        header[3].value = "/images/" + QByteArray::number(++requestNumber) + ".png";
+        BitOStream out(buffer);
+        out.clear();
+        QVERIFY(encoder.encodeRequest(out, header));
+    }
+}
+
+void tst_Hpack::huffmanEncode_data()
+{
+    addStrings();
+}
+
+void tst_Hpack::huffmanEncode()
+{
+    QFETCH(QByteArray, string);
+
+    std::vector<uchar> buffer;
+    buffer.reserve(2 * string.size() + 16);
+
+    QBENCHMARK {
+        BitOStream out(buffer);
+        out.clear();
+        out.write(string, true);
+    }
+}
+
+void tst_Hpack::huffmanDecode_data()
+{
+    addStrings();
+}
+
+void tst_Hpack::huffmanDecode()
+{
+    QFETCH(QByteArray, string);
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    out.write(string, true);
+
+    QBENCHMARK {
+        BitIStream in(out.begin(), out.end());
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+    }
+}
+
+QTEST_MAIN(tst_Hpack)
+
+#include "tst_bench_hpack.moc"
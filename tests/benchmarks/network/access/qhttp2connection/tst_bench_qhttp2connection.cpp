@@ -0,0 +1,163 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QTest>
+
+#include <QtCore/qeventloop.h>
+#include <QtCore/qtimer.h>
+
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtNetwork/private/qhttp2connection_p.h>
+
+class tst_QHttp2Connection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void requestsPerSecond_data();
+    void requestsPerSecond();
+};
+
+namespace {
+
+constexpr int RequestCount = 2000;
+
+// Answers every request with a small response.
+class Server : public QObject
+{
+public:
+    explicit Server(qint64 responseSize) : response(responseSize, 'a')
+    {
+        connect(&server, &QTcpServer::pendingConnectionAvailable, this, [this] {
+            QTcpSocket *socket = server.nextPendingConnection();
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            QHttp2Configuration config;
+            config.setMaxConcurrentStreams(1000);
+            QHttp2Connection *connection =
+                    QHttp2Connection::createDirectServerConnection(socket, config);
+            connect(socket, &QIODevice::readyRead, connection,
+                    &QHttp2Connection::handleReadyRead);
+            connect(connection, &QHttp2Connection::newIncomingStream, this,
+                    &Server::handleStream);
+        });
+    }
+
+    bool listen() { return server.listen(QHostAddress::LocalHost); }
+    quint16 port() const { return server.serverPort(); }
+
+private:
+    void handleStream(QHttp2Stream *stream)
+    {
+        connect(stream, &QHttp2Stream::headersReceived, stream, [this, stream] {
+            stream->sendHEADERS({ { ":status", "200" } }, false);
+            stream->sendDATA(response, true);
+        });
+        connect(stream, &QHttp2Stream::stateChanged, stream,
+                [stream](QHttp2Stream::State state) {
+                    if (state == QHttp2Stream::State::Closed)
+                        stream->deleteLater();
+                });
+    }
+
+    QTcpServer server;
+    QByteArray response;
+};
+
+// Keeps a number of requests in flight until all of them were answered.
+class Client : public QObject
+{
+public:
+    Client(QHttp2Connection *connection, int concurrentStreams)
+        : connection(connection), concurrentStreams(concurrentStreams)
+    {
+    }
+
+    bool run()
+    {
+        started = finished = 0;
+        while (inFlight < concurrentStreams && startRequest()) { }
+        // Not QTest::qWaitFor(), which sleeps between checking the condition
+        QTimer::singleShot(std::chrono::minutes(1), &loop, [this] { loop.exit(1); });
+        return loop.exec() == 0;
+    }
+
+private:
+    bool startRequest()
+    {
+        if (started == RequestCount)
+            return false;
+        auto result = connection->createStream();
+        if (!result.ok())
+            return false;
+        QHttp2Stream *stream = result.unwrap();
+        connect(stream, &QHttp2Stream::dataReceived, this,
+                [this, stream](const QByteArray &, bool endStream) {
+                    if (!endStream)
+                        return;
+                    stream->deleteLater();
+                    --inFlight;
+                    if (++finished == RequestCount)
+                        loop.quit();
+                    startRequest();
+                });
+        const HPack::HttpHeader headers{
+            { ":authority", "localhost" },
+            { ":method", "GET" },
+            { ":path", "/" },
+            { ":scheme", "http" },
+        };
+        stream->sendHEADERS(headers, true);
+        ++started;
+        ++inFlight;
+        return true;
+    }
+
+    QEventLoop loop;
+    QHttp2Connection *connection;
+    const int concurrentStreams;
+    int started = 0;
+    int finished = 0;
+    int inFlight = 0;
+};
+
+} // unnamed namespace
+
+void tst_QHttp2Connection::requestsPerSecond_data()
+{
+    QTest::addColumn<int>("concurrentStreams");
+    QTest::addColumn<qint64>("responseSize");
+    for (int streams : { 1, 10, 100, 1000 }) {
+        QTest::addRow("%d-streams-1KiB", streams) << streams << qint64(1024);
+        QTest::addRow("%d-streams-64KiB", streams) << streams << qint64(64 * 1024);
+    }
+}
+
+void tst_QHttp2Connection::requestsPerSecond()
+{
+    QFETCH(int, concurrentStreams);
+    QFETCH(qint64, responseSize);
+
+    Server server(responseSize);
+    QVERIFY(server.listen());
+
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, server.port());
+    QVERIFY(socket.waitForConnected());
+    socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    QHttp2Connection *connection = QHttp2Connection::createDirectConnection(&socket, {});
+    connect(&socket, &QIODevice::readyRead, connection, &QHttp2Connection::handleReadyRead);
+    connection->setReceiveWindowAutoTuningEnabled(true);
+    QVERIFY(QTest::qWaitFor([connection] {
+        return connection->maxConcurrentStreams() == 1000;
+    }));
+
+    Client client(connection, concurrentStreams);
+    QBENCHMARK {
+        QVERIFY(client.run());
+    }
+}
+
+QTEST_MAIN(tst_QHttp2Connection)
+
+#include "tst_bench_qhttp2connection.moc"
@@ -13,6 +13,11 @@
 #include <qhostinfo.h>
 
 #include <QNetworkProxy>
+#include <QSemaphore>
+#include <QThread>
+
+#include <memory>
+#include <vector>
 
 #include "../../../../auto/network-settings.h"
 
@@ -34,6 +39,8 @@ private slots:
     void ipv4LoopbackPerformanceTest();
     void ipv6LoopbackPerformanceTest();
     void ipv4PerformanceTest();
+    void acceptThroughput_data();
+    void acceptThroughput();
 };
 
 tst_QTcpServer::tst_QTcpServer()
@@ -237,5 +244,92 @@ void tst_QTcpServer::ipv4PerformanceTest()
     delete clientB;
 }
 
+namespace {
+// Accepts connections on a shared port in its own event loop
+class AcceptThread : public QThread
+{
+public:
+    AcceptThread(quint16 port, QSemaphore *listening) : port(port), listening(listening) {}
+
+    QAtomicInt accepted;
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.setPortSharingEnabled(true);
+        server.setListenBacklogSize(1024);
+        server.setMaxPendingConnections(1024);
+        const bool ok = server.listen(QHostAddress::LocalHost, port);
+        listening->release();
+        if (!ok)
+            return;
+        connect(&server, &QTcpServer::newConnection, &server, [this, &server] {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                accepted.fetchAndAddRelaxed(1);
+                delete socket;
+            }
+        });
+        exec();
+    }
+
+private:
+    quint16 port;
+    QSemaphore *listening;
+};
+} // unnamed namespace
+
+void tst_QTcpServer::acceptThroughput_data()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int count : {1, 2, 4})
+        QTest::addRow("%d-threads", count) << count;
+}
+
+void tst_QTcpServer::acceptThroughput()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(int, threadCount);
+
+    QTcpServer reserved;
+    reserved.setPortSharingEnabled(true);
+    if (!reserved.listen(QHostAddress::LocalHost))
+        QSKIP("Port sharing is not supported on this platform");
+    const quint16 port = reserved.serverPort();
+
+    QSemaphore listening;
+    std::vector<std::unique_ptr<AcceptThread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.push_back(std::make_unique<AcceptThread>(port, &listening));
+        threads.back()->start();
+    }
+    listening.acquire(threadCount);
+    reserved.close();
+
+    constexpr int ClientCount = 128;
+    const auto totalAccepted = [&threads] {
+        int total = 0;
+        for (const auto &thread : threads)
+            total += thread->accepted.loadRelaxed();
+        return total;
+    };
+    QBENCHMARK {
+        const int expected = totalAccepted() + ClientCount;
+        std::vector<std::unique_ptr<QTcpSocket>> clients;
+        for (int i = 0; i < ClientCount; ++i) {
+            clients.push_back(std::make_unique<QTcpSocket>());
+            clients.back()->connectToHost(QHostAddress::LocalHost, port);
+        }
+        QVERIFY(QTest::qWaitFor([&] { return totalAccepted() == expected; }, 10000));
+    }
+
+    for (const auto &thread : threads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -16,6 +16,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void loopbackThroughput_data();
+    void loopbackThroughput();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -51,5 +53,59 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::loopbackThroughput_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("batched");
+    for (int value : {64, 512, 1200, 4096}) {
+        QTest::addRow("%d-single", value) << value << false;
+        QTest::addRow("%d-batched", value) << value << true;
+    }
+}
+
+void tst_QUdpSocket::loopbackThroughput()
+{
+    QFETCH(int, size);
+    QFETCH(bool, batched);
+
+    // small enough rounds for the receive buffer to hold all the datagrams
+    constexpr qsizetype Rounds = 16;
+    constexpr qsizetype Count = 32;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost));
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1024 * 1024);
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost));
+
+    const QList<QNetworkDatagram> datagrams(Count, QNetworkDatagram(QByteArray(size, 'a'),
+                                                                    QHostAddress::LocalHost,
+                                                                    receiver.localPort()));
+    QBENCHMARK {
+        for (qsizetype round = 0; round < Rounds; ++round) {
+            if (batched) {
+                QCOMPARE(sender.writeDatagrams(datagrams), Count);
+            } else {
+                for (const QNetworkDatagram &datagram : datagrams)
+                    QCOMPARE(sender.writeDatagram(datagram), qint64(size));
+            }
+
+            qsizetype received = 0;
+            while (received < Count) {
+                if (!receiver.hasPendingDatagrams())
+                    QVERIFY(receiver.waitForReadyRead(5000));
+                if (batched) {
+                    received += receiver.receiveDatagrams(Count - received).size();
+                } else {
+                    while (received < Count && receiver.hasPendingDatagrams()) {
+                        QCOMPARE(receiver.receiveDatagram().data().size(), size);
+                        ++received;
+                    }
+                }
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"